@@ -0,0 +1,317 @@
+#ifndef ASYNC_SINK_H
+#define ASYNC_SINK_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+namespace Collections {
+namespace Log {
+    /* The async sink hands formatted log lines over to a background writer thread, instead of writing (and flushing)
+     * them on the logging thread. Lines are pushed in to a lock free multiple producer single consumer queue, and the
+     * writer drains the queue in to a per file buffer that is written out in large chunks. The files are flushed only
+     * when a line that asks for it (ERROR level) is written, when the flush interval expires, or at shutdown
+     *
+     * Note that, the thread that writes a line that asks for a flush waits until the line has been flushed, since an
+     * error is usually followed by an exception that may take the process down before the writer gets to it
+    */
+    class AsyncSink {
+        public:
+            struct File {
+                std::ofstream stream;
+                std::string path;
+                /* Lines that are waiting to be written to the stream, only touched by the writer thread
+                */
+                std::string pending;
+                size_t bytesWritten;
+            };
+
+        private:
+            typedef enum {
+                OPEN_FILE  = 0,
+                WRITE_LINE = 1,
+                CLOSE_FILE = 2
+            } e_entryType;
+
+            struct Entry {
+                std::atomic <Entry*> next;
+                e_entryType type;
+                File* file;
+                std::string line;
+                /* Flush the file once the line is written (WRITE_LINE), or delete the file if nothing was written to it
+                 * (CLOSE_FILE)
+                */
+                bool flag;
+                /* Set by the writer once the line has been flushed, if the writing thread is waiting on it
+                */
+                bool* flushed;
+            };
+            /* Producers swap themselves in to the head, and the writer follows the next links from the tail. The stub
+             * entry keeps the queue from ever being empty, which is what makes the push a single exchange. See, Dmitry
+             * Vyukov's non intrusive MPSC node based queue
+            */
+            Entry m_stubEntry;
+            std::atomic <Entry*> m_head;
+            Entry* m_tail;
+            std::atomic <size_t> m_pendingCount;
+
+            std::vector <File*> m_files;
+            std::thread m_writerThread;
+            std::once_flag m_writerThreadStarted;
+            std::atomic <bool> m_stopRequested;
+            /* Only used to put the writer to sleep and to wake it up, the queue itself does not need the mutex
+            */
+            std::mutex m_wakeMutex;
+            std::condition_variable m_wakeCondition;
+            bool m_wakeRequested;
+            std::condition_variable m_flushedCondition;
+            bool m_writerExited;
+            /* Flags of the lines that were drained but not flushed yet, only touched by the writer thread
+            */
+            std::vector <bool*> m_flushWaiters;
+
+            size_t m_batchSize;
+            size_t m_wakeThreshold;
+            std::chrono::milliseconds m_flushInterval;
+
+            void push (Entry* entry) {
+                entry->next.store (nullptr, std::memory_order_relaxed);
+                Entry* prev = m_head.exchange (entry, std::memory_order_acq_rel);
+                prev->next.store (entry, std::memory_order_release);
+            }
+
+            /* Note that, the entry that is returned becomes the new tail (stub), and is freed by the next pop. A null
+             * is returned if the queue is empty, or if a producer is in the middle of linking in its entry
+            */
+            Entry* pop (void) {
+                Entry* tail = m_tail;
+                Entry* next = tail->next.load (std::memory_order_acquire);
+                if (next == nullptr)
+                    return nullptr;
+
+                m_tail = next;
+                if (tail != &m_stubEntry)
+                    delete tail;
+                return next;
+            }
+
+            void wake (void) {
+                {
+                    std::lock_guard <std::mutex> lock (m_wakeMutex);
+                    m_wakeRequested = true;
+                }
+                m_wakeCondition.notify_one();
+            }
+
+            void writePending (File* file) {
+                if (file->pending.empty())
+                    return;
+
+                file->stream.write (file->pending.data(), static_cast <std::streamsize> (file->pending.size()));
+                file->bytesWritten += file->pending.size();
+                file->pending.clear();
+            }
+
+            void flushFiles (void) {
+                for (auto const& file: m_files) {
+                    writePending (file);
+                    file->stream.flush();
+                }
+            }
+
+            void drain (void) {
+                while (Entry* entry = pop()) {
+                    File* file = entry->file;
+                    switch (entry->type) {
+                        case OPEN_FILE:
+                            m_files.push_back (file);
+                            break;
+
+                        case WRITE_LINE:
+                            file->pending += entry->line;
+                            entry->line.clear();
+                            if (file->pending.size() >= m_batchSize)
+                                writePending (file);
+                            if (entry->flushed != nullptr)
+                                m_flushWaiters.push_back (entry->flushed);
+                            m_pendingCount.fetch_sub (1, std::memory_order_relaxed);
+                            break;
+
+                        case CLOSE_FILE:
+                            writePending (file);
+                            file->stream.close();
+                            if (entry->flag && file->bytesWritten == 0)
+                                std::remove (file->path.c_str());
+
+                            m_files.erase (std::remove (m_files.begin(), m_files.end(), file), m_files.end());
+                            delete file;
+                            break;
+                    }
+                }
+            }
+
+            void runWriter (void) {
+                auto nextFlush = std::chrono::steady_clock::now() + m_flushInterval;
+                while (true) {
+                    bool stopRequested = m_stopRequested.load (std::memory_order_acquire);
+                    drain();
+
+                    auto now = std::chrono::steady_clock::now();
+                    if (!m_flushWaiters.empty() || stopRequested || now >= nextFlush) {
+                        flushFiles();
+                        nextFlush = now + m_flushInterval;
+                    }
+                    if (!m_flushWaiters.empty()) {
+                        {
+                            std::lock_guard <std::mutex> lock (m_wakeMutex);
+                            for (auto const& flushed: m_flushWaiters)
+                                *flushed = true;
+                        }
+                        m_flushWaiters.clear();
+                        m_flushedCondition.notify_all();
+                    }
+                    /* The stop request is read before draining, so every line pushed before it has been written
+                    */
+                    if (stopRequested)
+                        break;
+
+                    std::unique_lock <std::mutex> lock (m_wakeMutex);
+                    m_wakeCondition.wait_until (lock, nextFlush, [this] {
+                        return m_wakeRequested || m_stopRequested.load (std::memory_order_acquire);
+                    });
+                    m_wakeRequested = false;
+                }
+                {
+                    std::lock_guard <std::mutex> lock (m_wakeMutex);
+                    m_writerExited = true;
+                }
+                m_flushedCondition.notify_all();
+            }
+
+            void startWriter (void) {
+                std::call_once (m_writerThreadStarted, [this] {
+                    m_writerThread = std::thread (&AsyncSink::runWriter, this);
+                });
+            }
+
+        public:
+            AsyncSink (size_t batchSize                       = 64 * 1024,
+                       size_t wakeThreshold                   = 4096,
+                       std::chrono::milliseconds flushInterval = std::chrono::milliseconds (100)) {
+
+                m_stubEntry.next.store (nullptr, std::memory_order_relaxed);
+                m_head.store (&m_stubEntry, std::memory_order_relaxed);
+                m_tail = &m_stubEntry;
+                m_pendingCount.store (0, std::memory_order_relaxed);
+
+                m_stopRequested.store (false, std::memory_order_relaxed);
+                m_wakeRequested = false;
+                m_writerExited  = false;
+                m_batchSize     = batchSize;
+                m_wakeThreshold = wakeThreshold;
+                m_flushInterval = flushInterval;
+            }
+
+            ~AsyncSink (void) {
+                shutdown();
+                /* Files that were never closed are closed here
+                */
+                for (auto const& file: m_files) {
+                    file->stream.close();
+                    delete file;
+                }
+                m_files.clear();
+                if (m_tail != &m_stubEntry)
+                    delete m_tail;
+            }
+
+            /* The file is opened on the calling thread so that a failure to open it can be reported right away, and is
+             * handed over to the writer thread through the queue. Note that, the file is opened in append mode
+            */
+            File* openFile (const std::string& filePath) {
+                File* file = new File;
+                file->path = filePath;
+                file->stream.open (filePath, std::ios_base::app | std::ios_base::out | std::ios_base::binary);
+                if (!file->stream.is_open()) {
+                    delete file;
+                    throw std::runtime_error ("Failed to open file for TO_FILE_ASYNC sink");
+                }
+                file->bytesWritten = 0;
+
+                startWriter();
+                Entry* entry = new Entry;
+                entry->type        = OPEN_FILE;
+                entry->file        = file;
+                entry->flag        = false;
+                entry->flushed     = nullptr;
+                push (entry);
+                return file;
+            }
+
+            /* The line is moved in to the queue, the writer is woken up only if the line needs to be flushed or if
+             * enough lines have piled up. Otherwise, it picks up the line when the flush interval expires
+            */
+            void writeLine (File* file, std::string&& line, bool flush) {
+                Entry* entry       = new Entry;
+                entry->type        = WRITE_LINE;
+                entry->file        = file;
+                entry->line        = std::move (line);
+                entry->flag        = flush;
+                bool flushed       = false;
+                entry->flushed     = flush ? &flushed: nullptr;
+                push (entry);
+
+                size_t pendingCount = m_pendingCount.fetch_add (1, std::memory_order_relaxed) + 1;
+                if (!flush) {
+                    if (pendingCount == m_wakeThreshold)
+                        wake();
+                    return;
+                }
+                /* The flag lives on this thread's stack, so this must not return before the writer is done with it. If
+                 * the writer has exited (after a shutdown), the line is never written and the flag is never touched
+                */
+                std::unique_lock <std::mutex> lock (m_wakeMutex);
+                m_wakeRequested = true;
+                m_wakeCondition.notify_one();
+                m_flushedCondition.wait (lock, [this, &flushed] {
+                    return flushed || m_writerExited;
+                });
+            }
+
+            /* The file is closed (and freed) by the writer once every line written to it before the close has been
+             * written out. The file must not be used after this call
+            */
+            void closeFile (File* file, bool deleteIfEmpty) {
+                Entry* entry = new Entry;
+                entry->type        = CLOSE_FILE;
+                entry->file        = file;
+                entry->flag        = deleteIfEmpty;
+                entry->flushed     = nullptr;
+                push (entry);
+                wake();
+            }
+
+            /* Write out everything that was queued and stop the writer thread. Note that, lines written after this are
+             * queued but never written
+            */
+            void shutdown (void) {
+                if (!m_writerThread.joinable())
+                    return;
+
+                m_stopRequested.store (true, std::memory_order_release);
+                wake();
+                m_writerThread.join();
+            }
+    };
+    AsyncSink g_asyncSink;
+}   // namespace Log
+}   // namespace Collections
+#endif  // ASYNC_SINK_H
@@ -0,0 +1,138 @@
+#ifndef BINARY_FORMAT_H
+#define BINARY_FORMAT_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <atomic>
+
+namespace Collections {
+namespace Log {
+    /* A binary log (.blog) file is a sequence of entries, each starting with a one byte tag. Instead of formatting the
+     * line, a binary log statement writes the id of its format descriptor, a timestamp and the raw bytes of each of its
+     * arguments. The descriptor itself (format string, calling function, line, argument types) is written only once per
+     * file, before the first record that uses it. The decoder tool turns the file back in to text
+     *
+     * HEADER  [tag] [magic] [u16 version] [u32 instance id]
+     * FORMAT  [tag] [u32 format id] [u8 level] [u32 line] [string function] [string format] [string argument types]
+     * RECORD  [tag] [u32 format id] [u64 timestamp] [arguments]
+     *
+     * Strings are written as a u32 length followed by the characters, and all values are in host byte order. Note that,
+     * the file is opened in append mode, so a header entry starts a new session and the decoder forgets the formats
+     * it has seen till then (format ids are only unique within a session)
+    */
+    typedef enum {
+        HEADER = 0,
+        FORMAT = 1,
+        RECORD = 2
+    } e_binaryTag;
+
+    constexpr char     g_binaryMagic[4]   = {'B', 'L', 'O', 'G'};
+    constexpr uint16_t g_binaryVersion    = 1;
+
+    /* Argument types, the integer types narrower than 32 bits are widened to 32 bits
+    */
+    typedef enum {
+        ARG_BOOL   = 'b',
+        ARG_CHAR   = 'c',
+        ARG_INT32  = 'i',
+        ARG_UINT32 = 'u',
+        ARG_INT64  = 'l',
+        ARG_UINT64 = 'm',
+        ARG_FLOAT  = 'f',
+        ARG_DOUBLE = 'd',
+        ARG_STRING = 's'
+    } e_argType;
+
+    template <typename T>
+    constexpr bool g_alwaysFalse = false;
+
+    template <typename T>
+    constexpr char getArgType (void) {
+        using U = std::decay_t <T>;
+        if constexpr (std::is_same_v <U, bool>)
+            return ARG_BOOL;
+        else if constexpr (std::is_same_v <U, char>)
+            return ARG_CHAR;
+        else if constexpr (std::is_enum_v <U>)
+            return getArgType <std::underlying_type_t <U>>();
+        else if constexpr (std::is_integral_v <U> && sizeof (U) <= 4)
+            return std::is_signed_v <U> ? ARG_INT32: ARG_UINT32;
+        else if constexpr (std::is_integral_v <U>)
+            return std::is_signed_v <U> ? ARG_INT64: ARG_UINT64;
+        else if constexpr (std::is_same_v <U, float>)
+            return ARG_FLOAT;
+        else if constexpr (std::is_floating_point_v <U>)
+            return ARG_DOUBLE;
+        else if constexpr (std::is_convertible_v <U, std::string_view>)
+            return ARG_STRING;
+        else
+            static_assert (g_alwaysFalse <U>, "Unsupported binary log argument type");
+    }
+
+    /* The argument types of a call site are worked out from the types of its arguments in an unevaluated context, so
+     * that the arguments are not evaluated just to register the format
+    */
+    template <typename... T>
+    struct BinaryArgTypes {
+        static constexpr char value[] = {getArgType <T>()..., '\0'};
+    };
+
+    template <typename... T>
+    BinaryArgTypes <T...> getBinaryArgTypes (const T&...);
+
+    /* Every binary log statement owns a static format descriptor, which is created the first time the statement runs
+    */
+    struct BinaryFormat {
+        uint32_t id;
+        uint8_t level;
+        uint32_t line;
+        const char* function;
+        const char* format;
+        const char* argTypes;
+    };
+
+    inline uint32_t getNextBinaryFormatId (void) {
+        static std::atomic <uint32_t> nextId = 0;
+        return nextId.fetch_add (1, std::memory_order_relaxed);
+    }
+
+    /* Append methods used by the binary sink to build entries
+    */
+    template <typename T>
+    void appendValue (std::string& bytes, T value) {
+        char raw[sizeof (T)];
+        std::memcpy (raw, &value, sizeof (T));
+        bytes.append (raw, sizeof (T));
+    }
+
+    inline void appendString (std::string& bytes, std::string_view value) {
+        appendValue <uint32_t> (bytes, static_cast <uint32_t> (value.size()));
+        bytes.append (value.data(), value.size());
+    }
+
+    template <typename T>
+    void appendArg (std::string& bytes, const T& arg) {
+        constexpr char argType = getArgType <T>();
+        if constexpr (argType == ARG_STRING)
+            appendString (bytes, std::string_view (arg));
+        else if constexpr (argType == ARG_BOOL || argType == ARG_CHAR)
+            appendValue <uint8_t>  (bytes, static_cast <uint8_t>  (arg));
+        else if constexpr (argType == ARG_INT32)
+            appendValue <int32_t>  (bytes, static_cast <int32_t>  (arg));
+        else if constexpr (argType == ARG_UINT32)
+            appendValue <uint32_t> (bytes, static_cast <uint32_t> (arg));
+        else if constexpr (argType == ARG_INT64)
+            appendValue <int64_t>  (bytes, static_cast <int64_t>  (arg));
+        else if constexpr (argType == ARG_UINT64)
+            appendValue <uint64_t> (bytes, static_cast <uint64_t> (arg));
+        else if constexpr (argType == ARG_FLOAT)
+            appendValue <float>    (bytes, static_cast <float>    (arg));
+        else
+            appendValue <double>   (bytes, static_cast <double>   (arg));
+    }
+}   // namespace Log
+}   // namespace Collections
+#endif  // BINARY_FORMAT_H
@@ -0,0 +1,152 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <stdexcept>
+#include <algorithm>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/* Size (in bytes) of the ring in each flight recorder file. Define this before including the log header to override it
+*/
+#ifndef LOG_FLIGHT_RECORDER_SIZE
+#define LOG_FLIGHT_RECORDER_SIZE                (64 * 1024)
+#endif  // LOG_FLIGHT_RECORDER_SIZE
+
+namespace Collections {
+namespace Log {
+    /* The flight recorder keeps the most recent lines of a log in a fixed size byte ring that lives in a memory mapped
+     * file. Writing a line is a couple of copies in to the mapping, with no allocation and no system call. Since the
+     * pages belong to the file (and not to the process), the ring survives the process being killed or crashing, and
+     * the reader tool recovers the lines that were in it
+     *
+     * Every entry is written as [u32 length] [line] [u32 length], the trailing length is what lets the reader walk the
+     * ring backwards from the head. The head is the total number of bytes ever written, and it is only moved once the
+     * entry has been written, so everything behind it is complete. Note that, the file is recreated each time the log
+     * is configured, so it needs to be read before the application is started again
+    */
+    struct FlightRecorderHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t capacity;
+        std::atomic <uint64_t> head;
+        std::atomic <uint64_t> entriesCount;
+    };
+    static_assert (std::atomic <uint64_t>::is_always_lock_free, "Flight recorder head needs lock free atomics");
+
+    constexpr char     g_flightRecorderMagic[4] = {'F', 'L', 'T', 'R'};
+    constexpr uint32_t g_flightRecorderVersion  = 1;
+    /* The ring starts at this offset in the file
+    */
+    constexpr size_t   g_flightRecorderDataOffset = 64;
+
+    class FlightRecorder {
+        private:
+            std::string m_filePath;
+            int m_fileDescriptor;
+            uint8_t* m_mapping;
+            size_t m_mappingSize;
+            FlightRecorderHeader* m_header;
+            uint8_t* m_ring;
+            uint64_t m_capacity;
+
+            /* Copy in to the ring at the given (unwrapped) offset, splitting the copy if it runs past the end
+            */
+            void copyToRing (uint64_t offset, const void* data, size_t size) {
+                size_t start     = static_cast <size_t> (offset % m_capacity);
+                size_t firstSize = std::min (size, static_cast <size_t> (m_capacity - start));
+                std::memcpy (m_ring + start, data, firstSize);
+                if (firstSize < size)
+                    std::memcpy (m_ring, static_cast <const uint8_t*> (data) + firstSize, size - firstSize);
+            }
+
+        public:
+            FlightRecorder (void) {
+                m_fileDescriptor = -1;
+                m_mapping        = nullptr;
+                m_mappingSize    = 0;
+                m_header         = nullptr;
+                m_ring           = nullptr;
+                m_capacity       = 0;
+            }
+
+            ~FlightRecorder (void) {
+                close (false);
+            }
+
+            bool isOpen (void) {
+                return m_mapping != nullptr;
+            }
+
+            void open (const std::string& filePath, size_t capacity) {
+                m_filePath       = filePath;
+                m_capacity       = capacity;
+                m_mappingSize    = g_flightRecorderDataOffset + capacity;
+                m_fileDescriptor = ::open (filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+                if (m_fileDescriptor == -1)
+                    throw std::runtime_error ("Failed to open file for TO_FILE_FLIGHT_RECORDER sink");
+                /* The file is sized up front, so that writing to the mapping never runs past the end of the file
+                */
+                if (ftruncate (m_fileDescriptor, static_cast <off_t> (m_mappingSize)) != 0) {
+                    ::close (m_fileDescriptor);
+                    throw std::runtime_error ("Failed to size file for TO_FILE_FLIGHT_RECORDER sink");
+                }
+
+                void* mapping = mmap (nullptr, m_mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fileDescriptor, 0);
+                if (mapping == MAP_FAILED) {
+                    ::close (m_fileDescriptor);
+                    throw std::runtime_error ("Failed to map file for TO_FILE_FLIGHT_RECORDER sink");
+                }
+                m_mapping = static_cast <uint8_t*> (mapping);
+                m_ring    = m_mapping + g_flightRecorderDataOffset;
+                /* The new file is all zeros, the header is constructed in place
+                */
+                m_header  = new (m_mapping) FlightRecorderHeader;
+                std::memcpy (m_header->magic, g_flightRecorderMagic, sizeof (g_flightRecorderMagic));
+                m_header->version  = g_flightRecorderVersion;
+                m_header->capacity = m_capacity;
+                m_header->head.store         (0, std::memory_order_relaxed);
+                m_header->entriesCount.store (0, std::memory_order_release);
+            }
+
+            /* Lines that do not fit in the ring (with their lengths) are cut short. Note that, writes are not
+             * synchronized here, the record calls this under its sink lock
+            */
+            void write (const char* line, size_t size) {
+                size_t maxSize  = static_cast <size_t> (m_capacity) - 2 * sizeof (uint32_t);
+                uint32_t length = static_cast <uint32_t> (std::min (size, maxSize));
+
+                uint64_t head   = m_header->head.load (std::memory_order_relaxed);
+                copyToRing (head,                             &length, sizeof (length));
+                copyToRing (head + sizeof (length),           line,    length);
+                copyToRing (head + sizeof (length) + length,  &length, sizeof (length));
+
+                m_header->entriesCount.fetch_add (1, std::memory_order_relaxed);
+                m_header->head.store (head + 2 * sizeof (length) + length, std::memory_order_release);
+            }
+
+            void close (bool deleteIfEmpty) {
+                if (m_mapping == nullptr)
+                    return;
+
+                bool isEmpty = m_header->entriesCount.load (std::memory_order_relaxed) == 0;
+                munmap (m_mapping, m_mappingSize);
+                ::close (m_fileDescriptor);
+                m_mapping        = nullptr;
+                m_header         = nullptr;
+                m_ring           = nullptr;
+                m_fileDescriptor = -1;
+
+                if (deleteIfEmpty && isEmpty)
+                    std::remove (m_filePath.c_str());
+            }
+    };
+}   // namespace Log
+}   // namespace Collections
+#endif  // FLIGHT_RECORDER_H
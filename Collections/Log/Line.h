@@ -0,0 +1,138 @@
+#ifndef LINE_H
+#define LINE_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include "Record.h"
+
+namespace Collections {
+namespace Log {
+    /* Stream buffer that appends to a string, clearing the string keeps its capacity so that a line buffer that has been
+     * used once does not allocate again for lines of the same length
+    */
+    class LineStreamBuf: public std::streambuf {
+        private:
+            std::string m_line;
+
+        protected:
+            int_type overflow (int_type c) override {
+                if (!traits_type::eq_int_type (c, traits_type::eof()))
+                    m_line.push_back (traits_type::to_char_type (c));
+                return c;
+            }
+
+            std::streamsize xsputn (const char* s, std::streamsize n) override {
+                m_line.append (s, static_cast <size_t> (n));
+                return n;
+            }
+
+        public:
+            std::string& getLine (void) {
+                return m_line;
+            }
+    };
+
+    struct LineBuffer {
+        LineStreamBuf streamBuf;
+        std::ostream stream;
+        std::ios_base::fmtflags defaultFlags;
+
+        LineBuffer (void): stream (&streamBuf) {
+            defaultFlags = stream.flags();
+        }
+    };
+
+    /* Every log statement builds its line in a line buffer that belongs to the logging thread, and hands the complete
+     * line over to the record's sinks upon std::endl (or at the end of the statement). This way, statements on different
+     * threads never share any state until the line is written, and the line is written to each sink in one go. The
+     * buffers are kept in a per thread stack, since the arguments of a statement may themselves log
+    */
+    class Line {
+        private:
+            struct LineBufferStack {
+                std::vector <std::unique_ptr <LineBuffer>> buffers;
+                size_t depth = 0;
+            };
+
+            Record* m_record;
+            e_level m_level;
+            e_sink m_sink;
+            LineBuffer* m_buffer;
+            /* std::endl is a template function, and this is the signature of that function
+            */
+            using endl_type = std::ostream& (std::ostream&);
+
+            static LineBufferStack& getLineBufferStack (void) {
+                thread_local LineBufferStack stack;
+                return stack;
+            }
+
+            void commit (bool endLine) {
+                std::string& line = m_buffer->streamBuf.getLine();
+                if (line.empty() && !endLine)
+                    return;
+
+                m_record->commitLine (m_level, m_sink, line, endLine);
+                line.clear();
+            }
+
+        public:
+            /* The header is written straight in to the line buffer
+            */
+            Line (Record* record,
+                  e_level level,
+                  const char* callingFunction,
+                  uint32_t line,
+                  bool enHeader) {
+
+                m_record = record;
+                m_level  = level;
+                m_sink   = record->getSink (level);
+
+                auto& stack = getLineBufferStack();
+                if (stack.depth == stack.buffers.size())
+                    stack.buffers.push_back (std::make_unique <LineBuffer>());
+                m_buffer = stack.buffers[stack.depth++].get();
+                /* Formatting flags set by an earlier statement on this thread are not carried over
+                */
+                m_buffer->stream.flags     (m_buffer->defaultFlags);
+                m_buffer->stream.precision (6);
+                m_buffer->stream.fill      (' ');
+                /* Skip header for lightweight logging
+                */
+                if (enHeader)
+                    m_record->appendHeader (m_buffer->streamBuf.getLine(), level, callingFunction, line);
+            }
+
+            /* A statement that does not end with std::endl is written out as is, without a new line
+            */
+            ~Line (void) {
+                commit (false);
+                getLineBufferStack().depth--;
+            }
+
+            Line (const Line&)            = delete;
+            Line& operator = (const Line&) = delete;
+
+            inline Line& getReference (void) {
+                return *this;
+            }
+
+            /* Overload for std::endl
+            */
+            Line& operator << (endl_type) {
+                commit (true);
+                return *this;
+            }
+
+            template <typename T>
+            Line& operator << (const T& data) {
+                m_buffer->stream << data;
+                return *this;
+            }
+    };
+}   // namespace Log
+}   // namespace Collections
+#endif  // LINE_H
@@ -2,6 +2,67 @@
 #define LOG_H
 
 #include "RecordMgr.h"
+#include "Line.h"
+
+/* Log levels that are compiled in, the log statements of any other level compile to nothing (their arguments are not 
+ * evaluated either). Define this before including this header to override it, for example (Log::ERROR) for production
+ * builds
+*/
+#ifndef LOG_COMPILED_LEVELS
+#define LOG_COMPILED_LEVELS                     (Log::INFO | Log::WARNING | Log::ERROR)
+#endif  // LOG_COMPILED_LEVELS
+/* Per module level masks, which further restrict the compiled levels for the log statements in source files whose path
+ * contains the given fragment. When more than one fragment matches, the last one wins. Each entry is followed by a 
+ * comma, for example
+ *
+ * #define LOG_MODULE_LEVELS {"Core/Model/", Log::WARNING | Log::ERROR}, {"Core/Device/", Log::ERROR},
+*/
+#ifndef LOG_MODULE_LEVELS
+#define LOG_MODULE_LEVELS
+#endif  // LOG_MODULE_LEVELS
+
+namespace Collections {
+namespace Log {
+    struct ModuleLevelInfo {
+        const char* pathFragment;
+        e_level levels;
+    };
+    /* The table ends with an empty entry, so that it is never empty
+    */
+    constexpr ModuleLevelInfo g_moduleLevelInfos[] = {
+        LOG_MODULE_LEVELS
+        {nullptr, NONE}
+    };
+
+    constexpr bool containsPathFragment (const char* path, const char* fragment) {
+        for (const char* start = path; *start != '\0'; start++) {
+            const char* p = start;
+            const char* f = fragment;
+            while (*f != '\0' && *p == *f) {
+                p++;
+                f++;
+            }
+            if (*f == '\0')
+                return true;
+        }
+        return false;
+    }
+
+    /* Evaluated at compile time for every log statement, using the path of the source file that it is in
+    */
+    constexpr bool isLevelCompiled (e_level level, const char* callingFile) {
+        if ((LOG_COMPILED_LEVELS & level) == 0)
+            return false;
+
+        int levels = VERBOSE;
+        for (auto const& info: g_moduleLevelInfos) {
+            if (info.pathFragment != nullptr && containsPathFragment (callingFile, info.pathFragment))
+                levels = info.levels;
+        }
+        return (levels & level) != 0;
+    }
+}   // namespace Log
+}   // namespace Collections
 
 /* Macro overloading
 */
@@ -24,6 +85,12 @@
                                                 GET_LOG(id)->addConfig (level, sink, nameExt);
 #define LOG_ADD_CONFIG_B(id, level, sink)       GET_LOG(id)->addConfig (level, sink);
 
+/* Switch the header timestamps of a log between the wall clock and the (cheaper) monotonic clock
+*/
+#define LOG_SET_TIMESTAMP_MODE(id, mode)        GET_LOG(id)->setTimestampMode (mode);
+/* Add the id of the logging thread to the headers of a log, for logs that are written to from more than one thread
+*/
+#define LOG_SET_THREAD_ID(id, enabled)          GET_LOG(id)->setThreadIdEnabled (enabled);
 #define LOG_CLEAR_CONFIG(id)                    GET_LOG(id)->clearConfig();
 #define LOG_CLEAR_ALL_CONFIGS                   Log::g_recordMgr.clearAllConfigs();
 
@@ -47,6 +114,24 @@
 /* Lightweight logging method with header disabled
 */
 #define LOG_LITE(c_record)                      LOG(c_record, Log::INFO, false)      
+/* Binary logging method, written only to the TO_FILE_BINARY sink. Each argument replaces a {} in the format string when
+ * the file is decoded. Note that, unlike the other logging methods, the arguments are passed to the macro instead of 
+ * being streamed in, and the macro expands to a block
+*/
+#define LOG_BINARY(c_record, level, format, ...)                                                                        \
+                                                if constexpr (!Log::isLevelCompiled (level, LOG_GET_FILE)) { ; }        \
+                                                else if (!c_record->isBinarySinkPresent (level)) { ; }                  \
+                                                else {                                                                  \
+                                                    static const Log::BinaryFormat c_binaryFormat = {                   \
+                                                        Log::getNextBinaryFormatId(),                                   \
+                                                        static_cast <uint8_t> (level),                                  \
+                                                        LOG_GET_LINE,                                                   \
+                                                        LOG_GET_FUNCTION,                                               \
+                                                        format,                                                         \
+                                                        decltype (Log::getBinaryArgTypes (__VA_ARGS__))::value          \
+                                                    };                                                                  \
+                                                    c_record->writeBinary (c_binaryFormat __VA_OPT__(,) __VA_ARGS__);   \
+                                                }
 /* Under the hood
 */   
 #define GET_LOG(id)                             static_cast <Log::Record*>                                              \
@@ -54,11 +139,15 @@
 #define LOG_GET_FILE                            __FILE__
 #define LOG_GET_FUNCTION                        __FUNCTION__
 #define LOG_GET_LINE                            __LINE__
-#define LOG(c_record, level, header)            if (!c_record->isSinkPresent (level)) { ; }                             \
+/* The first check is resolved at compile time, and the second check is a single test against the record's level mask.
+ * The line object lives until the end of the statement, and builds the line in a buffer that belongs to this thread
+*/
+#define LOG(c_record, level, header)            if constexpr (!Log::isLevelCompiled (level, LOG_GET_FILE)) { ; }        \
+                                                else if (!c_record->isSinkPresent (level)) { ; }                        \
                                                 else                                                                    \
-                                                    c_record->getReference() <<                                         \
-                                                    c_record->getHeader (level,                                         \
-                                                                         LOG_GET_FUNCTION,                              \
-                                                                         LOG_GET_LINE,                                  \
-                                                                         header)
+                                                    Log::Line (c_record,                                                \
+                                                               level,                                                   \
+                                                               LOG_GET_FUNCTION,                                        \
+                                                               LOG_GET_LINE,                                            \
+                                                               header).getReference()
 #endif  // LOG_H
\ No newline at end of file
@@ -3,7 +3,15 @@
 
 #include <fstream>
 #include <sstream>
+#include <array>
+#include <mutex>
+#include <atomic>
 #include "../Buffer/Buffer.h"
+#include "AsyncSink.h"
+#include "SharedSink.h"
+#include "FlightRecorder.h"
+#include "BinaryFormat.h"
+#include "Timestamp.h"
 
 namespace Collections {
 namespace Log {
@@ -19,17 +27,34 @@ namespace Log {
         TO_NONE                 = 0,
         TO_FILE_IMMEDIATE       = 1,
         TO_CONSOLE              = 2,
-        TO_FILE_BUFFER_CIRCULAR = 4
+        TO_FILE_BUFFER_CIRCULAR = 4,
+        TO_FILE_ASYNC           = 8,
+        TO_FILE_BINARY          = 16,
+        TO_FILE_SHARED          = 32,
+        TO_FILE_FLIGHT_RECORDER = 64
     } e_sink;
 
-    inline e_level operator | (e_level a, e_level b) {
+    constexpr e_level operator | (e_level a, e_level b) {
         return static_cast <e_level> (static_cast <int> (a) | static_cast <int> (b));
     }
 
-    inline e_sink operator | (e_sink a, e_sink b) {
+    constexpr e_sink operator | (e_sink a, e_sink b) {
         return static_cast <e_sink> (static_cast <int> (a) | static_cast <int> (b));
     }
 
+    /* Small sequential ids (in the order that threads first log) are easier to follow in the logs than the native ids
+    */
+    inline uint32_t getThreadId (void) {
+        static std::atomic <uint32_t> nextThreadId = 0;
+        thread_local uint32_t threadId = nextThreadId.fetch_add (1, std::memory_order_relaxed);
+        return threadId;
+    }
+
+    /* A record may be logged to from more than one thread at once (see Line.h). Lines are handed over to the sinks in
+     * one go, the async sink takes them without a lock, while the immediate, buffered and binary sinks are guarded by a
+     * lock that belongs to the record. Note that, the config of a record (add/clear config) is not meant to be changed
+     * while other threads are logging to it
+    */
     class Record: public Admin::NonTemplateBase {
         private:
             uint32_t m_instanceId;
@@ -37,25 +62,59 @@ namespace Log {
             std::string m_saveDir;
             size_t m_bufferCapacity;
             const char* m_format;
+            /* The padded instance id, which starts every header
+            */
+            std::string m_headerPrefix;
+            e_timestampMode m_timestampMode;
+            bool m_threadIdEnabled;
 
-            std::unordered_map <e_level, e_sink> m_levelConfig;
+            /* Sink for each level (indexed by getLevelIndex), and the mask of levels that have a sink. The mask is what
+             * is tested on every log statement
+            */
+            std::array <e_sink, 3> m_levelSinks;
+            int m_levelMask;
             std::fstream m_saveFileImmediate;
             std::fstream m_saveFileBuffered; 
-            /* std::endl is a template function, and this is the signature of that function
-            */
-            using endl_type = std::ostream& (std::ostream&); 
-            /* Variable to hold entry in buffered sink
+            /* The buffer is looked up once when the sink is added, so that logging does not go through the buffer mgr
             */
-            std::string m_bufferedSinkHolder;
+            Buffer::BufferImpl <std::string>* m_logBuffer;
+            AsyncSink::File* m_saveFileAsync;
+            std::mutex m_sinkMutex;
             /* File paths
             */
             std::string m_saveFilePathImmediate;
             std::string m_saveFilePathBuffered;
-            /* Current sink for the filtered level
+            std::string m_saveFilePathAsync;
+            /* Lines written to the shared file start with this tag, {<instance id> <calling file>}
             */
-            e_sink m_activeSink;
+            std::string m_sharedTag;
+            uint32_t m_sharedSaveDirIndex;
+            /* Unlike the circular buffer sink, the lines in the flight recorder are in the file as soon as they are 
+             * written (see FlightRecorder.h)
+            */
+            FlightRecorder m_flightRecorder;
+            std::string m_saveFilePathBinary;
+            /* Binary entries are built in to a chunk that is written to the file once it is full (or upon an error), 
+             * the chunk is never written out if no records were added to it
+            */
+            std::fstream m_saveFileBinary;
+            std::string m_binaryChunk;
+            size_t m_binaryChunkSize;
+            size_t m_binaryRecordsCount;
+            /* Format descriptors that have already been written to the binary file, indexed by format id
+            */
+            std::vector <bool> m_binaryFormatsWritten;
             bool m_fileImmediateReady;
             bool m_fileBufferedReady;
+            bool m_fileAsyncReady;
+            bool m_fileSharedReady;
+            bool m_fileBinaryReady;
+
+            /* INFO, WARNING and ERROR are the bits 0, 1 and 2
+            */
+            static constexpr size_t getLevelIndex (e_level level) {
+                return static_cast <size_t> (level) >> 1;
+            }
 
             const char* getLevelString (e_level level) {
                 switch (level) {
@@ -70,32 +129,6 @@ namespace Log {
                 }
             }
 
-            std::string getLocalTimestamp (void) {
-                /* The string stream associates a string object with a string. Using this we can read from string as if it
-                 * were a stream like cin
-                */
-                std::stringstream stream;
-                
-                std::chrono::time_point <std::chrono::system_clock> now = std::chrono::system_clock::now();
-                std::time_t t_c = std::chrono::system_clock::to_time_t (now);
-                /* https://en.cppreference.com/w/cpp/io/manip/put_time
-                */
-                stream << std::put_time (std::localtime (&t_c), "%F %T");
-                return stream.str();
-            }
-
-            /* These 2 methods helps us to convert everything to string type
-            */
-            std::string to_string (const std::string& r) const { 
-                return r; 
-            }
-
-            template <typename T>
-            typename std::enable_if <!std::is_convertible <T, std::string>::value, 
-                                      std::string>::type to_string (T r) const { 
-                return std::to_string (r); 
-            }
-
             void deleteEmptyFile (std::fstream& file, const char* filePath) {
                 /* Check if file is empty
                 */
@@ -108,10 +141,13 @@ namespace Log {
             /* Write buffered data to file, only used when sink is a buffered sink
             */
             void flushBufferToFile (void) {
-                if (m_saveFileBuffered.is_open()) {
-                    auto logBuffer = GET_BUFFER (RESERVED_ID_LOG_SINK + m_instanceId, std::string);
-                    logBuffer->BUFFER_FLUSH (m_saveFileBuffered);
-                }
+                if (m_saveFileBuffered.is_open())
+                    m_logBuffer->BUFFER_FLUSH (m_saveFileBuffered);
+            }
+
+            void writeBinaryChunk (void) {
+                m_saveFileBinary.write (m_binaryChunk.data(), static_cast <std::streamsize> (m_binaryChunk.size()));
+                m_binaryChunk.clear();
             }
 
         public:
@@ -126,14 +162,25 @@ namespace Log {
                 m_saveDir        = saveDir;
                 m_bufferCapacity = bufferCapacity;
                 m_format         = format;
+                m_timestampMode  = WALL_CLOCK;
+                m_threadIdEnabled = false;
+                /* Pad m_instanceId string for single digit ids
+                */
+                m_headerPrefix   = "[" + std::string (m_instanceId < 10 ? "0": "") + std::to_string (m_instanceId) + "] ";
 
-                m_levelConfig.insert ({INFO,    TO_NONE}); 
-                m_levelConfig.insert ({WARNING, TO_NONE}); 
-                m_levelConfig.insert ({ERROR,   TO_NONE}); 
+                m_levelSinks.fill (TO_NONE);
+                m_levelMask          = NONE;
 
-                m_activeSink         = TO_NONE;
+                m_logBuffer          = nullptr;
+                m_saveFileAsync      = nullptr;
                 m_fileImmediateReady = false;
                 m_fileBufferedReady  = false;
+                m_fileAsyncReady     = false;
+                m_fileSharedReady    = false;
+                m_sharedSaveDirIndex = 0;
+                m_fileBinaryReady    = false;
+                m_binaryChunkSize    = 64 * 1024;
+                m_binaryRecordsCount = 0;
 
                 /* Strip file path and file extension to get just its name
                 */
@@ -147,7 +194,15 @@ namespace Log {
             }
 
             void addConfig (e_level level, e_sink sink, const char* nameExtension = "") {
-                m_levelConfig[level] = sink;
+                /* A config may be added for more than one level at once (for example, VERBOSE)
+                */
+                for (auto const& bit: {INFO, WARNING, ERROR}) {
+                    if ((level & bit) == 0)
+                        continue;
+
+                    m_levelSinks[getLevelIndex (bit)] = sink;
+                    m_levelMask = sink == TO_NONE ? m_levelMask & ~bit: m_levelMask | bit;
+                }
                 /* Open file, note that for this sink we are in append mode
                 */
                 if (!m_fileImmediateReady && (sink & TO_FILE_IMMEDIATE)) { 
@@ -170,10 +225,10 @@ namespace Log {
                     if (m_bufferCapacity == 0)
                         throw std::runtime_error ("Buffer capacity invalid for TO_FILE_BUFFER_CIRCULAR sink");    
 
-                    BUFFER_INIT (RESERVED_ID_LOG_SINK + m_instanceId, 
-                                 Buffer::WITH_OVERFLOW, 
-                                 std::string, 
-                                 m_bufferCapacity);   
+                    m_logBuffer = BUFFER_INIT (RESERVED_ID_LOG_SINK + m_instanceId, 
+                                               Buffer::WITH_OVERFLOW, 
+                                               std::string, 
+                                               m_bufferCapacity);   
 
                     m_saveFilePathBuffered  = m_saveDir + "b_" + 
                                               std::to_string (m_instanceId) + "_" +
@@ -188,6 +243,64 @@ namespace Log {
 
                     m_fileBufferedReady = true;
                 }
+                /* The file for this sink is written to by the async sink's writer thread, so that the logging thread 
+                 * never waits on the disk
+                */
+                if (!m_fileAsyncReady && (sink & TO_FILE_ASYNC)) {
+                    m_saveFilePathAsync = m_saveDir + "a_" + 
+                                          std::to_string (m_instanceId) + "_" +
+                                          m_callingFile +
+                                          nameExtension +
+                                          m_format;
+
+                    m_saveFileAsync     = g_asyncSink.openFile (m_saveFilePathAsync);
+                    m_fileAsyncReady    = true;
+                }
+                /* No file is opened for this sink, the record only joins the file that is shared by every record with the
+                 * same save dir
+                */
+                if (!m_fileSharedReady && (sink & TO_FILE_SHARED)) {
+                    m_sharedTag          = "{" + m_headerPrefix.substr (1, m_headerPrefix.size() - 3) + " " +
+                                           m_callingFile +
+                                           nameExtension + "} ";
+                    m_sharedSaveDirIndex = g_sharedSink.addSaveDir (m_saveDir);
+                    m_fileSharedReady    = true;
+                }
+                if (!m_flightRecorder.isOpen() && (sink & TO_FILE_FLIGHT_RECORDER)) {
+                    std::string saveFilePathFlightRecorder = m_saveDir + "f_" + 
+                                                             std::to_string (m_instanceId) + "_" +
+                                                             m_callingFile +
+                                                             nameExtension +
+                                                             ".ring";
+
+                    m_flightRecorder.open (saveFilePathFlightRecorder, LOG_FLIGHT_RECORDER_SIZE);
+                }
+                /* Note that, the binary file always uses the .blog extension, and that only the binary log statements 
+                 * are written to it
+                */
+                if (!m_fileBinaryReady && (sink & TO_FILE_BINARY)) {
+                    m_saveFilePathBinary = m_saveDir + "s_" + 
+                                           std::to_string (m_instanceId) + "_" +
+                                           m_callingFile +
+                                           nameExtension +
+                                           ".blog";
+
+                    m_saveFileBinary.open (m_saveFilePathBinary, 
+                                           std::ios_base::app | std::ios_base::out | std::ios_base::binary);
+
+                    if (!m_saveFileBinary.is_open())
+                        throw std::runtime_error ("Failed to open file for TO_FILE_BINARY sink");
+
+                    m_binaryChunk.reserve (m_binaryChunkSize);
+                    appendValue <uint8_t>  (m_binaryChunk, HEADER);
+                    m_binaryChunk.append   (g_binaryMagic, sizeof (g_binaryMagic));
+                    appendValue <uint16_t> (m_binaryChunk, g_binaryVersion);
+                    appendValue <uint32_t> (m_binaryChunk, m_instanceId);
+
+                    m_binaryFormatsWritten.clear();
+                    m_binaryRecordsCount = 0;
+                    m_fileBinaryReady    = true;
+                }
             }
 
             /* Clear config method should be used to overwrite an existing configuration. Since the overwrite may include
@@ -215,35 +328,79 @@ namespace Log {
                         deleteEmptyFile (m_saveFileImmediate, m_saveFilePathImmediate.c_str());
                     }
                 }
+                /* The async sink closes (and deletes, if empty) the file once the entries queued before this are written
+                */
+                if (m_fileAsyncReady) {
+                    g_asyncSink.closeFile (m_saveFileAsync, deleteEmptyFiles);
+                    m_saveFileAsync = nullptr;
+                }
 
-                m_levelConfig[INFO]    = TO_NONE;
-                m_levelConfig[WARNING] = TO_NONE;
-                m_levelConfig[ERROR]   = TO_NONE;
+                m_flightRecorder.close (deleteEmptyFiles);
+                if (m_fileBinaryReady) {
+                    if (m_binaryRecordsCount != 0)
+                        writeBinaryChunk();
+                    m_binaryChunk.clear();
+                    m_saveFileBinary.close();
+                    if (deleteEmptyFiles) {
+                        m_saveFileBinary.open (m_saveFilePathBinary, std::ios_base::in);
+                        deleteEmptyFile (m_saveFileBinary, m_saveFilePathBinary.c_str());
+                        m_saveFileBinary.close();
+                    }
+                }
+
+                m_levelSinks.fill (TO_NONE);
+                m_levelMask            = NONE;
 
                 m_fileImmediateReady   = false;
                 m_fileBufferedReady    = false;
+                m_fileAsyncReady       = false;
+                m_fileSharedReady      = false;
+                m_fileBinaryReady      = false;
             }
 
-            inline Record& getReference (void) {
-                return *this;
+            inline e_sink getSink (e_level level) {
+                return m_levelSinks[getLevelIndex (level)];
             }
 
             e_sink getSink (void) {
                 e_sink allSinks = TO_NONE;
-                for (auto const& [level, sink]: m_levelConfig)
+                for (auto const& sink: m_levelSinks)
                     allSinks = allSinks | sink;
 
                 return allSinks;
             }
 
             e_level getLevel (void) {
-                e_level allLevels = NONE;
-                for (auto const& [level, sink]: m_levelConfig) {
-                    if (sink != TO_NONE)
-                        allLevels = allLevels | level;
-                }
+                return static_cast <e_level> (m_levelMask);
+            }
 
-                return allLevels;
+            void setTimestampMode (e_timestampMode mode) {
+                m_timestampMode = mode;
+            }
+
+            void setThreadIdEnabled (bool enabled) {
+                m_threadIdEnabled = enabled;
+            }
+
+            void appendHeader (std::string& header,
+                               e_level level,
+                               const char* callingFunction,
+                               uint32_t line) {
+
+                header += m_headerPrefix;
+                if (m_threadIdEnabled) {
+                    header += "[T";
+                    header += std::to_string (getThreadId());
+                    header += "] ";
+                }
+                g_timestampService.append (header, m_timestampMode);
+                header += " [";
+                header += getLevelString (level);
+                header += "] ";
+                header += callingFunction;
+                header += " ";
+                header += std::to_string (line);
+                header += " ";
             }
 
             std::string getHeader (e_level level,
@@ -255,72 +412,110 @@ namespace Log {
                 if (enHeader == false)
                     return "";
 
-                std::string instanceId = std::to_string (m_instanceId);
-                /* Pad m_instanceId string for single digit ids
-                */
-                if (m_instanceId < 10)
-                    instanceId.insert (0, 1, '0');
-
-                std::string header = "[" + instanceId + "]" + 
-                                     " " +
-                                     getLocalTimestamp() + 
-                                     " " +
-                                     "[" + getLevelString (level) + "]" 
-                                     + " " +
-                                     callingFunction + 
-                                     " " +
-                                     std::to_string (line) +  
-                                     " ";
-
+                std::string header;
+                header.reserve (96);
+                appendHeader (header, level, callingFunction, line);
                 return header;
             }
 
-            bool isSinkPresent (e_level level) {
-                /* Set active sink, this will decide where the logging will output to for this level
-                */
-                m_activeSink = m_levelConfig[level];
-                return m_activeSink == TO_NONE ? false: true;
+            inline bool isSinkPresent (e_level level) {
+                return (m_levelMask & level) != 0;
             }
 
-            /* Overload for std::endl
+            /* Binary log statements are written only to the binary sink
             */
-            Record& operator << (endl_type endl){
-                if (m_activeSink & TO_FILE_IMMEDIATE && m_saveFileImmediate.is_open())
-                    m_saveFileImmediate << endl;
-
-                if (m_activeSink & TO_CONSOLE)
-                    std::cout << endl;
-                
-                /* For buffered sink, instead of inserting a new line we push the log entry into the buffer
-                */
-                if (m_activeSink & TO_FILE_BUFFER_CIRCULAR) {
-                    auto logBuffer = GET_BUFFER (RESERVED_ID_LOG_SINK + m_instanceId, std::string);
-                    logBuffer->BUFFER_PUSH (m_bufferedSinkHolder);
-                    /* Clear after flush
-                    */
-                    m_bufferedSinkHolder = "";
+            inline bool isBinarySinkPresent (e_level level) {
+                return (m_levelMask & level) != 0 && (m_levelSinks[getLevelIndex (level)] & TO_FILE_BINARY);
+            }
+
+            /* The format descriptor is written to the file before its first record. Only errors are flushed right away
+            */
+            template <typename... T>
+            void writeBinary (const BinaryFormat& format, const T&... args) {
+                std::lock_guard <std::mutex> lock (m_sinkMutex);
+                if (format.id >= m_binaryFormatsWritten.size())
+                    m_binaryFormatsWritten.resize (format.id + 1, false);
+
+                if (!m_binaryFormatsWritten[format.id]) {
+                    appendValue <uint8_t>  (m_binaryChunk, FORMAT);
+                    appendValue <uint32_t> (m_binaryChunk, format.id);
+                    appendValue <uint8_t>  (m_binaryChunk, format.level);
+                    appendValue <uint32_t> (m_binaryChunk, format.line);
+                    appendString           (m_binaryChunk, format.function);
+                    appendString           (m_binaryChunk, format.format);
+                    appendString           (m_binaryChunk, format.argTypes);
+                    m_binaryFormatsWritten[format.id] = true;
                 }
 
-                return *this;
+                auto timestamp = std::chrono::duration_cast <std::chrono::nanoseconds> 
+                                 (std::chrono::system_clock::now().time_since_epoch()).count();
+                appendValue <uint8_t>  (m_binaryChunk, RECORD);
+                appendValue <uint32_t> (m_binaryChunk, format.id);
+                appendValue <uint64_t> (m_binaryChunk, static_cast <uint64_t> (timestamp));
+                (appendArg (m_binaryChunk, args), ...);
+                m_binaryRecordsCount++;
+
+                if (format.level == ERROR) {
+                    writeBinaryChunk();
+                    m_saveFileBinary.flush();
+                }
+                else if (m_binaryChunk.size() >= m_binaryChunkSize)
+                    writeBinaryChunk();
             }
 
-            /* Templated overload operator, 
-             * reference: https://stackoverflow.com/questions/17595957/operator-overloading-in-c-for-logging-purposes
+            /* Write a complete line (built by the logging thread) to every sink of the level. The line does not have a
+             * new line at the end, it is added here if the statement ended the line
             */
-            template <typename T>
-            Record& operator << (const T& data) {
-                if (m_activeSink & TO_FILE_IMMEDIATE && m_saveFileImmediate.is_open())
-                    m_saveFileImmediate << data;
+            void commitLine (e_level level, e_sink sink, std::string& line, bool endLine) {
+                /* Hand the line over to the async sink, only errors are flushed right away
+                */
+                if (sink & TO_FILE_ASYNC && m_saveFileAsync != nullptr) {
+                    std::string asyncLine;
+                    asyncLine.reserve (line.size() + 1);
+                    asyncLine += line;
+                    if (endLine)
+                        asyncLine += '\n';
+                    g_asyncSink.writeLine (m_saveFileAsync, std::move (asyncLine), level == ERROR);
+                }
 
-                if (m_activeSink & TO_CONSOLE)
-                    std::cout << data;
+                if (sink & TO_FILE_SHARED && m_fileSharedReady) {
+                    std::string sharedLine;
+                    sharedLine.reserve (m_sharedTag.size() + line.size() + 1);
+                    sharedLine += m_sharedTag;
+                    sharedLine += line;
+                    if (endLine)
+                        sharedLine += '\n';
+                    g_asyncSink.writeLine (g_sharedSink.getFile (m_sharedSaveDirIndex, getThreadId()),
+                                           std::move (sharedLine), 
+                                           level == ERROR);
+                }
 
-                /* Hold till we flush it upon std::endl
+                if (endLine)
+                    line += '\n';
+                /* A single write call keeps lines from different threads from being mixed up on the console
                 */
-                if (m_activeSink & TO_FILE_BUFFER_CIRCULAR)
-                    m_bufferedSinkHolder += to_string (data);
-            
-                return *this;
+                if (sink & TO_CONSOLE) {
+                    std::cout.write (line.data(), static_cast <std::streamsize> (line.size()));
+                    if (endLine)
+                        std::cout.flush();
+                }
+
+                if (sink & (TO_FILE_IMMEDIATE | TO_FILE_BUFFER_CIRCULAR | TO_FILE_FLIGHT_RECORDER)) {
+                    std::lock_guard <std::mutex> lock (m_sinkMutex);
+                    if (sink & TO_FILE_IMMEDIATE && m_saveFileImmediate.is_open()) {
+                        m_saveFileImmediate.write (line.data(), static_cast <std::streamsize> (line.size()));
+                        if (endLine)
+                            m_saveFileImmediate.flush();
+                    }
+                    /* For buffered sink, the new line is not pushed in to the buffer since it is added upon flush
+                    */
+                    if (sink & TO_FILE_BUFFER_CIRCULAR && m_logBuffer != nullptr)
+                        m_logBuffer->BUFFER_PUSH (endLine ? line.substr (0, line.size() - 1): line);
+                    /* Same goes for the flight recorder, the reader adds the new lines
+                    */
+                    if (sink & TO_FILE_FLIGHT_RECORDER && m_flightRecorder.isOpen())
+                        m_flightRecorder.write (line.data(), endLine ? line.size() - 1: line.size());
+                }
             }
     };
 }   // namespace Log
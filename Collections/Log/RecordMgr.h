@@ -1,18 +1,31 @@
 #ifndef RECORD_MGR_H
 #define RECORD_MGR_H
 
+#include <shared_mutex>
 #include "Record.h"
 
 namespace Collections {
 namespace Log {
+    /* Records may be looked up (GET_LOG) from any thread, so the pool is guarded by a reader writer lock. Note that, the
+     * statements that log through a record pointer that they already hold do not touch the pool at all
+    */
     class RecordMgr: public Admin::InstanceMgr {
+        private:
+            std::shared_mutex m_instancePoolMutex;
+
         public:
+            Admin::NonTemplateBase* getInstance (uint32_t instanceId) {
+                std::shared_lock <std::shared_mutex> lock (m_instancePoolMutex);
+                return Admin::InstanceMgr::getInstance (instanceId);
+            }
+
             Record* createRecord (uint32_t instanceId, 
                                   std::string callingFile,
                                   std::string saveDir       = "",
                                   size_t bufferCapacity     = 0,
                                   const char* format        = ".txt") {
             
+                std::unique_lock <std::shared_mutex> lock (m_instancePoolMutex);
                 /* Add record object to pool
                 */
                 if (m_instancePool.find (instanceId) == m_instancePool.end()) {
@@ -32,6 +45,7 @@ namespace Log {
             }
 
             void closeRecord (uint32_t instanceId) {
+                std::unique_lock <std::shared_mutex> lock (m_instancePoolMutex);
                 if (m_instancePool.find (instanceId) != m_instancePool.end()) { 
                     Record* c_record = static_cast <Record*> (m_instancePool[instanceId]);
                     delete c_record;
@@ -49,6 +63,7 @@ namespace Log {
             }
 
             void closeAllRecords (void) {
+                std::unique_lock <std::shared_mutex> lock (m_instancePoolMutex);
                 for (auto const& [key, val]: m_instancePool) {
                     Record* c_record = static_cast <Record*> (val);
                     delete c_record;
@@ -61,6 +76,7 @@ namespace Log {
              * in the pool since they are not freed yet, meaning you could re add a config and start logging again
             */
             void clearAllConfigs (void) {
+                std::unique_lock <std::shared_mutex> lock (m_instancePoolMutex);
                 for (auto const& [key, val]: m_instancePool) {
                     Record* c_record = static_cast <Record*> (val);                        
                     c_record->clearConfig();
@@ -0,0 +1,76 @@
+#ifndef SHARED_SINK_H
+#define SHARED_SINK_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
+#include "AsyncSink.h"
+
+/* Write a shared file per logging thread instead of one per save dir. Define this before including the log header to
+ * override it
+*/
+#ifndef LOG_SHARED_FILE_PER_THREAD
+#define LOG_SHARED_FILE_PER_THREAD              (false)
+#endif  // LOG_SHARED_FILE_PER_THREAD
+
+namespace Collections {
+namespace Log {
+    /* The shared sink multiplexes the lines of every record that uses it in to a single file per save dir (or, one per
+     * save dir per thread), instead of a file per record. Each line is tagged with the instance id and the source of its
+     * record, so that the split tool can pull the per record views back out. The files are written through the async
+     * sink, and stay open until it is shut down
+    */
+    class SharedSink {
+        private:
+            std::vector <std::string> m_saveDirs;
+            std::unordered_map <std::string, AsyncSink::File*> m_files;
+            std::mutex m_mutex;
+            bool m_perThread;
+
+            AsyncSink::File* openFile (uint32_t saveDirIndex, uint32_t threadId) {
+                std::lock_guard <std::mutex> lock (m_mutex);
+                std::string filePath = m_saveDirs[saveDirIndex] + "m_shared";
+                if (m_perThread)
+                    filePath += "_T" + std::to_string (threadId);
+                filePath += ".txt";
+
+                if (m_files.find (filePath) == m_files.end())
+                    m_files[filePath] = g_asyncSink.openFile (filePath);
+                return m_files[filePath];
+            }
+
+        public:
+            SharedSink (bool perThread) {
+                m_perThread = perThread;
+            }
+
+            /* Returns the index of the save dir, which the record keeps so that it does not look up the dir by its path
+             * for every line
+            */
+            uint32_t addSaveDir (const std::string& saveDir) {
+                std::lock_guard <std::mutex> lock (m_mutex);
+                for (uint32_t i = 0; i < m_saveDirs.size(); i++) {
+                    if (m_saveDirs[i] == saveDir)
+                        return i;
+                }
+                m_saveDirs.push_back (saveDir);
+                return static_cast <uint32_t> (m_saveDirs.size() - 1);
+            }
+
+            /* The files are cached per thread, so the lock is only taken the first time a thread logs to a save dir
+            */
+            AsyncSink::File* getFile (uint32_t saveDirIndex, uint32_t threadId) {
+                thread_local std::vector <AsyncSink::File*> files;
+                if (saveDirIndex >= files.size())
+                    files.resize (saveDirIndex + 1, nullptr);
+
+                if (files[saveDirIndex] == nullptr)
+                    files[saveDirIndex] = openFile (saveDirIndex, threadId);
+                return files[saveDirIndex];
+            }
+    };
+    SharedSink g_sharedSink (LOG_SHARED_FILE_PER_THREAD);
+}   // namespace Log
+}   // namespace Collections
+#endif  // SHARED_SINK_H
@@ -0,0 +1,94 @@
+#ifndef TIMESTAMP_H
+#define TIMESTAMP_H
+
+#include <ctime>
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+namespace Collections {
+namespace Log {
+    typedef enum {
+        /* Local date and time with microseconds, 2024-01-01 00:00:00.000000
+        */
+        WALL_CLOCK = 0,
+        /* Seconds and microseconds on the steady clock since the timestamp service was first used, +000012.345678. This
+         * is cheaper than the wall clock and never jumps, which makes it a better fit for high frequency records
+        */
+        MONOTONIC  = 1
+    } e_timestampMode;
+
+    /* Formatting the date and time of every header through a string stream and std::localtime is slow, and localtime is
+     * not thread safe either (it returns a pointer to a shared buffer). Instead, the formatted date and time is cached
+     * for the current second, and only the sub second digits are formatted for every header using integer math. The
+     * cache is per thread, so no lock is needed and localtime_r is called at most once per second per thread
+    */
+    class TimestampService {
+        private:
+            struct WallClockCache {
+                int64_t second;
+                /* "YYYY-MM-DD HH:MM:SS"
+                */
+                char prefix[20];
+                size_t prefixSize;
+            };
+            std::chrono::steady_clock::time_point m_monotonicStart;
+
+            /* Write the value in to the given number of digits (with leading zeros), from right to left
+            */
+            static void appendDigits (std::string& out, uint64_t value, size_t digitsCount) {
+                char digits[20];
+                for (size_t i = digitsCount; i > 0; i--) {
+                    digits[i - 1] = static_cast <char> ('0' + value % 10);
+                    value        /= 10;
+                }
+                out.append (digits, digitsCount);
+            }
+
+        public:
+            TimestampService (void) {
+                m_monotonicStart = std::chrono::steady_clock::now();
+            }
+
+            /* The nanoseconds are since the unix epoch, this is also used by the binary log decoder so that both the
+             * text and the binary logs have the same timestamps
+            */
+            static void appendWallClock (std::string& out, int64_t nanoseconds) {
+                thread_local WallClockCache cache = {-1, {}, 0};
+
+                int64_t second = nanoseconds / 1000000000;
+                if (second != cache.second) {
+                    std::time_t t_c = static_cast <std::time_t> (second);
+                    std::tm localTime;
+                    localtime_r (&t_c, &localTime);
+                    cache.prefixSize = std::strftime (cache.prefix, sizeof (cache.prefix), "%F %T", &localTime);
+                    cache.second     = second;
+                }
+                out.append (cache.prefix, cache.prefixSize);
+                out.push_back ('.');
+                appendDigits (out, static_cast <uint64_t> (nanoseconds % 1000000000) / 1000, 6);
+            }
+
+            void appendMonotonic (std::string& out) {
+                auto microseconds = std::chrono::duration_cast <std::chrono::microseconds>
+                                    (std::chrono::steady_clock::now() - m_monotonicStart).count();
+                out.push_back ('+');
+                appendDigits (out, static_cast <uint64_t> (microseconds) / 1000000, 6);
+                out.push_back ('.');
+                appendDigits (out, static_cast <uint64_t> (microseconds) % 1000000, 6);
+            }
+
+            void append (std::string& out, e_timestampMode mode) {
+                if (mode == MONOTONIC) {
+                    appendMonotonic (out);
+                    return;
+                }
+                auto nanoseconds = std::chrono::duration_cast <std::chrono::nanoseconds>
+                                   (std::chrono::system_clock::now().time_since_epoch()).count();
+                appendWallClock (out, static_cast <int64_t> (nanoseconds));
+            }
+    };
+    TimestampService g_timestampService;
+}   // namespace Log
+}   // namespace Collections
+#endif  // TIMESTAMP_H
@@ -0,0 +1,185 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstdint>
+#include <stdexcept>
+
+namespace Collections {
+    /* A slot map stores its values in fixed size pages of slots that are never moved once allocated, so a pointer to a
+     * value stays valid until the value is erased. A dense array of live slot indices is kept on the side for iteration
+     *
+     * Values are addressed by a caller provided key (the info ids used across Core), keys are expected to be small
+     * integers since they index directly in to a sparse array of slot indices. Note that, keys are plain integers and
+     * carry no generation, so once a key is erased and inserted again, the key refers to the new value
+    */
+    template <typename T>
+    class SlotMap {
+        private:
+            struct Slot {
+                T value;
+                uint32_t key;
+                uint32_t denseIndex;
+            };
+
+            static constexpr uint32_t m_pageSize     = 64;
+            static constexpr uint32_t m_invalidIndex = UINT32_MAX;
+            std::vector <std::unique_ptr <Slot[]>> m_pages;
+            std::vector <uint32_t> m_freeSlotIndices;
+            std::vector <uint32_t> m_denseSlotIndices;
+            std::vector <uint32_t> m_keyToIndex;
+            /* Keys at or above this are rejected, since the sparse array is sized by the largest key in use
+            */
+            uint32_t m_maxKeysCount;
+            /* One past the largest key in use, this only moves down on erasing the largest key, past the keys that are
+             * not in use, so keeping it up to date is amortized constant time
+            */
+            uint32_t m_nextKey = 0;
+
+            inline Slot* getSlot (uint32_t index) {
+                return &m_pages[index / m_pageSize][index % m_pageSize];
+            }
+
+            inline const Slot* getSlot (uint32_t index) const {
+                return &m_pages[index / m_pageSize][index % m_pageSize];
+            }
+
+            inline uint32_t getIndex (uint32_t key) const {
+                return key < m_keyToIndex.size() ? m_keyToIndex[key]: m_invalidIndex;
+            }
+
+            /* The iterator is shared between the mutable and const forms, which differ only in the constness of the
+             * slot map and the value they hand out
+            */
+            template <typename SlotMapType, typename ValueType>
+            class IteratorBase {
+                private:
+                    SlotMapType* m_slotMap;
+                    size_t m_denseIndex;
+
+                public:
+                    IteratorBase (SlotMapType* slotMap, size_t denseIndex) {
+                        m_slotMap    = slotMap;
+                        m_denseIndex = denseIndex;
+                    }
+
+                    std::pair <const uint32_t, ValueType&> operator * (void) const {
+                        auto slot = m_slotMap->getSlot (m_slotMap->m_denseSlotIndices[m_denseIndex]);
+                        return {slot->key, slot->value};
+                    }
+
+                    IteratorBase& operator ++ (void) {
+                        m_denseIndex++;
+                        return *this;
+                    }
+
+                    bool operator != (const IteratorBase& other) const {
+                        return m_denseIndex != other.m_denseIndex;
+                    }
+            };
+
+        public:
+            using Iterator      = IteratorBase <SlotMap,       T>;
+            using ConstIterator = IteratorBase <const SlotMap, const T>;
+
+            SlotMap (uint32_t maxKeysCount = 65536) {
+                m_maxKeysCount = maxKeysCount;
+            }
+
+            Iterator begin (void) {
+                return Iterator (this, 0);
+            }
+
+            Iterator end (void) {
+                return Iterator (this, m_denseSlotIndices.size());
+            }
+
+            ConstIterator begin (void) const {
+                return ConstIterator (this, 0);
+            }
+
+            ConstIterator end (void) const {
+                return ConstIterator (this, m_denseSlotIndices.size());
+            }
+
+            size_t size (void) const {
+                return m_denseSlotIndices.size();
+            }
+
+            bool contains (uint32_t key) const {
+                return getIndex (key) != m_invalidIndex;
+            }
+
+            /* Returns nullptr if the key is not in use
+            */
+            T* find (uint32_t key) {
+                uint32_t index = getIndex (key);
+                return index != m_invalidIndex ? &getSlot (index)->value: nullptr;
+            }
+
+            /* Returns one past the largest key in use
+            */
+            uint32_t getNextKey (void) const {
+                return m_nextKey;
+            }
+
+            /* Throws if the key is outside the key range of the slot map, or is already in use
+            */
+            T* insert (uint32_t key, const T& value) {
+                if (key >= m_maxKeysCount)
+                    throw std::runtime_error ("Slot map key out of range");
+                if (contains (key))
+                    throw std::runtime_error ("Slot map key already in use");
+
+                if (m_freeSlotIndices.empty()) {
+                    uint32_t firstIndex = static_cast <uint32_t> (m_pages.size()) * m_pageSize;
+                    m_pages.push_back (std::make_unique <Slot[]> (m_pageSize));
+                    /* Push in reverse so that the lowest index is reused first
+                    */
+                    for (uint32_t i = m_pageSize; i > 0; i--)
+                        m_freeSlotIndices.push_back (firstIndex + i - 1);
+                }
+
+                uint32_t index = m_freeSlotIndices.back();
+                m_freeSlotIndices.pop_back();
+
+                Slot* slot       = getSlot (index);
+                slot->value      = value;
+                slot->key        = key;
+                slot->denseIndex = static_cast <uint32_t> (m_denseSlotIndices.size());
+                m_denseSlotIndices.push_back (index);
+
+                if (key >= m_keyToIndex.size())
+                    m_keyToIndex.resize (key + 1, m_invalidIndex);
+                m_keyToIndex[key] = index;
+                if (key >= m_nextKey)
+                    m_nextKey = key + 1;
+                return &slot->value;
+            }
+
+            /* The last slot index in the dense array is moved in to the erased slot index's place, so that the dense
+             * array stays packed (the values themselves never move). Returns false if the key is not in use
+            */
+            bool erase (uint32_t key) {
+                uint32_t index = getIndex (key);
+                if (index == m_invalidIndex)
+                    return false;
+
+                Slot* slot                           = getSlot (index);
+                uint32_t lastIndex                   = m_denseSlotIndices.back();
+                m_denseSlotIndices[slot->denseIndex] = lastIndex;
+                getSlot (lastIndex)->denseIndex      = slot->denseIndex;
+                m_denseSlotIndices.pop_back();
+
+                slot->value = T{};
+                m_freeSlotIndices.push_back (index);
+                m_keyToIndex[key] = m_invalidIndex;
+                while (m_nextKey > 0 && m_keyToIndex[m_nextKey - 1] == m_invalidIndex)
+                    m_nextKey--;
+                return true;
+            }
+    };
+}   // namespace Collections
+#endif  // SLOT_MAP_H
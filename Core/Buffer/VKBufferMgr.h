@@ -1,10 +1,10 @@
 #ifndef VK_BUFFER_MGR_H
 #define VK_BUFFER_MGR_H
 
-#include "../Device/VKPhyDevice.h"
+#include "../Device/VKMemoryAllocator.h"
 
 namespace Core {
-    class VKBufferMgr: protected virtual VKPhyDevice {
+    class VKBufferMgr: protected virtual VKMemoryAllocator {
         private:
             struct BufferInfo {
                 struct Meta {
@@ -25,28 +25,22 @@ namespace Core {
                 } params;
 
                 struct Allocation {
+                    uint32_t memoryAllocationInfoId;
+                    VkDeviceSize offset;
                     VkDeviceSize size;
                     uint32_t memoryTypeBits;
                     uint32_t memoryTypeIndex;
                 } allocation;
-
-                bool operator == (const BufferInfo& other) const {
-                    return meta.id == other.meta.id;
-                }                   
             };
-            std::unordered_map <e_bufferType, std::vector <BufferInfo>> m_bufferInfoPool;
+            std::unordered_map <e_bufferType, SlotMap <BufferInfo>> m_bufferInfoPool;
 
             Log::Record* m_VKBufferMgrLog;
             const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
 
             void deleteBufferInfo (BufferInfo* bufferInfo, e_bufferType type) {
-                if (m_bufferInfoPool.find (type) != m_bufferInfoPool.end()) {
-                    auto& infos = m_bufferInfoPool[type];
-
-                    infos.erase (std::remove (infos.begin(), infos.end(), *bufferInfo), infos.end());
-                    m_bufferInfoPool[type] = infos;
+                auto pool = m_bufferInfoPool.find (type);
+                if (pool != m_bufferInfoPool.end() && pool->second.erase (bufferInfo->meta.id))
                     return;
-                }
 
                 LOG_ERROR (m_VKBufferMgrLog) << "Failed to delete buffer info "
                                              << "[" << bufferInfo->meta.id << "]"
@@ -59,8 +53,8 @@ namespace Core {
         public:
             VKBufferMgr (void) {
                 m_VKBufferMgrLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_IMMEDIATE);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE); 
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE); 
             }
 
             ~VKBufferMgr (void) {
@@ -77,15 +71,13 @@ namespace Core {
                                const std::vector <uint32_t>& queueFamilyIndices) {
 
                 auto deviceInfo = getDeviceInfo (deviceInfoId);
-                for (auto const& info: m_bufferInfoPool[type]) {
-                    if (info.meta.id == bufferInfoId) {
-                        LOG_ERROR (m_VKBufferMgrLog) << "Buffer info id already exists " 
-                                                     << "[" << bufferInfoId << "]"
-                                                     << " "
-                                                     << "[" << Utils::getBufferTypeString (type) << "]"
-                                                     << std::endl;
-                        throw std::runtime_error ("Buffer info id already exists");
-                    }
+                if (m_bufferInfoPool[type].contains (bufferInfoId)) {
+                    LOG_ERROR (m_VKBufferMgrLog) << "Buffer info id already exists " 
+                                                 << "[" << bufferInfoId << "]"
+                                                 << " "
+                                                 << "[" << Utils::getBufferTypeString (type) << "]"
+                                                 << std::endl;
+                    throw std::runtime_error ("Buffer info id already exists");
                 }
 
                 VkBufferCreateInfo createInfo;
@@ -138,88 +130,68 @@ namespace Core {
                  * (3) memoryTypeBits: A bitmask which contains one bit set for every supported memory type for the 
                  * resource. Bit i is set if and only if the memory type i in the VkPhysicalDeviceMemoryProperties 
                  * structure for the physical device is supported for the resource
+                 *
+                 * Along with the requirements, we also find out whether the implementation prefers the buffer to have a
+                 * memory object of its own (dedicated allocation)
                 */
-                VkMemoryRequirements memRequirements;
-                vkGetBufferMemoryRequirements (deviceInfo->resource.logDevice, buffer, &memRequirements);
-                /* Next, we can allocate the memory by filling in the VkMemoryAllocateInfo structure
-                */
-                VkMemoryAllocateInfo allocInfo;
-                allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-                allocInfo.pNext = VK_NULL_HANDLE;
-                /* Memory allocation is now as simple as specifying the size and type, both of which are derived from 
-                 * the memory requirements of the buffer and the desired property
-                */
-                allocInfo.allocationSize = memRequirements.size;                                                                                           
-                /* Find suitable memory type
-                */
-                allocInfo.memoryTypeIndex = getMemoryTypeIndex (deviceInfoId, memRequirements.memoryTypeBits, property);
-
-                /* It should be noted that in a real world application, you're not supposed to actually call 
-                 * vkAllocateMemory for every individual buffer. The maximum number of simultaneous memory allocations 
-                 * is limited by the maxMemoryAllocationCount physical device limit, which may be as low as 4096 even 
-                 * on high end hardware like an NVIDIA GTX 1080. The right way to allocate memory for a large number of 
-                 * objects at the same time is to create a custom allocator that splits up a single allocation among 
-                 * many different objects by using the offset parameters that we've seen in many functions, or, use
-                 * VulkanMemoryAllocator library
+                bool prefersDedicated;
+                auto memRequirements = getMemoryRequirements (deviceInfoId, buffer, VK_NULL_HANDLE, prefersDedicated);
+                /* Instead of allocating memory for every individual buffer, we request a sub allocation from the memory 
+                 * allocator that satisfies the memory requirements of the buffer and the desired property. Host visible 
+                 * sub allocations are persistently mapped, so the buffer comes with a mapped pointer for free
                  * 
                  * It is also recommended to store multiple buffers, like the vertex and index buffer, into a single 
                  * VkBuffer and use offsets in commands like vkCmdBindVertexBuffers. The advantage is that your data is 
                  * more cache friendly in that case, because it's closer together
                 */
-                deviceInfo->meta.memoryAllocationCount++;
-
-                VkDeviceMemory bufferMemory;
-                result = vkAllocateMemory (deviceInfo->resource.logDevice, &allocInfo, VK_NULL_HANDLE, &bufferMemory);
-                if (result != VK_SUCCESS) {
-                    LOG_ERROR (m_VKBufferMgrLog) << "Failed to allocate buffer memory " 
-                                                 << "[" << bufferInfoId << "]"
-                                                 << " "
-                                                 << "[" << Utils::getBufferTypeString (type) << "]"
-                                                 << " "
-                                                 << "[" << string_VkResult (result) << "]"
-                                                 << std::endl; 
-                    throw std::runtime_error ("Failed to allocate buffer memory");
-                }
-
+                uint32_t memoryAllocationInfoId = createMemoryAllocation (deviceInfoId, 
+                                                                          memRequirements, 
+                                                                          property, 
+                                                                          true,
+                                                                          prefersDedicated,
+                                                                          buffer,
+                                                                          VK_NULL_HANDLE);
+                auto memoryAllocationInfo       = getMemoryAllocationInfo (memoryAllocationInfoId);
                 /* If memory allocation was successful, then we can now associate this memory with the buffer. The fourth 
                  * parameter is the offset within the region of memory that is to be bound to the buffer. If the offset 
                  * is non-zero, then it is required to be divisible by memRequirements.alignment
                 */
-                vkBindBufferMemory (deviceInfo->resource.logDevice, buffer, bufferMemory, 0);
+                vkBindBufferMemory (deviceInfo->resource.logDevice, 
+                                    buffer, 
+                                    memoryAllocationInfo->resource.memory, 
+                                    memoryAllocationInfo->params.offset);
 
                 BufferInfo info;
-                info.meta.id                    = bufferInfoId;
-                info.meta.size                  = size;
-                info.meta.bufferMapped          = VK_NULL_HANDLE;
-                info.resource.buffer            = buffer;
-                info.resource.bufferMemory      = bufferMemory;
-                info.params.usage               = usage;
-                info.params.property            = property;
-                info.params.sharingMode         = createInfo.sharingMode;
-                info.allocation.size            = allocInfo.allocationSize;
-                info.allocation.memoryTypeBits  = memRequirements.memoryTypeBits;
-                info.allocation.memoryTypeIndex = allocInfo.memoryTypeIndex;
+                info.meta.id                           = bufferInfoId;
+                info.meta.size                         = size;
+                info.meta.bufferMapped                 = memoryAllocationInfo->meta.mapped;
+                info.resource.buffer                   = buffer;
+                info.resource.bufferMemory             = memoryAllocationInfo->resource.memory;
+                info.params.usage                      = usage;
+                info.params.property                   = property;
+                info.params.sharingMode                = createInfo.sharingMode;
+                info.allocation.memoryAllocationInfoId = memoryAllocationInfoId;
+                info.allocation.offset                 = memoryAllocationInfo->params.offset;
+                info.allocation.size                   = memRequirements.size;
+                info.allocation.memoryTypeBits         = memRequirements.memoryTypeBits;
+                info.allocation.memoryTypeIndex        = memoryAllocationInfo->params.memoryTypeIndex;
                 
-                m_bufferInfoPool[type].push_back (info);
+                m_bufferInfoPool[type].insert (info.meta.id, info);
             }            
 
             uint32_t getNextInfoIdFromBufferType (e_bufferType type) {
-                uint32_t nextInfoId = 0;
-                if (m_bufferInfoPool.find (type) != m_bufferInfoPool.end()) {
-                    auto& infos = m_bufferInfoPool[type];
-                    for (auto const& info: infos) {
-                        if (info.meta.id >= nextInfoId) nextInfoId = info.meta.id + 1;
-                    }
-                }
-                return nextInfoId;
+                auto pool = m_bufferInfoPool.find (type);
+                if (pool != m_bufferInfoPool.end())
+                    return pool->second.getNextKey();
+                return 0;
             }
 
             BufferInfo* getBufferInfo (uint32_t bufferInfoId, e_bufferType type) {
-                if (m_bufferInfoPool.find (type) != m_bufferInfoPool.end()) {
-                    auto& infos = m_bufferInfoPool[type];
-                    for (auto& info: infos) {
-                        if (info.meta.id == bufferInfoId) return &info;
-                    }
+                auto pool = m_bufferInfoPool.find (type);
+                if (pool != m_bufferInfoPool.end()) {
+                    auto info = pool->second.find (bufferInfoId);
+                    if (info != nullptr)
+                        return info;
                 }
 
                 LOG_ERROR (m_VKBufferMgrLog) << "Failed to find buffer info "
@@ -239,7 +211,7 @@ namespace Core {
                                                 << "[" << Utils::getBufferTypeString (key) << "]"
                                                 << std::endl;
                     
-                    for (auto const& info: val) {
+                    for (auto const& [infoId, info]: val) {
                         LOG_INFO (m_VKBufferMgrLog) << "Id "
                                                     << "[" << info.meta.id << "]"
                                                     << std::endl; 
@@ -266,6 +238,14 @@ namespace Core {
                                                     << "[" << string_VkSharingMode (info.params.sharingMode) << "]"
                                                     << std::endl;  
 
+                        LOG_INFO (m_VKBufferMgrLog) << "Memory allocation info id "
+                                                    << "[" << info.allocation.memoryAllocationInfoId << "]"
+                                                    << std::endl;
+
+                        LOG_INFO (m_VKBufferMgrLog) << "Allocation offset "
+                                                    << "[" << info.allocation.offset << "]"
+                                                    << std::endl;
+
                         LOG_INFO (m_VKBufferMgrLog) << "Allocation size "
                                                     << "[" << info.allocation.size << "]"
                                                     << std::endl;     
@@ -285,12 +265,12 @@ namespace Core {
                 auto deviceInfo = getDeviceInfo (deviceInfoId);
                 auto bufferInfo = getBufferInfo (bufferInfoId, type);
 
-                vkDestroyBuffer  (deviceInfo->resource.logDevice, bufferInfo->resource.buffer,       VK_NULL_HANDLE);
+                vkDestroyBuffer      (deviceInfo->resource.logDevice, bufferInfo->resource.buffer, VK_NULL_HANDLE);
                 /* Memory that is bound to a buffer object may be freed once the buffer is no longer used, so let's free 
                  * it after the buffer has been destroyed
                 */
-                vkFreeMemory     (deviceInfo->resource.logDevice, bufferInfo->resource.bufferMemory, VK_NULL_HANDLE);
-                deleteBufferInfo (bufferInfo, type);
+                freeMemoryAllocation (deviceInfoId, bufferInfo->allocation.memoryAllocationInfoId);
+                deleteBufferInfo     (bufferInfo, type);
             } 
     };
 }   // namespace Core
@@ -24,36 +24,17 @@ namespace Core {
             */
             void createIndexBuffer (uint32_t deviceInfoId,
                                     uint32_t bufferInfoId,
-                                    VkDeviceSize size, 
-                                    const void* data) {
+                                    VkDeviceSize size) {
                                         
                 auto deviceInfo = getDeviceInfo (deviceInfoId);
-                auto stagingBufferShareQueueFamilyIndices = std::vector {
-                    deviceInfo->meta.transferFamilyIndex.value()
-                };
-                createBuffer (deviceInfoId, 
-                              bufferInfoId,
-                              STAGING_BUFFER,
-                              size,
-                              VK_BUFFER_USAGE_TRANSFER_SRC_BIT, 
-                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | 
-                              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 
-                              stagingBufferShareQueueFamilyIndices);
-
-                auto bufferInfo = getBufferInfo (bufferInfoId, STAGING_BUFFER);
-                vkMapMemory (deviceInfo->resource.logDevice, 
-                             bufferInfo->resource.bufferMemory, 
-                             0, 
-                             size, 
-                             0, 
-                             &bufferInfo->meta.bufferMapped);
-                memcpy (bufferInfo->meta.bufferMapped, data, static_cast <size_t> (size));
-                vkUnmapMemory (deviceInfo->resource.logDevice, bufferInfo->resource.bufferMemory);
-
                 auto bufferShareQueueFamilyIndices = std::vector {
                     deviceInfo->meta.graphicsFamilyIndex.value(), 
+#if !ENABLE_QUEUE_FAMILY_OWNERSHIP_TRANSFER
                     deviceInfo->meta.transferFamilyIndex.value()
+#endif  // ENABLE_QUEUE_FAMILY_OWNERSHIP_TRANSFER
                 };
+                /* Similar to the vertex buffer, the index data is uploaded through the staging buffer
+                */
                 createBuffer (deviceInfoId, 
                               bufferInfoId,
                               INDEX_BUFFER,
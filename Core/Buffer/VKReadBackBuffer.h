@@ -0,0 +1,82 @@
+#ifndef VK_READ_BACK_BUFFER_H
+#define VK_READ_BACK_BUFFER_H
+
+#include <fstream>
+#include "VKBufferMgr.h"
+
+namespace Core {
+    class VKReadBackBuffer: protected virtual VKBufferMgr {
+        private:
+            Log::Record* m_VKReadBackBufferLog;
+            const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
+
+        public:
+            VKReadBackBuffer (void) {
+                m_VKReadBackBufferLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+            }
+
+            ~VKReadBackBuffer (void) {
+                LOG_CLOSE (m_instanceId);
+            }
+
+        protected:
+            /* A read back buffer is the destination of an image to buffer copy, which lets the host access the contents
+             * of an image that was rendered to. Similar to the storage buffers, the buffer stays mapped for its whole
+             * life time (persistent mapping), since we will be reading from it every frame
+            */
+            void createReadBackBuffer (uint32_t deviceInfoId,
+                                       uint32_t bufferInfoId,
+                                       VkDeviceSize size) {
+
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto bufferShareQueueFamilyIndices = std::vector {
+                    deviceInfo->meta.graphicsFamilyIndex.value()
+                };
+
+                createBuffer (deviceInfoId,
+                              bufferInfoId,
+                              READBACK_BUFFER,
+                              size,
+                              VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                              bufferShareQueueFamilyIndices);
+            }
+
+            /* Save the contents of the read back buffer as a binary PPM (P6) image. Note that, the buffer is expected to
+             * hold tightly packed 4 channel 8 bit texels in RGBA order, and the alpha channel is dropped since PPM does
+             * not support it
+            */
+            void saveReadBackBuffer (uint32_t bufferInfoId,
+                                     uint32_t width,
+                                     uint32_t height,
+                                     const std::string& filePath) {
+
+                auto bufferInfo = getBufferInfo (bufferInfoId, READBACK_BUFFER);
+                std::ofstream file (filePath, std::ios::out | std::ios::binary);
+                if (!file.is_open()) {
+                    LOG_ERROR (m_VKReadBackBufferLog) << "Failed to open file "
+                                                      << "[" << filePath << "]"
+                                                      << std::endl;
+                    throw std::runtime_error ("Failed to open file");
+                }
+
+                file << "P6\n" << width << " " << height << "\n" << 255 << "\n";
+                auto texels = static_cast <const uint8_t*> (bufferInfo->meta.bufferMapped);
+                std::vector <char> row (width * 3);
+
+                for (uint32_t y = 0; y < height; y++) {
+                    for (uint32_t x = 0; x < width; x++) {
+                        const uint8_t* texel = texels + (y * width + x) * 4;
+                        row[x * 3 + 0]       = static_cast <char> (texel[0]);
+                        row[x * 3 + 1]       = static_cast <char> (texel[1]);
+                        row[x * 3 + 2]       = static_cast <char> (texel[2]);
+                    }
+                    file.write (row.data(), static_cast <std::streamsize> (row.size()));
+                }
+                file.close();
+            }
+    };
+}   // namespace Core
+#endif  // VK_READ_BACK_BUFFER_H
@@ -0,0 +1,510 @@
+#ifndef VK_STAGING_BUFFER_H
+#define VK_STAGING_BUFFER_H
+
+#include "../Cmd/VKCmdBuffer.h"
+#include "../Cmd/VKCmd.h"
+#include "../Scene/VKSyncObject.h"
+
+namespace Core {
+    /* Instead of creating a host visible staging buffer for every resource that is uploaded to device local memory, we
+     * create a single staging buffer that stays mapped for its lifetime, and pack all uploads in to it. The copy
+     * commands for the uploads are recorded in to one command buffer as they are staged, and are submitted to the
+     * transfer queue in one go. If the staging buffer runs out of space, the recorded copies are submitted and we wait
+     * on the transfer fence, after which the staging buffer can be reused from the start (ring)
+     *
+     * If ENABLE_QUEUE_FAMILY_OWNERSHIP_TRANSFER is set, the resources that are uploaded to are owned exclusively by the
+     * graphics queue family (VK_SHARING_MODE_EXCLUSIVE), which lets the driver keep them in their most optimal form.
+     * The staging buffer keeps track of the resources written to by its copies, and hands them over to the graphics 
+     * queue family once they have been written to in full
+    */
+    class VKStagingBuffer: protected virtual VKCmdBuffer,
+                           protected virtual VKCmd,
+                           protected virtual VKSyncObject {
+        private:
+            /* Resource written to by the copies, the buffer type is VOID_BUFFER if the resource is an image and vice 
+             * versa
+            */
+            struct OwnershipTransferInfo {
+                uint32_t infoId;
+                e_bufferType bufferType;
+                e_imageType imageType;
+            };
+
+            struct StagingBufferInfo {
+                struct Meta {
+                    uint32_t bufferInfoId;
+                    uint32_t fenceInfoId;
+                    uint8_t* bufferMapped;
+                    /* Offset at which the next upload will be packed, and the alignment applied to it
+                    */
+                    VkDeviceSize offset;
+                    VkDeviceSize alignment;
+                    bool recording;
+                    /* Set while a submission is in flight that has not been waited on yet
+                    */
+                    bool submitted;
+                    /* Set if the resources written to by the copies are owned exclusively by the graphics queue family, 
+                     * which differs from the transfer queue family (see ENABLE_QUEUE_FAMILY_OWNERSHIP_TRANSFER)
+                    */
+                    bool ownershipTransfer;
+                    uint32_t graphicsFamilyIndex;
+                    uint32_t transferFamilyIndex;
+                } meta;
+
+                struct Resource {
+                    VkCommandPool commandPool;
+                    VkCommandBuffer commandBuffer;
+                } resource;
+
+                struct Stats {
+                    VkDeviceSize peakOffset;
+                    VkDeviceSize stagedSize;
+                    uint32_t copiesCount;
+                    uint32_t submitsCount;
+                } stats;
+                /* The release half of an ownership transfer is recorded at the end of the command buffer that writes to 
+                 * the resource. The acquire half can only be recorded once that submission is complete, or is ordered 
+                 * before the acquire by a semaphore
+                */
+                std::vector <OwnershipTransferInfo> pendingReleases;
+                std::vector <OwnershipTransferInfo> submittedReleases;
+                std::vector <OwnershipTransferInfo> pendingAcquires;
+            } m_stagingBufferInfo;
+
+            Log::Record* m_VKStagingBufferLog;
+            const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
+
+            /* Returns a pointer to a region of the staging buffer that is large enough to hold the upload, along with
+             * its offset in the staging buffer. Note that, this may submit the copies recorded so far (and wait on them)
+             * if there isn't enough space left
+            */
+            uint8_t* getStagingSpace (uint32_t deviceInfoId, VkDeviceSize size, VkDeviceSize& offset) {
+                if (size > g_coreSettings.stagingBufferSize) {
+                    LOG_ERROR (m_VKStagingBufferLog) << "Upload does not fit in staging buffer "
+                                                     << "[" << size << "]"
+                                                     << "->"
+                                                     << "[" << g_coreSettings.stagingBufferSize << "]"
+                                                     << std::endl;
+                    throw std::runtime_error ("Upload does not fit in staging buffer");
+                }
+
+                auto& meta = m_stagingBufferInfo.meta;
+                offset     = (meta.offset + meta.alignment - 1) / meta.alignment * meta.alignment;
+                /* The command buffer can't be recorded in to while a submission is in flight
+                */
+                if (meta.submitted || offset + size > g_coreSettings.stagingBufferSize) {
+                    submitCopies (deviceInfoId, VK_NULL_HANDLE, false);
+                    waitCopies   (deviceInfoId);
+                    offset = 0;
+                }
+
+                if (!meta.recording) {
+                    beginRecording (m_stagingBufferInfo.resource.commandBuffer,
+                                    VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+                                    VK_NULL_HANDLE);
+                    meta.recording = true;
+                }
+
+                auto& stats       = m_stagingBufferInfo.stats;
+                meta.offset       = offset + size;
+                stats.peakOffset  = std::max (stats.peakOffset, meta.offset);
+                stats.stagedSize += size;
+                stats.copiesCount++;
+                return meta.bufferMapped + offset;
+            }
+
+            void addOwnershipTransfer (uint32_t infoId, e_bufferType bufferType, e_imageType imageType) {
+                if (!m_stagingBufferInfo.meta.ownershipTransfer)
+                    return;
+                /* Consecutive uploads to the same resource (the geometry of each model, for example) share a transfer
+                */
+                auto& releases = m_stagingBufferInfo.pendingReleases;
+                if (!releases.empty() && releases.back().infoId     == infoId     &&
+                                         releases.back().bufferType == bufferType &&
+                                         releases.back().imageType  == imageType)
+                    return;
+                releases.push_back ({infoId, bufferType, imageType});
+            }
+
+            /* Hand over the resources written to by the copies recorded so far from the transfer queue family to the 
+             * graphics queue family
+            */
+            void recordOwnershipReleases (void) {
+                auto& meta = m_stagingBufferInfo.meta;
+                for (auto const& release: m_stagingBufferInfo.pendingReleases) {
+                    release.imageType == VOID_IMAGE ?
+                    transferBufferOwnership (release.infoId, release.bufferType,
+                                             meta.transferFamilyIndex,
+                                             meta.graphicsFamilyIndex,
+                                             VK_ACCESS_TRANSFER_WRITE_BIT,
+                                             VK_ACCESS_NONE,
+                                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                             VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                             m_stagingBufferInfo.resource.commandBuffer):
+                    transferImageOwnership  (release.infoId, release.imageType,
+                                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                             meta.transferFamilyIndex,
+                                             meta.graphicsFamilyIndex,
+                                             VK_ACCESS_TRANSFER_WRITE_BIT,
+                                             VK_ACCESS_NONE,
+                                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                             VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                             m_stagingBufferInfo.resource.commandBuffer);
+
+                    m_stagingBufferInfo.submittedReleases.push_back (release);
+                }
+                m_stagingBufferInfo.pendingReleases.clear();
+            }
+
+            void completeOwnershipReleases (void) {
+                auto& info = m_stagingBufferInfo;
+                info.pendingAcquires.insert (info.pendingAcquires.end(), 
+                                             info.submittedReleases.begin(), 
+                                             info.submittedReleases.end());
+                info.submittedReleases.clear();
+            }
+
+            /* Note that, the resources written to by the copies are only released to the graphics queue family when
+             * asked to. A resource that is written to across multiple submissions (when the staging buffer runs out of
+             * space midway through a large upload, for example) must not be released until it has been written to in 
+             * full, since the transfer queue family would no longer own it
+            */
+            bool submitCopies (uint32_t deviceInfoId, VkSemaphore signalSemaphore, bool releaseOwnership) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto& meta      = m_stagingBufferInfo.meta;
+                if (!meta.recording)
+                    return false;
+
+                if (releaseOwnership)
+                    recordOwnershipReleases();
+                endRecording (m_stagingBufferInfo.resource.commandBuffer);
+
+                VkSubmitInfo submitInfo{};
+                submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                submitInfo.commandBufferCount   = 1;
+                submitInfo.pCommandBuffers      = &m_stagingBufferInfo.resource.commandBuffer;
+                submitInfo.signalSemaphoreCount = signalSemaphore == VK_NULL_HANDLE ? 0: 1;
+                submitInfo.pSignalSemaphores    = &signalSemaphore;
+
+                auto fenceInfo  = getFenceInfo (meta.fenceInfoId, FEN_TRANSFER_DONE);
+                VkResult result = vkQueueSubmit (deviceInfo->resource.transferQueue,
+                                                 1,
+                                                 &submitInfo,
+                                                 fenceInfo->resource.fence);
+                if (result != VK_SUCCESS) {
+                    LOG_ERROR (m_VKStagingBufferLog) << "Failed to submit staging buffer copies "
+                                                     << "[" << deviceInfoId << "]"
+                                                     << " "
+                                                     << "[" << string_VkResult (result) << "]"
+                                                     << std::endl;
+                    throw std::runtime_error ("Failed to submit staging buffer copies");
+                }
+
+                meta.recording = false;
+                meta.submitted = true;
+                m_stagingBufferInfo.stats.submitsCount++;
+                if (signalSemaphore != VK_NULL_HANDLE)
+                    completeOwnershipReleases();
+                return true;
+            }
+
+            void waitCopies (uint32_t deviceInfoId) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto& meta      = m_stagingBufferInfo.meta;
+                if (!meta.submitted)
+                    return;
+
+                auto fenceInfo = getFenceInfo (meta.fenceInfoId, FEN_TRANSFER_DONE);
+                vkWaitForFences (deviceInfo->resource.logDevice, 1, &fenceInfo->resource.fence, VK_TRUE, UINT64_MAX);
+                vkResetFences   (deviceInfo->resource.logDevice, 1, &fenceInfo->resource.fence);
+
+                meta.offset    = 0;
+                meta.submitted = false;
+                completeOwnershipReleases();
+            }
+
+        public:
+            VKStagingBuffer (void) {
+                m_VKStagingBufferLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+            }
+
+            ~VKStagingBuffer (void) {
+                LOG_CLOSE (m_instanceId);
+            }
+
+        protected:
+            void readyStagingBuffer (uint32_t deviceInfoId, uint32_t bufferInfoId, uint32_t fenceInfoId) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto stagingBufferShareQueueFamilyIndices = std::vector {
+                    deviceInfo->meta.transferFamilyIndex.value()
+                };
+                /* The buffer usage bit is set to VK_BUFFER_USAGE_TRANSFER_SRC_BIT, this means the buffer can be used as 
+                 * source in a memory transfer operation
+                 *
+                 * Memory type properties:
+                 * (1) VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+                 * This property says that we are able to map the allocated memory so we can write to it from the CPU. 
+                 * Note that, the memory allocator keeps host visible memory mapped, so we don't have to call 
+                 * vkMapMemory/vkUnmapMemory for every upload
+                 * 
+                 * (2) VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                 * After we memcpy the data to the mapped memory, the driver may not immediately copy the data into the 
+                 * buffer memory, for example because of caching. It is also possible that writes to the buffer are not 
+                 * visible in the mapped memory yet. There are two ways to deal with that problem:
+                 * 
+                 * (1) Use a memory heap that is host coherent, indicated with VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                 * (2) Or, call vkFlushMappedMemoryRanges after writing to the mapped memory, and call 
+                 * vkInvalidateMappedMemoryRanges before reading from the mapped memory
+                 * 
+                 * We went for the first approach, which ensures that the mapped memory always matches the contents of 
+                 * the allocated memory. Do keep in mind that this may lead to slightly worse performance than explicit 
+                 * flushing
+                */
+                createBuffer (deviceInfoId,
+                              bufferInfoId,
+                              STAGING_BUFFER,
+                              g_coreSettings.stagingBufferSize,
+                              VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                              stagingBufferShareQueueFamilyIndices);
+                /* Note that the command buffers that we will be submitting to the transfer queue will be short lived, so
+                 * we will choose the VK_COMMAND_POOL_CREATE_TRANSIENT_BIT flag. And, the copy commands require a queue
+                 * family that supports transfer operations, which is indicated using VK_QUEUE_TRANSFER_BIT. The command
+                 * buffer is recorded again after every submission, which requires it to be reset first, this is done
+                 * implicitly by vkBeginCommandBuffer if the pool is created with the 
+                 * VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT flag
+                */
+                auto commandPool = getCommandPool (deviceInfoId,
+                                                   VK_COMMAND_POOL_CREATE_TRANSIENT_BIT |
+                                                   VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+                                                   deviceInfo->meta.transferFamilyIndex.value());
+                auto commandBuffers = getCommandBuffers (deviceInfoId,
+                                                         commandPool,
+                                                         1,
+                                                         VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+                createFence (deviceInfoId, fenceInfoId, FEN_TRANSFER_DONE, 0);
+                /* The buffer offset of a buffer to image copy must be a multiple of the texel block size (and of 4), the
+                 * optimal alignment reported by the device is applied on top of that
+                */
+                VkDeviceSize alignment = std::max (static_cast <VkDeviceSize> (16),
+                                                   deviceInfo->params.optimalBufferCopyOffsetAlignment);
+                auto bufferInfo        = getBufferInfo (bufferInfoId, STAGING_BUFFER);
+
+                m_stagingBufferInfo.meta.bufferInfoId      = bufferInfoId;
+                m_stagingBufferInfo.meta.fenceInfoId       = fenceInfoId;
+                m_stagingBufferInfo.meta.bufferMapped      = static_cast <uint8_t*> (bufferInfo->meta.bufferMapped);
+                m_stagingBufferInfo.meta.offset            = 0;
+                m_stagingBufferInfo.meta.alignment         = alignment;
+                m_stagingBufferInfo.meta.recording         = false;
+                m_stagingBufferInfo.meta.submitted         = false;
+                m_stagingBufferInfo.meta.ownershipTransfer = ENABLE_QUEUE_FAMILY_OWNERSHIP_TRANSFER &&
+                                                             deviceInfo->meta.graphicsFamilyIndex.value() != 
+                                                             deviceInfo->meta.transferFamilyIndex.value();
+                m_stagingBufferInfo.meta.graphicsFamilyIndex = deviceInfo->meta.graphicsFamilyIndex.value();
+                m_stagingBufferInfo.meta.transferFamilyIndex = deviceInfo->meta.transferFamilyIndex.value();
+                m_stagingBufferInfo.resource.commandPool   = commandPool;
+                m_stagingBufferInfo.resource.commandBuffer = commandBuffers[0];
+                m_stagingBufferInfo.stats.peakOffset       = 0;
+                m_stagingBufferInfo.stats.stagedSize       = 0;
+                m_stagingBufferInfo.stats.copiesCount      = 0;
+                m_stagingBufferInfo.stats.submitsCount     = 0;
+            }
+
+            /* Upload data to a region of a device local buffer, uploads that are larger than the staging buffer are
+             * split up in to multiple copies
+            */
+            void stageBufferUpload (uint32_t deviceInfoId,
+                                    uint32_t dstBufferInfoId,
+                                    e_bufferType dstBufferType,
+                                    VkDeviceSize dstOffset,
+                                    const void* data,
+                                    VkDeviceSize size) {
+
+                VkDeviceSize stagedSize = 0;
+                while (stagedSize < size) {
+                    VkDeviceSize chunkSize = std::min (size - stagedSize, g_coreSettings.stagingBufferSize);
+                    VkDeviceSize srcOffset;
+                    uint8_t* stagingSpace  = getStagingSpace (deviceInfoId, chunkSize, srcOffset);
+
+                    memcpy (stagingSpace,
+                            static_cast <const uint8_t*> (data) + stagedSize,
+                            static_cast <size_t> (chunkSize));
+                    copyBufferToBuffer (m_stagingBufferInfo.meta.bufferInfoId,
+                                        dstBufferInfoId,
+                                        STAGING_BUFFER, dstBufferType,
+                                        srcOffset,
+                                        dstOffset + stagedSize,
+                                        chunkSize,
+                                        m_stagingBufferInfo.resource.commandBuffer);
+                    addOwnershipTransfer (dstBufferInfoId, dstBufferType, VOID_IMAGE);
+                    stagedSize += chunkSize;
+                }
+            }
+
+            /* Upload pixel data to mip level 0 of an image, the image is transitioned to be a transfer destination as
+             * part of the copy
+            */
+            void stageImageUpload (uint32_t deviceInfoId,
+                                   uint32_t dstImageInfoId,
+                                   e_imageType dstImageType,
+                                   const void* data,
+                                   VkDeviceSize size) {
+
+                VkDeviceSize srcOffset;
+                uint8_t* stagingSpace = getStagingSpace (deviceInfoId, size, srcOffset);
+
+                memcpy (stagingSpace, data, static_cast <size_t> (size));
+                recordImageCopy (dstImageInfoId, dstImageType, srcOffset, 1);
+            }
+
+            /* Returns true if an upload of the given size can be packed in to the staging buffer without having to 
+             * submit the copies recorded so far
+            */
+            bool isStagingSpaceAvailable (VkDeviceSize size) {
+                auto& meta          = m_stagingBufferInfo.meta;
+                VkDeviceSize offset = (meta.offset + meta.alignment - 1) / meta.alignment * meta.alignment;
+                return offset + size <= g_coreSettings.stagingBufferSize;
+            }
+
+            /* Reserve a region of the staging buffer that the caller will write to directly (possibly from other 
+             * threads), instead of handing over the data to be copied in. The copy out of the region is recorded 
+             * separately once it has been written to. Note that, all reserved regions must be written to and their 
+             * copies recorded before the next reservation that does not fit, since that will submit the copies
+            */
+            uint8_t* reserveStagingSpace (uint32_t deviceInfoId, VkDeviceSize size, VkDeviceSize& offset) {
+                return getStagingSpace (deviceInfoId, size, offset);
+            }
+
+            /* Record the copy of a staged region to the first few mip levels of an image, the levels are expected to be
+             * tightly packed in the region starting from level 0
+            */
+            void recordImageCopy (uint32_t dstImageInfoId,
+                                  e_imageType dstImageType,
+                                  VkDeviceSize srcOffset,
+                                  uint32_t copyMipLevels) {
+
+                copyBufferToImage (m_stagingBufferInfo.meta.bufferInfoId,
+                                   dstImageInfoId,
+                                   STAGING_BUFFER, dstImageType,
+                                   srcOffset,
+                                   copyMipLevels,
+                                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                   m_stagingBufferInfo.resource.commandBuffer);
+                addOwnershipTransfer (dstImageInfoId, VOID_BUFFER, dstImageType);
+            }
+
+            /* Submit all copies recorded so far without waiting on them. The staging buffer can't be written to again
+             * until the submission is complete, see isStagingBufferIdle. If a semaphore is given, it is signaled once 
+             * the copies are complete, so that the work on the graphics queue that depends on them can be ordered after
+             * them without the host having to wait in between. Returns false if there were no copies to submit, in 
+             * which case the semaphore will not be signaled
+            */
+            bool flushStagingBuffer (uint32_t deviceInfoId, VkSemaphore signalSemaphore) {
+                return submitCopies (deviceInfoId, signalSemaphore, true);
+            }
+
+            /* Returns true if there is no submission in flight, without blocking. Once the transfer fence is found to 
+             * be signaled, it is reset and the staging buffer is free to be reused from the start
+            */
+            bool isStagingBufferIdle (uint32_t deviceInfoId) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto& meta      = m_stagingBufferInfo.meta;
+                if (!meta.submitted)
+                    return true;
+
+                auto fenceInfo = getFenceInfo (meta.fenceInfoId, FEN_TRANSFER_DONE);
+                if (vkGetFenceStatus (deviceInfo->resource.logDevice, fenceInfo->resource.fence) != VK_SUCCESS)
+                    return false;
+
+                vkResetFences (deviceInfo->resource.logDevice, 1, &fenceInfo->resource.fence);
+                meta.offset    = 0;
+                meta.submitted = false;
+                completeOwnershipReleases();
+                return true;
+            }
+
+            /* Submit all copies recorded so far and wait on the transfer fence, once it is signaled the staging buffer
+             * is free to be reused from the start
+             *
+             * Unlike the draw commands, there are no events we need to wait on. A fence would allow you to schedule
+             * multiple transfers simultaneously and wait for all of them complete, instead of executing one at a time.
+             * That may give the driver more opportunities to optimize
+            */
+            void submitStagingBuffer (uint32_t deviceInfoId) {
+                submitCopies (deviceInfoId, VK_NULL_HANDLE, true);
+                waitCopies   (deviceInfoId);
+            }
+
+            /* Take over the resources that were handed over by the completed submissions, this has to be recorded on the
+             * graphics queue before the resources are used there
+            */
+            void recordOwnershipAcquires (VkCommandBuffer commandBuffer) {
+                auto& meta = m_stagingBufferInfo.meta;
+                for (auto const& acquire: m_stagingBufferInfo.pendingAcquires) {
+                    /* Only the geometry is uploaded to buffers through the staging buffer
+                    */
+                    acquire.imageType == VOID_IMAGE ?
+                    transferBufferOwnership (acquire.infoId, acquire.bufferType,
+                                             meta.transferFamilyIndex,
+                                             meta.graphicsFamilyIndex,
+                                             VK_ACCESS_NONE,
+                                             acquire.bufferType == INDEX_BUFFER ? VK_ACCESS_INDEX_READ_BIT:
+                                                                                  VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+                                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                             VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                                             commandBuffer):
+                    transferImageOwnership  (acquire.infoId, acquire.imageType,
+                                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                             meta.transferFamilyIndex,
+                                             meta.graphicsFamilyIndex,
+                                             VK_ACCESS_NONE,
+                                             VK_ACCESS_TRANSFER_WRITE_BIT,
+                                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                             commandBuffer);
+                }
+                m_stagingBufferInfo.pendingAcquires.clear();
+            }
+
+            void dumpStagingBufferStats (void) {
+                LOG_INFO (m_VKStagingBufferLog) << "Dumping staging buffer stats"
+                                                << std::endl;
+
+                LOG_INFO (m_VKStagingBufferLog) << "Buffer info id "
+                                                << "[" << m_stagingBufferInfo.meta.bufferInfoId << "]"
+                                                << std::endl;
+
+                LOG_INFO (m_VKStagingBufferLog) << "Alignment "
+                                                << "[" << m_stagingBufferInfo.meta.alignment << "]"
+                                                << std::endl;
+
+                LOG_INFO (m_VKStagingBufferLog) << "Peak usage "
+                                                << "[" << m_stagingBufferInfo.stats.peakOffset << "]"
+                                                << "->"
+                                                << "[" << g_coreSettings.stagingBufferSize << "]"
+                                                << std::endl;
+
+                LOG_INFO (m_VKStagingBufferLog) << "Staged size "
+                                                << "[" << m_stagingBufferInfo.stats.stagedSize << "]"
+                                                << std::endl;
+
+                LOG_INFO (m_VKStagingBufferLog) << "Copies count "
+                                                << "[" << m_stagingBufferInfo.stats.copiesCount << "]"
+                                                << std::endl;
+
+                LOG_INFO (m_VKStagingBufferLog) << "Submits count "
+                                                << "[" << m_stagingBufferInfo.stats.submitsCount << "]"
+                                                << std::endl;
+            }
+
+            void cleanUpStagingBuffer (uint32_t deviceInfoId) {
+                cleanUpFence         (deviceInfoId, m_stagingBufferInfo.meta.fenceInfoId, FEN_TRANSFER_DONE);
+                VKCmdBuffer::cleanUp (deviceInfoId, m_stagingBufferInfo.resource.commandPool);
+                VKBufferMgr::cleanUp (deviceInfoId, m_stagingBufferInfo.meta.bufferInfoId, STAGING_BUFFER);
+            }
+    };
+}   // namespace Core
+#endif  // VK_STAGING_BUFFER_H
@@ -36,14 +36,6 @@ namespace Core {
                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | 
                               VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 
                               bufferShareQueueFamilyIndices);
-
-                auto bufferInfo = getBufferInfo (bufferInfoId, STORAGE_BUFFER);
-                vkMapMemory (deviceInfo->resource.logDevice, 
-                             bufferInfo->resource.bufferMemory, 
-                             0, 
-                             size, 
-                             0, 
-                             &bufferInfo->meta.bufferMapped);
             }
 
             void updateStorageBuffer (uint32_t bufferInfoId, 
@@ -40,19 +40,12 @@ namespace Core {
                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | 
                               VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 
                               bufferShareQueueFamilyIndices);
-
-                auto bufferInfo = getBufferInfo (bufferInfoId, UNIFORM_BUFFER);
-                /* We map the buffer right after creation using vkMapMemory to get a pointer to which we can write the 
-                 * data later on. The buffer stays mapped to this pointer for the application's whole lifetime. This 
-                 * technique is called "persistent mapping" and works on all Vulkan implementations. Not having to map 
-                 * the buffer every time we need to update it increases performances, as mapping is not free
+                /* Note that, we don't need to map the buffer to get a pointer to which we can write the data later on.
+                 * The memory allocator maps host visible blocks right after creation, and they stay mapped for the 
+                 * application's whole lifetime. This technique is called "persistent mapping" and works on all Vulkan 
+                 * implementations. Not having to map the buffer every time we need to update it increases performances, 
+                 * as mapping is not free
                 */
-                vkMapMemory (deviceInfo->resource.logDevice, 
-                             bufferInfo->resource.bufferMemory, 
-                             0, 
-                             size, 
-                             0, 
-                             &bufferInfo->meta.bufferMapped);
             }
 
             void updateUniformBuffer (uint32_t bufferInfoId, 
@@ -4,11 +4,13 @@
 #include "../Image/VKImageMgr.h"
 #include "../Buffer/VKBufferMgr.h"
 #include "../Pipeline/VKPipelineMgr.h"
+#include "../Scene/VKFrameAllocator.h"
 
 namespace Core {
     class VKCmd: protected virtual VKImageMgr,
                  protected virtual VKBufferMgr,
-                 protected virtual VKPipelineMgr {
+                 protected virtual VKPipelineMgr,
+                 protected virtual VKFrameAllocator {
         private:
             Log::Record* m_VKCmdLog;
             const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
@@ -25,7 +27,7 @@ namespace Core {
         protected:
             void setViewPorts (uint32_t deviceInfoId,
                                uint32_t firstViewPort,
-                               std::vector <VkViewport>& viewPorts,
+                               std::span <const VkViewport> viewPorts,
                                VkCommandBuffer commandBuffer) {
                 
                 auto deviceInfo = getDeviceInfo (deviceInfoId);
@@ -40,19 +42,23 @@ namespace Core {
                 defaultViewPort.height   = static_cast <float> (deviceInfo->params.swapChainExtent.height);
                 defaultViewPort.minDepth = 0.0f;
                 defaultViewPort.maxDepth = 1.0f;
-                /* Add default view port to list of custom view ports (if any)
+                /* Set the list of custom view ports (if any), followed by the default view port
                 */
-                viewPorts.push_back (defaultViewPort);
+                if (!viewPorts.empty())
+                    vkCmdSetViewport (commandBuffer, 
+                                      firstViewPort, 
+                                      static_cast <uint32_t> (viewPorts.size()), 
+                                      viewPorts.data());
 
                 vkCmdSetViewport (commandBuffer, 
-                                  firstViewPort, 
-                                  static_cast <uint32_t> (viewPorts.size()), 
-                                  viewPorts.data());
+                                  firstViewPort + static_cast <uint32_t> (viewPorts.size()), 
+                                  1, 
+                                  &defaultViewPort);
             }
 
             void setScissors (uint32_t deviceInfoId,
                               uint32_t firstScissor,
-                              std::vector <VkRect2D>& scissors,
+                              std::span <const VkRect2D> scissors,
                               VkCommandBuffer commandBuffer) {
 
                 auto deviceInfo = getDeviceInfo (deviceInfoId);
@@ -61,11 +67,16 @@ namespace Core {
                 defaultScissor.offset = {0, 0};
                 defaultScissor.extent = deviceInfo->params.swapChainExtent;
 
-                scissors.push_back (defaultScissor);
+                if (!scissors.empty())
+                    vkCmdSetScissor (commandBuffer, 
+                                     firstScissor, 
+                                     static_cast <uint32_t> (scissors.size()), 
+                                     scissors.data());
+
                 vkCmdSetScissor (commandBuffer, 
-                                 firstScissor, 
-                                 static_cast <uint32_t> (scissors.size()), 
-                                 scissors.data());
+                                 firstScissor + static_cast <uint32_t> (scissors.size()), 
+                                 1, 
+                                 &defaultScissor);
             }
 
             void copyBufferToBuffer (uint32_t srcBufferInfoId,
@@ -74,6 +85,7 @@ namespace Core {
                                      e_bufferType dstBufferType,
                                      VkDeviceSize srcOffset,
                                      VkDeviceSize dstOffset,
+                                     VkDeviceSize size,
                                      VkCommandBuffer commandBuffer) {
 
                 auto srcBufferInfo = getBufferInfo (srcBufferInfoId, srcBufferType);
@@ -85,7 +97,7 @@ namespace Core {
                 VkBufferCopy copyRegion;
                 copyRegion.srcOffset = srcOffset; 
                 copyRegion.dstOffset = dstOffset;
-                copyRegion.size      = srcBufferInfo->meta.size;
+                copyRegion.size      = size;
                 vkCmdCopyBuffer (commandBuffer, 
                                  srcBufferInfo->resource.buffer, 
                                  dstBufferInfo->resource.buffer, 
@@ -98,6 +110,7 @@ namespace Core {
                                     e_bufferType srcBufferType, 
                                     e_imageType dstImageType, 
                                     VkDeviceSize srcOffset,
+                                    uint32_t copyMipLevels,
                                     VkImageLayout dstImageLayout,
                                     VkCommandBuffer commandBuffer) {
 
@@ -149,36 +162,111 @@ namespace Core {
                  * example, you could have some padding bytes between rows of the image. Specifying 0 for both indicates 
                  * that the pixels are simply tightly packed. The imageSubresource, imageOffset and imageExtent fields 
                  * indicate to which part of the image we want to copy the pixels
+                 *
+                 * If more than one mip level is to be copied, the levels are expected to be tightly packed in the buffer
+                 * one after the other (starting from level 0), with one copy region per level
                 */
+                std::vector <VkBufferImageCopy> copyRegions (copyMipLevels);
+                VkDeviceSize levelOffset = srcOffset;
+                uint32_t mipWidth        = dstImageInfo->meta.width;
+                uint32_t mipHeight       = dstImageInfo->meta.height;
+
+                for (uint32_t i = 0; i < copyMipLevels; i++) {
+                    auto& copyRegion             = copyRegions[i];
+                    copyRegion.bufferOffset      = levelOffset;
+                    copyRegion.bufferRowLength   = 0;
+                    copyRegion.bufferImageHeight = 0;
+
+                    copyRegion.imageSubresource.aspectMask     = dstImageInfo->params.aspect;
+                    copyRegion.imageSubresource.mipLevel       = i;
+                    copyRegion.imageSubresource.baseArrayLayer = 0;
+                    copyRegion.imageSubresource.layerCount     = 1;
+
+                    copyRegion.imageOffset = {0, 0, 0};
+                    copyRegion.imageExtent = {
+                                                mipWidth,
+                                                mipHeight,
+                                                1
+                                             };
+                    levelOffset += getMipLevelSize (dstImageInfo->params.format, mipWidth, mipHeight);
+                    if (mipWidth > 1)  mipWidth  /= 2;
+                    if (mipHeight > 1) mipHeight /= 2;
+                }
+                /* Buffer to image copy operations are enqueued using the vkCmdCopyBufferToImage function, the fourth 
+                 * parameter indicates which layout the image is currently using. I'm assuming here that the image has 
+                 * already been transitioned to the layout that is optimal for copying pixels to
+                 * 
+                 * Note that, it's possible to specify an array of VkBufferImageCopy to perform many different copies 
+                 * from this buffer to the image in one operation, which is what we do to fill multiple mip levels
+                */
+                vkCmdCopyBufferToImage (commandBuffer,
+                                        srcBufferInfo->resource.buffer,
+                                        dstImageInfo->resource.image,
+                                        dstImageLayout,
+                                        static_cast <uint32_t> (copyRegions.size()),
+                                        copyRegions.data());
+            }
+
+            /* Copy the contents of a color attachment to a host visible buffer once the render pass that writes to it has
+             * ended. Note that, the image is expected to be in the src image layout already (set as the final layout of
+             * the attachment), and the render pass is expected to order the color attachment writes and the layout
+             * transition before the copy through a dependency to VK_SUBPASS_EXTERNAL (see createReadBackDependency).
+             * So, we only need to make sure that the copy is complete before the host reads from the buffer
+            */
+            void copyImageToBuffer (uint32_t srcImageInfoId,
+                                    uint32_t dstBufferInfoId,
+                                    e_imageType srcImageType,
+                                    e_bufferType dstBufferType,
+                                    VkImageLayout srcImageLayout,
+                                    VkCommandBuffer commandBuffer) {
+
+                auto srcImageInfo  = getImageInfo  (srcImageInfoId,  srcImageType);
+                auto dstBufferInfo = getBufferInfo (dstBufferInfoId, dstBufferType);
+
                 VkBufferImageCopy copyRegion;
-                copyRegion.bufferOffset      = srcOffset;
+                copyRegion.bufferOffset      = 0;
                 copyRegion.bufferRowLength   = 0;
                 copyRegion.bufferImageHeight = 0;
 
-                copyRegion.imageSubresource.aspectMask     = dstImageInfo->params.aspect;
+                copyRegion.imageSubresource.aspectMask     = srcImageInfo->params.aspect;
                 copyRegion.imageSubresource.mipLevel       = 0;
                 copyRegion.imageSubresource.baseArrayLayer = 0;
                 copyRegion.imageSubresource.layerCount     = 1;
 
                 copyRegion.imageOffset = {0, 0, 0};
                 copyRegion.imageExtent = {
-                                            dstImageInfo->meta.width,
-                                            dstImageInfo->meta.height,
+                                            srcImageInfo->meta.width,
+                                            srcImageInfo->meta.height,
                                             1
                                          };
-                /* Buffer to image copy operations are enqueued using the vkCmdCopyBufferToImage function, the fourth 
-                 * parameter indicates which layout the image is currently using. I'm assuming here that the image has 
-                 * already been transitioned to the layout that is optimal for copying pixels to
-                 * 
-                 * We're only copying one chunk of pixels to the whole image, but it's possible to specify an array of 
-                 * VkBufferImageCopy to perform many different copies from this buffer to the image in one operation
-                */
-                vkCmdCopyBufferToImage (commandBuffer,
-                                        srcBufferInfo->resource.buffer,
-                                        dstImageInfo->resource.image,
-                                        dstImageLayout,
+
+                vkCmdCopyImageToBuffer (commandBuffer,
+                                        srcImageInfo->resource.image,
+                                        srcImageLayout,
+                                        dstBufferInfo->resource.buffer,
                                         1,
-                                        &copyRegion);                
+                                        &copyRegion);
+                /* Make the transfer writes available to the host, the in flight fence that is signaled at the end of the
+                 * submission then guarantees that the host can read the buffer after waiting on it
+                */
+                VkBufferMemoryBarrier bufferBarrier;
+                bufferBarrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+                bufferBarrier.pNext               = VK_NULL_HANDLE;
+                bufferBarrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+                bufferBarrier.dstAccessMask       = VK_ACCESS_HOST_READ_BIT;
+                bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                bufferBarrier.buffer              = dstBufferInfo->resource.buffer;
+                bufferBarrier.offset              = 0;
+                bufferBarrier.size                = VK_WHOLE_SIZE;
+
+                vkCmdPipelineBarrier (commandBuffer,
+                                      VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                      VK_PIPELINE_STAGE_HOST_BIT,
+                                      0,
+                                      0, VK_NULL_HANDLE,
+                                      1, &bufferBarrier,
+                                      0, VK_NULL_HANDLE);
             }
 
             /* Mipmaps are precalculated, downscaled versions of an image. Each new image is half the width and height of 
@@ -364,10 +452,123 @@ namespace Core {
                                       1, &barrier);                 
             }
 
+            /* If all mip levels of the image have already been filled (for example, when the mip chain is generated on 
+             * the host and copied along with the base level), there is nothing left to blit and we only need to prepare 
+             * all the levels for shader access. Note that, this transition has to be submitted to a queue with graphics 
+             * capability since it waits on the fragment shader stage
+            */
+            void transitionImageToShaderRead (uint32_t imageInfoId, 
+                                              e_imageType imageType,
+                                              VkCommandBuffer commandBuffer) {
+
+                auto imageInfo = getImageInfo (imageInfoId, imageType);
+                VkImageMemoryBarrier barrier;
+                VkPipelineStageFlags sourceStage, destinationStage;
+
+                transitionImageLayout (imageInfo->resource.image,
+                                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                       VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                       0,
+                                       imageInfo->meta.mipLevels,
+                                       imageInfo->params.aspect,
+                                       &barrier,
+                                       sourceStage,
+                                       destinationStage);
+
+                vkCmdPipelineBarrier (commandBuffer,
+                                      sourceStage,
+                                      destinationStage,
+                                      0,
+                                      0, VK_NULL_HANDLE,
+                                      0, VK_NULL_HANDLE,
+                                      1, &barrier);
+            }
+
+            /* Resources that are created with VK_SHARING_MODE_EXCLUSIVE are owned by one queue family at a time, and 
+             * using them in another queue family requires their ownership to be transferred. A transfer is made up of 
+             * two halves, a release barrier recorded on a queue of the family that gives up ownership, and a matching 
+             * acquire barrier (with the same queue family indices, and the same layouts in the case of images) recorded 
+             * on a queue of the family that takes it. The acquire must not execute before the release, which is ensured 
+             * with a semaphore or with a fence that the host has seen signaled
+             *
+             * Note that, the dstAccessMask of the release and the srcAccessMask of the acquire are ignored, since the 
+             * memory dependency is split across the two barriers
+            */
+            void transferBufferOwnership (uint32_t bufferInfoId,
+                                          e_bufferType bufferType,
+                                          uint32_t srcQueueFamilyIndex,
+                                          uint32_t dstQueueFamilyIndex,
+                                          VkAccessFlags srcAccessMask,
+                                          VkAccessFlags dstAccessMask,
+                                          VkPipelineStageFlags sourceStage,
+                                          VkPipelineStageFlags destinationStage,
+                                          VkCommandBuffer commandBuffer) {
+
+                auto bufferInfo = getBufferInfo (bufferInfoId, bufferType);
+                VkBufferMemoryBarrier barrier;
+                barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+                barrier.pNext               = VK_NULL_HANDLE;
+                barrier.srcAccessMask       = srcAccessMask;
+                barrier.dstAccessMask       = dstAccessMask;
+                barrier.srcQueueFamilyIndex = srcQueueFamilyIndex;
+                barrier.dstQueueFamilyIndex = dstQueueFamilyIndex;
+                barrier.buffer              = bufferInfo->resource.buffer;
+                barrier.offset              = 0;
+                barrier.size                = VK_WHOLE_SIZE;
+
+                vkCmdPipelineBarrier (commandBuffer,
+                                      sourceStage,
+                                      destinationStage,
+                                      0,
+                                      0, VK_NULL_HANDLE,
+                                      1, &barrier,
+                                      0, VK_NULL_HANDLE);
+            }
+
+            /* The image is kept in the same layout across the transfer, so that the layout transition isn't performed 
+             * twice (once by each half)
+            */
+            void transferImageOwnership (uint32_t imageInfoId,
+                                         e_imageType imageType,
+                                         VkImageLayout imageLayout,
+                                         uint32_t srcQueueFamilyIndex,
+                                         uint32_t dstQueueFamilyIndex,
+                                         VkAccessFlags srcAccessMask,
+                                         VkAccessFlags dstAccessMask,
+                                         VkPipelineStageFlags sourceStage,
+                                         VkPipelineStageFlags destinationStage,
+                                         VkCommandBuffer commandBuffer) {
+
+                auto imageInfo = getImageInfo (imageInfoId, imageType);
+                VkImageMemoryBarrier barrier;
+                barrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                barrier.pNext               = VK_NULL_HANDLE;
+                barrier.srcAccessMask       = srcAccessMask;
+                barrier.dstAccessMask       = dstAccessMask;
+                barrier.oldLayout           = imageLayout;
+                barrier.newLayout           = imageLayout;
+                barrier.srcQueueFamilyIndex = srcQueueFamilyIndex;
+                barrier.dstQueueFamilyIndex = dstQueueFamilyIndex;
+                barrier.image               = imageInfo->resource.image;
+                barrier.subresourceRange.aspectMask     = imageInfo->params.aspect;
+                barrier.subresourceRange.baseMipLevel   = 0;
+                barrier.subresourceRange.levelCount     = imageInfo->meta.mipLevels;
+                barrier.subresourceRange.baseArrayLayer = 0;
+                barrier.subresourceRange.layerCount     = 1;
+
+                vkCmdPipelineBarrier (commandBuffer,
+                                      sourceStage,
+                                      destinationStage,
+                                      0,
+                                      0, VK_NULL_HANDLE,
+                                      0, VK_NULL_HANDLE,
+                                      1, &barrier);
+            }
+
             void beginRenderPass (uint32_t deviceInfoId,
                                   uint32_t renderPassInfoId,
                                   uint32_t swapChainImageId,
-                                  const std::vector <VkClearValue>& clearValues,
+                                  std::span <const VkClearValue> clearValues,
                                   VkCommandBuffer commandBuffer) {
                 
                 auto deviceInfo     = getDeviceInfo     (deviceInfoId);
@@ -434,20 +635,20 @@ namespace Core {
                                     offset, size, data);
             }
 
-            void bindVertexBuffers (const std::vector <uint32_t>& bufferInfoIds,
+            void bindVertexBuffers (std::span <const uint32_t> bufferInfoIds,
                                     uint32_t firstBinding,
-                                    const std::vector <VkDeviceSize>& offsets,
+                                    std::span <const VkDeviceSize> offsets,
                                     VkCommandBuffer commandBuffer) {
                 
-                std::vector <VkBuffer> vertexBuffers;
+                auto vertexBuffers = allocateFromFrameArena <VkBuffer> (bufferInfoIds.size());
                 /* The vkCmdBindVertexBuffers function is used to bind vertex buffers to bindings. The first two 
                  * parameters, besides the command buffer, specify the offset and number of bindings we're going to 
                  * specify vertex buffers for. The last two parameters specify the array of vertex buffers to bind and 
                  * the byte offsets to start reading vertex data from
                 */
-                for (auto const& infoId: bufferInfoIds) {
-                    auto bufferInfo = getBufferInfo (infoId, VERTEX_BUFFER);
-                    vertexBuffers.push_back (bufferInfo->resource.buffer);
+                for (size_t i = 0; i < bufferInfoIds.size(); i++) {
+                    auto bufferInfo  = getBufferInfo (bufferInfoIds[i], VERTEX_BUFFER);
+                    vertexBuffers[i] = bufferInfo->resource.buffer;
                 }
 
                 vkCmdBindVertexBuffers (commandBuffer, 
@@ -477,8 +678,8 @@ namespace Core {
             void bindDescriptorSets (uint32_t pipelineInfoId,
                                      VkPipelineBindPoint bindPoint,
                                      uint32_t firstSet,
-                                     const std::vector <VkDescriptorSet>& descriptorSets,
-                                     const std::vector <uint32_t>& dynamicOffsets,
+                                     std::span <const VkDescriptorSet> descriptorSets,
+                                     std::span <const uint32_t> dynamicOffsets,
                                      VkCommandBuffer commandBuffer) {
                 
                 auto pipelineInfo = getPipelineInfo (pipelineInfoId);
@@ -0,0 +1,111 @@
+#ifndef VK_QUERY_POOL_H
+#define VK_QUERY_POOL_H
+
+#include "../Device/VKDeviceMgr.h"
+
+namespace Core {
+    class VKQueryPool: protected virtual VKDeviceMgr {
+        private:
+            Log::Record* m_VKQueryPoolLog;
+            const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
+
+        public:
+            VKQueryPool (void) {
+                m_VKQueryPoolLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
+                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+            }
+
+            ~VKQueryPool (void) {
+                LOG_CLOSE (m_instanceId);
+            }
+
+        protected:
+            /* Queries provide a mechanism to return information about the processing of a sequence of Vulkan commands.
+             * Query operations are asynchronous, and as such, their results are not returned immediately. Instead, their
+             * results, and their availability status are stored in a query pool
+             *
+             * A timestamp query writes the current device time to the query slot once all previous commands have
+             * completed executing as far as the specified pipeline stage. The difference between two timestamps
+             * multiplied by the timestamp period gives the time in nanoseconds the device spent between them
+            */
+            VkQueryPool getQueryPool (uint32_t deviceInfoId, VkQueryType queryType, uint32_t queryCount) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                if (queryType == VK_QUERY_TYPE_TIMESTAMP && deviceInfo->params.timestampPeriod == 0.0f) {
+                    LOG_WARNING (m_VKQueryPoolLog) << "Timestamp queries are not supported "
+                                                   << "[" << deviceInfoId << "]"
+                                                   << std::endl;
+                }
+
+                VkQueryPoolCreateInfo createInfo;
+                createInfo.sType              = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+                createInfo.pNext              = VK_NULL_HANDLE;
+                createInfo.flags              = 0;
+                createInfo.queryType          = queryType;
+                createInfo.queryCount         = queryCount;
+                /* Pipeline statistics is ignored for all query types other than VK_QUERY_TYPE_PIPELINE_STATISTICS
+                */
+                createInfo.pipelineStatistics = 0;
+
+                VkQueryPool queryPool;
+                VkResult result = vkCreateQueryPool (deviceInfo->resource.logDevice,
+                                                     &createInfo,
+                                                     VK_NULL_HANDLE,
+                                                     &queryPool);
+                if (result != VK_SUCCESS) {
+                    LOG_ERROR (m_VKQueryPoolLog) << "Failed to create query pool "
+                                                 << "[" << string_VkResult (result) << "]"
+                                                 << std::endl;
+                    throw std::runtime_error ("Failed to create query pool");
+                }
+                return queryPool;
+            }
+
+            /* Queries must be reset before they are written to, note that the reset is recorded in to the command buffer
+             * and has to be outside of a render pass instance
+            */
+            void resetQueryPool (VkQueryPool queryPool,
+                                 uint32_t firstQuery,
+                                 uint32_t queryCount,
+                                 VkCommandBuffer commandBuffer) {
+
+                vkCmdResetQueryPool (commandBuffer, queryPool, firstQuery, queryCount);
+            }
+
+            void writeTimestamp (VkQueryPool queryPool,
+                                 uint32_t query,
+                                 VkPipelineStageFlagBits stage,
+                                 VkCommandBuffer commandBuffer) {
+
+                vkCmdWriteTimestamp (commandBuffer, stage, queryPool, query);
+            }
+
+            /* Returns the time in milliseconds between a pair of timestamp queries. Note that, we don't ask the driver to
+             * wait for the results, since the caller is expected to have waited on the fence of the submission that wrote
+             * them. If the results are not yet available for some reason, a negative value is returned instead
+            */
+            float getTimestampDiffMs (uint32_t deviceInfoId, VkQueryPool queryPool, uint32_t firstQuery) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                uint64_t timestamps[2];
+
+                VkResult result = vkGetQueryPoolResults (deviceInfo->resource.logDevice,
+                                                         queryPool,
+                                                         firstQuery,
+                                                         2,
+                                                         sizeof (timestamps),
+                                                         timestamps,
+                                                         sizeof (uint64_t),
+                                                         VK_QUERY_RESULT_64_BIT);
+                if (result != VK_SUCCESS || timestamps[1] < timestamps[0])
+                    return -1.0f;
+
+                return static_cast <float> (timestamps[1] - timestamps[0]) * deviceInfo->params.timestampPeriod / 1e6f;
+            }
+
+            void cleanUp (uint32_t deviceInfoId, VkQueryPool queryPool) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                vkDestroyQueryPool (deviceInfo->resource.logDevice, queryPool, VK_NULL_HANDLE);
+            }
+    };
+}   // namespace Core
+#endif  // VK_QUERY_POOL_H
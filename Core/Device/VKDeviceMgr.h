@@ -4,6 +4,7 @@
 #include <vulkan/vk_enum_string_helper.h>
 #include "../VKConfig.h"
 #include "../../Collections/Log/Log.h"
+#include "../../Collections/SlotMap/SlotMap.h"
 
 using namespace Collections;
 
@@ -65,13 +66,29 @@ namespace Core {
                     uint32_t maxStorageBufferRange;
                     uint32_t maxPushConstantsSize;
                     uint32_t maxMemoryAllocationCount;
+                    /* The maximum number of sampled images (and samplers) that can be in update after bind descriptor 
+                     * sets, this limits the size of the texture table
+                    */
+                    uint32_t maxUpdateAfterBindSampledImages;
+                    /* The granularity in bytes at which buffer or linear image resources, and optimal image resources can
+                     * be bound to adjacent offsets in the same memory object without aliasing
+                    */
+                    VkDeviceSize bufferImageGranularity;
+                    /* Optimal alignment of the buffer offset when copying to/from an image, staging uploads are packed
+                     * using this alignment
+                    */
+                    VkDeviceSize optimalBufferCopyOffsetAlignment;
                     /* maxAnisotropy is the anisotropy value clamp used by the sampler, it limits the amount of texel 
                      * samples that can be used to calculate the final color
                     */
                     float maxSamplerAnisotropy;
+                    /* The number of nanoseconds required for a timestamp query to be incremented by 1, this is used to
+                     * convert the difference between two timestamp query results to time
+                    */
+                    float timestampPeriod;
                 } params;
             };
-            std::unordered_map <uint32_t, DeviceInfo> m_deviceInfoPool;
+            SlotMap <DeviceInfo> m_deviceInfoPool;
 
             /* List of required device extensions
             */
@@ -79,10 +96,12 @@ namespace Core {
 #if __APPLE__
                 "VK_KHR_portability_subset",
 #endif  // __APPLE__
+#if !ENABLE_HEADLESS_MODE
                 /* Extensions for enabling swap chain, since image presentation is heavily tied into the window 
                  * system and the surfaces associated with windows, it is not actually part of the Vulkan core
                 */
                 VK_KHR_SWAPCHAIN_EXTENSION_NAME,
+#endif  // ENABLE_HEADLESS_MODE
                 /* Extensions to enable descriptor indexing and bindless (run time) descriptor arrays. With 
                  * bindless, the shader author does not need to know the upper limit of the array, and from the 
                  * application side the implementer only needs to be sure they do not cause the shader to index 
@@ -95,15 +114,20 @@ namespace Core {
                  * (4) Run time descriptor array    [shader side]
                 */
                 VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME,
-                VK_KHR_MAINTENANCE_3_EXTENSION_NAME
+                VK_KHR_MAINTENANCE_3_EXTENSION_NAME,
+                /* Extensions to query whether a resource prefers (or requires) a memory object of its own, and to tell 
+                 * the implementation which resource a dedicated memory object is for, so that it can lay out the 
+                 * memory for that resource alone (see VKMemoryAllocator)
+                */
+                VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME,
+                VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME
             }; 
             
             Log::Record* m_VKDeviceMgrLog;
             const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
 
             void deleteDeviceInfo (uint32_t deviceInfoId) {
-                if (m_deviceInfoPool.find (deviceInfoId) != m_deviceInfoPool.end()) {
-                    m_deviceInfoPool.erase (deviceInfoId);
+                if (m_deviceInfoPool.erase (deviceInfoId)) {
                     return;
                 }
 
@@ -116,8 +140,8 @@ namespace Core {
         public:
             VKDeviceMgr (void) {
                 m_VKDeviceMgrLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_IMMEDIATE);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
             }
 
             ~VKDeviceMgr (void) {
@@ -126,7 +150,7 @@ namespace Core {
 
         protected:
             void readyDeviceInfo (uint32_t deviceInfoId) {
-                if (m_deviceInfoPool.find (deviceInfoId) != m_deviceInfoPool.end()) {
+                if (m_deviceInfoPool.contains (deviceInfoId)) {
                     LOG_ERROR (m_VKDeviceMgrLog) << "Device info id already exists "
                                                  << "[" << deviceInfoId << "]"
                                                  << std::endl;
@@ -134,7 +158,7 @@ namespace Core {
                 }
 
                 DeviceInfo info{};
-                m_deviceInfoPool[deviceInfoId] = info;
+                m_deviceInfoPool.insert (deviceInfoId, info);
             }
 
             const std::vector <const char*>& getDeviceExtensions (void) {
@@ -142,8 +166,9 @@ namespace Core {
             }
 
             DeviceInfo* getDeviceInfo (uint32_t deviceInfoId) {
-                if (m_deviceInfoPool.find (deviceInfoId) != m_deviceInfoPool.end())
-                    return &m_deviceInfoPool[deviceInfoId];
+                auto info = m_deviceInfoPool.find (deviceInfoId);
+                if (info != nullptr)
+                    return info;
                 
                 LOG_ERROR (m_VKDeviceMgrLog) << "Failed to find device info "
                                              << "[" << deviceInfoId << "]"
@@ -209,9 +234,25 @@ namespace Core {
                                                 << "[" << val.params.maxMemoryAllocationCount << "]"
                                                 << std::endl;   
 
+                    LOG_INFO (m_VKDeviceMgrLog) << "Max update after bind sampled images "
+                                                << "[" << val.params.maxUpdateAfterBindSampledImages << "]"
+                                                << std::endl;
+
+                    LOG_INFO (m_VKDeviceMgrLog) << "Buffer image granularity "
+                                                << "[" << val.params.bufferImageGranularity << "]"
+                                                << std::endl;
+
+                    LOG_INFO (m_VKDeviceMgrLog) << "Optimal buffer copy offset alignment "
+                                                << "[" << val.params.optimalBufferCopyOffsetAlignment << "]"
+                                                << std::endl;
+
                     LOG_INFO (m_VKDeviceMgrLog) << "Max sampler anisotropy "
                                                 << "[" << val.params.maxSamplerAnisotropy << "]"
                                                 << std::endl;
+
+                    LOG_INFO (m_VKDeviceMgrLog) << "Timestamp period "
+                                                << "[" << val.params.timestampPeriod << "]"
+                                                << std::endl;
                 }
             }
 
@@ -11,6 +11,7 @@ namespace Core {
 
             std::vector <const char*> getInstanceExtensions (void) {
                 std::vector <const char*> instanceExtensions;
+#if !ENABLE_HEADLESS_MODE
                 /* Since Vulkan is a platform agnostic API, it can not interface directly with the window system on its 
                  * own. To establish the connection between Vulkan and the window system to present results to the 
                  * screen, we need to use the WSI (Window System Integration) extensions (ex: VK_KHR_surface) (included 
@@ -21,6 +22,7 @@ namespace Core {
 
                 for (uint32_t i = 0; i < glfwExtensionCount; i++)
                     instanceExtensions.emplace_back (glfwExtensions[i]);
+#endif  // ENABLE_HEADLESS_MODE
 
 #if __APPLE__
                 /* If using MacOS with the latest MoltenVK sdk, you may get VK_ERROR_INCOMPATIBLE_DRIVER (-9) returned 
@@ -80,9 +82,9 @@ namespace Core {
         public:
             VKInstance (void) {
                 m_VKInstanceLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO,    Log::TO_FILE_IMMEDIATE);
-                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,    Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_SHARED | Log::TO_CONSOLE);
             }
 
             ~VKInstance (void) { 
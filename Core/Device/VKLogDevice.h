@@ -14,8 +14,8 @@ namespace Core {
         public:
             VKLogDevice (void) {
                 m_VKLogDeviceLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);              
+                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_SHARED | Log::TO_CONSOLE);              
             }
 
             ~VKLogDevice (void) {
@@ -129,8 +129,18 @@ namespace Core {
                 /* Enable only the following descriptor indexing features, note that we have queried for their support 
                  * already while selecting the phy device
                  * (1) runtimeDescriptorArray
+                 * (2) shaderSampledImageArrayNonUniformIndexing
+                 * (3) descriptorBindingSampledImageUpdateAfterBind
+                 * (4) descriptorBindingUpdateUnusedWhilePending
+                 * (5) descriptorBindingPartiallyBound
+                 * (6) descriptorBindingVariableDescriptorCount
                 */
-                descriptorIndexingFeatures.runtimeDescriptorArray = VK_TRUE;
+                descriptorIndexingFeatures.runtimeDescriptorArray                       = VK_TRUE;
+                descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing    = VK_TRUE;
+                descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+                descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending    = VK_TRUE;
+                descriptorIndexingFeatures.descriptorBindingPartiallyBound              = VK_TRUE;
+                descriptorIndexingFeatures.descriptorBindingVariableDescriptorCount     = VK_TRUE;
 
                 auto requiredFeatures2 = getPhyDeviceFeatures2 (deviceInfo->resource.phyDevice,
                                                                 &requiredFeatures,
@@ -0,0 +1,539 @@
+#ifndef VK_MEMORY_ALLOCATOR_H
+#define VK_MEMORY_ALLOCATOR_H
+
+#include <set>
+#include "VKPhyDevice.h"
+
+namespace Core {
+    /* The maximum number of simultaneous memory allocations is limited by the maxMemoryAllocationCount physical device
+     * limit, which may be as low as 4096 even on high end hardware. Instead of calling vkAllocateMemory for every
+     * resource, we allocate large blocks of device memory per memory type and split them up among many resources by
+     * using the offset parameter in vkBindBufferMemory/vkBindImageMemory
+     *
+     * Each block is managed by a buddy allocator. The block is recursively split into halves (buddies) until we reach
+     * the smallest node that fits the request, and on free, a node is merged with its buddy whenever the buddy is free
+     * as well. Since block and node sizes are powers of two, every node offset is aligned to its own size, which takes
+     * care of the alignment requirement of the resource by simply picking a node that is at least as large as it
+    */
+    class VKMemoryAllocator: protected virtual VKPhyDevice {
+        private:
+            struct MemoryBlockInfo {
+                uint32_t id;
+                /* Linear resources (buffers, linear tiling images) and non linear resources (optimal tiling images)
+                 * bound to the same memory object must be placed bufferImageGranularity bytes apart, so that they
+                 * don't share a "page". If the granularity is larger than the smallest node, we simply don't mix them
+                 * within a block
+                */
+                bool linear;
+                VkDeviceMemory memory;
+                /* Host visible blocks are mapped once on creation and stay mapped until the block is freed (persistent
+                 * mapping), allocations from the block get a pointer at their offset into it
+                */
+                void* mapped;
+                VkDeviceSize usedSize;
+                uint32_t allocationsCount;
+                /* Offsets of free nodes indexed by order, where a node of order n is (min allocation size << n) bytes
+                 * in size
+                */
+                std::vector <std::set <VkDeviceSize>> freeNodes;
+            };
+            std::unordered_map <uint32_t, std::vector <MemoryBlockInfo>> m_memoryBlockInfoPool;
+
+            struct MemoryAllocationInfo {
+                struct Meta {
+                    uint32_t id;
+                    uint32_t blockId;
+                    uint32_t order;
+                    /* Dedicated allocations own their memory object instead of being sub allocated from a block
+                    */
+                    bool dedicated;
+                    void* mapped;
+                } meta;
+
+                struct Resource {
+                    VkDeviceMemory memory;
+                } resource;
+
+                struct Parameters {
+                    VkDeviceSize offset;
+                    VkDeviceSize size;
+                    uint32_t memoryTypeIndex;
+                } params;
+            };
+            SlotMap <MemoryAllocationInfo> m_memoryAllocationInfoPool;
+            /* Ids of deleted allocations are handed out again before new ones, so that the ids stay small
+            */
+            std::vector <uint32_t> m_freeMemoryAllocationInfoIds;
+            uint32_t m_nextMemoryAllocationInfoId;
+            uint32_t m_nextMemoryBlockInfoId;
+
+            Log::Record* m_VKMemoryAllocatorLog;
+            const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
+
+            uint32_t getMaxOrder (void) {
+                uint32_t maxOrder = 0;
+                while ((g_memoryAllocatorSettings.minAllocationSize << maxOrder) < g_memoryAllocatorSettings.blockSize)
+                    maxOrder++;
+                return maxOrder;
+            }
+
+            uint32_t getOrder (VkDeviceSize size) {
+                uint32_t order = 0;
+                while ((g_memoryAllocatorSettings.minAllocationSize << order) < size)
+                    order++;
+                return order;
+            }
+
+            VkMemoryPropertyFlags getMemoryTypeProperties (uint32_t deviceInfoId, uint32_t memoryTypeIndex) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                VkPhysicalDeviceMemoryProperties memProperties;
+                vkGetPhysicalDeviceMemoryProperties (deviceInfo->resource.phyDevice, &memProperties);
+
+                return memProperties.memoryTypes[memoryTypeIndex].propertyFlags;
+            }
+
+            /* Allocate a memory object and map it if it is host visible, this is used for both blocks and dedicated
+             * allocations. Returns VK_NULL_HANDLE if the allocation failed, so that the caller can decide how to proceed
+             *
+             * Dedicated allocations pass in the buffer or the image that the memory object is for (the other one is 
+             * VK_NULL_HANDLE), which is chained to the allocate info
+            */
+            VkDeviceMemory getMemory (uint32_t deviceInfoId,
+                                      VkDeviceSize size,
+                                      uint32_t memoryTypeIndex,
+                                      VkBuffer buffer,
+                                      VkImage image,
+                                      void** mapped) {
+
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                VkMemoryDedicatedAllocateInfoKHR dedicatedAllocInfo;
+                dedicatedAllocInfo.sType  = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO_KHR;
+                dedicatedAllocInfo.pNext  = VK_NULL_HANDLE;
+                dedicatedAllocInfo.buffer = buffer;
+                dedicatedAllocInfo.image  = image;
+
+                bool isDedicated = buffer != VK_NULL_HANDLE || image != VK_NULL_HANDLE;
+                VkMemoryAllocateInfo allocInfo;
+                allocInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+                allocInfo.pNext           = isDedicated ? &dedicatedAllocInfo: VK_NULL_HANDLE;
+                allocInfo.allocationSize  = size;
+                allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+                VkDeviceMemory memory;
+                VkResult result = vkAllocateMemory (deviceInfo->resource.logDevice, &allocInfo, VK_NULL_HANDLE, &memory);
+                if (result != VK_SUCCESS)
+                    return VK_NULL_HANDLE;
+                deviceInfo->meta.memoryAllocationCount++;
+
+                *mapped = VK_NULL_HANDLE;
+                if (getMemoryTypeProperties (deviceInfoId, memoryTypeIndex) & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+                    result = vkMapMemory (deviceInfo->resource.logDevice, memory, 0, VK_WHOLE_SIZE, 0, mapped);
+                    if (result != VK_SUCCESS) {
+                        LOG_ERROR (m_VKMemoryAllocatorLog) << "Failed to map memory "
+                                                           << "[" << memoryTypeIndex << "]"
+                                                           << " "
+                                                           << "[" << string_VkResult (result) << "]"
+                                                           << std::endl;
+                        throw std::runtime_error ("Failed to map memory");
+                    }
+                }
+                return memory;
+            }
+
+            void freeMemory (uint32_t deviceInfoId, VkDeviceMemory memory, void* mapped) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                if (mapped != VK_NULL_HANDLE)
+                    vkUnmapMemory (deviceInfo->resource.logDevice, memory);
+
+                vkFreeMemory (deviceInfo->resource.logDevice, memory, VK_NULL_HANDLE);
+                deviceInfo->meta.memoryAllocationCount--;
+            }
+
+            /* Find the smallest free node of at least the requested order, split it down to the requested order and
+             * push the unused halves in to the free lists. Returns false if the block has no node large enough
+            */
+            bool getNode (MemoryBlockInfo* blockInfo, uint32_t order, VkDeviceSize& offset) {
+                uint32_t nodeOrder = order;
+                while (nodeOrder < blockInfo->freeNodes.size() && blockInfo->freeNodes[nodeOrder].empty())
+                    nodeOrder++;
+                if (nodeOrder == blockInfo->freeNodes.size())
+                    return false;
+
+                offset = *blockInfo->freeNodes[nodeOrder].begin();
+                blockInfo->freeNodes[nodeOrder].erase (blockInfo->freeNodes[nodeOrder].begin());
+
+                while (nodeOrder > order) {
+                    nodeOrder--;
+                    blockInfo->freeNodes[nodeOrder].insert (offset + (g_memoryAllocatorSettings.minAllocationSize <<
+                                                                      nodeOrder));
+                }
+                return true;
+            }
+
+            /* The buddy of a node is found by flipping the bit corresponding to the node size in its offset, keep merging
+             * with the buddy for as long as it is free
+            */
+            void freeNode (MemoryBlockInfo* blockInfo, uint32_t order, VkDeviceSize offset) {
+                while (order + 1 < blockInfo->freeNodes.size()) {
+                    VkDeviceSize buddyOffset = offset ^ (g_memoryAllocatorSettings.minAllocationSize << order);
+                    if (blockInfo->freeNodes[order].erase (buddyOffset) == 0)
+                        break;
+
+                    offset = std::min (offset, buddyOffset);
+                    order++;
+                }
+                blockInfo->freeNodes[order].insert (offset);
+            }
+
+            MemoryBlockInfo* getMemoryBlockInfo (uint32_t memoryTypeIndex, uint32_t blockId) {
+                if (m_memoryBlockInfoPool.find (memoryTypeIndex) != m_memoryBlockInfoPool.end()) {
+                    for (auto& info: m_memoryBlockInfoPool[memoryTypeIndex]) {
+                        if (info.id == blockId) return &info;
+                    }
+                }
+
+                LOG_ERROR (m_VKMemoryAllocatorLog) << "Failed to find memory block info "
+                                                   << "[" << blockId << "]"
+                                                   << " "
+                                                   << "[" << memoryTypeIndex << "]"
+                                                   << std::endl;
+                throw std::runtime_error ("Failed to find memory block info");
+            }
+
+            void deleteMemoryBlockInfo (uint32_t memoryTypeIndex, uint32_t blockId) {
+                if (m_memoryBlockInfoPool.find (memoryTypeIndex) != m_memoryBlockInfoPool.end()) {
+                    auto& infos = m_memoryBlockInfoPool[memoryTypeIndex];
+
+                    infos.erase (std::remove_if (infos.begin(), infos.end(), [&](const MemoryBlockInfo& info) {
+                        return info.id == blockId;
+                    }), infos.end());
+                    return;
+                }
+
+                LOG_ERROR (m_VKMemoryAllocatorLog) << "Failed to delete memory block info "
+                                                   << "[" << blockId << "]"
+                                                   << " "
+                                                   << "[" << memoryTypeIndex << "]"
+                                                   << std::endl;
+                throw std::runtime_error ("Failed to delete memory block info");
+            }
+
+            void deleteMemoryAllocationInfo (uint32_t memoryAllocationInfoId) {
+                if (m_memoryAllocationInfoPool.erase (memoryAllocationInfoId)) {
+                    m_freeMemoryAllocationInfoIds.push_back (memoryAllocationInfoId);
+                    return;
+                }
+
+                LOG_ERROR (m_VKMemoryAllocatorLog) << "Failed to delete memory allocation info "
+                                                   << "[" << memoryAllocationInfoId << "]"
+                                                   << std::endl;
+                throw std::runtime_error ("Failed to delete memory allocation info");
+            }
+
+        public:
+            VKMemoryAllocator (void) {
+                m_VKMemoryAllocatorLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+
+                m_nextMemoryAllocationInfoId = 0;
+                m_nextMemoryBlockInfoId      = 0;
+            }
+
+            ~VKMemoryAllocator (void) {
+                LOG_CLOSE (m_instanceId);
+            }
+
+
+        protected:
+            /* Query the memory requirements of a buffer or an image (the other one is VK_NULL_HANDLE), along with
+             * whether the implementation prefers (or requires) the resource to be given a memory object of its own. Since
+             * the instance is created with API version 1.0, the query functions of VK_KHR_get_memory_requirements2 need
+             * to be loaded using vkGetDeviceProcAddr
+            */
+            VkMemoryRequirements getMemoryRequirements (uint32_t deviceInfoId,
+                                                        VkBuffer buffer,
+                                                        VkImage image,
+                                                        bool& prefersDedicated) {
+
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                VkMemoryDedicatedRequirementsKHR dedicatedRequirements;
+                dedicatedRequirements.sType                       = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS_KHR;
+                dedicatedRequirements.pNext                       = VK_NULL_HANDLE;
+                dedicatedRequirements.prefersDedicatedAllocation  = VK_FALSE;
+                dedicatedRequirements.requiresDedicatedAllocation = VK_FALSE;
+
+                VkMemoryRequirements2KHR memRequirements;
+                memRequirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2_KHR;
+                memRequirements.pNext = &dedicatedRequirements;
+
+                if (buffer != VK_NULL_HANDLE) {
+                    auto func = (PFN_vkGetBufferMemoryRequirements2KHR) vkGetDeviceProcAddr (
+                                                                        deviceInfo->resource.logDevice,
+                                                                        "vkGetBufferMemoryRequirements2KHR");
+                    if (func == VK_NULL_HANDLE) {
+                        LOG_ERROR (m_VKMemoryAllocatorLog) << "Failed to load function "
+                                                           << "[" << "vkGetBufferMemoryRequirements2KHR" << "]"
+                                                           << std::endl;
+                        throw std::runtime_error ("Failed to load function");
+                    }
+                    VkBufferMemoryRequirementsInfo2KHR requirementsInfo;
+                    requirementsInfo.sType  = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2_KHR;
+                    requirementsInfo.pNext  = VK_NULL_HANDLE;
+                    requirementsInfo.buffer = buffer;
+                    func (deviceInfo->resource.logDevice, &requirementsInfo, &memRequirements);
+                }
+                else {
+                    auto func = (PFN_vkGetImageMemoryRequirements2KHR) vkGetDeviceProcAddr (
+                                                                       deviceInfo->resource.logDevice,
+                                                                       "vkGetImageMemoryRequirements2KHR");
+                    if (func == VK_NULL_HANDLE) {
+                        LOG_ERROR (m_VKMemoryAllocatorLog) << "Failed to load function "
+                                                           << "[" << "vkGetImageMemoryRequirements2KHR" << "]"
+                                                           << std::endl;
+                        throw std::runtime_error ("Failed to load function");
+                    }
+                    VkImageMemoryRequirementsInfo2KHR requirementsInfo;
+                    requirementsInfo.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2_KHR;
+                    requirementsInfo.pNext = VK_NULL_HANDLE;
+                    requirementsInfo.image = image;
+                    func (deviceInfo->resource.logDevice, &requirementsInfo, &memRequirements);
+                }
+
+                prefersDedicated = dedicatedRequirements.prefersDedicatedAllocation  == VK_TRUE ||
+                                   dedicatedRequirements.requiresDedicatedAllocation == VK_TRUE;
+                return memRequirements.memoryRequirements;
+            }
+
+            /* Returns the id of a memory allocation that satisfies the memory requirements of a resource. Requests that
+             * are at least as large as the dedicated allocation size (large images, render targets etc.) get a memory
+             * object of their own since they would otherwise take up most of a block, everything else is sub allocated
+             * from a block of the matching memory type. Lazily allocated memory is always dedicated, since the backing
+             * store is committed per memory object and only as the implementation needs it. So are the resources that
+             * the implementation prefers to have a memory object of their own (see getMemoryRequirements)
+             *
+             * The buffer or the image (the other one is VK_NULL_HANDLE) that the allocation is for is handed to the
+             * implementation along with a dedicated allocation, which lets it apply optimizations that only hold for a
+             * memory object that is bound to a single resource
+            */
+            uint32_t createMemoryAllocation (uint32_t deviceInfoId,
+                                             const VkMemoryRequirements& memRequirements,
+                                             VkMemoryPropertyFlags property,
+                                             bool linear,
+                                             bool prefersDedicated,
+                                             VkBuffer buffer,
+                                             VkImage image) {
+
+                auto deviceInfo            = getDeviceInfo (deviceInfoId);
+                uint32_t memoryTypeIndex   = getMemoryTypeIndex (deviceInfoId, memRequirements.memoryTypeBits, property);
+                VkDeviceSize nodeSize      = std::max (memRequirements.size, memRequirements.alignment);
+                bool isGranularityConflict = deviceInfo->params.bufferImageGranularity >
+                                             g_memoryAllocatorSettings.minAllocationSize;
+
+                MemoryAllocationInfo info{};
+                if (m_freeMemoryAllocationInfoIds.empty())
+                    info.meta.id = m_nextMemoryAllocationInfoId++;
+                else {
+                    info.meta.id = m_freeMemoryAllocationInfoIds.back();
+                    m_freeMemoryAllocationInfoIds.pop_back();
+                }
+                info.params.size            = memRequirements.size;
+                info.params.memoryTypeIndex = memoryTypeIndex;
+
+                MemoryBlockInfo* allocatedBlockInfo = VK_NULL_HANDLE;
+                if ((property & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) == 0 && !prefersDedicated &&
+                    nodeSize < g_memoryAllocatorSettings.dedicatedAllocationSize) {
+                    uint32_t order = getOrder (nodeSize);
+                    for (auto& blockInfo: m_memoryBlockInfoPool[memoryTypeIndex]) {
+                        if (isGranularityConflict && blockInfo.linear != linear)
+                            continue;
+
+                        if (getNode (&blockInfo, order, info.params.offset)) {
+                            allocatedBlockInfo = &blockInfo;
+                            break;
+                        }
+                    }
+                    /* None of the existing blocks could fit the request, so allocate a new one. If the heap is unable
+                     * to fit a whole block, we will fall back to a dedicated allocation below
+                    */
+                    if (allocatedBlockInfo == VK_NULL_HANDLE) {
+                        void* mapped;
+                        VkDeviceMemory memory = getMemory (deviceInfoId,
+                                                           g_memoryAllocatorSettings.blockSize,
+                                                           memoryTypeIndex,
+                                                           VK_NULL_HANDLE,
+                                                           VK_NULL_HANDLE,
+                                                           &mapped);
+                        if (memory != VK_NULL_HANDLE) {
+                            MemoryBlockInfo blockInfo{};
+                            blockInfo.id               = m_nextMemoryBlockInfoId++;
+                            blockInfo.linear           = linear;
+                            blockInfo.memory           = memory;
+                            blockInfo.mapped           = mapped;
+                            blockInfo.usedSize         = 0;
+                            blockInfo.allocationsCount = 0;
+                            blockInfo.freeNodes.resize (getMaxOrder() + 1);
+                            blockInfo.freeNodes[getMaxOrder()].insert (0);
+
+                            m_memoryBlockInfoPool[memoryTypeIndex].push_back (blockInfo);
+                            allocatedBlockInfo = &m_memoryBlockInfoPool[memoryTypeIndex].back();
+                            getNode (allocatedBlockInfo, order, info.params.offset);
+                        }
+                    }
+
+                    if (allocatedBlockInfo != VK_NULL_HANDLE) {
+                        allocatedBlockInfo->usedSize += g_memoryAllocatorSettings.minAllocationSize << order;
+                        allocatedBlockInfo->allocationsCount++;
+
+                        info.meta.blockId    = allocatedBlockInfo->id;
+                        info.meta.order      = order;
+                        info.meta.dedicated  = false;
+                        info.meta.mapped     = allocatedBlockInfo->mapped == VK_NULL_HANDLE ? VK_NULL_HANDLE:
+                                               static_cast <uint8_t*> (allocatedBlockInfo->mapped) + info.params.offset;
+                        info.resource.memory = allocatedBlockInfo->memory;
+                    }
+                }
+
+                if (allocatedBlockInfo == VK_NULL_HANDLE) {
+                    info.resource.memory = getMemory (deviceInfoId,
+                                                      memRequirements.size,
+                                                      memoryTypeIndex,
+                                                      buffer,
+                                                      image,
+                                                      &info.meta.mapped);
+                    if (info.resource.memory == VK_NULL_HANDLE) {
+                        LOG_ERROR (m_VKMemoryAllocatorLog) << "Failed to allocate memory "
+                                                           << "[" << memRequirements.size << "]"
+                                                           << " "
+                                                           << "[" << memoryTypeIndex << "]"
+                                                           << std::endl;
+                        throw std::runtime_error ("Failed to allocate memory");
+                    }
+                    info.meta.dedicated = true;
+                    info.params.offset  = 0;
+                }
+
+                m_memoryAllocationInfoPool.insert (info.meta.id, info);
+                return info.meta.id;
+            }
+
+            MemoryAllocationInfo* getMemoryAllocationInfo (uint32_t memoryAllocationInfoId) {
+                auto info = m_memoryAllocationInfoPool.find (memoryAllocationInfoId);
+                if (info != nullptr)
+                    return info;
+
+                LOG_ERROR (m_VKMemoryAllocatorLog) << "Failed to find memory allocation info "
+                                                   << "[" << memoryAllocationInfoId << "]"
+                                                   << std::endl;
+                throw std::runtime_error ("Failed to find memory allocation info");
+            }
+
+            /* Returns the number of bytes actually backed by physical memory, for memory types that don't have the lazily
+             * allocated property this is simply the size of the allocation
+            */
+            VkDeviceSize getMemoryCommitment (uint32_t deviceInfoId, uint32_t memoryAllocationInfoId) {
+                auto deviceInfo           = getDeviceInfo (deviceInfoId);
+                auto memoryAllocationInfo = getMemoryAllocationInfo (memoryAllocationInfoId);
+                auto memProperties        = getMemoryTypeProperties (deviceInfoId,
+                                                                     memoryAllocationInfo->params.memoryTypeIndex);
+
+                if ((memProperties & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) == 0)
+                    return memoryAllocationInfo->params.size;
+
+                VkDeviceSize committedSize;
+                vkGetDeviceMemoryCommitment (deviceInfo->resource.logDevice,
+                                             memoryAllocationInfo->resource.memory,
+                                             &committedSize);
+                return committedSize;
+            }
+
+            void dumpMemoryAllocatorStats (void) {
+                LOG_INFO (m_VKMemoryAllocatorLog) << "Dumping memory allocator stats"
+                                                  << std::endl;
+
+                for (auto const& [key, val]: m_memoryBlockInfoPool) {
+                    LOG_INFO (m_VKMemoryAllocatorLog) << "Memory type index "
+                                                      << "[" << key << "]"
+                                                      << std::endl;
+
+                    for (auto const& info: val) {
+                        VkDeviceSize largestFreeNodeSize = 0;
+                        for (uint32_t i = 0; i < info.freeNodes.size(); i++) {
+                            if (!info.freeNodes[i].empty())
+                                largestFreeNodeSize = g_memoryAllocatorSettings.minAllocationSize << i;
+                        }
+
+                        LOG_INFO (m_VKMemoryAllocatorLog) << "Block id "
+                                                          << "[" << info.id << "]"
+                                                          << std::endl;
+
+                        LOG_INFO (m_VKMemoryAllocatorLog) << "Linear "
+                                                          << "[" << (info.linear ? "TRUE": "FALSE") << "]"
+                                                          << std::endl;
+
+                        LOG_INFO (m_VKMemoryAllocatorLog) << "Mapped "
+                                                          << "[" << (info.mapped != VK_NULL_HANDLE ? "TRUE": "FALSE")
+                                                          << "]"
+                                                          << std::endl;
+
+                        LOG_INFO (m_VKMemoryAllocatorLog) << "Used size "
+                                                          << "[" << info.usedSize << "]"
+                                                          << "->"
+                                                          << "[" << g_memoryAllocatorSettings.blockSize << "]"
+                                                          << std::endl;
+
+                        LOG_INFO (m_VKMemoryAllocatorLog) << "Allocations count "
+                                                          << "[" << info.allocationsCount << "]"
+                                                          << std::endl;
+
+                        LOG_INFO (m_VKMemoryAllocatorLog) << "Largest free node size "
+                                                          << "[" << largestFreeNodeSize << "]"
+                                                          << std::endl;
+                    }
+                }
+
+                LOG_INFO (m_VKMemoryAllocatorLog) << "Dedicated allocations"
+                                                  << std::endl;
+                for (auto const& [key, val]: m_memoryAllocationInfoPool) {
+                    if (!val.meta.dedicated)
+                        continue;
+
+                    LOG_INFO (m_VKMemoryAllocatorLog) << "Id "
+                                                      << "[" << key << "]"
+                                                      << std::endl;
+
+                    LOG_INFO (m_VKMemoryAllocatorLog) << "Memory type index "
+                                                      << "[" << val.params.memoryTypeIndex << "]"
+                                                      << std::endl;
+
+                    LOG_INFO (m_VKMemoryAllocatorLog) << "Size "
+                                                      << "[" << val.params.size << "]"
+                                                      << std::endl;
+                }
+            }
+
+            /* Return the node to its block, the block itself is freed once it holds no more allocations
+            */
+            void freeMemoryAllocation (uint32_t deviceInfoId, uint32_t memoryAllocationInfoId) {
+                auto memoryAllocationInfo = getMemoryAllocationInfo (memoryAllocationInfoId);
+
+                if (memoryAllocationInfo->meta.dedicated)
+                    freeMemory (deviceInfoId, memoryAllocationInfo->resource.memory, memoryAllocationInfo->meta.mapped);
+                else {
+                    auto blockInfo = getMemoryBlockInfo (memoryAllocationInfo->params.memoryTypeIndex,
+                                                         memoryAllocationInfo->meta.blockId);
+
+                    freeNode (blockInfo, memoryAllocationInfo->meta.order, memoryAllocationInfo->params.offset);
+                    blockInfo->usedSize -= g_memoryAllocatorSettings.minAllocationSize << memoryAllocationInfo->meta.order;
+                    blockInfo->allocationsCount--;
+
+                    if (blockInfo->allocationsCount == 0) {
+                        freeMemory            (deviceInfoId, blockInfo->memory, blockInfo->mapped);
+                        deleteMemoryBlockInfo (memoryAllocationInfo->params.memoryTypeIndex, blockInfo->id);
+                    }
+                }
+                deleteMemoryAllocationInfo (memoryAllocationInfoId);
+            }
+    };
+}   // namespace Core
+#endif  // VK_MEMORY_ALLOCATOR_H
@@ -63,6 +63,11 @@ namespace Core {
                  * does have to be explicitly enabled
                 */
                 bool swapChainAdequate = false;
+#if ENABLE_HEADLESS_MODE
+                /* Swap chain support is not required in headless mode, since we render to offscreen images
+                */
+                swapChainAdequate = true;
+#else
                 if (extensionsSupported) {
                     auto swapChainSupport = getSwapChainSupportDetails (deviceInfoId, phyDevice);
                     /* Swap chain support is sufficient for now if there is at least one supported image format and one 
@@ -70,6 +75,7 @@ namespace Core {
                     */
                     swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
                 }
+#endif  // ENABLE_HEADLESS_MODE
 
                 VkPhysicalDeviceFeatures supportedFeatures;
                 vkGetPhysicalDeviceFeatures (phyDevice, &supportedFeatures);
@@ -86,7 +92,15 @@ namespace Core {
                        /* This indicates whether the implementation supports the SPIR-V run time descriptor array 
                         * capability. If this feature is not enabled, descriptors must not be declared in runtime arrays
                        */
-                       descriptorIndexingFeatures.runtimeDescriptorArray;
+                       descriptorIndexingFeatures.runtimeDescriptorArray                       &&
+                       /* The texture table is indexed with a texture id that varies across instances, and is written
+                        * to while it is bound
+                       */
+                       descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing    &&
+                       descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind &&
+                       descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending    &&
+                       descriptorIndexingFeatures.descriptorBindingPartiallyBound              &&
+                       descriptorIndexingFeatures.descriptorBindingVariableDescriptorCount;
             }
 
             /* The exact maximum number of sample points for MSAA can be extracted from VkPhysicalDeviceProperties 
@@ -116,8 +130,8 @@ namespace Core {
         public:
             VKPhyDevice (void) {
                 m_VKPhyDeviceLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_IMMEDIATE);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
             }
 
             ~VKPhyDevice (void) {
@@ -267,6 +281,22 @@ namespace Core {
                 throw std::runtime_error ("Failed to find suitable memory type");
             }
 
+            /* Unlike the above function, this will not throw if there is no suitable memory type, which lets us pick a
+             * fallback set of properties (ex: lazily allocated memory is usually only offered by tile based renderers)
+            */
+            bool isMemoryTypeSupported (uint32_t deviceInfoId, uint32_t typeFilter, VkMemoryPropertyFlags properties) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                VkPhysicalDeviceMemoryProperties memProperties;
+                vkGetPhysicalDeviceMemoryProperties (deviceInfo->resource.phyDevice, &memProperties);
+
+                for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+                    if ((typeFilter & (1 << i)) &&
+                        (memProperties.memoryTypes[i].propertyFlags & properties) == properties)
+                        return true;
+                }
+                return false;
+            }
+
             VkPhysicalDeviceFeatures2 getPhyDeviceFeatures2 (VkPhysicalDevice phyDevice, 
                                                              const VkPhysicalDeviceFeatures* features,
                                                              void* pNext,
@@ -306,15 +336,32 @@ namespace Core {
 
                 for (auto const& phyDevice: phyDevices) {
                     if (isPhyDeviceSupported (deviceInfoId, phyDevice, deviceExtensions)) {
-                        VkPhysicalDeviceProperties properties;
-                        vkGetPhysicalDeviceProperties (phyDevice, &properties);
-
-                        deviceInfo->resource.phyDevice              = phyDevice;
-                        deviceInfo->params.maxSampleCount           = getMaxUsableSampleCount (deviceInfoId);
-                        deviceInfo->params.maxStorageBufferRange    = properties.limits.maxStorageBufferRange;
-                        deviceInfo->params.maxPushConstantsSize     = properties.limits.maxPushConstantsSize;
-                        deviceInfo->params.maxMemoryAllocationCount = properties.limits.maxMemoryAllocationCount;
-                        deviceInfo->params.maxSamplerAnisotropy     = properties.limits.maxSamplerAnisotropy;
+                        VkPhysicalDeviceDescriptorIndexingProperties descriptorIndexingProperties{};
+                        descriptorIndexingProperties.sType = 
+                                            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+                        descriptorIndexingProperties.pNext = VK_NULL_HANDLE;
+
+                        VkPhysicalDeviceProperties2 properties2{};
+                        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+                        properties2.pNext = &descriptorIndexingProperties;
+                        vkGetPhysicalDeviceProperties2 (phyDevice, &properties2);
+                        auto const& properties = properties2.properties;
+
+                        deviceInfo->resource.phyDevice                      = phyDevice;
+                        deviceInfo->params.maxSampleCount                   = getMaxUsableSampleCount (deviceInfoId);
+                        deviceInfo->params.maxStorageBufferRange            = properties.limits.maxStorageBufferRange;
+                        deviceInfo->params.maxPushConstantsSize             = properties.limits.maxPushConstantsSize;
+                        deviceInfo->params.maxMemoryAllocationCount         = properties.limits.maxMemoryAllocationCount;
+                        deviceInfo->params.maxUpdateAfterBindSampledImages  = std::min ({
+                            descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindSampledImages,
+                            descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindSamplers,
+                            descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                            descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers
+                        });
+                        deviceInfo->params.bufferImageGranularity           = properties.limits.bufferImageGranularity;
+                        deviceInfo->params.optimalBufferCopyOffsetAlignment = properties.limits.optimalBufferCopyOffsetAlignment;
+                        deviceInfo->params.maxSamplerAnisotropy             = properties.limits.maxSamplerAnisotropy;
+                        deviceInfo->params.timestampPeriod                  = properties.limits.timestampPeriod;
                         break;
                     }
                 }
@@ -21,7 +21,7 @@ namespace Core {
         public:
             VKQueue (void) {
                 m_VKQueueLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO, Log::TO_FILE_IMMEDIATE);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO, Log::TO_FILE_SHARED);
             }
 
             ~VKQueue (void) {
@@ -72,10 +72,18 @@ namespace Core {
                         deviceInfo->meta.graphicsFamilyIndex = queueFamilyIndex;
 
                     VkBool32 presentSupport = false;
+#if ENABLE_HEADLESS_MODE
+                    /* There is no surface to present to in headless mode, so we alias the present queue to the graphics
+                     * queue. This keeps the queue family indices complete without having to special case every user of 
+                     * the present family index
+                    */
+                    presentSupport = queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT;
+#else
                     vkGetPhysicalDeviceSurfaceSupportKHR (phyDevice, 
                                                           queueFamilyIndex, 
                                                           deviceInfo->resource.surface, 
                                                           &presentSupport);
+#endif  // ENABLE_HEADLESS_MODE
                     if (presentSupport &&
                         !deviceInfo->meta.presentFamilyIndex.has_value())
                          deviceInfo->meta.presentFamilyIndex = queueFamilyIndex;
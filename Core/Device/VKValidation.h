@@ -28,10 +28,6 @@ namespace Core {
 
             static Log::Record* m_VKValidationLog;
             const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
-            /* Logging to a circular buffer requires us to specify the buffer capacity. A multiple of 3 will allow us to
-             * save the validation message as a whole (msg, severity and type)
-            */
-            const size_t m_logBufferCapacity = 3;
 
             /* Check if required validation layers are supported
             */
@@ -130,11 +126,15 @@ namespace Core {
             VKValidation (void) {
                 m_enableValidationLayers    = false;
                 m_validationLayersSupported = false;
-                m_VKValidationLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath, m_logBufferCapacity);
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO,    Log::TO_FILE_IMMEDIATE);
-                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE | 
-                                                                                     Log::TO_FILE_BUFFER_CIRCULAR);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
+                m_VKValidationLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,    Log::TO_FILE_SHARED);
+                /* The last validation messages are kept in the flight recorder, so that they can be recovered even if the
+                 * application is killed or crashes (see Tool/FlightRecorderReader.cpp)
+                */
+                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_SHARED | Log::TO_CONSOLE | 
+                                                                                  Log::TO_FILE_FLIGHT_RECORDER);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_SHARED | Log::TO_CONSOLE | 
+                                                                                  Log::TO_FILE_FLIGHT_RECORDER);
             }
 
             ~VKValidation (void) {
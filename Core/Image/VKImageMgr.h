@@ -1,10 +1,11 @@
 #ifndef VK_IMAGE_MGR_H
 #define VK_IMAGE_MGR_H
 
-#include "../Device/VKPhyDevice.h"
+#include <map>
+#include "../Device/VKMemoryAllocator.h"
 
 namespace Core {
-    class VKImageMgr: protected virtual VKPhyDevice {
+    class VKImageMgr: protected virtual VKMemoryAllocator {
         private:
             struct ImageInfo {
                 struct Meta {
@@ -36,16 +37,14 @@ namespace Core {
                 } params;
 
                 struct Allocation {
+                    uint32_t memoryAllocationInfoId;
+                    VkDeviceSize offset;
                     VkDeviceSize size;
                     uint32_t memoryTypeBits;
                     uint32_t memoryTypeIndex;
                 } allocation;
-
-                bool operator == (const ImageInfo& other) const {
-                    return meta.id == other.meta.id;
-                }  
             };
-            std::unordered_map <e_imageType, std::vector <ImageInfo>> m_imageInfoPool;
+            std::unordered_map <e_imageType, SlotMap <ImageInfo>> m_imageInfoPool;
 
             Log::Record* m_VKImageMgrLog;
             const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
@@ -57,13 +56,9 @@ namespace Core {
             }
 
             void deleteImageInfo (ImageInfo* imageInfo, e_imageType type) {
-                if (m_imageInfoPool.find (type) != m_imageInfoPool.end()) {
-                    auto& infos = m_imageInfoPool[type];
-
-                    infos.erase (std::remove (infos.begin(), infos.end(), *imageInfo), infos.end());
-                    m_imageInfoPool[type] = infos;
+                auto pool = m_imageInfoPool.find (type);
+                if (pool != m_imageInfoPool.end() && pool->second.erase (imageInfo->meta.id))
                     return;
-                }
 
                 LOG_ERROR (m_VKImageMgrLog) << "Failed to delete image info "
                                             << "[" << imageInfo->meta.id << "]"
@@ -76,13 +71,13 @@ namespace Core {
         public:
             VKImageMgr (void) {
                 m_VKImageMgrLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_IMMEDIATE);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE); 
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE); 
                 /* Create a type void image, since the image info struct is private, there may be cases where we need
                  * its type. Using the get function with an auto will help to resolve this
                 */
                 ImageInfo info{};
-                m_imageInfoPool[VOID_IMAGE].push_back (info);
+                m_imageInfoPool[VOID_IMAGE].insert (info.meta.id, info);
             }
 
             ~VKImageMgr (void) {
@@ -126,6 +121,36 @@ namespace Core {
                 throw std::runtime_error ("Failed to find supported format");
             }
 
+            /* Size in bytes of a mip level that is tightly packed in a buffer. Block compressed formats store 4x4 texel 
+             * blocks, so a level that is smaller than a block (or not a multiple of it) still takes up whole blocks. All 
+             * other formats that we copy from a buffer as of now are 4 bytes per texel
+            */
+            VkDeviceSize getMipLevelSize (VkFormat format, uint32_t width, uint32_t height) {
+                VkDeviceSize blocksCount = static_cast <VkDeviceSize> ((width + 3) / 4) * ((height + 3) / 4);
+                switch (format) {
+                    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+                    case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+                    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+                    case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+                    case VK_FORMAT_BC4_UNORM_BLOCK:
+                    case VK_FORMAT_BC4_SNORM_BLOCK:
+                        return blocksCount * 8;
+
+                    case VK_FORMAT_BC2_UNORM_BLOCK:
+                    case VK_FORMAT_BC2_SRGB_BLOCK:
+                    case VK_FORMAT_BC3_UNORM_BLOCK:
+                    case VK_FORMAT_BC3_SRGB_BLOCK:
+                    case VK_FORMAT_BC5_UNORM_BLOCK:
+                    case VK_FORMAT_BC5_SNORM_BLOCK:
+                    case VK_FORMAT_BC7_UNORM_BLOCK:
+                    case VK_FORMAT_BC7_SRGB_BLOCK:
+                        return blocksCount * 16;
+
+                    default:
+                        return static_cast <VkDeviceSize> (width) * height * 4;
+                }
+            }
+
             /* To use any VkImage, including those in the swap chain, in the render pipeline we have to create a 
              * VkImageView object. An image view is quite literally a view into an image. It describes how to access the 
              * image and which part of the image to access
@@ -137,15 +162,13 @@ namespace Core {
                                   VkImage image) {
 
                 auto deviceInfo = getDeviceInfo (deviceInfoId);
-                for (auto const& info: m_imageInfoPool[type]) {
-                    if (info.meta.id == imageInfo->meta.id) {
-                        LOG_ERROR (m_VKImageMgrLog) << "Image info id already exists " 
-                                                    << "[" << imageInfo->meta.id << "]"
-                                                    << " "
-                                                    << "[" << Utils::getImageTypeString (type) << "]"
-                                                    << std::endl;
-                        throw std::runtime_error ("Image info id already exists");
-                    }
+                if (m_imageInfoPool[type].contains (imageInfo->meta.id)) {
+                    LOG_ERROR (m_VKImageMgrLog) << "Image info id already exists " 
+                                                << "[" << imageInfo->meta.id << "]"
+                                                << " "
+                                                << "[" << Utils::getImageTypeString (type) << "]"
+                                                << std::endl;
+                    throw std::runtime_error ("Image info id already exists");
                 }
 
                 VkImageViewCreateInfo createInfo;
@@ -189,7 +212,7 @@ namespace Core {
 
                 imageInfo->resource.image     = image;
                 imageInfo->resource.imageView = imageView;
-                m_imageInfoPool[type].push_back (*imageInfo);
+                m_imageInfoPool[type].insert (imageInfo->meta.id, *imageInfo);
             }
 
             void createImageResources (uint32_t deviceInfoId,
@@ -208,15 +231,13 @@ namespace Core {
                                        VkImageAspectFlags aspect) {
 
                 auto deviceInfo = getDeviceInfo (deviceInfoId);
-                for (auto const& info: m_imageInfoPool[type]) {
-                    if (info.meta.id == imageInfoId) {
-                        LOG_ERROR (m_VKImageMgrLog) << "Image info id already exists " 
-                                                    << "[" << imageInfoId << "]"
-                                                    << " "
-                                                    << "[" << Utils::getImageTypeString (type) << "]"
-                                                    << std::endl;
-                        throw std::runtime_error ("Image info id already exists");
-                    }
+                if (m_imageInfoPool[type].contains (imageInfoId)) {
+                    LOG_ERROR (m_VKImageMgrLog) << "Image info id already exists " 
+                                                << "[" << imageInfoId << "]"
+                                                << " "
+                                                << "[" << Utils::getImageTypeString (type) << "]"
+                                                << std::endl;
+                    throw std::runtime_error ("Image info id already exists");
                 }
 
                 VkImageCreateInfo createInfo;
@@ -304,49 +325,58 @@ namespace Core {
                  * vkGetImageMemoryRequirements instead of vkGetBufferMemoryRequirements, and use vkBindImageMemory 
                  * instead of vkBindBufferMemory
                 */
-                VkMemoryRequirements memRequirements;
-                vkGetImageMemoryRequirements (deviceInfo->resource.logDevice, image, &memRequirements);
-
-                VkMemoryAllocateInfo allocInfo;
-                allocInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-                allocInfo.pNext           = VK_NULL_HANDLE;
-                allocInfo.allocationSize  = memRequirements.size;
-                allocInfo.memoryTypeIndex = getMemoryTypeIndex (deviceInfoId, memRequirements.memoryTypeBits, property);
-
-                deviceInfo->meta.memoryAllocationCount++;
-
-                VkDeviceMemory imageMemory;
-                result = vkAllocateMemory (deviceInfo->resource.logDevice, &allocInfo, VK_NULL_HANDLE, &imageMemory);
-                if (result != VK_SUCCESS) {
-                    LOG_ERROR (m_VKImageMgrLog) << "Failed to allocate image memory " 
-                                                << "[" << imageInfoId << "]"
-                                                << " "
-                                                << "[" << Utils::getImageTypeString (type) << "]"
-                                                << " "
-                                                << "[" << string_VkResult (result) << "]"
-                                                << std::endl;                     
-                    throw std::runtime_error ("Failed to allocate image memory");
+                bool prefersDedicated;
+                auto memRequirements = getMemoryRequirements (deviceInfoId, VK_NULL_HANDLE, image, prefersDedicated);
+                /* Lazily allocated memory is usually only offered by tile based renderers, fall back to device local
+                 * memory if none of the memory types suitable for the image has it. Note that, the image may still keep
+                 * the transient attachment usage, since it only says that lazily allocated memory may be used
+                */
+                if ((property & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) &&
+                    !isMemoryTypeSupported (deviceInfoId, memRequirements.memoryTypeBits, property)) {
+                    LOG_INFO (m_VKImageMgrLog) << "Lazily allocated memory not supported, falling back to device local "
+                                               << "[" << imageInfoId << "]"
+                                               << " "
+                                               << "[" << Utils::getImageTypeString (type) << "]"
+                                               << std::endl;
+                    property = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
                 }
 
-                vkBindImageMemory (deviceInfo->resource.logDevice, image, imageMemory, 0);
+                /* Note that, optimal tiling images are non linear resources, this lets the memory allocator keep them
+                 * apart from buffers and linear tiling images as required by the buffer image granularity
+                */
+                uint32_t memoryAllocationInfoId = createMemoryAllocation (deviceInfoId, 
+                                                                          memRequirements, 
+                                                                          property, 
+                                                                          tiling == VK_IMAGE_TILING_LINEAR,
+                                                                          prefersDedicated,
+                                                                          VK_NULL_HANDLE,
+                                                                          image);
+                auto memoryAllocationInfo       = getMemoryAllocationInfo (memoryAllocationInfoId);
+
+                vkBindImageMemory (deviceInfo->resource.logDevice, 
+                                   image, 
+                                   memoryAllocationInfo->resource.memory, 
+                                   memoryAllocationInfo->params.offset);
 
                 ImageInfo info;
-                info.meta.id                    = imageInfoId;
-                info.meta.width                 = width;
-                info.meta.height                = height;
-                info.meta.mipLevels             = mipLevels;
-                info.resource.imageMemory       = imageMemory;
-                info.params.initialLayout       = initialLayout;
-                info.params.format              = format;
-                info.params.usage               = usage;
-                info.params.sampleCount         = sampleCount;
-                info.params.tiling              = tiling;
-                info.params.property            = property;
-                info.params.sharingMode         = createInfo.sharingMode;
-                info.params.aspect              = aspect;
-                info.allocation.size            = allocInfo.allocationSize;
-                info.allocation.memoryTypeBits  = memRequirements.memoryTypeBits;
-                info.allocation.memoryTypeIndex = allocInfo.memoryTypeIndex;
+                info.meta.id                           = imageInfoId;
+                info.meta.width                        = width;
+                info.meta.height                       = height;
+                info.meta.mipLevels                    = mipLevels;
+                info.resource.imageMemory              = memoryAllocationInfo->resource.memory;
+                info.params.initialLayout              = initialLayout;
+                info.params.format                     = format;
+                info.params.usage                      = usage;
+                info.params.sampleCount                = sampleCount;
+                info.params.tiling                     = tiling;
+                info.params.property                   = property;
+                info.params.sharingMode                = createInfo.sharingMode;
+                info.params.aspect                     = aspect;
+                info.allocation.memoryAllocationInfoId = memoryAllocationInfoId;
+                info.allocation.offset                 = memoryAllocationInfo->params.offset;
+                info.allocation.size                   = memRequirements.size;
+                info.allocation.memoryTypeBits         = memRequirements.memoryTypeBits;
+                info.allocation.memoryTypeIndex        = memoryAllocationInfo->params.memoryTypeIndex;
                 /* Create image view
                 */
                 createImageView (deviceInfoId,
@@ -455,12 +485,24 @@ namespace Core {
                 }
             }
 
+            /* Exchange the images (along with their dimensions, memory and views) held by two image infos of the same
+             * type, while the ids stay where they are. This lets an image be replaced without changing the id it is
+             * looked up by, the replaced image is left behind in the other image info to be cleaned up later
+            */
+            void swapImageResources (uint32_t imageInfoIdA, uint32_t imageInfoIdB, e_imageType type) {
+                auto imageInfoA = getImageInfo (imageInfoIdA, type);
+                auto imageInfoB = getImageInfo (imageInfoIdB, type);
+
+                std::swap (*imageInfoA,         *imageInfoB);
+                std::swap (imageInfoA->meta.id, imageInfoB->meta.id);
+            }
+
             ImageInfo* getImageInfo (uint32_t imageInfoId, e_imageType type) {
-                if (m_imageInfoPool.find (type) != m_imageInfoPool.end()) {
-                    auto& infos = m_imageInfoPool[type];
-                    for (auto& info: infos) {
-                        if (info.meta.id == imageInfoId) return &info;
-                    }
+                auto pool = m_imageInfoPool.find (type);
+                if (pool != m_imageInfoPool.end()) {
+                    auto info = pool->second.find (imageInfoId);
+                    if (info != nullptr)
+                        return info;
                 }
 
                 LOG_ERROR (m_VKImageMgrLog) << "Failed to find image info "
@@ -480,7 +522,7 @@ namespace Core {
                                                << "[" << Utils::getImageTypeString (key) << "]"
                                                << std::endl;
                     
-                    for (auto const& info: val) {
+                    for (auto const& [infoId, info]: val) {
                         LOG_INFO (m_VKImageMgrLog) << "Id "
                                                    << "[" << info.meta.id << "]"
                                                    << std::endl; 
@@ -532,6 +574,14 @@ namespace Core {
                                                    << "[" << string_VkImageAspectFlags (info.params.aspect) << "]"
                                                    << std::endl; 
 
+                        LOG_INFO (m_VKImageMgrLog) << "Memory allocation info id "
+                                                   << "[" << info.allocation.memoryAllocationInfoId << "]"
+                                                   << std::endl;
+
+                        LOG_INFO (m_VKImageMgrLog) << "Allocation offset "
+                                                   << "[" << info.allocation.offset << "]"
+                                                   << std::endl;
+
                         LOG_INFO (m_VKImageMgrLog) << "Allocation size "
                                                    << "[" << info.allocation.size << "]"
                                                    << std::endl;     
@@ -547,19 +597,74 @@ namespace Core {
                 }
             }
 
+            /* Transient attachments (multi sample, depth) are only used within the render pass, so on devices that
+             * offer lazily allocated memory, the memory backing them may never be committed at all. The bytes saved are
+             * reported per resolution since the attachments are recreated along with the swap chain. Note that, the
+             * commitment may grow as the attachments are used, so this should be called after rendering at least once
+            */
+            void dumpTransientImageStats (uint32_t deviceInfoId) {
+                LOG_INFO (m_VKImageMgrLog) << "Dumping transient image stats"
+                                           << std::endl;
+
+                std::map <std::pair <uint32_t, uint32_t>, std::pair <VkDeviceSize, VkDeviceSize>> resolutionStats;
+                for (auto const& [key, val]: m_imageInfoPool) {
+                    for (auto const& [infoId, info]: val) {
+                        if ((info.params.usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) == 0)
+                            continue;
+
+                        VkDeviceSize committedSize = getMemoryCommitment (deviceInfoId,
+                                                                          info.allocation.memoryAllocationInfoId);
+                        auto& stats                = resolutionStats[{info.meta.width, info.meta.height}];
+                        stats.first               += info.allocation.size;
+                        stats.second              += committedSize;
+
+                        LOG_INFO (m_VKImageMgrLog) << "Id "
+                                                   << "[" << info.meta.id << "]"
+                                                   << " "
+                                                   << "[" << Utils::getImageTypeString (key) << "]"
+                                                   << std::endl;
+
+                        LOG_INFO (m_VKImageMgrLog) << "Lazily allocated "
+                                                   << "[" << ((info.params.property &
+                                                              VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) ? "TRUE": "FALSE")
+                                                   << "]"
+                                                   << std::endl;
+
+                        LOG_INFO (m_VKImageMgrLog) << "Committed size "
+                                                   << "[" << committedSize << "]"
+                                                   << "->"
+                                                   << "[" << info.allocation.size << "]"
+                                                   << std::endl;
+                    }
+                }
+
+                for (auto const& [key, val]: resolutionStats) {
+                    LOG_INFO (m_VKImageMgrLog) << "Resolution "
+                                               << "[" << key.first    << ", "
+                                                      << key.second   << "]"
+                                               << std::endl;
+
+                    LOG_INFO (m_VKImageMgrLog) << "Bytes saved "
+                                               << "[" << val.first - val.second << "]"
+                                               << "->"
+                                               << "[" << val.first << "]"
+                                               << std::endl;
+                }
+            }
+
             void cleanUp (uint32_t deviceInfoId, uint32_t imageInfoId, e_imageType type) {
                 auto deviceInfo = getDeviceInfo (deviceInfoId); 
                 auto imageInfo  = getImageInfo  (imageInfoId, type);
                 /* If we are cleaning up swap chain resources, we are only going to delete the associated image view. The
                  * destroy swap chain method will take care of the rest
                 */
-                vkDestroyImageView (deviceInfo->resource.logDevice, imageInfo->resource.imageView,   VK_NULL_HANDLE);
+                vkDestroyImageView   (deviceInfo->resource.logDevice, imageInfo->resource.imageView, VK_NULL_HANDLE);
 
                 if (type != SWAPCHAIN_IMAGE) {
-                vkDestroyImage     (deviceInfo->resource.logDevice, imageInfo->resource.image,       VK_NULL_HANDLE);
-                vkFreeMemory       (deviceInfo->resource.logDevice, imageInfo->resource.imageMemory, VK_NULL_HANDLE);
+                vkDestroyImage       (deviceInfo->resource.logDevice, imageInfo->resource.image,     VK_NULL_HANDLE);
+                freeMemoryAllocation (deviceInfoId, imageInfo->allocation.memoryAllocationInfoId);
                 }
-                deleteImageInfo    (imageInfo, type);
+                deleteImageInfo      (imageInfo, type);
             }
     };
 }   // namespace Core
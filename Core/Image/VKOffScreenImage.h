@@ -0,0 +1,65 @@
+#ifndef VK_OFF_SCREEN_IMAGE_H
+#define VK_OFF_SCREEN_IMAGE_H
+
+#include "VKImageMgr.h"
+
+namespace Core {
+    class VKOffScreenImage: protected virtual VKImageMgr {
+        private:
+            Log::Record* m_VKOffScreenImageLog;
+            const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
+
+        public:
+            VKOffScreenImage (void) {
+                m_VKOffScreenImageLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
+            }
+
+            ~VKOffScreenImage (void) {
+                LOG_CLOSE (m_instanceId);
+            }
+
+        protected:
+            /* In headless mode, there is no window or surface and hence no swap chain to acquire images from. Instead, we
+             * create a fixed set of offscreen images that take the place of the swap chain images as the resolve target.
+             * Note that, we populate the swap chain params in the device info with the offscreen image params, so that
+             * the rest of the resources (depth, multi sample, frame buffers, camera etc.) that are sized and formatted
+             * using the swap chain params can be created without any changes
+             *
+             * The images are created with the transfer src usage flag so that they can be copied to a host visible
+             * buffer for read back once the render pass has ended
+            */
+            void createOffScreenResources (uint32_t deviceInfoId, uint32_t imageInfoId) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto imageShareQueueFamilyIndices = std::vector {
+                    deviceInfo->meta.graphicsFamilyIndex.value()
+                };
+
+                VkExtent2D extent;
+                extent.width  = static_cast <uint32_t> (g_windowSettings.width);
+                extent.height = static_cast <uint32_t> (g_windowSettings.height);
+
+                for (uint32_t i = 0; i < g_headlessSettings.offScreenImageCount; i++) {
+                    createImageResources (deviceInfoId,
+                                          imageInfoId + i,
+                                          OFFSCREEN_IMAGE,
+                                          extent.width,
+                                          extent.height,
+                                          1,
+                                          VK_IMAGE_LAYOUT_UNDEFINED,
+                                          g_headlessSettings.offScreenImageFormat,
+                                          VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                                          VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                          VK_SAMPLE_COUNT_1_BIT,
+                                          VK_IMAGE_TILING_OPTIMAL,
+                                          VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                          imageShareQueueFamilyIndices,
+                                          VK_IMAGE_ASPECT_COLOR_BIT);
+                }
+
+                deviceInfo->meta.swapChainSize     = g_headlessSettings.offScreenImageCount;
+                deviceInfo->params.swapChainFormat = g_headlessSettings.offScreenImageFormat;
+                deviceInfo->params.swapChainExtent = extent;
+            }
+    };
+}   // namespace Core
+#endif  // VK_OFF_SCREEN_IMAGE_H
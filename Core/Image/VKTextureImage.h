@@ -6,20 +6,450 @@
 */
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <filesystem>
+#include <glm/glm.hpp>
 #include "VKImageMgr.h"
-#include "../Buffer/VKBufferMgr.h"
+#include "../Buffer/VKStagingBuffer.h"
+#include "../Scene/VKTextureTable.h"
+#include "../../Utils/KTXContainer.h"
 
 namespace Core {
     class VKTextureImage: protected virtual VKImageMgr,
-                          protected virtual VKBufferMgr {
+                          protected virtual VKStagingBuffer,
+                          protected virtual VKTextureTable {
         private:
+            struct TextureDecodeInfo {
+                uint32_t imageInfoId;
+                /* Path to the source image, or to the block compressed container that is loaded in its place
+                */
+                std::string imageFilePath;
+                VkFormat format;
+                uint32_t width;
+                uint32_t height;
+                uint32_t mipLevels;
+                /* First mip level of the texture that is held by the image, the image is created with the dimensions of
+                 * this level and the levels above it are left out. This is always 0 unless the texture is streamed (see 
+                 * VKTextureStream)
+                */
+                uint32_t baseMipLevel;
+                /* Number of mip levels that are filled from the host (starting from the base level), and their combined 
+                 * size
+                */
+                uint32_t copyMipLevels;
+                VkDeviceSize size;
+                /* Location of each mip level in the container (starting from level 0), this is empty if the texture is
+                 * decoded from the source image
+                */
+                std::vector <Utils::KTXLevelIndex> levelIndices;
+                /* Region of the staging buffer reserved for the texture, the worker thread decoding the texture writes 
+                 * to it directly
+                */
+                uint8_t* stagingSpace;
+                VkDeviceSize srcOffset;
+                float decodeTime;
+                bool decoded;
+            };
+
+            std::vector <TextureDecodeInfo> m_textureDecodeInfos;
+
+            /* Tracks the batch of textures that is being decoded on the worker threads, and (if progressive startup is
+             * enabled) the textures that are loaded after the first frame
+            */
+            struct TextureLoadInfo {
+                struct Meta {
+                    /* Range of decode infos in the current batch, the decode infos before loadedCount have landed in
+                     * their images
+                    */
+                    size_t batchBegin;
+                    size_t batchEnd;
+                    size_t loadedCount;
+                    uint32_t placeholderImageInfoId;
+                    bool decoding;
+                    bool transferring;
+                    /* Index of the decode info for each image info id
+                    */
+                    std::vector <size_t> decodeInfoIndices;
+                    std::chrono::time_point <std::chrono::high_resolution_clock> startTime;
+                } meta;
+
+                struct Resource {
+                    std::vector <std::thread> workers;
+                    std::atomic <size_t> nextIndex;
+                    std::atomic <size_t> decodedCount;
+                } resource;
+
+                /* Decode infos of the textures that have landed but are yet to be prepared for shader access
+                */
+                std::vector <size_t> pendingTransitions;
+            } m_textureLoadInfo;
+
+            /* Faces with no texture map to the default diffuse texture, which the shaders shade with its color instead
+             * of sampling it. The color is worked out from the texture itself, so that it follows the texture path in
+             * the settings
+            */
+            struct DefaultTextureInfo {
+                uint32_t imageInfoId;
+                glm::vec4 color;
+            } m_defaultTextureInfo;
+
             Log::Record* m_VKTextureImageLog;
             const uint32_t m_instanceId = g_collectionsSettings.instanceId++; 
 
+            /* The texture format is sRGB, so the color channels are converted to linear space before they are averaged,
+             * otherwise the smaller mip levels would come out darker than the base level. The alpha channel is always
+             * linear
+            */
+            static float srgbToLinear (uint8_t value) {
+                static const std::array <float, 256> table = [] {
+                    std::array <float, 256> values;
+                    for (uint32_t i = 0; i < 256; i++) {
+                        float normalized = i / 255.0f;
+                        values[i]        = normalized <= 0.04045f ? normalized / 12.92f: 
+                                                                    std::pow ((normalized + 0.055f) / 1.055f, 2.4f);
+                    }
+                    return values;
+                }();
+                return table[value];
+            }
+
+            static uint8_t linearToSrgb (float value) {
+                float normalized = value <= 0.0031308f ? value * 12.92f: 
+                                                         1.055f * std::pow (value, 1.0f / 2.4f) - 0.055f;
+                return static_cast <uint8_t> (std::clamp (normalized * 255.0f + 0.5f, 0.0f, 255.0f));
+            }
+
+            /* Decode the image and average its texels in linear space, returns false if the image could not be decoded
+            */
+            static bool getLinearColor (const std::string& imageFilePath, glm::vec4& color) {
+                int width, height, channels;
+                stbi_uc* pixels = stbi_load (imageFilePath.c_str(), 
+                                             &width, 
+                                             &height, 
+                                             &channels, 
+                                             STBI_rgb_alpha);
+                if (!pixels)
+                    return false;
+
+                size_t texelsCount = static_cast <size_t> (width) * height;
+                glm::vec4 sum      = glm::vec4 (0.0f);
+                for (size_t i = 0; i < texelsCount; i++) {
+                    const stbi_uc* texel = &pixels[i * 4];
+                    sum += glm::vec4 (srgbToLinear (texel[0]),
+                                      srgbToLinear (texel[1]),
+                                      srgbToLinear (texel[2]),
+                                      texel[3] / 255.0f);
+                }
+                stbi_image_free (pixels);
+                color = sum / static_cast <float> (texelsCount);
+                return true;
+            }
+
+            /* Generate mip levels 1 to mipLevels - 1 on the host using a 2x2 box filter, each level is built from the 
+             * previous one and written to the staging buffer right after it. Note that, the staging buffer memory may 
+             * be write combined (slow to read from), so the levels are built in scratch arrays first instead of being 
+             * read back from the staging buffer
+            */
+            static void generateMipMaps (TextureDecodeInfo& info, const uint8_t* basePixels) {
+                std::vector <uint8_t> levelPixels[2];
+                const uint8_t* srcPixels = basePixels;
+                uint32_t srcWidth        = info.width;
+                uint32_t srcHeight       = info.height;
+                uint8_t* stagingSpace    = info.stagingSpace + static_cast <VkDeviceSize> (srcWidth) * srcHeight * 4;
+
+                for (uint32_t i = 1; i < info.mipLevels; i++) {
+                    uint32_t dstWidth  = srcWidth  > 1 ? srcWidth  / 2: 1;
+                    uint32_t dstHeight = srcHeight > 1 ? srcHeight / 2: 1;
+                    auto& dstPixels    = levelPixels[i % 2];
+                    dstPixels.resize (static_cast <size_t> (dstWidth) * dstHeight * 4);
+
+                    for (uint32_t y = 0; y < dstHeight; y++) {
+                        /* If a dimension is odd (or has already reached 1), the last row/column is repeated
+                        */
+                        const uint8_t* srcRows[2] = {
+                            srcPixels + static_cast <size_t> (std::min (2 * y,     srcHeight - 1)) * srcWidth * 4,
+                            srcPixels + static_cast <size_t> (std::min (2 * y + 1, srcHeight - 1)) * srcWidth * 4
+                        };
+                        for (uint32_t x = 0; x < dstWidth; x++) {
+                            uint32_t srcColumns[2] = {
+                                std::min (2 * x,     srcWidth - 1) * 4,
+                                std::min (2 * x + 1, srcWidth - 1) * 4
+                            };
+                            uint8_t* dstTexel = &dstPixels[(static_cast <size_t> (y) * dstWidth + x) * 4];
+
+                            for (uint32_t c = 0; c < 3; c++) {
+                                float sum = srgbToLinear (srcRows[0][srcColumns[0] + c]) +
+                                            srgbToLinear (srcRows[0][srcColumns[1] + c]) +
+                                            srgbToLinear (srcRows[1][srcColumns[0] + c]) +
+                                            srgbToLinear (srcRows[1][srcColumns[1] + c]);
+                                dstTexel[c] = linearToSrgb (sum * 0.25f);
+                            }
+                            uint32_t alphaSum = srcRows[0][srcColumns[0] + 3] + srcRows[0][srcColumns[1] + 3] +
+                                                srcRows[1][srcColumns[0] + 3] + srcRows[1][srcColumns[1] + 3];
+                            dstTexel[3]       = static_cast <uint8_t> ((alphaSum + 2) / 4);
+                        }
+                    }
+
+                    memcpy (stagingSpace, dstPixels.data(), dstPixels.size());
+                    stagingSpace += dstPixels.size();
+                    srcPixels     = dstPixels.data();
+                    srcWidth      = dstWidth;
+                    srcHeight     = dstHeight;
+                }
+            }
+
+            /* Runs on a worker thread, so it must not make any Vulkan calls. Failures are reported back through the 
+             * decoded flag, and are logged by the worker
+            */
+            static void decodeTexture (TextureDecodeInfo& info) {
+                int width, height, channels;
+                /* The stbi_load function takes the file path and number of channels to load as arguments. The 
+                 * STBI_rgb_alpha value forces the image to be loaded with an alpha channel, even if it doesn't have one, 
+                 * which is nice for consistency with other textures (if any). The middle three parameters are outputs 
+                 * for the width, height and actual number of channels in the image
+                 * 
+                 * The pointer that is returned is the first element in an array of pixel values
+                */
+                stbi_uc* pixels = stbi_load (info.imageFilePath.c_str(), 
+                                             &width, 
+                                             &height, 
+                                             &channels, 
+                                             STBI_rgb_alpha);
+
+                if (!pixels || static_cast <uint32_t> (width)  != info.width 
+                            || static_cast <uint32_t> (height) != info.height) {
+                    stbi_image_free (pixels);
+                    info.decoded = false;
+                    return;
+                }
+                /* The pixels are laid out row by row with 4 bytes per pixel in the case of STBI_rgb_alpha for a total of 
+                 * texWidth * texHeight * 4 values
+                */
+                memcpy (info.stagingSpace, pixels, static_cast <size_t> (width) * height * 4);
+#if ENABLE_HOST_MIP_GENERATION
+                generateMipMaps (info, pixels);
+#endif  // ENABLE_HOST_MIP_GENERATION
+                stbi_image_free (pixels);
+                info.decoded = true;
+            }
+
+            /* Runs on a worker thread, the mip levels stored in the container are already in the layout they are
+             * copied in, so they are read straight in to the staging buffer (base level first)
+            */
+            static void loadContainer (TextureDecodeInfo& info) {
+                std::ifstream file (info.imageFilePath, std::ios::binary);
+                uint8_t* stagingSpace = info.stagingSpace;
+
+                for (size_t i = info.baseMipLevel; i < info.levelIndices.size(); i++) {
+                    auto const& levelIndex = info.levelIndices[i];
+                    file.seekg (static_cast <std::streamoff> (levelIndex.byteOffset));
+                    file.read  (reinterpret_cast <char*> (stagingSpace), 
+                                static_cast <std::streamsize> (levelIndex.byteLength));
+                    stagingSpace += levelIndex.byteLength;
+                }
+                info.decoded = file.good();
+            }
+
+            /* Read the header and level index of a container, the container is only used if it holds a single 2D image 
+             * with no supercompression, and the size of every level matches its format and dimensions
+            */
+            bool isContainerValid (const std::string& containerFilePath,
+                                   Utils::KTXHeader& header,
+                                   std::vector <Utils::KTXLevelIndex>& levelIndices) {
+
+                std::ifstream file (containerFilePath, std::ios::binary);
+                if (!file.is_open())
+                    return false;
+
+                file.read (reinterpret_cast <char*> (&header), sizeof (header));
+                if (!file.good() || memcmp (header.identifier, Utils::g_KTXIdentifier, sizeof (header.identifier)) != 0)
+                    return false;
+
+                uint32_t maxMipLevels = static_cast <uint32_t> (std::floor 
+                                                               (std::log2 
+                                                               (std::max (std::max (header.pixelWidth, 
+                                                                                    header.pixelHeight), 1u)))) + 1;
+                if (header.pixelWidth == 0 || header.pixelHeight == 0 || header.pixelDepth != 0 || 
+                    header.layerCount > 1  || header.faceCount   != 1 || header.supercompressionScheme != 0 ||
+                    header.levelCount == 0 || header.levelCount  > maxMipLevels) 
+                    return false;
+
+                levelIndices.resize (header.levelCount);
+                file.read (reinterpret_cast <char*> (levelIndices.data()), 
+                           static_cast <std::streamsize> (levelIndices.size() * sizeof (Utils::KTXLevelIndex)));
+                if (!file.good())
+                    return false;
+
+                uint32_t mipWidth  = header.pixelWidth;
+                uint32_t mipHeight = header.pixelHeight;
+                for (auto const& levelIndex: levelIndices) {
+                    if (levelIndex.byteLength != getMipLevelSize (static_cast <VkFormat> (header.vkFormat), 
+                                                                  mipWidth, 
+                                                                  mipHeight))
+                        return false;
+                    if (mipWidth > 1)  mipWidth  /= 2;
+                    if (mipHeight > 1) mipHeight /= 2;
+                }
+                return true;
+            }
+
+            /* Start decoding a batch of textures (whose staging regions have already been reserved) across the worker 
+             * threads, this returns right away
+            */
+            void launchTextureDecodeBatch (size_t batchBegin, size_t batchEnd) {
+                auto& load                 = m_textureLoadInfo;
+                load.meta.batchBegin       = batchBegin;
+                load.meta.batchEnd         = batchEnd;
+                load.meta.decoding         = true;
+                load.resource.nextIndex    = batchBegin;
+                load.resource.decodedCount = 0;
+
+                /* The workers log the textures that they decode (or fail to decode) themselves, since the log is safe to 
+                 * write to from more than one thread
+                */
+                auto worker = [&infos = m_textureDecodeInfos, &load, log = m_VKTextureImageLog] (void) {
+                    size_t index;
+                    while ((index = load.resource.nextIndex.fetch_add (1)) < load.meta.batchEnd) {
+                        auto& info     = infos[index];
+                        auto startTime = std::chrono::high_resolution_clock::now();
+
+                        info.levelIndices.empty() ? decodeTexture (info): loadContainer (info);
+
+                        auto endTime    = std::chrono::high_resolution_clock::now();
+                        info.decodeTime = std::chrono::duration <float, std::chrono::milliseconds::period> 
+                                          (endTime - startTime).count();
+                        if (info.decoded) {
+                            LOG_INFO (log) << "Texture image decoded "
+                                           << "[" << info.imageInfoId << "]"
+                                           << " "
+                                           << "[" << info.imageFilePath << "]"
+                                           << " "
+                                           << "[" << string_VkFormat (info.format) << "]"
+                                           << " "
+                                           << "[" << info.copyMipLevels << "/" << info.mipLevels << "]"
+                                           << " "
+                                           << "[" << info.size << "]"
+                                           << " "
+                                           << "[" << info.decodeTime << " ms" << "]"
+                                           << std::endl;
+                        }
+                        else {
+                            LOG_ERROR (log) << "Failed to decode texture image "
+                                            << "[" << info.imageInfoId << "]"
+                                            << " "
+                                            << "[" << info.imageFilePath << "]"
+                                            << " "
+                                            << "[" << info.width << "x" << info.height << "]"
+                                            << std::endl;
+                        }
+                        load.resource.decodedCount.fetch_add (1, std::memory_order_release);
+                    }
+                };
+
+                size_t workersCount = std::min (static_cast <size_t> (g_coreSettings.textureDecodeWorkersCount), 
+                                                batchEnd - batchBegin);
+                for (size_t i = 0; i < workersCount; i++)
+                    load.resource.workers.emplace_back (worker);
+            }
+
+            bool isTextureDecodeBatchDone (void) {
+                auto& load = m_textureLoadInfo;
+                return load.resource.decodedCount.load (std::memory_order_acquire) == 
+                       load.meta.batchEnd - load.meta.batchBegin;
+            }
+
+            /* Wait on the worker threads, and record the copies of the decoded batch
+            */
+            void finishTextureDecodeBatch (void) {
+                auto& load = m_textureLoadInfo;
+                for (auto& thread: load.resource.workers)
+                    thread.join();
+                load.resource.workers.clear();
+                load.meta.decoding = false;
+
+                for (size_t i = load.meta.batchBegin; i < load.meta.batchEnd; i++) {
+                    auto& info = m_textureDecodeInfos[i];
+                    if (!info.decoded) {
+                        LOG_ERROR (m_VKTextureImageLog) << "Failed to load texture image " 
+                                                        << "[" << info.imageInfoId << "]"
+                                                        << " "
+                                                        << "[" << info.imageFilePath << "]"
+                                                        << std::endl;
+                        throw std::runtime_error ("Failed to load texture image");
+                    }
+                    recordImageCopy (info.imageInfoId, TEXTURE_IMAGE, info.srcOffset, info.copyMipLevels);
+                }
+            }
+
+            void decodeTextureBatch (size_t batchBegin, size_t batchEnd) {
+                if (batchBegin == batchEnd)
+                    return;
+
+                launchTextureDecodeBatch (batchBegin, batchEnd);
+                finishTextureDecodeBatch();
+            }
+
+            /* Reserve staging space for the next batch of textures to be loaded after the first frame, the batch ends
+             * when the next texture does not fit in what is left of the staging buffer
+            */
+            void scheduleTextureLoadBatch (uint32_t deviceInfoId) {
+                auto& load        = m_textureLoadInfo;
+                size_t batchBegin = load.meta.loadedCount;
+                size_t batchEnd   = batchBegin;
+
+                while (batchEnd < m_textureDecodeInfos.size() && 
+                       batchEnd - batchBegin < g_coreSettings.textureLoadBatchSize) {
+                    auto& info = m_textureDecodeInfos[batchEnd];
+                    if (batchEnd != batchBegin && !isStagingSpaceAvailable (info.size))
+                        break;
+
+                    info.stagingSpace = reserveStagingSpace (deviceInfoId, info.size, info.srcOffset);
+                    batchEnd++;
+                }
+                launchTextureDecodeBatch (batchBegin, batchEnd);
+            }
+
+            /* The copies of a batch have landed once the transfer fence is signaled, the textures in it are now ready to
+             * be prepared for shader access and are written to the texture table. Note that, the frames in flight that
+             * were recorded before this keep sampling the placeholder texture's slot
+            */
+            void completeTextureLoadBatch (uint32_t deviceInfoId) {
+                auto& load = m_textureLoadInfo;
+                for (size_t i = load.meta.batchBegin; i < load.meta.batchEnd; i++) {
+                    uint32_t imageInfoId = m_textureDecodeInfos[i].imageInfoId;
+                    load.pendingTransitions.push_back (i);
+                    writeTextureTableEntry (deviceInfoId, imageInfoId, imageInfoId);
+                }
+                load.meta.loadedCount  = load.meta.batchEnd;
+                load.meta.transferring = false;
+
+                if (areTextureImagesLoaded()) {
+                    auto endTime = std::chrono::high_resolution_clock::now();
+                    LOG_INFO (m_VKTextureImageLog) << "Texture images loaded "
+                                                   << "[" << load.meta.loadedCount << "]"
+                                                   << " "
+                                                   << "[" << std::chrono::duration <float, 
+                                                             std::chrono::milliseconds::period> 
+                                                             (endTime - load.meta.startTime).count() << " ms" << "]"
+                                                   << std::endl;
+                    /* The staging buffer is no longer needed
+                    */
+                    dumpStagingBufferStats();
+                    cleanUpStagingBuffer (deviceInfoId);
+                }
+            }
+
         public:
             VKTextureImage (void) {
                 m_VKTextureImageLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE); 
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE); 
+                LOG_SET_THREAD_ID (m_instanceId, true);
             }
 
             ~VKTextureImage (void) {
@@ -27,6 +457,16 @@ namespace Core {
             }
 
         protected:
+            VkDeviceSize getMipChainSize (VkFormat format, uint32_t width, uint32_t height, uint32_t mipLevels) {
+                VkDeviceSize size = 0;
+                for (uint32_t i = 0; i < mipLevels; i++) {
+                    size += getMipLevelSize (format, width, height);
+                    if (width > 1)  width  /= 2;
+                    if (height > 1) height /= 2;
+                }
+                return size;
+            }
+
             /* We've already worked with image objects before, but those were automatically created by the swap chain 
              * extension. This time we'll have to create one by ourselves. Creating an image and filling it with data is 
              * similar to vertex buffer creation. We'll start by creating a 'staging resource' and filling it with pixel 
@@ -61,135 +501,364 @@ namespace Core {
              * Optimal for sampling from a shader
             */
             void createTextureResources (uint32_t deviceInfoId, 
-                                         uint32_t imageInfoId, 
-                                         const char* imageFilePath) {
-                                            
+                                         const std::unordered_map <std::string, uint32_t>& textureImagePool) {
+
                 auto deviceInfo = getDeviceInfo (deviceInfoId);
-                int width, height, channels;
-                /* The stbi_load function takes the file path and number of channels to load as arguments. The 
-                 * STBI_rgb_alpha value forces the image to be loaded with an alpha channel, even if it doesn't have one, 
-                 * which is nice for consistency with other textures (if any). The middle three parameters are outputs 
-                 * for the width, height and actual number of channels in the image
-                 * 
-                 * The pointer that is returned is the first element in an array of pixel values
-                */
-                stbi_uc* pixels = stbi_load (imageFilePath, 
-                                             &width, 
-                                             &height, 
-                                             &channels, 
-                                             STBI_rgb_alpha);
-                /* Calculate the number of levels in the mip chain. The max function selects the largest dimension. The 
-                 * log2 function calculates how many times that dimension can be divided by 2. The floor function handles 
-                 * cases where the largest dimension is not a power of 2. 1 is added so that the original image has a mip 
-                 * level
-                */
-                uint32_t mipLevels = static_cast <uint32_t> (std::floor 
-                                                            (std::log2 
-                                                            (std::max (width, height)))) + 1;
+                auto startTime  = std::chrono::high_resolution_clock::now();
+
+                auto& load             = m_textureLoadInfo;
+                load.meta.startTime    = startTime;
+                load.meta.decoding     = false;
+                load.meta.transferring = false;
+
+                auto& decodeInfos = m_textureDecodeInfos;
+                decodeInfos.reserve (textureImagePool.size());
+
+                for (auto const& [path, imageInfoId]: textureImagePool) {
+                    TextureDecodeInfo info{};
+                    info.imageInfoId = imageInfoId;
+                    /* If a block compressed container (see Tool/TextureEncoder.cpp) sits next to the source image, it is
+                     * loaded instead, along with its precomputed mip levels. Block compressed formats take up 4 to 8 
+                     * times less memory (and bandwidth) than the decoded image, and no mip levels are generated at load 
+                     * time. If the device does not support the format of the container, the supported format search 
+                     * falls back to the format of the decoded image
+                    */
+                    Utils::KTXHeader header;
+                    auto containerFilePath = std::filesystem::path (path).replace_extension (".ktx2").string();
+                    if (isContainerValid (containerFilePath, header, info.levelIndices)) {
+                        auto formatCandidates = std::vector {
+                            static_cast <VkFormat> (header.vkFormat),
+                            VK_FORMAT_R8G8B8A8_SRGB
+                        };
+                        auto format = getSupportedFormat (deviceInfoId,
+                                                          formatCandidates,
+                                                          VK_IMAGE_TILING_OPTIMAL,
+                                                          VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT);
+
+                        if (format == static_cast <VkFormat> (header.vkFormat)) {
+                            info.imageFilePath = containerFilePath;
+                            info.format        = format;
+                            info.width         = header.pixelWidth;
+                            info.height        = header.pixelHeight;
+                            info.mipLevels     = header.levelCount;
+                            info.copyMipLevels = header.levelCount;
+#if ENABLE_TEXTURE_STREAMING
+                            /* Skip the levels that are larger than the initial resident size, they are streamed in 
+                             * later on demand. Note that, the smallest level is always kept
+                            */
+                            while (info.baseMipLevel + 1 < info.mipLevels && 
+                                   std::max (info.width  >> info.baseMipLevel, 
+                                             info.height >> info.baseMipLevel) > 
+                                   g_textureStreamSettings.initialResidentDimension)
+                                info.baseMipLevel++;
+                            info.copyMipLevels = info.mipLevels - info.baseMipLevel;
+#endif  // ENABLE_TEXTURE_STREAMING
+                        }
+                        else {
+                            LOG_INFO (m_VKTextureImageLog) << "Container format not supported, falling back "
+                                                           << "[" << containerFilePath << "]"
+                                                           << " "
+                                                           << "[" << string_VkFormat (formatCandidates[0]) << "]"
+                                                           << std::endl;
+                            info.levelIndices.clear();
+                        }
+                    }
+                    else
+                        info.levelIndices.clear();
+
+                    if (info.levelIndices.empty()) {
+                        int width, height, channels;
+                        /* Only the header of the image is parsed here to find its dimensions, which is all we need to 
+                         * create the image and reserve its staging space. The pixels are decoded later on the worker 
+                         * threads
+                        */
+                        if (!stbi_info (path.c_str(), &width, &height, &channels)) {
+                            LOG_ERROR (m_VKTextureImageLog) << "Failed to load texture image " 
+                                                            << "[" << imageInfoId << "]"
+                                                            << " "
+                                                            << "[" << path << "]"
+                                                            << std::endl;
+                            throw std::runtime_error ("Failed to load texture image");
+                        }
+                        /* Calculate the number of levels in the mip chain. The max function selects the largest 
+                         * dimension. The log2 function calculates how many times that dimension can be divided by 2. The 
+                         * floor function handles cases where the largest dimension is not a power of 2. 1 is added so 
+                         * that the original image has a mip level
+                        */
+                        uint32_t mipLevels = static_cast <uint32_t> (std::floor 
+                                                                    (std::log2 
+                                                                    (std::max (width, height)))) + 1;
+                        /* Unless the mip levels are generated on the host, we will be using vkCmdBlitImage to generate 
+                         * all the mip levels, which is quiet convenient, but unfortunately it is not guaranteed to be 
+                         * supported on all platforms. It requires the image format we use to support linear filtering. 
+                         * There are two alternatives in this case. You could implement a function that searches common 
+                         * texture image formats for one that does support linear blitting, or you could implement the 
+                         * mipmap generation in software (see ENABLE_HOST_MIP_GENERATION). Each mip level can then be 
+                         * loaded into the image in the same way that you loaded the original image.
+                         * 
+                         * It should be noted that it is uncommon in practice to generate the mipmap levels at runtime 
+                         * anyway. Usually they are pregenerated and stored in the texture file alongside the base level 
+                         * to improve loading speed, which is what the block compressed containers are for
+                        */
+                        auto formatCandidates = std::vector {
+                            VK_FORMAT_R8G8B8A8_SRGB
+                        };
+                        info.imageFilePath = path;
+                        info.format        = getSupportedFormat (deviceInfoId,
+                                                                 formatCandidates,
+                                                                 VK_IMAGE_TILING_OPTIMAL,
+                                                                 VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT);
+                        info.width         = static_cast <uint32_t> (width);
+                        info.height        = static_cast <uint32_t> (height);
+                        info.mipLevels     = mipLevels;
+#if ENABLE_HOST_MIP_GENERATION
+                        info.copyMipLevels = mipLevels;
+#else
+                        info.copyMipLevels = 1;
+#endif  // ENABLE_HOST_MIP_GENERATION
+                    }
+                    /* Although we could set up the shader to access the pixel values in the buffer, it's better to use 
+                     * image objects in Vulkan for this purpose. Image objects will make it easier and faster to retrieve 
+                     * colors by allowing us to use 2D coordinates
+                     * 
+                     * format
+                     * Vulkan supports many possible image formats, but we should use the same format for the texels as 
+                     * the pixels in the buffer, otherwise the copy operation will fail
+                     * 
+                     * tiling
+                     * If you want to be able to directly access texels in the memory of the image, then you must use 
+                     * VK_IMAGE_TILING_LINEAR. We will be using a staging buffer instead of a staging image, so this 
+                     * won't be necessary. We will be using VK_IMAGE_TILING_OPTIMAL for efficient access from the shader
+                     *
+                     * usage 
+                     * The usage field has the same semantics as the one during buffer creation. The image is going to be 
+                     * used as destination for the buffer copy, so it should be set up as a transfer destination. We also 
+                     * want to be able to access the image from the shader to color our mesh, so the usage should include 
+                     * VK_IMAGE_USAGE_SAMPLED_BIT
+                    */
+                    auto imageShareQueueFamilyIndices = std::vector {
+                        deviceInfo->meta.graphicsFamilyIndex.value(),
+#if !ENABLE_QUEUE_FAMILY_OWNERSHIP_TRANSFER
+                        deviceInfo->meta.transferFamilyIndex.value()
+#endif  // ENABLE_QUEUE_FAMILY_OWNERSHIP_TRANSFER
+                    };
+                    uint32_t baseWidth  = std::max (info.width  >> info.baseMipLevel, 1u);
+                    uint32_t baseHeight = std::max (info.height >> info.baseMipLevel, 1u);
+                    createImageResources (deviceInfoId, 
+                                          imageInfoId,
+                                          TEXTURE_IMAGE,
+                                          baseWidth,
+                                          baseHeight,
+                                          info.mipLevels - info.baseMipLevel,
+                                          VK_IMAGE_LAYOUT_UNDEFINED,
+                                          info.format,
+                                          VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                                          VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                                          VK_IMAGE_USAGE_SAMPLED_BIT,
+                                          VK_SAMPLE_COUNT_1_BIT,
+                                          VK_IMAGE_TILING_OPTIMAL,
+                                          VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                          imageShareQueueFamilyIndices,
+                                          VK_IMAGE_ASPECT_COLOR_BIT);
 
-                if (!pixels) {
-                    LOG_ERROR (m_VKTextureImageLog) << "Failed to load texture image " 
-                                                    << "[" << imageInfoId << "]"
+                    info.size = getMipChainSize (info.format, baseWidth, baseHeight, info.copyMipLevels);
+                    decodeInfos.push_back (info);
+                }
+                /* The default diffuse texture is always decoded from its source image here (it is small), since its
+                 * image may be loaded from a block compressed container
+                */
+                m_defaultTextureInfo.imageInfoId = textureImagePool.at (g_coreSettings.defaultDiffuseTexturePath);
+                if (!getLinearColor (g_coreSettings.defaultDiffuseTexturePath, m_defaultTextureInfo.color)) {
+                    LOG_ERROR (m_VKTextureImageLog) << "Failed to load default texture image " 
+                                                    << "[" << m_defaultTextureInfo.imageInfoId << "]"
                                                     << " "
-                                                    << "[" << imageFilePath << "]"
+                                                    << "[" << g_coreSettings.defaultDiffuseTexturePath << "]"
                                                     << std::endl;
-                    throw std::runtime_error ("Failed to load texture image");
+                    throw std::runtime_error ("Failed to load default texture image");
                 }
-
-                /* The pixels are laid out row by row with 4 bytes per pixel in the case of STBI_rgb_alpha for a total of 
-                 * texWidth * texHeight * 4 values
+                LOG_INFO (m_VKTextureImageLog) << "Default texture color "
+                                               << "[" << m_defaultTextureInfo.imageInfoId << "]"
+                                               << " "
+                                               << "[" << m_defaultTextureInfo.color.r << ", "
+                                                      << m_defaultTextureInfo.color.g << ", "
+                                                      << m_defaultTextureInfo.color.b << ", "
+                                                      << m_defaultTextureInfo.color.a << "]"
+                                               << std::endl;
+#if ENABLE_PROGRESSIVE_STARTUP
+                /* Only the default diffuse texture is loaded before the first frame, it is sampled in place of every
+                 * other texture until they are loaded in batches after the first frame (see updateTextureLoads). The
+                 * images of all textures are still created here, since their headers are cheap to read
                 */
-                VkDeviceSize size = static_cast <VkDeviceSize> (width * height * 4);
-                auto stagingBufferShareQueueFamilyIndices = std::vector {
-                    deviceInfo->meta.transferFamilyIndex.value()
-                };
-                /* Create staging buffer, the buffer should be in host visible memory so that we can map it and it 
-                 * should be usable as a transfer source so that we can copy it to an image later on
+                load.meta.placeholderImageInfoId = m_defaultTextureInfo.imageInfoId;
+                std::stable_partition (decodeInfos.begin(), decodeInfos.end(), [&] (const TextureDecodeInfo& info) {
+                    return info.imageInfoId == load.meta.placeholderImageInfoId;
+                });
+                size_t loadEnd = 1;
+#else
+                size_t loadEnd = decodeInfos.size();
+#endif  // ENABLE_PROGRESSIVE_STARTUP
+                load.meta.decodeInfoIndices.resize (decodeInfos.size());
+                for (size_t i = 0; i < decodeInfos.size(); i++)
+                    load.meta.decodeInfoIndices[decodeInfos[i].imageInfoId] = i;
+                /* Reserve staging space for as many textures as will fit in the staging buffer, and decode them in to it 
+                 * in parallel. When the next texture does not fit, the batch so far is decoded and its copies recorded,
+                 * so that the reservation that follows can safely submit them and start over
                 */
-                createBuffer (deviceInfoId, 
-                              imageInfoId,
-                              STAGING_BUFFER_TEX,
-                              size,
-                              VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | 
-                              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                              stagingBufferShareQueueFamilyIndices);
-
-                /* Now, we can directly copy the pixel values that we got from the image loading library to the buffer
-                */
-                auto bufferInfo = getBufferInfo (imageInfoId, STAGING_BUFFER_TEX);
-                vkMapMemory (deviceInfo->resource.logDevice, 
-                             bufferInfo->resource.bufferMemory, 
-                             0, 
-                             size, 
-                             0, 
-                             &bufferInfo->meta.bufferMapped);
-                memcpy (bufferInfo->meta.bufferMapped, pixels, static_cast <size_t> (size));
-                vkUnmapMemory (deviceInfo->resource.logDevice, bufferInfo->resource.bufferMemory);
-
-                /* Clean up the original pixel array
-                */
-                stbi_image_free (pixels);
+                size_t batchBegin = 0;
+                for (size_t i = 0; i < loadEnd; i++) {
+                    auto& info = decodeInfos[i];
+                    if (!isStagingSpaceAvailable (info.size)) {
+                        decodeTextureBatch (batchBegin, i);
+                        batchBegin = i;
+                    }
+                    info.stagingSpace = reserveStagingSpace (deviceInfoId, info.size, info.srcOffset);
+                }
+                decodeTextureBatch (batchBegin, loadEnd);
+                load.meta.loadedCount = loadEnd;
 
-                /* Although we could set up the shader to access the pixel values in the buffer, it's better to use image 
-                 * objects in Vulkan for this purpose. Image objects will make it easier and faster to retrieve colors 
-                 * by allowing us to use 2D coordinates
-                 * 
-                 * format
-                 * Vulkan supports many possible image formats, but we should use the same format for the texels as the 
-                 * pixels in the buffer, otherwise the copy operation will fail
-                 * 
-                 * tiling
-                 * If you want to be able to directly access texels in the memory of the image, then you must use 
-                 * VK_IMAGE_TILING_LINEAR. We will be using a staging buffer instead of a staging image, so this won't be 
-                 * necessary. We will be using VK_IMAGE_TILING_OPTIMAL for efficient access from the shader
-                 *
-                 * usage 
-                 * The usage field has the same semantics as the one during buffer creation. The image is going to be 
-                 * used as destination for the buffer copy, so it should be set up as a transfer destination. We also 
-                 * want to be able to access the image from the shader to color our mesh, so the usage should include 
-                 * VK_IMAGE_USAGE_SAMPLED_BIT
-                */
+                auto endTime = std::chrono::high_resolution_clock::now();
+                LOG_INFO (m_VKTextureImageLog) << "Texture images decoded "
+                                               << "[" << loadEnd << "/" << decodeInfos.size() << "]"
+                                               << " "
+                                               << "[" << std::chrono::duration <float, std::chrono::milliseconds::period> 
+                                                         (endTime - startTime).count() << " ms" << "]"
+                                               << std::endl;
+            }
 
-                /* We will be using vkCmdBlitImage to generate all the mip levels, which is quiet convenient, but 
-                 * unfortunately it is not guaranteed to be supported on all platforms. It requires the image format 
-                 * we use to support linear filtering. There are two alternatives in this case. You could implement a 
-                 * function that searches common texture image formats for one that does support linear blitting, or you 
-                 * could implement the mipmap generation in software with a library like stb_image_resize. Each mip level 
-                 * can then be loaded into the image in the same way that you loaded the original image.
-                 * 
-                 * It should be noted that it is uncommon in practice to generate the mipmap levels at runtime anyway. 
-                 * Usually they are pregenerated and stored in the texture file alongside the base level to improve 
-                 * loading speed
-                */
-                auto formatCandidates = std::vector {
-                    VK_FORMAT_R8G8B8A8_SRGB
-                };
-                auto format = getSupportedFormat (deviceInfoId,
-                                                  formatCandidates,
-                                                  VK_IMAGE_TILING_OPTIMAL,
-                                                  VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT);
-
-                auto imageShareQueueFamilyIndices = std::vector {
-                    deviceInfo->meta.graphicsFamilyIndex.value(),
-                    deviceInfo->meta.transferFamilyIndex.value()
+            /* Record the blits that fill the mip levels which were not copied from the host (if any), and prepare all 
+             * mip levels for shader access. Note that, this has to be submitted to a queue with graphics capability
+            */
+            void recordTextureMipMaps (VkCommandBuffer commandBuffer) {
+                for (size_t i = 0; i < m_textureLoadInfo.meta.loadedCount; i++) {
+                    auto const& info = m_textureDecodeInfos[i];
+                    info.baseMipLevel + info.copyMipLevels == info.mipLevels ? 
+                    transitionImageToShaderRead (info.imageInfoId, TEXTURE_IMAGE, commandBuffer):
+                    blitImageToMipMaps          (info.imageInfoId, TEXTURE_IMAGE, commandBuffer);
+                }
+            }
+
+            uint32_t getDefaultTextureImageInfoId (void) {
+                return m_defaultTextureInfo.imageInfoId;
+            }
+
+            glm::vec4 getDefaultTextureColor (void) {
+                return m_defaultTextureInfo.color;
+            }
+
+            const std::vector <TextureDecodeInfo>& getTextureDecodeInfos (void) {
+                return m_textureDecodeInfos;
+            }
+
+            bool areTextureImagesLoaded (void) {
+                return m_textureLoadInfo.meta.loadedCount == m_textureDecodeInfos.size();
+            }
+
+            bool isTextureImageLoaded (uint32_t imageInfoId) {
+                return m_textureLoadInfo.meta.decodeInfoIndices[imageInfoId] < m_textureLoadInfo.meta.loadedCount;
+            }
+
+            /* Returns the image that is sampled in place of the texture, which is the placeholder texture until the 
+             * texture has been loaded
+            */
+            uint32_t getSampledTextureImageInfoId (uint32_t imageInfoId) {
+                return isTextureImageLoaded (imageInfoId) ? imageInfoId: m_textureLoadInfo.meta.placeholderImageInfoId;
+            }
+
+            /* Called once every frame, after the frame's fence has been waited on. This moves the textures that are 
+             * loaded after the first frame through their stages (decode on the worker threads, copy on the transfer 
+             * queue), without ever blocking the frame loop
+            */
+            void updateTextureLoads (uint32_t deviceInfoId) {
+                auto& load = m_textureLoadInfo;
+                if (load.meta.decoding && isTextureDecodeBatchDone()) {
+                    finishTextureDecodeBatch();
+                    flushStagingBuffer (deviceInfoId, VK_NULL_HANDLE);
+                    load.meta.transferring = true;
+                }
+                if (load.meta.transferring && isStagingBufferIdle (deviceInfoId))
+                    completeTextureLoadBatch (deviceInfoId);
+
+                if (!load.meta.decoding && !load.meta.transferring && !areTextureImagesLoaded())
+                    scheduleTextureLoadBatch (deviceInfoId);
+            }
+
+            /* Record the blits (or transitions) of the textures that have landed since the last frame, this has to be 
+             * recorded in to the frame's command buffer before the render pass begins
+            */
+            void recordTextureLoadTransitions (VkCommandBuffer commandBuffer) {
+                auto& load = m_textureLoadInfo;
+                recordOwnershipAcquires (commandBuffer);
+                for (auto const& index: load.pendingTransitions) {
+                    auto const& info = m_textureDecodeInfos[index];
+                    info.baseMipLevel + info.copyMipLevels == info.mipLevels ? 
+                    transitionImageToShaderRead (info.imageInfoId, TEXTURE_IMAGE, commandBuffer):
+                    blitImageToMipMaps          (info.imageInfoId, TEXTURE_IMAGE, commandBuffer);
+                }
+                load.pendingTransitions.clear();
+            }
+
+            /* Wait on the batch that is in flight (if any), and destroy the staging buffer if it hasn't been already
+            */
+            void cleanUpTextureLoads (uint32_t deviceInfoId) {
+                auto& load = m_textureLoadInfo;
+                if (load.meta.decoding)
+                    finishTextureDecodeBatch();
+                if (areTextureImagesLoaded())
+                    return;
+
+                submitStagingBuffer  (deviceInfoId);
+                cleanUpStagingBuffer (deviceInfoId);
+            }
+
+            /* Compare the memory taken up by the texture images against what they would have taken up as decoded images
+             * (with a full mip chain), grouped by the directory they were loaded from (texture set)
+            */
+            void dumpTextureImageStats (void) {
+                struct TextureSetStats {
+                    uint32_t texturesCount;
+                    VkDeviceSize size;
+                    VkDeviceSize decodedSize;
+                    float decodeTime;
                 };
-                createImageResources (deviceInfoId, 
-                                      imageInfoId,
-                                      TEXTURE_IMAGE,
-                                      static_cast <uint32_t> (width),
-                                      static_cast <uint32_t> (height),
-                                      mipLevels,
-                                      VK_IMAGE_LAYOUT_UNDEFINED,
-                                      format,
-                                      VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
-                                      VK_IMAGE_USAGE_TRANSFER_DST_BIT |
-                                      VK_IMAGE_USAGE_SAMPLED_BIT,
-                                      VK_SAMPLE_COUNT_1_BIT,
-                                      VK_IMAGE_TILING_OPTIMAL,
-                                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                                      imageShareQueueFamilyIndices,
-                                      VK_IMAGE_ASPECT_COLOR_BIT);
+                std::map <std::string, TextureSetStats> textureSetStats;
+
+                for (auto const& info: m_textureDecodeInfos) {
+                    auto setPath  = std::filesystem::path (info.imageFilePath).parent_path().string();
+                    auto& stats   = textureSetStats[setPath];
+                    stats.texturesCount++;
+                    stats.size        += getMipChainSize (info.format, 
+                                                          std::max (info.width  >> info.baseMipLevel, 1u),
+                                                          std::max (info.height >> info.baseMipLevel, 1u),
+                                                          info.mipLevels - info.baseMipLevel);
+                    stats.decodedSize += getMipChainSize (VK_FORMAT_R8G8B8A8_SRGB, info.width, info.height, 
+                                                          info.mipLevels);
+                    stats.decodeTime  += info.decodeTime;
+                }
+
+                LOG_INFO (m_VKTextureImageLog) << "Dumping texture image stats"
+                                               << std::endl;
+
+                for (auto const& [setPath, stats]: textureSetStats) {
+                    LOG_INFO (m_VKTextureImageLog) << "Texture set "
+                                                   << "[" << setPath << "]"
+                                                   << " "
+                                                   << "[" << stats.texturesCount << "]"
+                                                   << std::endl;
+
+                    LOG_INFO (m_VKTextureImageLog) << "Size "
+                                                   << "[" << stats.decodedSize << "]"
+                                                   << "->"
+                                                   << "[" << stats.size << "]"
+                                                   << std::endl;
+
+                    LOG_INFO (m_VKTextureImageLog) << "Saved size "
+                                                   << "[" << stats.decodedSize - stats.size << "]"
+                                                   << std::endl;
+
+                    LOG_INFO (m_VKTextureImageLog) << "Load time "
+                                                   << "[" << stats.decodeTime << " ms" << "]"
+                                                   << std::endl;
+                }
             }
     };
 }   // namespace Core
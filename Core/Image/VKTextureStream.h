@@ -0,0 +1,733 @@
+#ifndef VK_TEXTURE_STREAM_H
+#define VK_TEXTURE_STREAM_H
+
+#include "VKTextureImage.h"
+#include "../Model/VKModelMgr.h"
+#include "../Scene/VKCameraMgr.h"
+
+namespace Core {
+    /* Textures that are loaded from block compressed containers start out with only their smallest mip levels resident
+     * (see ENABLE_TEXTURE_STREAMING). Every frame, the mip level that each texture is required at is worked out from the
+     * projected size of the instances that use it, and textures that need more detail than they hold are streamed in
+     * on the transfer queue without stalling the frame loop
+     *
+     * Since an image cannot gain mip levels after it is created, streaming a texture in (or evicting it) means creating
+     * a new image that holds the levels from the required level downwards. The levels are read from the container in
+     * to a dedicated staging buffer on a loader thread, their copies are submitted to the transfer queue, and once the
+     * transfer fence is signaled the new image takes the place of the old one under the same image info id. Note that,
+     * a smaller image takes the place of clamping the sampler's min lod, since the levels that are not resident simply
+     * do not exist in the image that is sampled from
+     *
+     * The new image is written to a new slot in the texture table right away, while the frames in flight that were
+     * recorded before keep sampling the old image through the old slot. The old image is cleaned up when no frame in
+     * flight can be using it anymore
+    */
+    class VKTextureStream: protected virtual VKTextureImage,
+                           protected virtual VKModelMgr,
+                           protected virtual VKCameraMgr {
+        private:
+            struct StreamedTextureInfo {
+                uint32_t imageInfoId;
+                std::string containerFilePath;
+                VkFormat format;
+                uint32_t width;
+                uint32_t height;
+                uint32_t mipLevels;
+                std::vector <Utils::KTXLevelIndex> levelIndices;
+                /* The texture never drops below its initial level, and never streams in past the min level, which is
+                 * the largest level whose mip chain fits in the staging buffer
+                */
+                uint32_t initialBaseMipLevel;
+                uint32_t minBaseMipLevel;
+                uint32_t residentBaseMipLevel;
+                uint32_t requiredBaseMipLevel;
+                /* Frame in which the resident levels were last required, used to pick the least recently used texture
+                 * for eviction
+                */
+                uint64_t lastRequiredFrame;
+                bool pending;
+            };
+
+            struct StreamRequestInfo {
+                uint32_t textureIndex;
+                /* Image info that the new image is created under, until it takes the place of the texture's image
+                */
+                uint32_t imageInfoId;
+                uint32_t baseMipLevel;
+                VkDeviceSize srcOffset;
+                VkDeviceSize size;
+            };
+
+            struct RetiredImageInfo {
+                uint32_t imageInfoId;
+                /* The image is cleaned up once this many frames have been recorded
+                */
+                uint64_t retireFrame;
+            };
+
+            struct TextureStreamInfo {
+                struct Meta {
+                    uint32_t bufferInfoId;
+                    uint32_t fenceInfoId;
+                    uint8_t* bufferMapped;
+                    VkDeviceSize alignment;
+                    uint32_t nextImageInfoId;
+                    uint64_t framesCount;
+                    VkDeviceSize residentSize;
+                    /* A batch is either being read in to the staging buffer (loading), or being copied on the transfer
+                     * queue (transferring). Only one batch is in progress at a time
+                    */
+                    bool loading;
+                    bool transferring;
+                    bool loadFailed;
+                    std::atomic <bool> loaded;
+                    /* Set if the streamed images are owned exclusively by the graphics queue family, in which case they
+                     * are handed over from the transfer queue family once their copies are done
+                    */
+                    bool ownershipTransfer;
+                    uint32_t graphicsFamilyIndex;
+                    uint32_t transferFamilyIndex;
+                } meta;
+
+                struct Resource {
+                    VkCommandPool commandPool;
+                    VkCommandBuffer commandBuffer;
+                    std::thread loader;
+                } resource;
+
+                struct Stats {
+                    uint32_t streamedInCount;
+                    uint32_t evictedCount;
+                    uint32_t batchesCount;
+                    VkDeviceSize streamedSize;
+                    VkDeviceSize peakResidentSize;
+                } stats;
+
+                std::vector <StreamedTextureInfo> textures;
+                /* Index of each texture image info id in to the textures above, UINT32_MAX if it is not streamed
+                */
+                std::vector <uint32_t> textureIndices;
+                std::unordered_map <uint32_t, float> modelRadii;
+                std::vector <uint32_t> candidates;
+                std::vector <StreamRequestInfo> requests;
+                std::vector <RetiredImageInfo> retiredImages;
+                /* Ids of the retired images that have been cleaned up, these are handed out again before new ids are
+                 * taken, so that the ids (and the image info pool's key array) do not grow over a long session
+                */
+                std::vector <uint32_t> freeImageInfoIds;
+                /* Texture image info ids whose new image is yet to be prepared for shader access
+                */
+                std::vector <uint32_t> pendingTransitions;
+            } m_textureStreamInfo;
+
+            Log::Record* m_VKTextureStreamLog;
+            const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
+
+            VkDeviceSize getResidentSize (const StreamedTextureInfo& texture, uint32_t baseMipLevel) {
+                return getMipChainSize (texture.format,
+                                        std::max (texture.width  >> baseMipLevel, 1u),
+                                        std::max (texture.height >> baseMipLevel, 1u),
+                                        texture.mipLevels - baseMipLevel);
+            }
+
+            /* Runs on the loader thread, so it must not make any Vulkan calls. The levels of each request are read in to
+             * its region of the staging buffer, and the loaded flag is set once all of them are done. The requests that
+             * fail to load are logged here, the batch as a whole is failed once it is submitted
+            */
+            static void loadTextureStreamBatch (TextureStreamInfo& info, Log::Record* log) {
+                bool loadFailed = false;
+                for (auto const& request: info.requests) {
+                    auto const& texture   = info.textures[request.textureIndex];
+                    uint8_t* stagingSpace = info.meta.bufferMapped + request.srcOffset;
+                    std::ifstream file (texture.containerFilePath, std::ios::binary);
+
+                    for (size_t i = request.baseMipLevel; i < texture.levelIndices.size(); i++) {
+                        file.seekg (static_cast <std::streamoff> (texture.levelIndices[i].byteOffset));
+                        file.read  (reinterpret_cast <char*> (stagingSpace),
+                                    static_cast <std::streamsize> (texture.levelIndices[i].byteLength));
+                        stagingSpace += texture.levelIndices[i].byteLength;
+                    }
+                    if (!file.good()) {
+                        LOG_ERROR (log) << "Failed to load streamed texture levels "
+                                        << "[" << texture.imageInfoId << "]"
+                                        << " "
+                                        << "[" << texture.containerFilePath << "]"
+                                        << " "
+                                        << "[" << request.baseMipLevel << "]"
+                                        << std::endl;
+                        loadFailed = true;
+                    }
+                }
+                info.meta.loadFailed = loadFailed;
+                info.meta.loaded.store (true, std::memory_order_release);
+            }
+
+            /* The mip level a texture is required at is found by comparing its size against the size (in pixels) that
+             * the instances using it are projected to on the screen. We assume that a texture is stretched across the
+             * bounding sphere of the model once, so that the texture needs a level that is about as wide as the
+             * projected diameter of the bounding sphere
+            */
+            void updateTextureDemand (uint32_t deviceInfoId,
+                                      const std::vector <uint32_t>& modelInfoIds,
+                                      uint32_t cameraInfoId) {
+
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto cameraInfo = getCameraInfo (cameraInfoId);
+                auto& info      = m_textureStreamInfo;
+
+                for (auto& texture: info.textures)
+                    texture.requiredBaseMipLevel = texture.initialBaseMipLevel;
+                /* Number of pixels covered by a unit length at unit distance from the camera
+                */
+                float pixelsPerUnit = deviceInfo->params.swapChainExtent.height /
+                                      (2.0f * std::tan (glm::radians (cameraInfo->meta.fovDeg) * 0.5f));
+
+                for (auto const& infoId: modelInfoIds) {
+                    auto modelInfo = getModelInfo (infoId);
+                    float radius   = info.modelRadii[infoId];
+
+                    for (auto const& instance: modelInfo->meta.instances) {
+                        glm::vec3 position = glm::vec3 (instance.modelMatrix[3]);
+                        float scale        = std::max ({glm::length (glm::vec3 (instance.modelMatrix[0])),
+                                                        glm::length (glm::vec3 (instance.modelMatrix[1])),
+                                                        glm::length (glm::vec3 (instance.modelMatrix[2]))});
+                        float distance     = std::max (glm::distance (position, cameraInfo->meta.position) -
+                                                       radius * scale,
+                                                       cameraInfo->meta.nearPlane);
+                        float projectedSize = std::max (2.0f * radius * scale * pixelsPerUnit / distance, 1.0f);
+
+                        for (auto const& texId: modelInfo->id.diffuseTextureImageInfos) {
+                            /* Look up the texture that the instance actually uses in place of the model's texture
+                            */
+                            const uint32_t numColumns = 4;
+                            uint32_t imageInfoId      = static_cast <uint32_t>
+                                                        (instance.texIdLUT[texId / numColumns][texId % numColumns]);
+                            if (imageInfoId >= info.textureIndices.size() ||
+                                info.textureIndices[imageInfoId] == UINT32_MAX)
+                                continue;
+
+                            auto& texture  = info.textures[info.textureIndices[imageInfoId]];
+                            float level    = std::log2 (std::max (texture.width, texture.height) / projectedSize) +
+                                             g_textureStreamSettings.mipLevelBias;
+                            uint32_t requiredBaseMipLevel = static_cast <uint32_t>
+                                                            (std::clamp (std::floor (level),
+                                                             static_cast <float> (texture.minBaseMipLevel),
+                                                             static_cast <float> (texture.initialBaseMipLevel)));
+
+                            texture.requiredBaseMipLevel  = std::min (texture.requiredBaseMipLevel,
+                                                                      requiredBaseMipLevel);
+                        }
+                    }
+                }
+
+                for (auto& texture: info.textures) {
+                    if (texture.requiredBaseMipLevel <= texture.residentBaseMipLevel)
+                        texture.lastRequiredFrame = info.meta.framesCount;
+                }
+            }
+
+            /* Create the image that will take the place of a texture's image, and reserve the region of the staging
+             * buffer that its levels will be read in to. Returns false if there isn't enough space left in the staging
+             * buffer
+            */
+            bool addStreamRequest (uint32_t deviceInfoId,
+                                   uint32_t textureIndex,
+                                   uint32_t baseMipLevel,
+                                   VkDeviceSize& stagingOffset) {
+
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto& info      = m_textureStreamInfo;
+                auto& texture   = info.textures[textureIndex];
+
+                VkDeviceSize size   = getResidentSize (texture, baseMipLevel);
+                VkDeviceSize offset = (stagingOffset + info.meta.alignment - 1) / info.meta.alignment *
+                                       info.meta.alignment;
+                if (offset + size > g_textureStreamSettings.stagingBufferSize)
+                    return false;
+
+                StreamRequestInfo request;
+                request.textureIndex = textureIndex;
+                if (!info.freeImageInfoIds.empty()) {
+                    request.imageInfoId = info.freeImageInfoIds.back();
+                    info.freeImageInfoIds.pop_back();
+                }
+                else
+                    request.imageInfoId = info.meta.nextImageInfoId++;
+                request.baseMipLevel = baseMipLevel;
+                request.srcOffset    = offset;
+                request.size         = size;
+
+                auto imageShareQueueFamilyIndices = std::vector {
+                    deviceInfo->meta.graphicsFamilyIndex.value(),
+#if !ENABLE_QUEUE_FAMILY_OWNERSHIP_TRANSFER
+                    deviceInfo->meta.transferFamilyIndex.value()
+#endif  // ENABLE_QUEUE_FAMILY_OWNERSHIP_TRANSFER
+                };
+                createImageResources (deviceInfoId,
+                                      request.imageInfoId,
+                                      TEXTURE_IMAGE,
+                                      std::max (texture.width  >> baseMipLevel, 1u),
+                                      std::max (texture.height >> baseMipLevel, 1u),
+                                      texture.mipLevels - baseMipLevel,
+                                      VK_IMAGE_LAYOUT_UNDEFINED,
+                                      texture.format,
+                                      VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                                      VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                                      VK_IMAGE_USAGE_SAMPLED_BIT,
+                                      VK_SAMPLE_COUNT_1_BIT,
+                                      VK_IMAGE_TILING_OPTIMAL,
+                                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                      imageShareQueueFamilyIndices,
+                                      VK_IMAGE_ASPECT_COLOR_BIT);
+
+                texture.pending = true;
+                stagingOffset   = offset + size;
+                info.requests.push_back (request);
+                return true;
+            }
+
+            /* Pick the textures that need the most detail compared to what they hold, and make room for them under the
+             * memory budget by evicting the least recently used textures that hold more detail than they need
+            */
+            void scheduleTextureStreamBatch (uint32_t deviceInfoId) {
+                auto& info       = m_textureStreamInfo;
+                auto& candidates = info.candidates;
+
+                candidates.clear();
+                for (uint32_t i = 0; i < info.textures.size(); i++) {
+                    auto const& texture = info.textures[i];
+                    /* Textures that are yet to be loaded (see ENABLE_PROGRESSIVE_STARTUP) are left alone
+                    */
+                    if (!texture.pending && texture.requiredBaseMipLevel < texture.residentBaseMipLevel &&
+                        isTextureImageLoaded (texture.imageInfoId))
+                        candidates.push_back (i);
+                }
+                if (candidates.empty())
+                    return;
+
+                std::sort (candidates.begin(), candidates.end(), [&info] (uint32_t a, uint32_t b) {
+                    auto const& textureA = info.textures[a];
+                    auto const& textureB = info.textures[b];
+                    return textureA.residentBaseMipLevel - textureA.requiredBaseMipLevel >
+                           textureB.residentBaseMipLevel - textureB.requiredBaseMipLevel;
+                });
+
+                VkDeviceSize stagingOffset = 0;
+                VkDeviceSize projectedSize = info.meta.residentSize;
+                uint32_t streamedInCount   = 0;
+
+                for (auto const& textureIndex: candidates) {
+                    if (streamedInCount == g_textureStreamSettings.maxTexturesPerBatch)
+                        break;
+
+                    auto& texture     = info.textures[textureIndex];
+                    VkDeviceSize grow = getResidentSize (texture, texture.requiredBaseMipLevel) -
+                                        getResidentSize (texture, texture.residentBaseMipLevel);
+
+                    while (projectedSize + grow > g_textureStreamSettings.memoryBudget) {
+                        uint32_t victimIndex = UINT32_MAX;
+                        for (uint32_t i = 0; i < info.textures.size(); i++) {
+                            auto const& victim = info.textures[i];
+                            if (victim.pending || victim.requiredBaseMipLevel <= victim.residentBaseMipLevel)
+                                continue;
+                            if (victimIndex == UINT32_MAX ||
+                                victim.lastRequiredFrame < info.textures[victimIndex].lastRequiredFrame)
+                                victimIndex = i;
+                        }
+                        if (victimIndex == UINT32_MAX)
+                            break;
+
+                        auto& victim = info.textures[victimIndex];
+                        if (!addStreamRequest (deviceInfoId, victimIndex, victim.requiredBaseMipLevel, stagingOffset))
+                            break;
+                        projectedSize -= getResidentSize (victim, victim.residentBaseMipLevel) -
+                                         getResidentSize (victim, victim.requiredBaseMipLevel);
+                    }
+
+                    if (projectedSize + grow > g_textureStreamSettings.memoryBudget)
+                        continue;
+                    if (!addStreamRequest (deviceInfoId, textureIndex, texture.requiredBaseMipLevel, stagingOffset))
+                        continue;
+
+                    projectedSize += grow;
+                    streamedInCount++;
+                }
+
+                if (info.requests.empty())
+                    return;
+                /* The levels are read from disk on the loader thread, the copies are submitted once it is done
+                */
+                info.meta.loading = true;
+                info.meta.loaded.store (false, std::memory_order_relaxed);
+                info.resource.loader = std::thread (loadTextureStreamBatch, std::ref (info), m_VKTextureStreamLog);
+            }
+
+            void submitTextureStreamBatch (uint32_t deviceInfoId) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto& info      = m_textureStreamInfo;
+
+                info.resource.loader.join();
+                info.meta.loading = false;
+                if (info.meta.loadFailed) {
+                    LOG_ERROR (m_VKTextureStreamLog) << "Failed to load streamed texture levels "
+                                                     << "[" << info.requests.size() << "]"
+                                                     << std::endl;
+                    throw std::runtime_error ("Failed to load streamed texture levels");
+                }
+
+                vkResetCommandBuffer (info.resource.commandBuffer, 0);
+                beginRecording       (info.resource.commandBuffer,
+                                      VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+                                      VK_NULL_HANDLE);
+
+                for (auto const& request: info.requests) {
+                    auto const& texture = info.textures[request.textureIndex];
+                    copyBufferToImage (info.meta.bufferInfoId,
+                                       request.imageInfoId,
+                                       STAGING_BUFFER, TEXTURE_IMAGE,
+                                       request.srcOffset,
+                                       texture.mipLevels - request.baseMipLevel,
+                                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                       info.resource.commandBuffer);
+                    if (info.meta.ownershipTransfer)
+                        transferImageOwnership (request.imageInfoId, TEXTURE_IMAGE,
+                                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                info.meta.transferFamilyIndex,
+                                                info.meta.graphicsFamilyIndex,
+                                                VK_ACCESS_TRANSFER_WRITE_BIT,
+                                                VK_ACCESS_NONE,
+                                                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                                VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                                info.resource.commandBuffer);
+                }
+                endRecording (info.resource.commandBuffer);
+
+                VkSubmitInfo submitInfo{};
+                submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                submitInfo.commandBufferCount = 1;
+                submitInfo.pCommandBuffers    = &info.resource.commandBuffer;
+
+                VkResult result = vkQueueSubmit (deviceInfo->resource.transferQueue,
+                                                 1,
+                                                 &submitInfo,
+                                                 getFenceInfo (info.meta.fenceInfoId,
+                                                               FEN_TRANSFER_DONE)->resource.fence);
+                if (result != VK_SUCCESS) {
+                    LOG_ERROR (m_VKTextureStreamLog) << "Failed to submit texture stream copies "
+                                                     << "[" << deviceInfoId << "]"
+                                                     << " "
+                                                     << "[" << string_VkResult (result) << "]"
+                                                     << std::endl;
+                    throw std::runtime_error ("Failed to submit texture stream copies");
+                }
+                info.meta.transferring = true;
+            }
+
+            /* Once the copies are done, the new images take the place of the old ones. The old images are cleaned up
+             * after every frame in flight has moved on to the new images and has been waited on at least once since
+             * then
+            */
+            void completeTextureStreamBatch (uint32_t deviceInfoId) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto fenceInfo  = getFenceInfo  (m_textureStreamInfo.meta.fenceInfoId, FEN_TRANSFER_DONE);
+                auto& info      = m_textureStreamInfo;
+
+                if (vkGetFenceStatus (deviceInfo->resource.logDevice, fenceInfo->resource.fence) != VK_SUCCESS)
+                    return;
+                vkResetFences (deviceInfo->resource.logDevice, 1, &fenceInfo->resource.fence);
+
+                for (auto const& request: info.requests) {
+                    auto& texture = info.textures[request.textureIndex];
+                    swapImageResources (texture.imageInfoId, request.imageInfoId, TEXTURE_IMAGE);
+
+                    RetiredImageInfo retiredImage;
+                    retiredImage.imageInfoId = request.imageInfoId;
+                    retiredImage.retireFrame = info.meta.framesCount + 2 * g_coreSettings.maxFramesInFlight;
+                    info.retiredImages.push_back  (retiredImage);
+                    info.pendingTransitions.push_back (texture.imageInfoId);
+
+                    info.meta.residentSize = info.meta.residentSize -
+                                             getResidentSize (texture, texture.residentBaseMipLevel) +
+                                             request.size;
+                    if (request.baseMipLevel < texture.residentBaseMipLevel) {
+                        info.stats.streamedInCount++;
+                        info.stats.streamedSize += request.size;
+                    }
+                    else
+                        info.stats.evictedCount++;
+
+                    LOG_INFO (m_VKTextureStreamLog) << "Texture streamed "
+                                                    << "[" << texture.imageInfoId << "]"
+                                                    << " "
+                                                    << "[" << texture.residentBaseMipLevel << "]"
+                                                    << "->"
+                                                    << "[" << request.baseMipLevel << "]"
+                                                    << " "
+                                                    << "[" << request.size << "]"
+                                                    << std::endl;
+
+                    texture.residentBaseMipLevel = request.baseMipLevel;
+                    texture.pending              = false;
+                    writeTextureTableEntry (deviceInfoId, texture.imageInfoId, texture.imageInfoId);
+                }
+
+                info.stats.peakResidentSize = std::max (info.stats.peakResidentSize, info.meta.residentSize);
+                info.stats.batchesCount++;
+                info.requests.clear();
+                info.meta.transferring = false;
+            }
+
+            void cleanUpRetiredImages (uint32_t deviceInfoId, bool cleanUpAll) {
+                auto& retiredImages    = m_textureStreamInfo.retiredImages;
+                auto& freeImageInfoIds = m_textureStreamInfo.freeImageInfoIds;
+                auto framesCount       = m_textureStreamInfo.meta.framesCount;
+
+                std::erase_if (retiredImages, [&] (const RetiredImageInfo& retiredImage) {
+                    if (!cleanUpAll && retiredImage.retireFrame > framesCount)
+                        return false;
+                    VKImageMgr::cleanUp (deviceInfoId, retiredImage.imageInfoId, TEXTURE_IMAGE);
+                    freeImageInfoIds.push_back (retiredImage.imageInfoId);
+                    return true;
+                });
+            }
+
+        public:
+            VKTextureStream (void) {
+                m_VKTextureStreamLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+                LOG_SET_THREAD_ID (m_instanceId, true);
+            }
+
+            ~VKTextureStream (void) {
+                LOG_CLOSE (m_instanceId);
+            }
+
+        protected:
+            /* Note that, this is to be called once the texture resources have been created, and before the geometry is
+             * released (if enabled), since the bounding sphere of each model is found from its vertices
+            */
+            void readyTextureStream (uint32_t deviceInfoId,
+                                     const std::vector <uint32_t>& modelInfoIds,
+                                     uint32_t bufferInfoId,
+                                     uint32_t fenceInfoId) {
+
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto& info      = m_textureStreamInfo;
+                auto stagingBufferShareQueueFamilyIndices = std::vector {
+                    deviceInfo->meta.transferFamilyIndex.value()
+                };
+                createBuffer (deviceInfoId,
+                              bufferInfoId,
+                              STAGING_BUFFER,
+                              g_textureStreamSettings.stagingBufferSize,
+                              VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                              stagingBufferShareQueueFamilyIndices);
+                /* The command buffer is re-recorded for every batch, so we need to be able to reset it
+                */
+                auto commandPool    = getCommandPool (deviceInfoId,
+                                                      VK_COMMAND_POOL_CREATE_TRANSIENT_BIT |
+                                                      VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+                                                      deviceInfo->meta.transferFamilyIndex.value());
+                auto commandBuffers = getCommandBuffers (deviceInfoId,
+                                                         commandPool,
+                                                         1,
+                                                         VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+                createFence (deviceInfoId, fenceInfoId, FEN_TRANSFER_DONE, 0);
+
+                info.meta.bufferInfoId          = bufferInfoId;
+                info.meta.fenceInfoId           = fenceInfoId;
+                info.meta.bufferMapped          = static_cast <uint8_t*>
+                                                  (getBufferInfo (bufferInfoId, STAGING_BUFFER)->meta.bufferMapped);
+                info.meta.alignment             = std::max (static_cast <VkDeviceSize> (16),
+                                                            deviceInfo->params.optimalBufferCopyOffsetAlignment);
+                info.meta.framesCount           = 0;
+                info.meta.residentSize          = 0;
+                info.meta.loading               = false;
+                info.meta.transferring          = false;
+                info.meta.loadFailed            = false;
+                info.meta.loaded.store (false);
+                info.meta.ownershipTransfer     = ENABLE_QUEUE_FAMILY_OWNERSHIP_TRANSFER &&
+                                                  deviceInfo->meta.graphicsFamilyIndex.value() != 
+                                                  deviceInfo->meta.transferFamilyIndex.value();
+                info.meta.graphicsFamilyIndex   = deviceInfo->meta.graphicsFamilyIndex.value();
+                info.meta.transferFamilyIndex   = deviceInfo->meta.transferFamilyIndex.value();
+                info.resource.commandPool       = commandPool;
+                info.resource.commandBuffer     = commandBuffers[0];
+                info.stats.streamedInCount      = 0;
+                info.stats.evictedCount         = 0;
+                info.stats.batchesCount         = 0;
+                info.stats.streamedSize         = 0;
+                info.stats.peakResidentSize     = 0;
+                /* Only the textures loaded from containers are streamed. The default diffuse texture is never streamed,
+                 * since it is held in the reserved slot of the texture table
+                */
+                uint32_t maxImageInfoId = 0;
+                for (auto const& decodeInfo: getTextureDecodeInfos()) {
+                    maxImageInfoId = std::max (maxImageInfoId, decodeInfo.imageInfoId);
+                    if (decodeInfo.levelIndices.empty() || decodeInfo.imageInfoId == getDefaultTextureImageInfoId())
+                        continue;
+
+                    StreamedTextureInfo texture;
+                    texture.imageInfoId          = decodeInfo.imageInfoId;
+                    texture.containerFilePath    = decodeInfo.imageFilePath;
+                    texture.format               = decodeInfo.format;
+                    texture.width                = decodeInfo.width;
+                    texture.height               = decodeInfo.height;
+                    texture.mipLevels            = decodeInfo.mipLevels;
+                    texture.levelIndices         = decodeInfo.levelIndices;
+                    texture.initialBaseMipLevel  = decodeInfo.baseMipLevel;
+                    texture.minBaseMipLevel      = decodeInfo.baseMipLevel;
+                    texture.residentBaseMipLevel = decodeInfo.baseMipLevel;
+                    texture.requiredBaseMipLevel = decodeInfo.baseMipLevel;
+                    texture.lastRequiredFrame    = 0;
+                    texture.pending              = false;
+
+                    while (texture.minBaseMipLevel > 0 &&
+                           getResidentSize (texture, texture.minBaseMipLevel - 1) <=
+                           g_textureStreamSettings.stagingBufferSize)
+                        texture.minBaseMipLevel--;
+
+                    info.meta.residentSize += getResidentSize (texture, texture.residentBaseMipLevel);
+                    info.textures.push_back (texture);
+                }
+
+                info.textureIndices.assign (maxImageInfoId + 1, UINT32_MAX);
+                for (uint32_t i = 0; i < info.textures.size(); i++)
+                    info.textureIndices[info.textures[i].imageInfoId] = i;
+                /* The new images are created under ids that come after the texture image pool
+                */
+                info.meta.nextImageInfoId = maxImageInfoId + 1;
+                info.stats.peakResidentSize = info.meta.residentSize;
+                /* Find the bounding sphere (centered at the origin in model space) of each model
+                */
+                for (auto const& infoId: modelInfoIds) {
+                    auto modelInfo = getModelInfo (infoId);
+                    float radius   = 0.0f;
+                    for (auto const& vertex: modelInfo->meta.vertices)
+                        radius = std::max (radius, glm::length (vertex.pos));
+                    info.modelRadii[infoId] = radius;
+                }
+                /* Reserve up front, so that scheduling a batch does not allocate in the frame loop
+                */
+                info.candidates.reserve         (info.textures.size());
+                info.requests.reserve           (info.textures.size());
+                info.retiredImages.reserve      (info.textures.size());
+                info.freeImageInfoIds.reserve   (info.textures.size());
+                info.pendingTransitions.reserve (info.textures.size());
+
+                LOG_INFO (m_VKTextureStreamLog) << "Streamed textures "
+                                                << "[" << info.textures.size() << "]"
+                                                << " "
+                                                << "[" << info.meta.residentSize << "]"
+                                                << "->"
+                                                << "[" << g_textureStreamSettings.memoryBudget << "]"
+                                                << std::endl;
+            }
+
+            /* Advance the texture stream by one step, this is to be called every frame once the fence of the frame in
+             * flight has been waited on
+            */
+            void updateTextureStream (uint32_t deviceInfoId,
+                                      const std::vector <uint32_t>& modelInfoIds,
+                                      uint32_t cameraInfoId) {
+
+                auto& info = m_textureStreamInfo;
+                if (info.meta.loading && info.meta.loaded.load (std::memory_order_acquire))
+                    submitTextureStreamBatch (deviceInfoId);
+
+                if (info.meta.transferring)
+                    completeTextureStreamBatch (deviceInfoId);
+
+                cleanUpRetiredImages (deviceInfoId, false);
+                updateTextureDemand  (deviceInfoId, modelInfoIds, cameraInfoId);
+
+                if (!info.meta.loading && !info.meta.transferring)
+                    scheduleTextureStreamBatch (deviceInfoId);
+            }
+
+            /* Prepare the new images for shader access (taking over their ownership first, if needed), this has to be 
+             * recorded in to the frame's command buffer before the render pass begins. Note that, the copies in to the 
+             * images were complete by the time their transfer fence was signaled
+            */
+            void recordTextureStreamTransitions (VkCommandBuffer commandBuffer) {
+                auto& info = m_textureStreamInfo;
+                for (auto const& imageInfoId: info.pendingTransitions) {
+                    if (info.meta.ownershipTransfer)
+                        transferImageOwnership (imageInfoId, TEXTURE_IMAGE,
+                                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                info.meta.transferFamilyIndex,
+                                                info.meta.graphicsFamilyIndex,
+                                                VK_ACCESS_NONE,
+                                                VK_ACCESS_TRANSFER_WRITE_BIT,
+                                                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                                commandBuffer);
+                    transitionImageToShaderRead (imageInfoId, TEXTURE_IMAGE, commandBuffer);
+                }
+
+                info.pendingTransitions.clear();
+                info.meta.framesCount++;
+            }
+
+            void dumpTextureStreamStats (void) {
+                LOG_INFO (m_VKTextureStreamLog) << "Dumping texture stream stats"
+                                                << std::endl;
+
+                LOG_INFO (m_VKTextureStreamLog) << "Resident size "
+                                                << "[" << m_textureStreamInfo.meta.residentSize << "]"
+                                                << "->"
+                                                << "[" << g_textureStreamSettings.memoryBudget << "]"
+                                                << std::endl;
+
+                LOG_INFO (m_VKTextureStreamLog) << "Peak resident size "
+                                                << "[" << m_textureStreamInfo.stats.peakResidentSize << "]"
+                                                << std::endl;
+
+                LOG_INFO (m_VKTextureStreamLog) << "Streamed size "
+                                                << "[" << m_textureStreamInfo.stats.streamedSize << "]"
+                                                << std::endl;
+
+                LOG_INFO (m_VKTextureStreamLog) << "Streamed in count "
+                                                << "[" << m_textureStreamInfo.stats.streamedInCount << "]"
+                                                << std::endl;
+
+                LOG_INFO (m_VKTextureStreamLog) << "Evicted count "
+                                                << "[" << m_textureStreamInfo.stats.evictedCount << "]"
+                                                << std::endl;
+
+                LOG_INFO (m_VKTextureStreamLog) << "Batches count "
+                                                << "[" << m_textureStreamInfo.stats.batchesCount << "]"
+                                                << std::endl;
+            }
+
+            /* Note that, the device is expected to be idle at this point
+            */
+            void cleanUpTextureStream (uint32_t deviceInfoId) {
+                auto& info = m_textureStreamInfo;
+                if (info.resource.loader.joinable())
+                    info.resource.loader.join();
+                if (info.meta.transferring) {
+                    auto deviceInfo = getDeviceInfo (deviceInfoId);
+                    vkWaitForFences (deviceInfo->resource.logDevice,
+                                     1,
+                                     &getFenceInfo (info.meta.fenceInfoId, FEN_TRANSFER_DONE)->resource.fence,
+                                     VK_TRUE,
+                                     UINT64_MAX);
+                }
+                /* Images of the batch in progress (if any) never took the place of the texture images
+                */
+                for (auto const& request: info.requests)
+                    VKImageMgr::cleanUp (deviceInfoId, request.imageInfoId, TEXTURE_IMAGE);
+                info.requests.clear();
+                cleanUpRetiredImages (deviceInfoId, true);
+
+                cleanUpFence         (deviceInfoId, info.meta.fenceInfoId, FEN_TRANSFER_DONE);
+                VKCmdBuffer::cleanUp (deviceInfoId, info.resource.commandPool);
+                VKBufferMgr::cleanUp (deviceInfoId, info.meta.bufferInfoId, STAGING_BUFFER);
+            }
+    };
+}   // namespace Core
+#endif  // VK_TEXTURE_STREAM_H
@@ -13,9 +13,9 @@ namespace Core {
         public:
             VKInstanceData (void) {
                 m_VKInstanceDataLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO,    Log::TO_FILE_IMMEDIATE);
-                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,    Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_SHARED | Log::TO_CONSOLE);
             }
 
             ~VKInstanceData (void) {
@@ -6,6 +6,7 @@
 #include <tiny_obj_loader.h>
 #include "VKVertexData.h"
 #include "../Scene/VKUniform.h"
+#include "../../Collections/SlotMap/SlotMap.h"
 
 namespace Core {
     class VKModelMgr: protected VKVertexData {
@@ -40,17 +41,18 @@ namespace Core {
                     uint32_t indexBufferInfo;
                 } id;
             };
-            std::unordered_map <uint32_t, ModelInfo>   m_modelInfoPool;
+            SlotMap <ModelInfo>                        m_modelInfoPool;
             std::unordered_map <std::string, uint32_t> m_textureImagePool;
             
             Log::Record* m_VKModelMgrLog;
             const uint32_t m_instanceId = g_collectionsSettings.instanceId++; 
 
             void deleteModelInfo (uint32_t modelInfoId) {
-                if (m_modelInfoPool.find (modelInfoId) != m_modelInfoPool.end()) {
+                auto info = m_modelInfoPool.find (modelInfoId);
+                if (info != nullptr) {
                     /* Delete parsed data log
                     */
-                    LOG_CLOSE (m_modelInfoPool[modelInfoId].meta.parsedDataLogInstanceId);
+                    LOG_CLOSE (info->meta.parsedDataLogInstanceId);
                     m_modelInfoPool.erase (modelInfoId);
                     return;
                 }
@@ -61,47 +63,40 @@ namespace Core {
                 throw std::runtime_error ("Failed to delete model info");   
             }
 
+            /* The parsed data is written to a binary log, since it holds every vertex and index of the model. Use the 
+             * log decoder tool to read it
+            */
             void dumpParsedData (uint32_t modelInfoId) {
                 auto modelInfo     = getModelInfo (modelInfoId);
                 auto parsedDataLog = GET_LOG (modelInfo->meta.parsedDataLogInstanceId);
 
-                LOG_INFO (parsedDataLog) << "Dumping parsed data "
-                                         << "[" << modelInfoId << "]"
-                                         << std::endl;
-
-                LOG_INFO (parsedDataLog) << "Vertex data"
-                                         << std::endl;
+                LOG_BINARY (parsedDataLog, Log::INFO, "Dumping parsed data [{}]", modelInfoId);
+                LOG_BINARY (parsedDataLog, Log::INFO, "Vertex data");
                 for (auto const& vertex: modelInfo->meta.vertices) {
-                LOG_INFO (parsedDataLog) << "[" << vertex.pos.x      << ", " << vertex.pos.y      << ", " 
-                                                << vertex.pos.z      << "]"
-                                         << " "
-                                         << "[" << vertex.texCoord.x << ", " << vertex.texCoord.y << "]"
-                                         << " "
-                                         << "[" << vertex.normal.x   << ", " << vertex.normal.y   << ", "
-                                                << vertex.normal.z   << "]"
-                                         << " "
-                                         << "[" << vertex.texId      << "]"
-                                         << std::endl;
+                LOG_BINARY (parsedDataLog, Log::INFO, "[{}, {}, {}] [{}, {}] [{}, {}, {}] [{}]",
+                            vertex.pos.x,      vertex.pos.y,      vertex.pos.z,
+                            vertex.texCoord.x, vertex.texCoord.y,
+                            vertex.normal.x,   vertex.normal.y,   vertex.normal.z,
+                            vertex.texId);
                 }
 
-                LOG_INFO (parsedDataLog) << "Index data"
-                                         << std::endl;
+                LOG_BINARY (parsedDataLog, Log::INFO, "Index data");
                 uint32_t loopIdx = 0;
                 while (loopIdx < modelInfo->meta.indicesCount) {
-                LOG_INFO (parsedDataLog) << "[" << modelInfo->meta.indices[loopIdx++] << ", "
-                                                << modelInfo->meta.indices[loopIdx++] << ", "
-                                                << modelInfo->meta.indices[loopIdx++]
-                                         << "]"
-                                         << std::endl;
+                LOG_BINARY (parsedDataLog, Log::INFO, "[{}, {}, {}]",
+                            modelInfo->meta.indices[loopIdx],
+                            modelInfo->meta.indices[loopIdx + 1],
+                            modelInfo->meta.indices[loopIdx + 2]);
+                loopIdx += 3;
                 }
             }
 
         public:
             VKModelMgr (void) {
                 m_VKModelMgrLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO,    Log::TO_FILE_IMMEDIATE);
-                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,    Log::TO_FILE_BINARY);
+                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_SHARED | Log::TO_CONSOLE);
             }
 
             ~VKModelMgr (void) {
@@ -113,7 +108,7 @@ namespace Core {
                                  const char* modelPath,
                                  const char* mtlFileDirPath) {
                 
-                if (m_modelInfoPool.find (modelInfoId) != m_modelInfoPool.end()) {
+                if (m_modelInfoPool.contains (modelInfoId)) {
                     LOG_ERROR (m_VKModelMgrLog) << "Model info id already exists "
                                                 << "[" << modelInfoId << "]"
                                                 << std::endl;
@@ -128,27 +123,40 @@ namespace Core {
                  * texture can sample from this default texture
                 */
                 info.path.diffuseTextureImages.push_back (g_coreSettings.defaultDiffuseTexturePath);
-                m_modelInfoPool[modelInfoId]      = info;
+                m_modelInfoPool.insert (modelInfoId, info);
                 /* Config log for parsed data
                 */
                 std::string nameExtension = "_PD_" + std::to_string (modelInfoId);
                 LOG_INIT       (info.meta.parsedDataLogInstanceId, g_collectionsSettings.logSaveDirPath);
                 LOG_ADD_CONFIG (info.meta.parsedDataLogInstanceId, 
                                 Log::INFO, 
-                                Log::TO_FILE_IMMEDIATE, 
+                                Log::TO_FILE_BINARY, 
                                 nameExtension.c_str());
             }
 
-            void createVertices (uint32_t modelInfoId, const std::vector <Vertex>& vertices) {
+            /* Note that, the vertex and index data is moved (not copied) in to the model info, it is copied only once 
+             * more, in to the staging buffer
+            */
+            void createVertices (uint32_t modelInfoId, std::vector <Vertex>&& vertices) {
                 auto modelInfo = getModelInfo (modelInfoId);
-                modelInfo->meta.vertices      = vertices;
                 modelInfo->meta.verticesCount = static_cast <uint32_t> (vertices.size());
+                modelInfo->meta.vertices      = std::move (vertices);
             }
 
-            void createIndices (uint32_t modelInfoId, const std::vector <uint32_t>& indices) {
+            void createIndices (uint32_t modelInfoId, std::vector <uint32_t>&& indices) {
                 auto modelInfo = getModelInfo (modelInfoId);
-                modelInfo->meta.indices      = indices;
                 modelInfo->meta.indicesCount = static_cast <uint32_t> (indices.size());
+                modelInfo->meta.indices      = std::move (indices);
+            }
+
+            /* Once the vertex and index data has been uploaded to the device, the host side copy is no longer needed
+             * for rendering. The counts are left as is, since they are used by the draw calls. Note that, clear() alone
+             * will not free the memory, so we swap with an empty vector instead
+            */
+            void releaseGeometry (uint32_t modelInfoId) {
+                auto modelInfo = getModelInfo (modelInfoId);
+                std::vector <Vertex>().swap   (modelInfo->meta.vertices);
+                std::vector <uint32_t>().swap (modelInfo->meta.indices);
             }
 
             /* OBJ file format
@@ -281,6 +289,16 @@ namespace Core {
                 std::unordered_map <Vertex, uint32_t> uniqueVertices;
                 std::vector <Vertex>   vertices;
                 std::vector <uint32_t> indices;
+                /* The number of indices is known up front (one per face vertex), which is also an upper bound on the
+                 * number of unique vertices. Reserving for it avoids reallocating (and copying) the arrays as they grow
+                */
+                size_t indicesCount = 0;
+                for (auto const& shape: shapes)
+                    indicesCount += shape.mesh.indices.size();
+
+                uniqueVertices.reserve (indicesCount);
+                vertices.reserve       (indicesCount);
+                indices.reserve        (indicesCount);
                 auto defaultTexCoords = std::vector <glm::vec2> {
                     {0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 0.0f},
                     {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f}
@@ -362,11 +380,11 @@ namespace Core {
                          * If we've seen the exact same vertex before, then we look up its index in the map container and 
                          * store that index in indices array
                         */
-                        if (uniqueVertices.count (vertex) == 0) {
-                            uniqueVertices[vertex] = static_cast <uint32_t> (vertices.size());
+                        auto [uniqueVertex, inserted] = uniqueVertices.try_emplace (vertex, 
+                                                                                    static_cast <uint32_t> (vertices.size()));
+                        if (inserted)
                             vertices.push_back (vertex);
-                        }
-                        indices.push_back (uniqueVertices[vertex]);
+                        indices.push_back (uniqueVertex->second);
                         /* Increment face index after we process a face (3 vertices make up a face)
                         */
                         indexProcessedCount++;
@@ -376,8 +394,8 @@ namespace Core {
                         }
                     }
                 }
-                createVertices (modelInfoId, vertices);
-                createIndices  (modelInfoId, indices);
+                createVertices (modelInfoId, std::move (vertices));
+                createIndices  (modelInfoId, std::move (indices));
                 dumpParsedData (modelInfoId);
             }
 
@@ -397,8 +415,9 @@ namespace Core {
             }
 
             ModelInfo* getModelInfo (uint32_t modelInfoId) {
-                if (m_modelInfoPool.find (modelInfoId) != m_modelInfoPool.end())
-                    return &m_modelInfoPool[modelInfoId];
+                auto info = m_modelInfoPool.find (modelInfoId);
+                if (info != nullptr)
+                    return info;
                 
                 LOG_ERROR (m_VKModelMgrLog) << "Failed to find model info "
                                             << "[" << modelInfoId << "]"
@@ -406,105 +425,68 @@ namespace Core {
                 throw std::runtime_error ("Failed to find model info");
             }
 
+            /* Note that, the info logs of this class are written to a binary log (see dumpParsedData)
+            */
             void dumpModelInfoPool (void) {
-                LOG_INFO (m_VKModelMgrLog) << "Dumping model info pool"
-                                           << std::endl;
+                LOG_BINARY (m_VKModelMgrLog, Log::INFO, "Dumping model info pool");
 
                 for (auto const& [key, val]: m_modelInfoPool) {
-                    LOG_INFO (m_VKModelMgrLog) << "Model info id " 
-                                               << "[" << key << "]"
-                                               << std::endl;
+                    LOG_BINARY (m_VKModelMgrLog, Log::INFO, "Model info id [{}]", key);
 
                     uint32_t modelInstanceId = 0;
                     for (auto const& instance: val.meta.instances) {
-                        LOG_INFO (m_VKModelMgrLog) << "Model instance id " 
-                                                   << "[" << modelInstanceId << "]"
-                                                   << std::endl;
+                        LOG_BINARY (m_VKModelMgrLog, Log::INFO, "Model instance id [{}]", modelInstanceId);
 
-                        LOG_INFO (m_VKModelMgrLog) << "Model matrix"
-                                                   << std::endl;
+                        LOG_BINARY (m_VKModelMgrLog, Log::INFO, "Model matrix");
                         uint32_t rowIdx = 0;
                         while (rowIdx < 4) {
-                            LOG_INFO (m_VKModelMgrLog) << "["
-                                                       << instance.modelMatrix[rowIdx][0] << " "
-                                                       << instance.modelMatrix[rowIdx][1] << " "
-                                                       << instance.modelMatrix[rowIdx][2] << " "
-                                                       << instance.modelMatrix[rowIdx][3]
-                                                       << "]"
-                                                       << std::endl;
+                            LOG_BINARY (m_VKModelMgrLog, Log::INFO, "[{} {} {} {}]",
+                                        instance.modelMatrix[rowIdx][0],
+                                        instance.modelMatrix[rowIdx][1],
+                                        instance.modelMatrix[rowIdx][2],
+                                        instance.modelMatrix[rowIdx][3]);
                             rowIdx++;
                         }
 
-                        LOG_INFO (m_VKModelMgrLog) << "Texture id look up table"
-                                                   << std::endl;
+                        LOG_BINARY (m_VKModelMgrLog, Log::INFO, "Texture id look up table");
                         rowIdx = 0;
                         while (rowIdx < 4) {
-                            LOG_INFO (m_VKModelMgrLog) << "["
-                                                       << instance.texIdLUT[rowIdx][0] << " "
-                                                       << instance.texIdLUT[rowIdx][1] << " "
-                                                       << instance.texIdLUT[rowIdx][2] << " "
-                                                       << instance.texIdLUT[rowIdx][3]
-                                                       << "]"
-                                                       << std::endl;
+                            LOG_BINARY (m_VKModelMgrLog, Log::INFO, "[{} {} {} {}]",
+                                        instance.texIdLUT[rowIdx][0],
+                                        instance.texIdLUT[rowIdx][1],
+                                        instance.texIdLUT[rowIdx][2],
+                                        instance.texIdLUT[rowIdx][3]);
                             rowIdx++;
                         }
                         modelInstanceId++;
                     }
 
-                    LOG_INFO (m_VKModelMgrLog) << "Vertices count " 
-                                               << "[" << val.meta.verticesCount << "]"
-                                               << std::endl;
-
-                    LOG_INFO (m_VKModelMgrLog) << "Indices count " 
-                                               << "[" << val.meta.indicesCount << "]"
-                                               << std::endl;
-
-                    LOG_INFO (m_VKModelMgrLog) << "Instances count " 
-                                               << "[" << val.meta.instancesCount << "]"
-                                               << std::endl;
-
-                    LOG_INFO (m_VKModelMgrLog) << "Parsed data log instance id " 
-                                               << "[" << val.meta.parsedDataLogInstanceId << "]"
-                                               << std::endl;
-
-                    LOG_INFO (m_VKModelMgrLog) << "Model path " 
-                                               << "[" << val.path.model << "]"
-                                               << std::endl;
-
-                    LOG_INFO (m_VKModelMgrLog) << "Material file directory path " 
-                                               << "[" << val.path.mtlFileDir << "]"
-                                               << std::endl;
+                    LOG_BINARY (m_VKModelMgrLog, Log::INFO, "Vertices count [{}]",  val.meta.verticesCount);
+                    LOG_BINARY (m_VKModelMgrLog, Log::INFO, "Indices count [{}]",   val.meta.indicesCount);
+                    LOG_BINARY (m_VKModelMgrLog, Log::INFO, "Instances count [{}]", val.meta.instancesCount);
+                    LOG_BINARY (m_VKModelMgrLog, Log::INFO, "Parsed data log instance id [{}]", 
+                                val.meta.parsedDataLogInstanceId);
+                    LOG_BINARY (m_VKModelMgrLog, Log::INFO, "Model path [{}]", val.path.model);
+                    LOG_BINARY (m_VKModelMgrLog, Log::INFO, "Material file directory path [{}]", val.path.mtlFileDir);
 
-                    LOG_INFO (m_VKModelMgrLog) << "Diffuse texture image paths" 
-                                               << std::endl;
+                    LOG_BINARY (m_VKModelMgrLog, Log::INFO, "Diffuse texture image paths");
                     for (auto const& path: val.path.diffuseTextureImages)
-                    LOG_INFO (m_VKModelMgrLog) << "[" << path << "]"
-                                               << std::endl;  
+                    LOG_BINARY (m_VKModelMgrLog, Log::INFO, "[{}]", path);
 
-                    LOG_INFO (m_VKModelMgrLog) << "Diffuse texture image info ids"
-                                               << std::endl;
+                    LOG_BINARY (m_VKModelMgrLog, Log::INFO, "Diffuse texture image info ids");
                     for (auto const& infoId: val.id.diffuseTextureImageInfos)
-                    LOG_INFO (m_VKModelMgrLog) << "[" << infoId << "]"
-                                               << std::endl;
+                    LOG_BINARY (m_VKModelMgrLog, Log::INFO, "[{}]", infoId);
 
-                    LOG_INFO (m_VKModelMgrLog) << "Vettex buffer info ids"
-                                               << std::endl;
+                    LOG_BINARY (m_VKModelMgrLog, Log::INFO, "Vettex buffer info ids");
                     for (auto const& infoId: val.id.vertexBufferInfos)
-                    LOG_INFO (m_VKModelMgrLog) << "[" << infoId << "]"
-                                               << std::endl;
+                    LOG_BINARY (m_VKModelMgrLog, Log::INFO, "[{}]", infoId);
 
-                    LOG_INFO (m_VKModelMgrLog) << "Index buffer info id " 
-                                               << "[" << val.id.indexBufferInfo << "]"
-                                               << std::endl;
+                    LOG_BINARY (m_VKModelMgrLog, Log::INFO, "Index buffer info id [{}]", val.id.indexBufferInfo);
                 }
 
-                LOG_INFO (m_VKModelMgrLog) << "Dumping texture image pool"
-                                           << std::endl;
+                LOG_BINARY (m_VKModelMgrLog, Log::INFO, "Dumping texture image pool");
                 for (auto const& [path, infoId]: m_textureImagePool)
-                LOG_INFO (m_VKModelMgrLog) << "[" << path << "]"
-                                           << " "
-                                           << "[" << infoId << "]"
-                                           << std::endl;  
+                LOG_BINARY (m_VKModelMgrLog, Log::INFO, "[{}] [{}]", path, infoId);
             }
 
             void cleanUp (uint32_t modelInfoId) {
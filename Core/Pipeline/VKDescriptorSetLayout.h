@@ -12,7 +12,7 @@ namespace Core {
         public:
             VKDescriptorSetLayout (void) {
                 m_VKDescriptorSetLayoutLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE); 
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE); 
             }
 
             ~VKDescriptorSetLayout (void) { 
@@ -95,6 +95,23 @@ namespace Core {
                 }
 
                 pipelineInfo->resource.descriptorSetLayouts.push_back (descriptorSetLayout);
+                /* Hash the description of the layout, note that the pointer to the immutable samplers (if any) is left 
+                 * out and the sampler handles are hashed instead
+                */
+                uint64_t layoutHash = getHash (&layoutCreateFlags, sizeof (layoutCreateFlags));
+                for (auto const& binding: layoutBindings) {
+                    layoutHash = getHash (&binding.binding,         sizeof (binding.binding),         layoutHash);
+                    layoutHash = getHash (&binding.descriptorType,  sizeof (binding.descriptorType),  layoutHash);
+                    layoutHash = getHash (&binding.descriptorCount, sizeof (binding.descriptorCount), layoutHash);
+                    layoutHash = getHash (&binding.stageFlags,      sizeof (binding.stageFlags),      layoutHash);
+                    if (binding.pImmutableSamplers != VK_NULL_HANDLE)
+                        layoutHash = getHash (binding.pImmutableSamplers, 
+                                              sizeof (VkSampler) * binding.descriptorCount, 
+                                              layoutHash);
+                }
+                layoutHash = getHash (bindingFlags.data(), sizeof (VkDescriptorBindingFlags) * bindingFlags.size(), 
+                                      layoutHash);
+                pipelineInfo->resource.descriptorSetLayoutHashes.push_back (layoutHash);
                 /* Note that, we need to specify the descriptor set layout during pipeline creation to tell Vulkan which 
                  * descriptors the shaders will be using. Descriptor set layouts are specified in the pipeline layout 
                  * object
@@ -0,0 +1,272 @@
+#ifndef VK_PIPELINE_CACHE_H
+#define VK_PIPELINE_CACHE_H
+
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include "../Device/VKDeviceMgr.h"
+
+namespace Core {
+    /* A pipeline cache allows the result of pipeline construction to be reused between pipelines and between runs of an
+     * application. Reuse between pipelines is achieved by passing the same pipeline cache object when creating multiple
+     * related pipelines. Reuse across runs of an application is achieved by retrieving pipeline cache contents in one
+     * run of an application, saving the contents, and using them to preinitialize a pipeline cache on a subsequent run
+     *
+     * Note that, the contents of the pipeline cache objects are managed by the implementation, and the application only
+     * manages the memory that is used to store the retrieved data
+    */
+    class VKPipelineCache: protected virtual VKDeviceMgr {
+        private:
+            struct PipelineCacheInfo {
+                struct Meta {
+                    /* Set if the pipeline cache was created with valid data that was read from the cache file, pipelines
+                     * created with a warm cache are expected to skip most of the shader compilation
+                    */
+                    bool warm;
+                    size_t initialDataSize;
+                } meta;
+
+                struct Resource {
+                    VkPipelineCache pipelineCache;
+                } resource;
+
+                struct Stats {
+                    uint32_t pipelinesCount;
+                    float createTimeMs;
+                } stats;
+            } m_pipelineCacheInfo;
+
+            Log::Record* m_VKPipelineCacheLog;
+            const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
+
+            /* The cache data begins with a header, which the implementation uses to check for compatibility. We do the
+             * same check here before handing the data over, since a cache file that was written by a different driver
+             * or device (say, after a driver update) is of no use to us and is silently ignored by some implementations
+            */
+            bool isPipelineCacheDataValid (uint32_t deviceInfoId, const std::vector <char>& cacheData) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                VkPhysicalDeviceProperties properties;
+                vkGetPhysicalDeviceProperties (deviceInfo->resource.phyDevice, &properties);
+
+                VkPipelineCacheHeaderVersionOne header;
+                if (cacheData.size() < sizeof (header)) {
+                    LOG_WARNING (m_VKPipelineCacheLog) << "Pipeline cache data is too small "
+                                                       << "[" << cacheData.size() << "]"
+                                                       << std::endl;
+                    return false;
+                }
+                std::memcpy (&header, cacheData.data(), sizeof (header));
+
+                if (header.headerSize    != sizeof (header) ||
+                    header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
+                    LOG_WARNING (m_VKPipelineCacheLog) << "Pipeline cache header mismatch "
+                                                       << "[" << header.headerSize << "]"
+                                                       << " "
+                                                       << "[" << header.headerVersion << "]"
+                                                       << std::endl;
+                    return false;
+                }
+
+                if (header.vendorID != properties.vendorID || header.deviceID != properties.deviceID) {
+                    LOG_WARNING (m_VKPipelineCacheLog) << "Pipeline cache device mismatch "
+                                                       << "[" << header.vendorID << "]"
+                                                       << "->"
+                                                       << "[" << properties.vendorID << "]"
+                                                       << " "
+                                                       << "[" << header.deviceID << "]"
+                                                       << "->"
+                                                       << "[" << properties.deviceID << "]"
+                                                       << std::endl;
+                    return false;
+                }
+                /* The pipeline cache UUID changes with the driver version, or any other change that may invalidate
+                 * the cached data
+                */
+                if (std::memcmp (header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+                    LOG_WARNING (m_VKPipelineCacheLog) << "Pipeline cache UUID mismatch "
+                                                       << "[" << deviceInfoId << "]"
+                                                       << std::endl;
+                    return false;
+                }
+                return true;
+            }
+
+            std::vector <char> readPipelineCacheFile (const char* filePath) {
+                std::ifstream file (filePath, std::ios::ate | std::ios::binary);
+                if (!file.is_open()) {
+                    LOG_INFO (m_VKPipelineCacheLog) << "Pipeline cache file not found "
+                                                    << "[" << filePath << "]"
+                                                    << std::endl;
+                    return {};
+                }
+
+                size_t fileSize = static_cast <size_t> (file.tellg());
+                std::vector <char> buffer (fileSize);
+                file.seekg (0);
+                file.read (buffer.data(), static_cast <std::streamsize> (fileSize));
+
+                file.close();
+                return buffer;
+            }
+
+        public:
+            VKPipelineCache (void) {
+                m_VKPipelineCacheLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,    Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+            }
+
+            ~VKPipelineCache (void) {
+                LOG_CLOSE (m_instanceId);
+            }
+
+        protected:
+            /* Create the pipeline cache, preinitialized with the contents of the cache file if it exists and matches
+             * the device. Otherwise, an empty pipeline cache is created which will be filled in by the pipelines
+             * created using it
+            */
+            void createPipelineCache (uint32_t deviceInfoId) {
+                auto deviceInfo     = getDeviceInfo (deviceInfoId);
+                m_pipelineCacheInfo = {};
+                auto& meta          = m_pipelineCacheInfo.meta;
+
+                std::vector <char> cacheData;
+                if (g_pipelineSettings.pipelineCache.loadFromFile) {
+                    cacheData = readPipelineCacheFile (g_pipelineSettings.pipelineCache.cacheFilePath);
+                    if (!cacheData.empty() && !isPipelineCacheDataValid (deviceInfoId, cacheData))
+                        cacheData.clear();
+                }
+                meta.warm            = !cacheData.empty();
+                meta.initialDataSize = cacheData.size();
+
+                VkPipelineCacheCreateInfo createInfo;
+                createInfo.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+                createInfo.pNext           = VK_NULL_HANDLE;
+                createInfo.flags           = 0;
+                createInfo.initialDataSize = cacheData.size();
+                createInfo.pInitialData    = cacheData.empty() ? VK_NULL_HANDLE: cacheData.data();
+
+                VkPipelineCache pipelineCache;
+                VkResult result = vkCreatePipelineCache (deviceInfo->resource.logDevice,
+                                                         &createInfo,
+                                                         VK_NULL_HANDLE,
+                                                         &pipelineCache);
+                if (result != VK_SUCCESS) {
+                    LOG_ERROR (m_VKPipelineCacheLog) << "Failed to create pipeline cache "
+                                                     << "[" << deviceInfoId << "]"
+                                                     << " "
+                                                     << "[" << string_VkResult (result) << "]"
+                                                     << std::endl;
+                    throw std::runtime_error ("Failed to create pipeline cache");
+                }
+                m_pipelineCacheInfo.resource.pipelineCache = pipelineCache;
+            }
+
+            VkPipelineCache getPipelineCache (void) {
+                return m_pipelineCacheInfo.resource.pipelineCache;
+            }
+
+            /* Pipeline creation times are accumulated here, so that a run with a cold cache can be compared against a run
+             * with a warm cache. Delete the cache file (or disable loading it) to measure the cold run. Note that, a 
+             * sample may cover several pipelines that were created in a single call
+            */
+            void addPipelineCreateSample (uint32_t pipelinesCount, float createTimeMs) {
+                auto& stats = m_pipelineCacheInfo.stats;
+                stats.pipelinesCount += pipelinesCount;
+                stats.createTimeMs   += createTimeMs;
+
+                LOG_INFO (m_VKPipelineCacheLog) << "Pipeline create time "
+                                                << "[" << pipelinesCount << "]"
+                                                << " "
+                                                << "[" << createTimeMs << " ms]"
+                                                << " "
+                                                << "[" << (m_pipelineCacheInfo.meta.warm ? "WARM": "COLD") << "]"
+                                                << std::endl;
+            }
+
+            /* Retrieve the contents of the pipeline cache and write them to the cache file. This may be called any
+             * number of times while the pipeline cache is alive (for example, after new pipelines have been created),
+             * and the file is replaced only once the data is written out in full
+            */
+            void savePipelineCache (uint32_t deviceInfoId) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                /* Query the size of the data first, and then retrieve the data
+                */
+                size_t dataSize = 0;
+                vkGetPipelineCacheData (deviceInfo->resource.logDevice,
+                                        m_pipelineCacheInfo.resource.pipelineCache,
+                                        &dataSize,
+                                        VK_NULL_HANDLE);
+                std::vector <char> cacheData (dataSize);
+                VkResult result = vkGetPipelineCacheData (deviceInfo->resource.logDevice,
+                                                          m_pipelineCacheInfo.resource.pipelineCache,
+                                                          &dataSize,
+                                                          cacheData.data());
+                if (result != VK_SUCCESS || dataSize == 0) {
+                    LOG_WARNING (m_VKPipelineCacheLog) << "Failed to get pipeline cache data "
+                                                       << "[" << string_VkResult (result) << "]"
+                                                       << std::endl;
+                    return;
+                }
+                /* Write to a temporary file and rename it over the cache file, so that an interrupted write never
+                 * leaves a truncated cache file behind
+                */
+                std::string filePath     = g_pipelineSettings.pipelineCache.cacheFilePath;
+                std::string tempFilePath = filePath + ".tmp";
+                std::ofstream file (tempFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+                if (!file.is_open()) {
+                    LOG_WARNING (m_VKPipelineCacheLog) << "Failed to open file "
+                                                       << "[" << tempFilePath << "]"
+                                                       << std::endl;
+                    return;
+                }
+                file.write (cacheData.data(), static_cast <std::streamsize> (dataSize));
+                file.close();
+
+                if (!file || std::rename (tempFilePath.c_str(), filePath.c_str()) != 0) {
+                    LOG_WARNING (m_VKPipelineCacheLog) << "Failed to save pipeline cache "
+                                                       << "[" << filePath << "]"
+                                                       << std::endl;
+                    std::remove (tempFilePath.c_str());
+                    return;
+                }
+
+                LOG_INFO (m_VKPipelineCacheLog) << "Saved pipeline cache "
+                                                << "[" << filePath << "]"
+                                                << " "
+                                                << "[" << dataSize << "]"
+                                                << std::endl;
+            }
+
+            void dumpPipelineCacheStats (void) {
+                LOG_INFO (m_VKPipelineCacheLog) << "Dumping pipeline cache stats"
+                                                << std::endl;
+
+                LOG_INFO (m_VKPipelineCacheLog) << "Cache state "
+                                                << "[" << (m_pipelineCacheInfo.meta.warm ? "WARM": "COLD") << "]"
+                                                << std::endl;
+
+                LOG_INFO (m_VKPipelineCacheLog) << "Initial data size "
+                                                << "[" << m_pipelineCacheInfo.meta.initialDataSize << "]"
+                                                << std::endl;
+
+                LOG_INFO (m_VKPipelineCacheLog) << "Pipelines count "
+                                                << "[" << m_pipelineCacheInfo.stats.pipelinesCount << "]"
+                                                << std::endl;
+
+                LOG_INFO (m_VKPipelineCacheLog) << "Total create time "
+                                                << "[" << m_pipelineCacheInfo.stats.createTimeMs << " ms]"
+                                                << std::endl;
+            }
+
+            void cleanUpPipelineCache (uint32_t deviceInfoId) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                vkDestroyPipelineCache (deviceInfo->resource.logDevice,
+                                        m_pipelineCacheInfo.resource.pipelineCache,
+                                        VK_NULL_HANDLE);
+                m_pipelineCacheInfo.resource.pipelineCache = VK_NULL_HANDLE;
+            }
+    };
+}   // namespace Core
+#endif  // VK_PIPELINE_CACHE_H
@@ -12,7 +12,7 @@ namespace Core {
         public:
             VKPipelineLayout (void) {
                 m_VKPipelineLayoutLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE); 
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE); 
             }
 
             ~VKPipelineLayout (void) { 
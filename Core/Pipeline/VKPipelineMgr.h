@@ -1,7 +1,9 @@
 #ifndef VK_PIPELINE_MGR_H
 #define VK_PIPELINE_MGR_H
 
+#include <unordered_map>
 #include "../RenderPass/VKRenderPassMgr.h"
+#include "VKPipelineCache.h"
 
 namespace Core {
     /* An overview of the pipeline
@@ -41,7 +43,8 @@ namespace Core {
      * Programmable stages are programmable, which means that you can upload your own code to the graphics card to apply 
      * exactly the operations you want
     */
-    class VKPipelineMgr: protected virtual VKRenderPassMgr {
+    class VKPipelineMgr: protected virtual VKRenderPassMgr,
+                         protected virtual VKPipelineCache {
         private:
             struct PipelineInfo {
                 struct Meta {
@@ -73,16 +76,28 @@ namespace Core {
                      * parent can also be done quicker
                     */
                     VkPipeline basePipeline; 
+                    /* Set if the pipeline handle is owned by another pipeline info that was requested with identical 
+                     * state (see VKPipelineRegistry), in which case it is not destroyed along with this pipeline info
+                    */
+                    bool sharedPipeline;
+                    /* Hashes of the descriptor set layout descriptions, these are used in place of the layout handles 
+                     * when hashing the pipeline state, since identically defined layouts are compatible
+                    */
+                    std::vector <uint64_t> descriptorSetLayoutHashes;
                 } resource;
             };
-            std::unordered_map <uint32_t, PipelineInfo> m_pipelineInfoPool;
+            SlotMap <PipelineInfo> m_pipelineInfoPool;
+            /* Shader modules are owned here and not by the pipelines that use them, since a pipeline may be compiled
+             * (see VKPipelineRegistry) long after its stages were created, and variants of a pipeline may reuse the same
+             * modules. The hash of the byte code is looked up when hashing the pipeline state
+            */
+            std::unordered_map <VkShaderModule, uint64_t> m_shaderModuleHashes;
 
             Log::Record* m_VKPipelineMgrLog;
             const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
             
             void deletePipelineInfo (uint32_t pipelineInfoId) {
-                if (m_pipelineInfoPool.find (pipelineInfoId) != m_pipelineInfoPool.end()) {
-                    m_pipelineInfoPool.erase (pipelineInfoId);
+                if (m_pipelineInfoPool.erase (pipelineInfoId)) {
                     return;
                 }
 
@@ -95,8 +110,8 @@ namespace Core {
         public:
             VKPipelineMgr (void) {
                 m_VKPipelineMgrLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath); 
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_IMMEDIATE);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE); 
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE); 
             }
 
             ~VKPipelineMgr (void) {
@@ -104,8 +119,33 @@ namespace Core {
             }
 
         protected:
+            /* FNV-1a hash, pass in the hash of the previous data as the seed to combine hashes
+            */
+            uint64_t getHash (const void* data, size_t size, uint64_t seed = 14695981039346656037ULL) {
+                auto bytes = static_cast <const uint8_t*> (data);
+                for (size_t i = 0; i < size; i++) {
+                    seed ^= bytes[i];
+                    seed *= 1099511628211ULL;
+                }
+                return seed;
+            }
+
+            void addShaderModule (VkShaderModule shaderModule, uint64_t codeHash) {
+                m_shaderModuleHashes[shaderModule] = codeHash;
+            }
+
+            uint64_t getShaderModuleHash (VkShaderModule shaderModule) {
+                auto it = m_shaderModuleHashes.find (shaderModule);
+                if (it != m_shaderModuleHashes.end())
+                    return it->second;
+
+                LOG_ERROR (m_VKPipelineMgrLog) << "Failed to find shader module"
+                                               << std::endl;
+                throw std::runtime_error ("Failed to find shader module");
+            }
+
             void readyPipelineInfo (uint32_t pipelineInfoId) {
-                if (m_pipelineInfoPool.find (pipelineInfoId) != m_pipelineInfoPool.end()) {
+                if (m_pipelineInfoPool.contains (pipelineInfoId)) {
                     LOG_ERROR (m_VKPipelineMgrLog) << "Pipeline info id already exists "
                                                    << "[" << pipelineInfoId << "]"
                                                    << std::endl;
@@ -113,7 +153,7 @@ namespace Core {
                 }
 
                 PipelineInfo info{};
-                m_pipelineInfoPool[pipelineInfoId] = info;
+                m_pipelineInfoPool.insert (pipelineInfoId, info);
             }
 
             void derivePipelineInfo (uint32_t pipelineInfoId, uint32_t basePipelineInfoId) {
@@ -126,98 +166,10 @@ namespace Core {
                 pipelineInfo->state    = basePipelineInfo->state;
             }
 
-            void createGraphicsPipeline (uint32_t deviceInfoId,
-                                         uint32_t renderPassInfoId,
-                                         uint32_t pipelineInfoId,
-                                         uint32_t subPassIndex,
-                                         int32_t basePipelineIndex,
-                                         VkPipeline basePipeline,
-                                         VkPipelineCreateFlags pipelineCreateFlags) {
-
-                auto deviceInfo     = getDeviceInfo     (deviceInfoId);
-                auto renderPassInfo = getRenderPassInfo (renderPassInfoId);
-                auto pipelineInfo   = getPipelineInfo   (pipelineInfoId);
-
-                pipelineInfo->meta.subPassIndex      = subPassIndex;
-                pipelineInfo->meta.basePipelineIndex = basePipelineIndex;
-                pipelineInfo->resource.renderPass    = renderPassInfo->resource.renderPass;
-                pipelineInfo->resource.basePipeline  = basePipeline;  
-
-                VkGraphicsPipelineCreateInfo createInfo;
-                createInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-                createInfo.pNext               = VK_NULL_HANDLE;
-                createInfo.flags               = pipelineCreateFlags;
-                createInfo.pVertexInputState   = &pipelineInfo->state.vertexInput;
-                createInfo.pInputAssemblyState = &pipelineInfo->state.inputAssembly; 
-                createInfo.pTessellationState  = VK_NULL_HANDLE;
-                createInfo.stageCount          = static_cast <uint32_t> (pipelineInfo->state.stages.size());
-                createInfo.pStages             = pipelineInfo->state.stages.data();
-                createInfo.pDepthStencilState  = &pipelineInfo->state.depthStencil;
-                createInfo.pRasterizationState = &pipelineInfo->state.rasterization;
-                createInfo.pMultisampleState   = &pipelineInfo->state.multiSample;
-                createInfo.pColorBlendState    = &pipelineInfo->state.colorBlend;
-                createInfo.pDynamicState       = &pipelineInfo->state.dynamicState;
-                createInfo.pViewportState      = &pipelineInfo->state.viewPort;
-
-                createInfo.subpass             = pipelineInfo->meta.subPassIndex;
-                createInfo.basePipelineIndex   = pipelineInfo->meta.basePipelineIndex;
-                createInfo.layout              = pipelineInfo->resource.layout;
-                /* Pipeline vs Render pass
-                 * VkPipeline is a GPU context. Think of the GPU as a FPGA (which it isn't, but bear with me). Doing 
-                 * vkCmdBindPipeline would set the GPU to a given gate configuration. But since the GPU is not a FPGA, it 
-                 * sets the GPU to a state where it can execute the shader programs and fixed-function pipeline stages 
-                 * defined by the VkPipeline
-                 * 
-                 * VkRenderPass is a data oriented thing. It is necessitated by tiled architecture GPUs. Conceptually, 
-                 * they divide the framebuffer up into tiles that are processed independently. Tiled-architecture GPUs 
-                 * need to "load" images\buffers from general-purpose RAM to "on-chip memory". When they are done they 
-                 * "store" their results back to RAM. This loading of attachments is done by smaller "tiles", so the 
-                 * on-chip memory (and therefore shaders) never sees the whole memory at the same time
-                 * 
-                 * Loading and storing these tiles is rather slow and a good optimization strategy is to combine as many 
-                 * operations as possible into one cycle over the whole framebuffer. It's trivial to see that operations 
-                 * can be combined safely as long as they don't depend on intermediate results from other tiles. Subpasses
-                 * and subpass dependencies tell the GPU drivers where these kinds of dependencies exist (or don't), so 
-                 * that they can group the actual render calls more effectively under the hood
-                 * 
-                 * Note that, you can have multiple pipeline in a single render pass
-                */
-                createInfo.renderPass         = renderPassInfo->resource.renderPass;
-                createInfo.basePipelineHandle = pipelineInfo->resource.basePipeline;                
-                /* Create the pipeline
-                 * The vkCreateGraphicsPipelines function actually has more parameters than the usual object creation 
-                 * functions in Vulkan. It is designed to take multiple VkGraphicsPipelineCreateInfo objects and create 
-                 * multiple VkPipeline objects in a single call.
-                 * 
-                 * The second parameter, for which we've passed the VK_NULL_HANDLE argument, references an optional 
-                 * VkPipelineCache object. A pipeline cache can be used to store and reuse data relevant to pipeline 
-                 * creation across multiple calls to vkCreateGraphicsPipelines and even across program executions if the 
-                 * cache is stored to a file. This makes it possible to significantly speed up pipeline creation at a 
-                 * later time
-                */
-                VkPipeline pipeline;
-                VkResult result = vkCreateGraphicsPipelines (deviceInfo->resource.logDevice, 
-                                                             VK_NULL_HANDLE,
-                                                             1,
-                                                             &createInfo,
-                                                             VK_NULL_HANDLE, 
-                                                             &pipeline);
-                if (result != VK_SUCCESS) {
-                    LOG_ERROR (m_VKPipelineMgrLog) << "Failed to create graphics pipeline " 
-                                                   << "[" << pipelineInfoId << "]"
-                                                   << " "
-                                                   << "[" << renderPassInfoId << "]"
-                                                   << " "
-                                                   << "[" << string_VkResult (result) << "]" 
-                                                   << std::endl;
-                    throw std::runtime_error ("Failed to create graphics pipeline");                
-                }
-                pipelineInfo->resource.pipeline = pipeline;
-            }
-
             PipelineInfo* getPipelineInfo (uint32_t pipelineInfoId) {
-                if (m_pipelineInfoPool.find (pipelineInfoId) != m_pipelineInfoPool.end())
-                    return &m_pipelineInfoPool[pipelineInfoId];
+                auto info = m_pipelineInfoPool.find (pipelineInfoId);
+                if (info != nullptr)
+                    return info;
                 
                 LOG_ERROR (m_VKPipelineMgrLog) << "Failed to find pipeline info "
                                                << "[" << pipelineInfoId << "]"
@@ -256,15 +208,28 @@ namespace Core {
                 auto deviceInfo   = getDeviceInfo   (deviceInfoId);
                 auto pipelineInfo = getPipelineInfo (pipelineInfoId);
 
-                vkDestroyPipeline       (deviceInfo->resource.logDevice, pipelineInfo->resource.pipeline, VK_NULL_HANDLE);
+                if (!pipelineInfo->resource.sharedPipeline)
+                    vkDestroyPipeline   (deviceInfo->resource.logDevice, pipelineInfo->resource.pipeline, VK_NULL_HANDLE);
                 vkDestroyPipelineLayout (deviceInfo->resource.logDevice, pipelineInfo->resource.layout,   VK_NULL_HANDLE);
 
                 for (auto const& descriptorSetLayout: pipelineInfo->resource.descriptorSetLayouts)
                     vkDestroyDescriptorSetLayout (deviceInfo->resource.logDevice, descriptorSetLayout, VK_NULL_HANDLE);
                 pipelineInfo->resource.descriptorSetLayouts.clear();
+                pipelineInfo->resource.descriptorSetLayoutHashes.clear();
 
                 deletePipelineInfo (pipelineInfoId);
             }
+
+            /* The compilation and linking of the SPIR-V bytecode to machine code for execution by the GPU doesn't 
+             * happen until the graphics pipeline is created. That means that we're allowed to destroy the shader modules
+             * as soon as there are no more pipelines to be created that use them
+            */
+            void cleanUpShaderModules (uint32_t deviceInfoId) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                for (auto const& [shaderModule, codeHash]: m_shaderModuleHashes)
+                    vkDestroyShaderModule (deviceInfo->resource.logDevice, shaderModule, VK_NULL_HANDLE);
+                m_shaderModuleHashes.clear();
+            }
     };
 }   // namespace Core
 #endif  // VK_PIPELINE_MGR_H
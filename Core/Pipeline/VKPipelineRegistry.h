@@ -0,0 +1,661 @@
+#ifndef VK_PIPELINE_REGISTRY_H
+#define VK_PIPELINE_REGISTRY_H
+
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <algorithm>
+#include "VKPipelineMgr.h"
+
+namespace Core {
+    /* The pipeline registry takes requests for graphics pipelines and compiles them in batches (a single call to
+     * vkCreateGraphicsPipelines) on a worker thread, so that adding pipeline variants does not stall start up or the
+     * frames being drawn. Until a requested pipeline is ready, a fallback pipeline is bound in its place (if one was
+     * given), or the draws that use it are skipped
+     *
+     * Each request is identified by a hash of its full state description (shader byte code and its specialization
+     * constants, fixed function state, pipeline layout description and render pass). A request whose state is identical
+     * to that of an earlier request is not compiled again, instead it shares the pipeline of the earlier request
+    */
+    class VKPipelineRegistry: protected virtual VKPipelineMgr {
+        private:
+            /* The pipeline state create infos hold pointers to data that is owned by the caller, which is only valid
+             * while the pipeline state is being configured. Hence, the state is copied in to a request at the time it is
+             * made, and the pointers are set to point to the copies right before compilation
+            */
+            struct PipelineStateInfo {
+                VkPipelineVertexInputStateCreateInfo vertexInput;
+                VkPipelineInputAssemblyStateCreateInfo inputAssembly;
+                VkPipelineDepthStencilStateCreateInfo depthStencil;
+                VkPipelineRasterizationStateCreateInfo rasterization;
+                VkPipelineMultisampleStateCreateInfo multiSample;
+                VkPipelineColorBlendStateCreateInfo colorBlend;
+                VkPipelineDynamicStateCreateInfo dynamicState;
+                VkPipelineViewportStateCreateInfo viewPort;
+
+                std::vector <VkVertexInputBindingDescription>     bindingDescriptions;
+                std::vector <VkVertexInputAttributeDescription>   attributeDescriptions;
+                std::vector <VkPipelineShaderStageCreateInfo>     stages;
+                std::vector <std::string>                         entryPoints;
+                std::vector <VkPipelineColorBlendAttachmentState> colorBlendAttachments;
+                std::vector <VkDynamicState>                      dynamicStates;
+                /* One specialization info per stage, with a map entry count of 0 if the stage is not specialized
+                */
+                std::vector <VkSpecializationInfo>                   specializationInfos;
+                std::vector <std::vector <VkSpecializationMapEntry>> specializationMapEntries;
+                std::vector <std::vector <uint8_t>>                  specializationData;
+            };
+
+            struct PipelineRequestInfo {
+                struct Meta {
+                    uint64_t stateHash;
+                    uint32_t renderPassInfoId;
+                    uint32_t subPassIndex;
+                    uint32_t basePipelineInfoId;
+                    uint32_t fallbackPipelineInfoId;
+                    /* The pipeline info id of the request that compiles the pipeline, this is different from the
+                     * request's own id if an identical request was made before it
+                    */
+                    uint32_t ownerPipelineInfoId;
+                    VkPipelineCreateFlags pipelineCreateFlags;
+                    bool ready;
+                } meta;
+
+                PipelineStateInfo state;
+            };
+            SlotMap <PipelineRequestInfo> m_pipelineRequestInfoPool;
+
+            struct PipelineRegistryInfo {
+                struct Meta {
+                    /* Set while a batch is being compiled by the worker thread
+                    */
+                    bool compiling;
+                    VkResult result;
+                    float createTimeMs;
+                } meta;
+
+                struct Resource {
+                    std::thread worker;
+                    std::atomic <bool> done;
+                } resource;
+
+                struct Stats {
+                    uint32_t requestsCount;
+                    uint32_t sharedCount;
+                    uint32_t collisionsCount;
+                    uint32_t batchesCount;
+                    uint32_t peakBatchSize;
+                } stats;
+                /* Map from state hash to the pipeline info id of the request that owns the pipeline, along with the
+                 * state key that was hashed
+                */
+                struct StateKeyInfo {
+                    uint32_t ownerPipelineInfoId;
+                    std::vector <uint8_t> stateKey;
+                };
+                std::unordered_map <uint64_t, StateKeyInfo> stateHashLUT;
+                /* Requests that are waiting to be compiled, and the batch of requests that is being compiled. Note that,
+                 * the batch owns the state of its requests while they are compiled
+                */
+                std::vector <uint32_t> pendingRequests;
+                std::vector <uint32_t> batchRequests;
+                std::vector <PipelineStateInfo> batchStates;
+                std::vector <VkGraphicsPipelineCreateInfo> batchCreateInfos;
+                std::vector <VkPipeline> batchPipelines;
+            } m_pipelineRegistryInfo;
+
+            Log::Record* m_VKPipelineRegistryLog;
+            const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
+
+            PipelineRequestInfo* getPipelineRequestInfo (uint32_t pipelineInfoId) {
+                auto info = m_pipelineRequestInfoPool.find (pipelineInfoId);
+                if (info != nullptr)
+                    return info;
+
+                LOG_ERROR (m_VKPipelineRegistryLog) << "Failed to find pipeline request info "
+                                                    << "[" << pipelineInfoId << "]"
+                                                    << std::endl;
+                throw std::runtime_error ("Failed to find pipeline request info");
+            }
+
+            /* Append the size of the data followed by the data itself to the state key, the size keeps the key
+             * unambiguous when variable length data is appended back to back
+            */
+            void appendStateKey (std::vector <uint8_t>& stateKey, const void* data, size_t size) {
+                auto sizeBytes = reinterpret_cast <const uint8_t*> (&size);
+                auto bytes     = static_cast      <const uint8_t*> (data);
+                stateKey.insert (stateKey.end(), sizeBytes, sizeBytes + sizeof (size));
+                if (size != 0)
+                    stateKey.insert (stateKey.end(), bytes, bytes + size);
+            }
+
+            /* The state key holds every field of the request that affects the pipeline. Requests are matched by the
+             * hash of their key, and the keys are compared on a hash hit to rule out collisions
+            */
+            std::vector <uint8_t> getPipelineStateKey (uint32_t pipelineInfoId,
+                                                       const PipelineStateInfo& state,
+                                                       VkRenderPass renderPass,
+                                                       uint32_t subPassIndex,
+                                                       VkPipelineCreateFlags pipelineCreateFlags) {
+
+                auto pipelineInfo = getPipelineInfo (pipelineInfoId);
+                /* The derivative flags only hint at how the pipeline may be created, and do not change the pipeline
+                */
+                pipelineCreateFlags &= ~(VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT | VK_PIPELINE_CREATE_DERIVATIVE_BIT);
+                std::vector <uint8_t> stateKey;
+                appendStateKey (stateKey, &pipelineCreateFlags, sizeof (pipelineCreateFlags));
+                appendStateKey (stateKey, &renderPass,          sizeof (renderPass));
+                appendStateKey (stateKey, &subPassIndex,        sizeof (subPassIndex));
+
+                for (auto const& layoutHash: pipelineInfo->resource.descriptorSetLayoutHashes)
+                    appendStateKey (stateKey, &layoutHash, sizeof (layoutHash));
+                for (auto const& range: pipelineInfo->resource.pushConstantRanges)
+                    appendStateKey (stateKey, &range, sizeof (range));
+
+                for (size_t i = 0; i < state.stages.size(); i++) {
+                    uint64_t codeHash = getShaderModuleHash (state.stages[i].module);
+                    appendStateKey (stateKey, &state.stages[i].stage, sizeof (state.stages[i].stage));
+                    appendStateKey (stateKey, &codeHash,              sizeof (codeHash));
+                    appendStateKey (stateKey, state.entryPoints[i].data(), state.entryPoints[i].size());
+                    /* Append the map entries field by field, since the struct has padding on most platforms
+                    */
+                    for (auto const& mapEntry: state.specializationMapEntries[i]) {
+                        appendStateKey (stateKey, &mapEntry.constantID, sizeof (uint32_t));
+                        appendStateKey (stateKey, &mapEntry.offset,     sizeof (uint32_t));
+                        appendStateKey (stateKey, &mapEntry.size,       sizeof (size_t));
+                    }
+                    appendStateKey (stateKey, state.specializationData[i].data(), state.specializationData[i].size());
+                }
+
+                appendStateKey (stateKey, state.bindingDescriptions.data(),
+                                sizeof (VkVertexInputBindingDescription)     * state.bindingDescriptions.size());
+                appendStateKey (stateKey, state.attributeDescriptions.data(),
+                                sizeof (VkVertexInputAttributeDescription)   * state.attributeDescriptions.size());
+                appendStateKey (stateKey, state.colorBlendAttachments.data(),
+                                sizeof (VkPipelineColorBlendAttachmentState) * state.colorBlendAttachments.size());
+                appendStateKey (stateKey, state.dynamicStates.data(),
+                                sizeof (VkDynamicState)                      * state.dynamicStates.size());
+
+                auto& inputAssembly = state.inputAssembly;
+                appendStateKey (stateKey, &inputAssembly.topology,               sizeof (VkPrimitiveTopology));
+                appendStateKey (stateKey, &inputAssembly.primitiveRestartEnable, sizeof (VkBool32));
+
+                auto& rasterization = state.rasterization;
+                appendStateKey (stateKey, &rasterization.depthClampEnable,        sizeof (VkBool32));
+                appendStateKey (stateKey, &rasterization.rasterizerDiscardEnable, sizeof (VkBool32));
+                appendStateKey (stateKey, &rasterization.polygonMode,             sizeof (VkPolygonMode));
+                appendStateKey (stateKey, &rasterization.cullMode,                sizeof (VkCullModeFlags));
+                appendStateKey (stateKey, &rasterization.frontFace,               sizeof (VkFrontFace));
+                appendStateKey (stateKey, &rasterization.depthBiasEnable,         sizeof (VkBool32));
+                appendStateKey (stateKey, &rasterization.depthBiasConstantFactor, sizeof (float));
+                appendStateKey (stateKey, &rasterization.depthBiasClamp,          sizeof (float));
+                appendStateKey (stateKey, &rasterization.depthBiasSlopeFactor,    sizeof (float));
+                appendStateKey (stateKey, &rasterization.lineWidth,               sizeof (float));
+
+                auto& multiSample = state.multiSample;
+                appendStateKey (stateKey, &multiSample.rasterizationSamples,  sizeof (VkSampleCountFlagBits));
+                appendStateKey (stateKey, &multiSample.sampleShadingEnable,   sizeof (VkBool32));
+                appendStateKey (stateKey, &multiSample.minSampleShading,      sizeof (float));
+                appendStateKey (stateKey, &multiSample.alphaToCoverageEnable, sizeof (VkBool32));
+                appendStateKey (stateKey, &multiSample.alphaToOneEnable,      sizeof (VkBool32));
+
+                auto& depthStencil = state.depthStencil;
+                appendStateKey (stateKey, &depthStencil.depthTestEnable,       sizeof (VkBool32));
+                appendStateKey (stateKey, &depthStencil.depthWriteEnable,      sizeof (VkBool32));
+                appendStateKey (stateKey, &depthStencil.depthCompareOp,        sizeof (VkCompareOp));
+                appendStateKey (stateKey, &depthStencil.depthBoundsTestEnable, sizeof (VkBool32));
+                appendStateKey (stateKey, &depthStencil.stencilTestEnable,     sizeof (VkBool32));
+                appendStateKey (stateKey, &depthStencil.front,                 sizeof (VkStencilOpState));
+                appendStateKey (stateKey, &depthStencil.back,                  sizeof (VkStencilOpState));
+                appendStateKey (stateKey, &depthStencil.minDepthBounds,        sizeof (float));
+                appendStateKey (stateKey, &depthStencil.maxDepthBounds,        sizeof (float));
+
+                auto& colorBlend = state.colorBlend;
+                appendStateKey (stateKey, &colorBlend.logicOpEnable,  sizeof (VkBool32));
+                appendStateKey (stateKey, &colorBlend.logicOp,        sizeof (VkLogicOp));
+                appendStateKey (stateKey, colorBlend.blendConstants,  sizeof (colorBlend.blendConstants));
+
+                auto& viewPort = state.viewPort;
+                appendStateKey (stateKey, &viewPort.viewportCount, sizeof (uint32_t));
+                appendStateKey (stateKey, &viewPort.scissorCount,  sizeof (uint32_t));
+                return stateKey;
+            }
+
+            /* Point the create infos in the state to the data that is owned by it
+            */
+            void resolvePipelineState (PipelineStateInfo& state) {
+                state.vertexInput.pVertexBindingDescriptions   = state.bindingDescriptions.data();
+                state.vertexInput.pVertexAttributeDescriptions = state.attributeDescriptions.data();
+                state.colorBlend.pAttachments                  = state.colorBlendAttachments.data();
+                state.dynamicState.pDynamicStates              = state.dynamicStates.data();
+
+                for (size_t i = 0; i < state.stages.size(); i++) {
+                    auto& specializationInfo = state.specializationInfos[i];
+                    specializationInfo.pMapEntries = state.specializationMapEntries[i].data();
+                    specializationInfo.pData       = state.specializationData[i].data();
+
+                    state.stages[i].pName               = state.entryPoints[i].c_str();
+                    state.stages[i].pSpecializationInfo = specializationInfo.mapEntryCount == 0 ? VK_NULL_HANDLE:
+                                                                                                  &specializationInfo;
+                }
+            }
+
+            void launchPipelineBatch (uint32_t deviceInfoId) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto& info      = m_pipelineRegistryInfo;
+
+                info.batchRequests.swap (info.pendingRequests);
+                info.pendingRequests.clear();
+                /* Reserve the states up front, since the create infos point in to them
+                */
+                info.batchStates.clear();
+                info.batchStates.reserve      (info.batchRequests.size());
+                info.batchCreateInfos.clear();
+                info.batchCreateInfos.reserve (info.batchRequests.size());
+                info.batchPipelines.assign    (info.batchRequests.size(), VK_NULL_HANDLE);
+
+                for (auto const& pipelineInfoId: info.batchRequests) {
+                    auto requestInfo    = getPipelineRequestInfo (pipelineInfoId);
+                    auto pipelineInfo   = getPipelineInfo        (pipelineInfoId);
+                    auto renderPassInfo = getRenderPassInfo      (requestInfo->meta.renderPassInfoId);
+
+                    info.batchStates.push_back (std::move (requestInfo->state));
+                    auto& state = info.batchStates.back();
+                    resolvePipelineState (state);
+                    /* A derivative may refer to a base pipeline that is in the same batch using its index in the batch,
+                     * the base must be at a lower index than the derivative. Otherwise, the handle of the base is used if
+                     * it is ready, and if it isn't, the pipeline is created as a regular pipeline
+                    */
+                    VkPipelineCreateFlags pipelineCreateFlags = requestInfo->meta.pipelineCreateFlags;
+                    VkPipeline basePipeline                   = VK_NULL_HANDLE;
+                    int32_t basePipelineIndex                 = -1;
+                    if (pipelineCreateFlags & VK_PIPELINE_CREATE_DERIVATIVE_BIT) {
+                        uint32_t baseOwnerInfoId = requestInfo->meta.basePipelineInfoId;
+                        auto baseRequestInfo     = m_pipelineRequestInfoPool.find (baseOwnerInfoId);
+                        if (baseRequestInfo != nullptr)
+                            baseOwnerInfoId = baseRequestInfo->meta.ownerPipelineInfoId;
+
+                        for (size_t i = 0; i < info.batchCreateInfos.size(); i++) {
+                            if (info.batchRequests[i] == baseOwnerInfoId) {
+                                basePipelineIndex = static_cast <int32_t> (i);
+                                break;
+                            }
+                        }
+                        if (basePipelineIndex == -1 && isPipelineReady (baseOwnerInfoId))
+                            basePipeline = getPipelineInfo (baseOwnerInfoId)->resource.pipeline;
+
+                        if (basePipelineIndex == -1 && basePipeline == VK_NULL_HANDLE)
+                            pipelineCreateFlags &= ~VK_PIPELINE_CREATE_DERIVATIVE_BIT;
+                    }
+
+                    pipelineInfo->meta.subPassIndex      = requestInfo->meta.subPassIndex;
+                    pipelineInfo->meta.basePipelineIndex = basePipelineIndex;
+                    pipelineInfo->resource.renderPass    = renderPassInfo->resource.renderPass;
+                    pipelineInfo->resource.basePipeline  = basePipeline;
+
+                    VkGraphicsPipelineCreateInfo createInfo;
+                    createInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+                    createInfo.pNext               = VK_NULL_HANDLE;
+                    createInfo.flags               = pipelineCreateFlags;
+                    createInfo.pVertexInputState   = &state.vertexInput;
+                    createInfo.pInputAssemblyState = &state.inputAssembly;
+                    createInfo.pTessellationState  = VK_NULL_HANDLE;
+                    createInfo.stageCount          = static_cast <uint32_t> (state.stages.size());
+                    createInfo.pStages             = state.stages.data();
+                    createInfo.pDepthStencilState  = &state.depthStencil;
+                    createInfo.pRasterizationState = &state.rasterization;
+                    createInfo.pMultisampleState   = &state.multiSample;
+                    createInfo.pColorBlendState    = &state.colorBlend;
+                    createInfo.pDynamicState       = &state.dynamicState;
+                    createInfo.pViewportState      = &state.viewPort;
+
+                    createInfo.subpass             = requestInfo->meta.subPassIndex;
+                    createInfo.basePipelineIndex   = basePipelineIndex;
+                    createInfo.layout              = pipelineInfo->resource.layout;
+                    /* Pipeline vs Render pass
+                     * VkPipeline is a GPU context. Think of the GPU as a FPGA (which it isn't, but bear with me). Doing
+                     * vkCmdBindPipeline would set the GPU to a given gate configuration. But since the GPU is not a
+                     * FPGA, it sets the GPU to a state where it can execute the shader programs and fixed-function
+                     * pipeline stages defined by the VkPipeline
+                     * 
+                     * VkRenderPass is a data oriented thing. It is necessitated by tiled architecture GPUs.
+                     * Conceptually, they divide the framebuffer up into tiles that are processed independently.
+                     * Tiled-architecture GPUs need to "load" images\buffers from general-purpose RAM to "on-chip memory".
+                     * When they are done they "store" their results back to RAM. This loading of attachments is done by
+                     * smaller "tiles", so the on-chip memory (and therefore shaders) never sees the whole memory at the
+                     * same time
+                     * 
+                     * Loading and storing these tiles is rather slow and a good optimization strategy is to combine as
+                     * many operations as possible into one cycle over the whole framebuffer. It's trivial to see that
+                     * operations can be combined safely as long as they don't depend on intermediate results from other
+                     * tiles. Subpasses and subpass dependencies tell the GPU drivers where these kinds of dependencies
+                     * exist (or don't), so that they can group the actual render calls more effectively under the hood
+                     * 
+                     * Note that, you can have multiple pipeline in a single render pass
+                    */
+                    createInfo.renderPass          = renderPassInfo->resource.renderPass;
+                    createInfo.basePipelineHandle  = basePipeline;
+                    info.batchCreateInfos.push_back (createInfo);
+                }
+
+                info.meta.compiling = true;
+                info.resource.done.store (false, std::memory_order_relaxed);
+                info.stats.batchesCount++;
+                info.stats.peakBatchSize = std::max (info.stats.peakBatchSize,
+                                                     static_cast <uint32_t> (info.batchRequests.size()));
+                /* Create the pipeline
+                 * The vkCreateGraphicsPipelines function actually has more parameters than the usual object creation 
+                 * functions in Vulkan. It is designed to take multiple VkGraphicsPipelineCreateInfo objects and create 
+                 * multiple VkPipeline objects in a single call.
+                 * 
+                 * The second parameter references an optional VkPipelineCache object. A pipeline cache can be used to 
+                 * store and reuse data relevant to pipeline creation across multiple calls to vkCreateGraphicsPipelines 
+                 * and even across program executions if the cache is stored to a file. This makes it possible to 
+                 * significantly speed up pipeline creation at a later time (see VKPipelineCache)
+                 *
+                 * The pipeline cache is internally synchronized, so it may be used by the worker while pipelines are
+                 * created on other threads. Note that, the worker does not touch anything but the batch
+                */
+                VkDevice logDevice            = deviceInfo->resource.logDevice;
+                VkPipelineCache pipelineCache = getPipelineCache();
+                info.resource.worker = std::thread ([&info, logDevice, pipelineCache](void) {
+                    auto createStartTime = std::chrono::high_resolution_clock::now();
+                    info.meta.result     = vkCreateGraphicsPipelines (logDevice,
+                                                                      pipelineCache,
+                                                                      static_cast <uint32_t>
+                                                                      (info.batchCreateInfos.size()),
+                                                                      info.batchCreateInfos.data(),
+                                                                      VK_NULL_HANDLE,
+                                                                      info.batchPipelines.data());
+                    auto createEndTime   = std::chrono::high_resolution_clock::now();
+                    info.meta.createTimeMs = std::chrono::duration <float, std::chrono::milliseconds::period>
+                                             (createEndTime - createStartTime).count();
+                    info.resource.done.store (true, std::memory_order_release);
+                });
+            }
+
+            void completePipelineBatch (void) {
+                auto& info = m_pipelineRegistryInfo;
+                info.resource.worker.join();
+                info.meta.compiling = false;
+
+                if (info.meta.result != VK_SUCCESS) {
+                    LOG_ERROR (m_VKPipelineRegistryLog) << "Failed to create graphics pipelines "
+                                                        << "[" << info.batchRequests.size() << "]"
+                                                        << " "
+                                                        << "[" << string_VkResult (info.meta.result) << "]"
+                                                        << std::endl;
+                    throw std::runtime_error ("Failed to create graphics pipelines");
+                }
+                addPipelineCreateSample (static_cast <uint32_t> (info.batchRequests.size()), info.meta.createTimeMs);
+
+                for (size_t i = 0; i < info.batchRequests.size(); i++) {
+                    auto requestInfo  = getPipelineRequestInfo (info.batchRequests[i]);
+                    auto pipelineInfo = getPipelineInfo        (info.batchRequests[i]);
+
+                    pipelineInfo->resource.pipeline = info.batchPipelines[i];
+                    requestInfo->meta.ready         = true;
+                    LOG_INFO (m_VKPipelineRegistryLog) << "Pipeline ready "
+                                                       << "[" << info.batchRequests[i] << "]"
+                                                       << " "
+                                                       << "[" << std::hex 
+                                                              << requestInfo->meta.stateHash 
+                                                              << std::dec << "]"
+                                                       << std::endl;
+                }
+                /* Hand over the pipelines to the requests that share them
+                */
+                for (auto const& [key, val]: m_pipelineRequestInfoPool) {
+                    if (val.meta.ready || !isPipelineReady (val.meta.ownerPipelineInfoId))
+                        continue;
+
+                    auto requestInfo  = getPipelineRequestInfo (key);
+                    auto pipelineInfo = getPipelineInfo        (key);
+                    pipelineInfo->resource.pipeline       = getPipelineInfo (val.meta.ownerPipelineInfoId)->
+                                                            resource.pipeline;
+                    pipelineInfo->resource.sharedPipeline = true;
+                    requestInfo->meta.ready               = true;
+                }
+
+                info.batchRequests.clear();
+                info.batchStates.clear();
+                info.batchCreateInfos.clear();
+                info.batchPipelines.clear();
+            }
+
+        public:
+            VKPipelineRegistry (void) {
+                m_pipelineRegistryInfo.meta.compiling = false;
+                m_pipelineRegistryInfo.resource.done.store (false);
+                m_pipelineRegistryInfo.stats          = {};
+
+                m_VKPipelineRegistryLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+            }
+
+            ~VKPipelineRegistry (void) {
+                LOG_CLOSE (m_instanceId);
+            }
+
+        protected:
+            /* Request a graphics pipeline for a pipeline info whose state and layout have been configured. The pipeline
+             * is compiled with the next batch (see flushPipelineRequests). Set the base pipeline info id if the
+             * pipeline is to be derived from another, and the fallback pipeline info id if another pipeline is to be
+             * bound in its place until it is ready. Note that, the fallback pipeline is required to have a layout that
+             * is compatible with that of the requested pipeline. Pass UINT32_MAX for either if not used
+            */
+            void requestGraphicsPipeline (uint32_t renderPassInfoId,
+                                          uint32_t pipelineInfoId,
+                                          uint32_t subPassIndex,
+                                          uint32_t basePipelineInfoId,
+                                          uint32_t fallbackPipelineInfoId,
+                                          VkPipelineCreateFlags pipelineCreateFlags) {
+
+                if (m_pipelineRequestInfoPool.contains (pipelineInfoId)) {
+                    LOG_ERROR (m_VKPipelineRegistryLog) << "Pipeline request info id already exists "
+                                                        << "[" << pipelineInfoId << "]"
+                                                        << std::endl;
+                    throw std::runtime_error ("Pipeline request info id already exists");
+                }
+
+                auto pipelineInfo   = getPipelineInfo   (pipelineInfoId);
+                auto renderPassInfo = getRenderPassInfo (renderPassInfoId);
+                auto& info          = m_pipelineRegistryInfo;
+
+                PipelineRequestInfo requestInfo{};
+                auto& state         = requestInfo.state;
+                state.vertexInput   = pipelineInfo->state.vertexInput;
+                state.inputAssembly = pipelineInfo->state.inputAssembly;
+                state.depthStencil  = pipelineInfo->state.depthStencil;
+                state.rasterization = pipelineInfo->state.rasterization;
+                state.multiSample   = pipelineInfo->state.multiSample;
+                state.colorBlend    = pipelineInfo->state.colorBlend;
+                state.dynamicState  = pipelineInfo->state.dynamicState;
+                state.viewPort      = pipelineInfo->state.viewPort;
+                state.stages        = pipelineInfo->state.stages;
+
+                state.bindingDescriptions.assign   (state.vertexInput.pVertexBindingDescriptions,
+                                                    state.vertexInput.pVertexBindingDescriptions +
+                                                    state.vertexInput.vertexBindingDescriptionCount);
+                state.attributeDescriptions.assign (state.vertexInput.pVertexAttributeDescriptions,
+                                                    state.vertexInput.pVertexAttributeDescriptions +
+                                                    state.vertexInput.vertexAttributeDescriptionCount);
+                state.colorBlendAttachments.assign (state.colorBlend.pAttachments,
+                                                    state.colorBlend.pAttachments +
+                                                    state.colorBlend.attachmentCount);
+                state.dynamicStates.assign         (state.dynamicState.pDynamicStates,
+                                                    state.dynamicState.pDynamicStates +
+                                                    state.dynamicState.dynamicStateCount);
+                for (auto const& stage: state.stages) {
+                    state.entryPoints.push_back (stage.pName);
+
+                    VkSpecializationInfo specializationInfo{};
+                    auto mapEntries = std::vector <VkSpecializationMapEntry> {};
+                    auto data       = std::vector <uint8_t>                  {};
+                    if (stage.pSpecializationInfo != VK_NULL_HANDLE) {
+                        specializationInfo = *stage.pSpecializationInfo;
+                        auto pData         = static_cast <const uint8_t*> (specializationInfo.pData);
+                        mapEntries.assign (specializationInfo.pMapEntries,
+                                           specializationInfo.pMapEntries + specializationInfo.mapEntryCount);
+                        data.assign       (pData, pData + specializationInfo.dataSize);
+                    }
+                    state.specializationInfos.push_back     (specializationInfo);
+                    state.specializationMapEntries.push_back (std::move (mapEntries));
+                    state.specializationData.push_back       (std::move (data));
+                }
+
+                auto stateKey                           = getPipelineStateKey (pipelineInfoId,
+                                                                               state,
+                                                                               renderPassInfo->resource.renderPass,
+                                                                               subPassIndex,
+                                                                               pipelineCreateFlags);
+                requestInfo.meta.stateHash              = getHash (stateKey.data(), stateKey.size());
+                requestInfo.meta.renderPassInfoId       = renderPassInfoId;
+                requestInfo.meta.subPassIndex           = subPassIndex;
+                requestInfo.meta.basePipelineInfoId     = basePipelineInfoId;
+                requestInfo.meta.fallbackPipelineInfoId = fallbackPipelineInfoId;
+                requestInfo.meta.ownerPipelineInfoId    = pipelineInfoId;
+                requestInfo.meta.pipelineCreateFlags    = pipelineCreateFlags;
+                requestInfo.meta.ready                  = false;
+                info.stats.requestsCount++;
+
+                auto it = info.stateHashLUT.find (requestInfo.meta.stateHash);
+                if (it != info.stateHashLUT.end() && it->second.stateKey == stateKey) {
+                    /* The state is identical to that of an earlier request, so the pipeline of that request is shared
+                     * once it is ready. The state is not needed anymore
+                    */
+                    uint32_t ownerPipelineInfoId         = it->second.ownerPipelineInfoId;
+                    requestInfo.meta.ownerPipelineInfoId = ownerPipelineInfoId;
+                    requestInfo.state                    = {};
+                    info.stats.sharedCount++;
+
+                    if (isPipelineReady (ownerPipelineInfoId)) {
+                        pipelineInfo->resource.pipeline       = getPipelineInfo (ownerPipelineInfoId)->resource.pipeline;
+                        pipelineInfo->resource.sharedPipeline = true;
+                        requestInfo.meta.ready                = true;
+                    }
+                    LOG_INFO (m_VKPipelineRegistryLog) << "Pipeline request shared "
+                                                       << "[" << pipelineInfoId << "]"
+                                                       << "->"
+                                                       << "[" << ownerPipelineInfoId << "]"
+                                                       << std::endl;
+                }
+                else {
+                    /* A different state with the same hash compiles its own pipeline, and the table keeps pointing to
+                     * the request that was made first
+                    */
+                    if (it != info.stateHashLUT.end()) {
+                        info.stats.collisionsCount++;
+                        LOG_INFO (m_VKPipelineRegistryLog) << "Pipeline state hash collision "
+                                                           << "[" << pipelineInfoId << "]"
+                                                           << "->"
+                                                           << "[" << it->second.ownerPipelineInfoId << "]"
+                                                           << " "
+                                                           << "[" << std::hex
+                                                                  << requestInfo.meta.stateHash
+                                                                  << std::dec << "]"
+                                                           << std::endl;
+                    }
+                    else
+                        info.stateHashLUT.insert ({requestInfo.meta.stateHash, {pipelineInfoId, std::move (stateKey)}});
+                    info.pendingRequests.push_back (pipelineInfoId);
+                }
+                m_pipelineRequestInfoPool.insert (pipelineInfoId, requestInfo);
+            }
+
+            /* Start compiling the requests made so far in a single batch, if a batch is not being compiled already
+            */
+            void flushPipelineRequests (uint32_t deviceInfoId) {
+                auto& info = m_pipelineRegistryInfo;
+                if (!info.meta.compiling && !info.pendingRequests.empty())
+                    launchPipelineBatch (deviceInfoId);
+            }
+
+            /* Pick up the batch that was compiled (if it is done) and start on the next one. This is to be called once
+             * every frame
+            */
+            void updatePipelineRequests (uint32_t deviceInfoId) {
+                auto& info = m_pipelineRegistryInfo;
+                if (info.meta.compiling && info.resource.done.load (std::memory_order_acquire))
+                    completePipelineBatch();
+                flushPipelineRequests (deviceInfoId);
+            }
+
+            /* Block until all the requests made so far have been compiled
+            */
+            void waitPipelineRequests (uint32_t deviceInfoId) {
+                auto& info = m_pipelineRegistryInfo;
+                while (info.meta.compiling || !info.pendingRequests.empty()) {
+                    if (info.meta.compiling)
+                        completePipelineBatch();
+                    flushPipelineRequests (deviceInfoId);
+                }
+            }
+
+            /* Note that, pipelines that were created without a request are always ready
+            */
+            bool isPipelineReady (uint32_t pipelineInfoId) {
+                auto requestInfo = m_pipelineRequestInfoPool.find (pipelineInfoId);
+                return requestInfo == nullptr || requestInfo->meta.ready;
+            }
+
+            /* Returns the pipeline info id of the pipeline to be bound in place of the requested pipeline, which is the
+             * requested pipeline itself if it is ready, or its fallback if that is ready. Otherwise, UINT32_MAX is
+             * returned and the draws that use the pipeline are to be skipped
+            */
+            uint32_t getBindablePipelineInfoId (uint32_t pipelineInfoId) {
+                if (isPipelineReady (pipelineInfoId))
+                    return pipelineInfoId;
+
+                uint32_t fallbackPipelineInfoId = getPipelineRequestInfo (pipelineInfoId)->meta.fallbackPipelineInfoId;
+                if (fallbackPipelineInfoId != UINT32_MAX && isPipelineReady (fallbackPipelineInfoId))
+                    return fallbackPipelineInfoId;
+                return UINT32_MAX;
+            }
+
+            void dumpPipelineRegistryStats (void) {
+                LOG_INFO (m_VKPipelineRegistryLog) << "Dumping pipeline registry stats"
+                                                   << std::endl;
+
+                LOG_INFO (m_VKPipelineRegistryLog) << "Requests count "
+                                                   << "[" << m_pipelineRegistryInfo.stats.requestsCount << "]"
+                                                   << std::endl;
+
+                LOG_INFO (m_VKPipelineRegistryLog) << "Shared count "
+                                                   << "[" << m_pipelineRegistryInfo.stats.sharedCount << "]"
+                                                   << std::endl;
+
+                LOG_INFO (m_VKPipelineRegistryLog) << "Collisions count "
+                                                   << "[" << m_pipelineRegistryInfo.stats.collisionsCount << "]"
+                                                   << std::endl;
+
+                LOG_INFO (m_VKPipelineRegistryLog) << "Batches count "
+                                                   << "[" << m_pipelineRegistryInfo.stats.batchesCount << "]"
+                                                   << std::endl;
+
+                LOG_INFO (m_VKPipelineRegistryLog) << "Peak batch size "
+                                                   << "[" << m_pipelineRegistryInfo.stats.peakBatchSize << "]"
+                                                   << std::endl;
+            }
+
+            /* Note that, the batch that is being compiled (if any) is waited on, and the pending requests are dropped
+            */
+            void cleanUpPipelineRegistry (void) {
+                auto& info = m_pipelineRegistryInfo;
+                if (info.meta.compiling)
+                    completePipelineBatch();
+
+                info.pendingRequests.clear();
+                info.stateHashLUT.clear();
+
+                std::vector <uint32_t> pipelineInfoIds;
+                for (auto const& [key, val]: m_pipelineRequestInfoPool)
+                    pipelineInfoIds.push_back (key);
+                for (auto const& pipelineInfoId: pipelineInfoIds)
+                    m_pipelineRequestInfoPool.erase (pipelineInfoId);
+            }
+    };
+}   // namespace Core
+#endif  // VK_PIPELINE_REGISTRY_H
@@ -71,8 +71,8 @@ namespace Core {
         public:
             VKShaderStage (void) {
                 m_VKShaderStageLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE); 
+                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_SHARED | Log::TO_CONSOLE); 
             }
 
             ~VKShaderStage (void) { 
@@ -80,11 +80,30 @@ namespace Core {
             }
 
         protected:  
+            /* Specialization constants are declared in the shader using the constant_id layout qualifier, along with a
+             * default value that is used if the constant is not specialized. Each map entry specifies the constant id,
+             * and the offset and size of its value in the specialization data. Note that, a bool constant takes up
+             * the size of a VkBool32 in the data
+            */
+            VkSpecializationMapEntry getSpecializationMapEntry (uint32_t constantId,
+                                                                uint32_t offset,
+                                                                size_t size) {
+                VkSpecializationMapEntry mapEntry;
+                mapEntry.constantID = constantId;
+                mapEntry.offset     = offset;
+                mapEntry.size       = size;
+                return mapEntry;
+            }
+
+            /* Note that, the specialization info (if any) and the data it points to are owned by the caller, and need to
+             * be valid only until the pipeline is requested
+            */
             VkShaderModule createShaderStage (uint32_t deviceInfoId,
                                               uint32_t pipelineInfoId,
                                               VkShaderStageFlagBits stage,
                                               const char* shaderBinaryPath,
-                                              const char* entryPoint) {
+                                              const char* entryPoint,
+                                              const VkSpecializationInfo* specializationInfo) {
 
                 auto pipelineInfo = getPipelineInfo (pipelineInfoId);
                 auto shaderCode   = getByteCode     (shaderBinaryPath);
@@ -107,6 +126,10 @@ namespace Core {
                                                    << std::endl; 
                     throw std::runtime_error ("Invalid shader module");
                 }
+                /* The module is owned by the pipeline manager from here on, along with the hash of its byte code which
+                 * is used to tell apart pipeline states that use different shaders
+                */
+                addShaderModule (module, getHash (shaderCode.data(), shaderCode.size()));
 
                 VkPipelineShaderStageCreateInfo createInfo;
                 createInfo.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -124,8 +147,11 @@ namespace Core {
                  * used in it. This is more efficient than configuring the shader using variables at render time, because 
                  * the compiler can do optimizations like eliminating if statements that depend on these values. If you 
                  * don't have any constants like that, then you can set the member to VK_NULL_HANDLE
+                 *
+                 * Pipelines that differ only in their specialization constants are different pipelines, which lets the
+                 * same shader module be used to build variants of a pipeline (for example, per material class)
                 */
-                createInfo.pSpecializationInfo = VK_NULL_HANDLE;
+                createInfo.pSpecializationInfo = specializationInfo;
 
                 pipelineInfo->state.stages.push_back (createInfo);
                 return module;
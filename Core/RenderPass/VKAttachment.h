@@ -96,7 +96,11 @@ namespace Core {
              * image
             */
             void createResolveAttachment (uint32_t imageInfoId, uint32_t renderPassInfoId) {
+#if ENABLE_HEADLESS_MODE
+                auto imageInfo      = getImageInfo (imageInfoId, OFFSCREEN_IMAGE);
+#else
                 auto imageInfo      = getImageInfo (imageInfoId, SWAPCHAIN_IMAGE);
+#endif  // ENABLE_HEADLESS_MODE
                 auto renderPassInfo = getRenderPassInfo (renderPassInfoId);
 
                 VkAttachmentDescription attachment;
@@ -108,7 +112,14 @@ namespace Core {
                 attachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
                 attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
                 attachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
-                attachment.finalLayout    = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;       
+#if ENABLE_HEADLESS_MODE
+                /* Offscreen images are never presented, instead they are left in a layout that is ready to be copied
+                 * from for read back
+                */
+                attachment.finalLayout    = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+#else
+                attachment.finalLayout    = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+#endif  // ENABLE_HEADLESS_MODE
 
                 renderPassInfo->resource.attachments.push_back (attachment);         
             }            
@@ -15,14 +15,13 @@ namespace Core {
                     VkRenderPass renderPass;
                 } resource;
             };
-            std::unordered_map <uint32_t, RenderPassInfo> m_renderPassInfoPool;
+            SlotMap <RenderPassInfo> m_renderPassInfoPool;
 
             Log::Record* m_VKRenderPassMgrLog;
             const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
             
             void deleteRenderPassInfo (uint32_t renderPassInfoId) {
-                if (m_renderPassInfoPool.find (renderPassInfoId) != m_renderPassInfoPool.end()) {
-                    m_renderPassInfoPool.erase (renderPassInfoId);
+                if (m_renderPassInfoPool.erase (renderPassInfoId)) {
                     return;
                 }
 
@@ -35,8 +34,8 @@ namespace Core {
         public:
             VKRenderPassMgr (void) {
                 m_VKRenderPassMgrLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_IMMEDIATE);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE); 
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE); 
             }
 
             ~VKRenderPassMgr (void) { 
@@ -45,7 +44,7 @@ namespace Core {
 
         protected:
             void readyRenderPassInfo (uint32_t renderPassInfoId) {
-                if (m_renderPassInfoPool.find (renderPassInfoId) != m_renderPassInfoPool.end()) {
+                if (m_renderPassInfoPool.contains (renderPassInfoId)) {
                     LOG_ERROR (m_VKRenderPassMgrLog) << "Render pass info id already exists "
                                                      << "[" << renderPassInfoId << "]"
                                                      << std::endl;
@@ -53,7 +52,7 @@ namespace Core {
                 }
 
                 RenderPassInfo info{};
-                m_renderPassInfoPool[renderPassInfoId] = info;
+                m_renderPassInfoPool.insert (renderPassInfoId, info);
             }
 
             void createRenderPass (uint32_t deviceInfoId, uint32_t renderPassInfoId) {
@@ -89,8 +88,9 @@ namespace Core {
             }
 
             RenderPassInfo* getRenderPassInfo (uint32_t renderPassInfoId) {
-                if (m_renderPassInfoPool.find (renderPassInfoId) != m_renderPassInfoPool.end())
-                    return &m_renderPassInfoPool[renderPassInfoId];
+                auto info = m_renderPassInfoPool.find (renderPassInfoId);
+                if (info != nullptr)
+                    return info;
                 
                 LOG_ERROR (m_VKRenderPassMgrLog) << "Failed to find render pass info "
                                                  << "[" << renderPassInfoId << "]"
@@ -195,6 +195,32 @@ namespace Core {
                 renderPassInfo->resource.dependencies.push_back (dependency);            
             }
 
+            /* In headless mode, the color attachment is copied to a read back buffer right after the render pass ends.
+             * Without a dependency to VK_SUBPASS_EXTERNAL, the implicit one only waits until the bottom of the pipe
+             * with no access, which does not order the writes or the transition to the final layout (transfer src)
+             * before the copy. This dependency makes the color attachment writes, and the layout transition that
+             * follows them, visible to the transfer reads of the copy
+            */
+            void createReadBackDependency (uint32_t renderPassInfoId,
+                                           uint32_t srcSubPass,
+                                           uint32_t dstSubPass) {
+
+                auto renderPassInfo = getRenderPassInfo (renderPassInfoId);
+
+                VkSubpassDependency dependency;
+                dependency.dependencyFlags = 0;
+                dependency.srcSubpass      = srcSubPass;
+                dependency.dstSubpass      = dstSubPass;
+
+                dependency.srcStageMask    = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+                dependency.srcAccessMask   = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+                dependency.dstStageMask    = VK_PIPELINE_STAGE_TRANSFER_BIT;
+                dependency.dstAccessMask   = VK_ACCESS_TRANSFER_READ_BIT;
+
+                renderPassInfo->resource.dependencies.push_back (dependency);
+            }
+
             void createSubPass (uint32_t renderPassInfoId,
                                 const std::vector <VkAttachmentReference>& colorAttachments,
                                 const VkAttachmentReference* depthStencilAttachment,
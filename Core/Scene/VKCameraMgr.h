@@ -36,14 +36,13 @@ namespace Core {
                     glm::mat4 projectionMatrix;
                 } transform;
             };
-            std::unordered_map <uint32_t, CameraInfo> m_cameraInfoPool;
+            SlotMap <CameraInfo> m_cameraInfoPool;
 
             Log::Record* m_VKCameraMgrLog;
             const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
 
             void deleteCameraInfo (uint32_t cameraInfoId) {
-                if (m_cameraInfoPool.find (cameraInfoId) != m_cameraInfoPool.end()) {
-                    m_cameraInfoPool.erase (cameraInfoId);
+                if (m_cameraInfoPool.erase (cameraInfoId)) {
                     return;
                 }
 
@@ -56,8 +55,8 @@ namespace Core {
         public:
             VKCameraMgr (void) {
                 m_VKCameraMgrLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_IMMEDIATE);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE); 
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE); 
             }
 
             ~VKCameraMgr (void) { 
@@ -66,7 +65,7 @@ namespace Core {
 
         protected:
             void readyCameraInfo (uint32_t cameraInfoId) {
-                if (m_cameraInfoPool.find (cameraInfoId) != m_cameraInfoPool.end()) {
+                if (m_cameraInfoPool.contains (cameraInfoId)) {
                     LOG_ERROR (m_VKCameraMgrLog) << "Camera info id already exists "
                                                  << "[" << cameraInfoId << "]"
                                                  << std::endl;
@@ -74,7 +73,7 @@ namespace Core {
                 }
 
                 CameraInfo info{};
-                m_cameraInfoPool[cameraInfoId] = info;
+                m_cameraInfoPool.insert (cameraInfoId, info);
             }
 
             void createCameraMatrix (uint32_t deviceInfoId, uint32_t cameraInfoId) {
@@ -132,8 +131,9 @@ namespace Core {
             }
 
             CameraInfo* getCameraInfo (uint32_t cameraInfoId) {
-                if (m_cameraInfoPool.find (cameraInfoId) != m_cameraInfoPool.end())
-                    return &m_cameraInfoPool[cameraInfoId];
+                auto info = m_cameraInfoPool.find (cameraInfoId);
+                if (info != nullptr)
+                    return info;
                 
                 LOG_ERROR (m_VKCameraMgrLog) << "Failed to find camera info "
                                              << "[" << cameraInfoId << "]"
@@ -7,12 +7,17 @@
 #include "../Device/VKLogDevice.h"
 #include "../Model/VKModelMgr.h"
 #include "../Image/VKImageMgr.h"
+#include "../Image/VKTextureImage.h"
+#include "../Image/VKTextureStream.h"
+#include "../Pipeline/VKPipelineRegistry.h"
 #include "../Buffer/VKBufferMgr.h"
 #include "../RenderPass/VKFrameBuffer.h"
 #include "../Cmd/VKCmdBuffer.h"
+#include "../Cmd/VKQueryPool.h"
 #include "VKCameraMgr.h"
 #include "VKTextureSampler.h"
-#include "VKDescriptor.h"
+#include "VKDescriptorAllocator.h"
+#include "VKTextureTable.h"
 #include "VKSyncObject.h"
 
 namespace Core {
@@ -22,12 +27,17 @@ namespace Core {
                             protected virtual VKLogDevice,
                             protected virtual VKModelMgr,
                             protected virtual VKImageMgr,
+                            protected virtual VKTextureImage,
+                            protected virtual VKTextureStream,
+                            protected virtual VKPipelineRegistry,
                             protected virtual VKBufferMgr,
                             protected virtual VKFrameBuffer,
                             protected virtual VKCmdBuffer,
+                            protected virtual VKQueryPool,
                             protected virtual VKCameraMgr,
                             protected virtual VKTextureSampler,
-                            protected virtual VKDescriptor,
+                            protected virtual VKDescriptorAllocator,
+                            protected virtual VKTextureTable,
                             protected virtual VKSyncObject {
         private:
             Log::Record* m_VKDeleteSequenceLog;
@@ -36,7 +46,7 @@ namespace Core {
         public:
             VKDeleteSequence (void) {
                 m_VKDeleteSequenceLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO, Log::TO_FILE_IMMEDIATE);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO, Log::TO_FILE_SHARED);
             }
 
             ~VKDeleteSequence (void) {
@@ -81,6 +91,16 @@ namespace Core {
                                                      << "[" << inFlightFenceInfoId << "]"
                                                      << std::endl;
                 }
+#if ENABLE_BENCHMARK_MODE
+                /* |------------------------------------------------------------------------------------------------|
+                 * | DESTROY DRAW OPS - QUERY POOL                                                                  |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                VKQueryPool::cleanUp (deviceInfoId, sceneInfo->resource.queryPool);
+                LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Draw ops query pool "
+                                                 << "[" << sceneInfoId << "]"
+                                                 << std::endl; 
+#endif  // ENABLE_BENCHMARK_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | DESTROY DRAW OPS - COMMAND POOL                                                                |
                  * |------------------------------------------------------------------------------------------------|
@@ -90,11 +110,21 @@ namespace Core {
                                                  << "[" << sceneInfoId << "]"
                                                  << std::endl; 
                 /* |------------------------------------------------------------------------------------------------|
-                 * | DESTROY DESCRIPTOR POOL                                                                        |
+                 * | DESTROY TEXTURE TABLE                                                                          |
                  * |------------------------------------------------------------------------------------------------|
                 */
-                VKDescriptor::cleanUp (deviceInfoId, sceneInfoId);
-                LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Descriptor pool " 
+                dumpTextureTableStats();
+                cleanUpTextureTable (deviceInfoId);
+                LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Texture table " 
+                                                 << "[" << sceneInfoId << "]"
+                                                 << std::endl; 
+                /* |------------------------------------------------------------------------------------------------|
+                 * | DESTROY DESCRIPTOR POOLS                                                                       |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                dumpDescriptorAllocatorStats();
+                cleanUpDescriptorAllocator (deviceInfoId);
+                LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Descriptor pools " 
                                                  << "[" << sceneInfoId << "]"
                                                  << std::endl; 
                 /* |------------------------------------------------------------------------------------------------|
@@ -105,6 +135,18 @@ namespace Core {
                 LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Texture sampler " 
                                                  << "[" << sceneInfoId << "]"
                                                  << std::endl; 
+                /* |------------------------------------------------------------------------------------------------|
+                 * | DESTROY PIPELINE REQUESTS                                                                      |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* The batch of pipelines that is being compiled (if any) is waited on before the pipelines and the 
+                 * shader modules are destroyed
+                */
+                dumpPipelineRegistryStats();
+                cleanUpPipelineRegistry();
+                LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Pipeline requests "
+                                                 << "[" << deviceInfoId << "]"
+                                                 << std::endl;
                 /* |------------------------------------------------------------------------------------------------|
                  * | DESTROY PIPELINE                                                                               |
                  * |------------------------------------------------------------------------------------------------|
@@ -115,6 +157,26 @@ namespace Core {
                                                      << "[" << infoId << "]"
                                                      << std::endl;
                 }
+                /* |------------------------------------------------------------------------------------------------|
+                 * | DESTROY SHADER MODULES                                                                         |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                cleanUpShaderModules (deviceInfoId);
+                LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Shader modules"
+                                                 << std::endl;
+                /* |------------------------------------------------------------------------------------------------|
+                 * | DESTROY PIPELINE CACHE                                                                         |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* Save the contents of the pipeline cache before it is destroyed, so that the next run starts with a 
+                 * warm cache
+                */
+                dumpPipelineCacheStats();
+                savePipelineCache    (deviceInfoId);
+                cleanUpPipelineCache (deviceInfoId);
+                LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Pipeline cache "
+                                                 << "[" << deviceInfoId << "]"
+                                                 << std::endl;
                 /* |------------------------------------------------------------------------------------------------|
                  * | DESTROY FRAME BUFFERS                                                                          |
                  * |------------------------------------------------------------------------------------------------|
@@ -133,6 +195,21 @@ namespace Core {
                 LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Render pass " 
                                                  << "[" << renderPassInfoId << "]"
                                                  << std::endl; 
+#if ENABLE_HEADLESS_MODE
+                /* |------------------------------------------------------------------------------------------------|
+                 * | DESTROY READ BACK BUFFERS                                                                      |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                if (g_headlessSettings.enableReadBack) {
+                    for (uint32_t i = 0; i < g_coreSettings.maxFramesInFlight; i++) {
+                        uint32_t readBackBufferInfoId = sceneInfo->id.readBackBufferInfoBase + i; 
+                        VKBufferMgr::cleanUp (deviceInfoId, readBackBufferInfoId, READBACK_BUFFER);
+                        LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Read back buffer " 
+                                                         << "[" << readBackBufferInfoId << "]"
+                                                         << std::endl; 
+                    }
+                }
+#endif  // ENABLE_HEADLESS_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | DESTROY STORAGE BUFFERS                                                                        |
                  * |------------------------------------------------------------------------------------------------|
@@ -165,6 +242,9 @@ namespace Core {
                                                      << "[" << infoId << "]"
                                                      << std::endl; 
                 }
+                /* Report the bytes saved by the transient attachments before they are destroyed
+                */
+                dumpTransientImageStats (deviceInfoId);
                 /* |------------------------------------------------------------------------------------------------|
                  * | DESTROY MULTI SAMPLE RESOURCES                                                                 |
                  * |------------------------------------------------------------------------------------------------|
@@ -181,6 +261,33 @@ namespace Core {
                 LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Depth resources " 
                                                  << "[" << sceneInfo->id.depthImageInfo << "]"
                                                  << std::endl; 
+#if ENABLE_PROGRESSIVE_STARTUP
+                /* |------------------------------------------------------------------------------------------------|
+                 * | DESTROY TEXTURE LOADS                                                                          |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* If we are closing before all textures were loaded, the worker threads and the batch in flight are 
+                 * waited on before the staging buffer is destroyed
+                */
+                cleanUpTextureLoads (deviceInfoId);
+                LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Texture loads "
+                                                 << "[" << deviceInfoId << "]"
+                                                 << std::endl;
+#endif  // ENABLE_PROGRESSIVE_STARTUP
+#if ENABLE_TEXTURE_STREAMING
+                /* |------------------------------------------------------------------------------------------------|
+                 * | DESTROY TEXTURE STREAM                                                                         |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* The images that were replaced by streamed images are cleaned up here, the images that are currently
+                 * in use are held by the texture image infos and are cleaned up along with the texture resources
+                */
+                dumpTextureStreamStats();
+                cleanUpTextureStream (deviceInfoId);
+                LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Texture stream "
+                                                 << "[" << deviceInfoId << "]"
+                                                 << std::endl;
+#endif  // ENABLE_TEXTURE_STREAMING
                 /* |------------------------------------------------------------------------------------------------|
                  * | DESTROY TEXTURE RESOURCES - DIFFUSE TEXTURE                                                    |
                  * |------------------------------------------------------------------------------------------------|
@@ -191,6 +298,21 @@ namespace Core {
                                                      << "[" << infoId << "]"
                                                      << std::endl; 
                 }
+#if ENABLE_HEADLESS_MODE
+                /* |------------------------------------------------------------------------------------------------|
+                 * | DESTROY OFF SCREEN RESOURCES                                                                   |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                for (uint32_t i = 0; i < deviceInfo->meta.swapChainSize; i++) {
+                    uint32_t offScreenImageInfoId = sceneInfo->id.swapChainImageInfoBase + i;
+                    VKImageMgr::cleanUp (deviceInfoId, offScreenImageInfoId, OFFSCREEN_IMAGE);
+                    LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Off screen resources " 
+                                                     << "[" << offScreenImageInfoId << "]"
+                                                     << " "
+                                                     << "[" << deviceInfoId << "]"
+                                                     << std::endl; 
+                }
+#else
                 /* |------------------------------------------------------------------------------------------------|
                  * | DESTROY SWAP CHAIN RESOURCES                                                                   |
                  * |------------------------------------------------------------------------------------------------|
@@ -212,6 +334,7 @@ namespace Core {
                 LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Swap chain "
                                                  << "[" << deviceInfoId << "]"
                                                  << std::endl;
+#endif  // ENABLE_HEADLESS_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | DESTROY LOG DEVICE                                                                             |
                  * |------------------------------------------------------------------------------------------------|
@@ -220,6 +343,7 @@ namespace Core {
                 LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Log device " 
                                                  << "[" << deviceInfoId << "]"
                                                  << std::endl;                
+#if !ENABLE_HEADLESS_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | DESTROY SURFACE                                                                                |
                  * |------------------------------------------------------------------------------------------------|
@@ -228,6 +352,7 @@ namespace Core {
                 LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Surface " 
                                                  << "[" << deviceInfoId << "]"
                                                  << std::endl;   
+#endif  // ENABLE_HEADLESS_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | DESTROY DEBUG MESSENGER                                                                        |
                  * |------------------------------------------------------------------------------------------------|
@@ -244,6 +369,7 @@ namespace Core {
                 LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Instance "
                                                  << "[" << deviceInfoId << "]" 
                                                  << std::endl;                 
+#if !ENABLE_HEADLESS_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | DESTROY WINDOW                                                                                 |
                  * |------------------------------------------------------------------------------------------------|
@@ -252,6 +378,7 @@ namespace Core {
                 LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Window " 
                                                  << "[" << deviceInfoId << "]"
                                                  << std::endl;   
+#endif  // ENABLE_HEADLESS_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | DESTROY SCENE INFO                                                                             |
                  * |------------------------------------------------------------------------------------------------|
@@ -294,6 +421,7 @@ namespace Core {
                 dumpModelInfoPool();
                 dumpImageInfoPool();
                 dumpBufferInfoPool();
+                dumpMemoryAllocatorStats();
                 dumpRenderPassInfoPool();
                 dumpPipelineInfoPool();
                 dumpCameraInfoPool();
@@ -27,7 +27,7 @@ namespace Core {
         public:
             VKDescriptor (void) {
                 m_VKDescriptorLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
             }
 
             ~VKDescriptor (void) {
@@ -44,133 +44,6 @@ namespace Core {
                 return poolSize;
             }
 
-            /* Descriptor sets can't be created directly, they must be allocated from a pool like command buffers. The 
-             * equivalent for descriptor sets is unsurprisingly called a descriptor pool. A descriptor pool is a big heap
-             * of available UBOs, textures, storage buffers, etc that can be used when instantiating descriptor sets. This
-             * allows you to allocate a big heap of types ahead of time so that later on you don't have to ask the gpu to 
-             * do expensive allocations
-            */
-            void createDescriptorPool (uint32_t deviceInfoId,
-                                       uint32_t sceneInfoId,
-                                       const std::vector <VkDescriptorPoolSize>& poolSizes,
-                                       uint32_t maxDescriptorSets,
-                                       VkDescriptorPoolCreateFlags poolCreateFlags) {
-
-                auto deviceInfo = getDeviceInfo (deviceInfoId);
-                auto sceneInfo  = getSceneInfo  (sceneInfoId);
-
-                VkDescriptorPoolCreateInfo createInfo;
-                createInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-                createInfo.pNext         = VK_NULL_HANDLE;
-                createInfo.flags         = poolCreateFlags;
-                createInfo.poolSizeCount = static_cast <uint32_t> (poolSizes.size());
-                createInfo.pPoolSizes    = poolSizes.data();
-                /* Aside from the maximum number of individual descriptors that are available, we also need to specify 
-                 * the maximum number of descriptor sets that may be allocated from the pool
-                */
-                createInfo.maxSets = maxDescriptorSets;
-
-                /* Inadequate descriptor pools are a good example of a problem that the validation layers will not catch.
-                 * As of Vulkan 1.1, vkAllocateDescriptorSets may fail with the error code VK_ERROR_POOL_OUT_OF_MEMORY if 
-                 * the pool is not sufficiently large, but the driver may also try to solve the problem internally. This 
-                 * means that sometimes (depending on hardware, pool size and allocation size) the driver will let us get 
-                 * away with an allocation that exceeds the limits of our descriptor pool. Other times, 
-                 * vkAllocateDescriptorSets will fail and return VK_ERROR_POOL_OUT_OF_MEMORY. This can be particularly 
-                 * frustrating if the allocation succeeds on some machines, but fails on others
-                 * 
-                 * Since Vulkan shifts the responsiblity for the allocation to the driver, it is no longer a strict 
-                 * requirement to only allocate as many descriptors of a certain type 
-                 * (VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, etc.) as specified by the corresponding descriptorCount 
-                 * members for the creation of the descriptor pool. However, it remains best practise to do so
-                */
-                VkDescriptorPool descriptorPool;
-                VkResult result = vkCreateDescriptorPool (deviceInfo->resource.logDevice, 
-                                                          &createInfo, 
-                                                          VK_NULL_HANDLE, 
-                                                          &descriptorPool);
-                if (result != VK_SUCCESS) {
-                    LOG_ERROR (m_VKDescriptorLog) << "Failed to create descriptor pool "
-                                                  << "[" << sceneInfoId << "]"
-                                                  << " "
-                                                  << "[" << string_VkResult (result) << "]"
-                                                  << std::endl;
-                    throw std::runtime_error ("Failed to create descriptor pool");
-                }
-                sceneInfo->resource.descriptorPool = descriptorPool;
-            }
-
-            /* A descriptor set specifies the actual buffer or image resources that will be bound to the descriptors, just 
-             * like a framebuffer specifies the actual image views to bind to render pass attachments. In short, we will 
-             * actually bind the resource to the  descriptors so that the shader can access them. The descriptor set is 
-             * then bound for the drawing commands just like the vertex buffers and framebuffer
-            */
-            void createDescriptorSets (uint32_t deviceInfoId,
-                                       uint32_t pipelineInfoId,
-                                       uint32_t sceneInfoId,
-                                       uint32_t descriptorSetLayoutId,
-                                       uint32_t descriptorSetCount) {
-
-                auto deviceInfo   = getDeviceInfo   (deviceInfoId);
-                auto pipelineInfo = getPipelineInfo (pipelineInfoId);
-                auto sceneInfo    = getSceneInfo    (sceneInfoId);
-
-                if (descriptorSetLayoutId >= pipelineInfo->resource.descriptorSetLayouts.size()) {
-                    LOG_ERROR (m_VKDescriptorLog) << "Invalid descriptor set layout id " 
-                                                  << "[" << descriptorSetLayoutId << "]"
-                                                  << "->"
-                                                  << "[" << pipelineInfo->resource.descriptorSetLayouts.size() << "]"
-                                                  << std::endl; 
-                    throw std::runtime_error ("Invalid descriptor set layout id");
-                }
-                /* A descriptor set layout defines the structure of a descriptor set, a template of sorts. Think of a 
-                 * class or struct in C or C++, it says "I am made out of, 3 UBOs, a texture sampler, etc". It's analogous
-                 * to going
-                 * 
-                 * struct MyDesc {
-                 *      Buffer MyBuffer[3];
-                 *      Texture MyTex;
-                 * };
-                 * 
-                 * struct MyOtherDesc {
-                 *      Buffer MyBuffer;
-                 * };
-                 * 
-                 * Whereas, a descriptor set is an actual instance of a descriptor, as defined by a descriptor set layout.
-                 * Using the class/struct analogy, it's like going MyDesc DescInstance();
-                */
-                std::vector <VkDescriptorSetLayout> layouts (descriptorSetCount, 
-                                                    pipelineInfo->resource.descriptorSetLayouts[descriptorSetLayoutId]);
-
-                /* A descriptor set allocation is described with a VkDescriptorSetAllocateInfo struct. You need to 
-                 * specify the descriptor pool to allocate from, the number of descriptor sets to allocate, and the 
-                 * descriptor layout to base them on
-                */
-                VkDescriptorSetAllocateInfo allocInfo;
-                allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-                allocInfo.pNext              = VK_NULL_HANDLE;
-                allocInfo.descriptorPool     = sceneInfo->resource.descriptorPool;
-                allocInfo.descriptorSetCount = descriptorSetCount;
-                allocInfo.pSetLayouts        = layouts.data();
-
-                std::vector <VkDescriptorSet> descriptorSets (descriptorSetCount);
-                VkResult result = vkAllocateDescriptorSets (deviceInfo->resource.logDevice, 
-                                                            &allocInfo, 
-                                                            descriptorSets.data());
-                if (result != VK_SUCCESS) {
-                    LOG_ERROR (m_VKDescriptorLog) << "Failed to allocate descriptor sets "
-                                                  << "[" << sceneInfoId << "]"
-                                                  << " "
-                                                  << "[" << pipelineInfoId << "]"
-                                                  << " "
-                                                  << "[" << descriptorSetLayoutId << "]"
-                                                  << " "
-                                                  << "[" << string_VkResult (result) << "]"
-                                                  << std::endl;
-                    throw std::runtime_error ("Failed to allocate descriptor sets");
-                }   
-                sceneInfo->resource.descriptorSets = descriptorSets;
-            }
-
             /* Descriptors that refer to buffers, like a uniform buffer descriptor, are configured with a 
              * VkDescriptorBufferInfo struct. This structure specifies the buffer and the region within it that contains
              * the data for the descriptor
@@ -278,17 +151,6 @@ namespace Core {
                                         0, 
                                         VK_NULL_HANDLE);                
             }
-
-            void cleanUp (uint32_t deviceInfoId, uint32_t sceneInfoId) {
-                auto deviceInfo = getDeviceInfo (deviceInfoId);
-                auto sceneInfo  = getSceneInfo  (sceneInfoId);
-                /* You don't need to explicitly clean up descriptor sets, because they will be automatically freed when 
-                 * the descriptor pool is destroyed
-                */
-                vkDestroyDescriptorPool (deviceInfo->resource.logDevice, 
-                                         sceneInfo->resource.descriptorPool, 
-                                         VK_NULL_HANDLE);
-            }
     };
 }   // namespace Core
 #endif  // VK_DESCRIPTOR_H
\ No newline at end of file
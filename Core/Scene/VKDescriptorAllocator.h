@@ -0,0 +1,483 @@
+#ifndef VK_DESCRIPTOR_ALLOCATOR_H
+#define VK_DESCRIPTOR_ALLOCATOR_H
+
+#include <unordered_map>
+#include <cmath>
+#include "VKDescriptor.h"
+
+namespace Core {
+    /* Instead of sizing a descriptor pool up front for every descriptor set that will ever be allocated from it, the
+     * descriptor allocator manages a list of pools for each pool class, and grows the list by creating a new (larger)
+     * pool whenever the current pool runs out. A pool class groups together descriptor set layouts with a similar mix
+     * of descriptor types, and describes the pools that it creates using the ratio of each descriptor type per set
+     * rather than exact counts
+     *
+     * The sets allocated from a per frame pool class are short lived, and are released all at once by resetting every
+     * pool of the frame in flight (after its fence has been waited on), which is much cheaper than freeing the sets one
+     * by one. The sets allocated from any other pool class live until the allocator is cleaned up
+     *
+     * Note that, the sets are also cached by their binding contents, so that asking for a set that is identical to one
+     * that was allocated (and written to) earlier returns the existing set. Since the cache identifies resources by
+     * their handles, a pool class should be reset when the resources its sets point to are destroyed
+    */
+    class VKDescriptorAllocator: protected virtual VKDescriptor {
+        private:
+            struct DescriptorPoolListInfo {
+                /* Pools that still have room in them, the last one is allocated from. A pool is moved to the full pools
+                 * once an allocation from it fails
+                */
+                std::vector <VkDescriptorPool> readyPools;
+                std::vector <VkDescriptorPool> fullPools;
+                /* Map from the hash of a set's layout and binding contents to the set, along with the key that was
+                 * hashed
+                */
+                struct CachedSetInfo {
+                    std::vector <uint8_t> setKey;
+                    VkDescriptorSet descriptorSet;
+                };
+                std::unordered_map <uint64_t, CachedSetInfo> cachedSets;
+                uint32_t setsPerPool;
+            };
+
+            struct DescriptorPoolClassInfo {
+                struct Meta {
+                    std::vector <std::pair <VkDescriptorType, float>> poolSizeRatios;
+                    VkDescriptorPoolCreateFlags poolCreateFlags;
+                    bool perFrame;
+                } meta;
+
+                struct Resource {
+                    /* One list of pools per frame in flight if the pool class is per frame, otherwise just the one
+                    */
+                    std::vector <DescriptorPoolListInfo> poolLists;
+                } resource;
+
+                struct Stats {
+                    uint32_t poolsCount;
+                    uint32_t growsCount;
+                    uint32_t allocationsCount;
+                    uint32_t cacheHitsCount;
+                    uint32_t cacheCollisionsCount;
+                    uint32_t resetsCount;
+                } stats;
+            };
+            std::unordered_map <uint32_t, DescriptorPoolClassInfo> m_descriptorPoolClassInfos;
+
+            Log::Record* m_VKDescriptorAllocatorLog;
+            const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
+
+            DescriptorPoolClassInfo* getDescriptorPoolClassInfo (uint32_t poolClassId) {
+                auto it = m_descriptorPoolClassInfos.find (poolClassId);
+                if (it != m_descriptorPoolClassInfos.end())
+                    return &it->second;
+
+                LOG_ERROR (m_VKDescriptorAllocatorLog) << "Failed to find descriptor pool class "
+                                                       << "[" << poolClassId << "]"
+                                                       << std::endl;
+                throw std::runtime_error ("Failed to find descriptor pool class");
+            }
+
+            DescriptorPoolListInfo* getDescriptorPoolListInfo (uint32_t poolClassId, uint32_t frameId) {
+                auto poolClassInfo = getDescriptorPoolClassInfo (poolClassId);
+                if (frameId >= poolClassInfo->resource.poolLists.size()) {
+                    LOG_ERROR (m_VKDescriptorAllocatorLog) << "Invalid descriptor pool list id "
+                                                           << "[" << poolClassId << "]"
+                                                           << " "
+                                                           << "[" << frameId << "]"
+                                                           << "->"
+                                                           << "[" << poolClassInfo->resource.poolLists.size() << "]"
+                                                           << std::endl;
+                    throw std::runtime_error ("Invalid descriptor pool list id");
+                }
+                return &poolClassInfo->resource.poolLists[frameId];
+            }
+
+            /* Descriptor sets can't be created directly, they must be allocated from a pool like command buffers. The
+             * equivalent for descriptor sets is unsurprisingly called a descriptor pool. A descriptor pool is a big heap
+             * of available UBOs, textures, storage buffers, etc that can be used when instantiating descriptor sets. This
+             * allows you to allocate a big heap of types ahead of time so that later on you don't have to ask the gpu to
+             * do expensive allocations
+            */
+            VkDescriptorPool createDescriptorPool (uint32_t deviceInfoId,
+                                                   uint32_t poolClassId,
+                                                   uint32_t setsPerPool) {
+
+                auto deviceInfo    = getDeviceInfo              (deviceInfoId);
+                auto poolClassInfo = getDescriptorPoolClassInfo (poolClassId);
+
+                std::vector <VkDescriptorPoolSize> poolSizes;
+                for (auto const& [descriptorType, ratio]: poolClassInfo->meta.poolSizeRatios) {
+                    uint32_t descriptorCount = static_cast <uint32_t> (std::ceil (ratio * setsPerPool));
+                    poolSizes.push_back (getPoolSize (descriptorType, std::max (descriptorCount, 1u)));
+                }
+
+                VkDescriptorPoolCreateInfo createInfo;
+                createInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+                createInfo.pNext         = VK_NULL_HANDLE;
+                createInfo.flags         = poolClassInfo->meta.poolCreateFlags;
+                createInfo.poolSizeCount = static_cast <uint32_t> (poolSizes.size());
+                createInfo.pPoolSizes    = poolSizes.data();
+                /* Aside from the maximum number of individual descriptors that are available, we also need to specify
+                 * the maximum number of descriptor sets that may be allocated from the pool
+                */
+                createInfo.maxSets       = setsPerPool;
+
+                VkDescriptorPool descriptorPool;
+                VkResult result = vkCreateDescriptorPool (deviceInfo->resource.logDevice,
+                                                          &createInfo,
+                                                          VK_NULL_HANDLE,
+                                                          &descriptorPool);
+                if (result != VK_SUCCESS) {
+                    LOG_ERROR (m_VKDescriptorAllocatorLog) << "Failed to create descriptor pool "
+                                                           << "[" << poolClassId << "]"
+                                                           << " "
+                                                           << "[" << setsPerPool << "]"
+                                                           << " "
+                                                           << "[" << string_VkResult (result) << "]"
+                                                           << std::endl;
+                    throw std::runtime_error ("Failed to create descriptor pool");
+                }
+                poolClassInfo->stats.poolsCount++;
+                return descriptorPool;
+            }
+
+            /* Return the pool to allocate from next, a new pool is created if none of the pools have room left in them.
+             * Each new pool is larger than the one before it, so that a pool class that keeps on growing needs fewer
+             * pools over time
+            */
+            VkDescriptorPool getReadyDescriptorPool (uint32_t deviceInfoId, uint32_t poolClassId, uint32_t frameId) {
+                auto poolListInfo = getDescriptorPoolListInfo (poolClassId, frameId);
+                if (!poolListInfo->readyPools.empty())
+                    return poolListInfo->readyPools.back();
+
+                VkDescriptorPool descriptorPool = createDescriptorPool (deviceInfoId,
+                                                                        poolClassId,
+                                                                        poolListInfo->setsPerPool);
+                poolListInfo->readyPools.push_back (descriptorPool);
+                poolListInfo->setsPerPool = std::min (static_cast <uint32_t> (poolListInfo->setsPerPool *
+                                                                              g_descriptorSettings.poolGrowthFactor),
+                                                      g_descriptorSettings.maxSetsPerPool);
+                return descriptorPool;
+            }
+
+            /* A descriptor set specifies the actual buffer or image resources that will be bound to the descriptors, just
+             * like a framebuffer specifies the actual image views to bind to render pass attachments. In short, we will
+             * actually bind the resource to the  descriptors so that the shader can access them. The descriptor set is
+             * then bound for the drawing commands just like the vertex buffers and framebuffer
+            */
+            VkResult allocateFromDescriptorPool (uint32_t deviceInfoId,
+                                                 VkDescriptorPool descriptorPool,
+                                                 VkDescriptorSetLayout descriptorSetLayout,
+                                                 VkDescriptorSet* descriptorSet) {
+
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                /* A descriptor set allocation is described with a VkDescriptorSetAllocateInfo struct. You need to
+                 * specify the descriptor pool to allocate from, the number of descriptor sets to allocate, and the
+                 * descriptor layout to base them on
+                */
+                VkDescriptorSetAllocateInfo allocInfo;
+                allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+                allocInfo.pNext              = VK_NULL_HANDLE;
+                allocInfo.descriptorPool     = descriptorPool;
+                allocInfo.descriptorSetCount = 1;
+                allocInfo.pSetLayouts        = &descriptorSetLayout;
+
+                return vkAllocateDescriptorSets (deviceInfo->resource.logDevice, &allocInfo, descriptorSet);
+            }
+
+            void appendSetKey (std::vector <uint8_t>& setKey, const void* data, size_t size) {
+                auto bytes = static_cast <const uint8_t*> (data);
+                setKey.insert (setKey.end(), bytes, bytes + size);
+            }
+
+            /* Append the layout and the binding contents to the key field by field, since the write and descriptor info
+             * structs have padding and pointers in them. Every field is of a fixed size, and the descriptor count of a
+             * write comes before its descriptor infos, so the key is unambiguous
+            */
+            std::vector <uint8_t> getDescriptorSetKey (VkDescriptorSetLayout descriptorSetLayout,
+                                                       const std::vector <VkWriteDescriptorSet>& writeDescriptorSets) {
+
+                std::vector <uint8_t> setKey;
+                appendSetKey (setKey, &descriptorSetLayout, sizeof (descriptorSetLayout));
+                for (auto const& writeDescriptorSet: writeDescriptorSets) {
+                    appendSetKey (setKey, &writeDescriptorSet.dstBinding,      sizeof (uint32_t));
+                    appendSetKey (setKey, &writeDescriptorSet.dstArrayElement, sizeof (uint32_t));
+                    appendSetKey (setKey, &writeDescriptorSet.descriptorType,  sizeof (VkDescriptorType));
+                    appendSetKey (setKey, &writeDescriptorSet.descriptorCount, sizeof (uint32_t));
+
+                    for (uint32_t i = 0; i < writeDescriptorSet.descriptorCount; i++) {
+                        if (writeDescriptorSet.pBufferInfo != VK_NULL_HANDLE) {
+                            auto& bufferInfo = writeDescriptorSet.pBufferInfo[i];
+                            appendSetKey (setKey, &bufferInfo.buffer, sizeof (VkBuffer));
+                            appendSetKey (setKey, &bufferInfo.offset, sizeof (VkDeviceSize));
+                            appendSetKey (setKey, &bufferInfo.range,  sizeof (VkDeviceSize));
+                        }
+                        if (writeDescriptorSet.pImageInfo != VK_NULL_HANDLE) {
+                            auto& imageInfo = writeDescriptorSet.pImageInfo[i];
+                            appendSetKey (setKey, &imageInfo.sampler,     sizeof (VkSampler));
+                            appendSetKey (setKey, &imageInfo.imageView,   sizeof (VkImageView));
+                            appendSetKey (setKey, &imageInfo.imageLayout, sizeof (VkImageLayout));
+                        }
+                    }
+                }
+                return setKey;
+            }
+
+        public:
+            VKDescriptorAllocator (void) {
+                m_VKDescriptorAllocatorLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+            }
+
+            ~VKDescriptorAllocator (void) {
+                LOG_CLOSE (m_instanceId);
+            }
+
+        protected:
+            /* The pool size ratios give the number of descriptors of each type per set, for example a pool class with a
+             * ratio of 4 for combined image samplers creates pools that have room for 4 samplers per set. Note that, no
+             * pools are created until the first set is allocated
+            */
+            void createDescriptorPoolClass (uint32_t poolClassId,
+                                            const std::vector <std::pair <VkDescriptorType, float>>& poolSizeRatios,
+                                            VkDescriptorPoolCreateFlags poolCreateFlags,
+                                            bool perFrame) {
+
+                if (m_descriptorPoolClassInfos.find (poolClassId) != m_descriptorPoolClassInfos.end()) {
+                    LOG_ERROR (m_VKDescriptorAllocatorLog) << "Descriptor pool class already exists "
+                                                           << "[" << poolClassId << "]"
+                                                           << std::endl;
+                    throw std::runtime_error ("Descriptor pool class already exists");
+                }
+
+                DescriptorPoolClassInfo info{};
+                info.meta.poolSizeRatios  = poolSizeRatios;
+                info.meta.poolCreateFlags = poolCreateFlags;
+                info.meta.perFrame        = perFrame;
+
+                info.resource.poolLists.resize (perFrame ? g_coreSettings.maxFramesInFlight: 1);
+                for (auto& poolListInfo: info.resource.poolLists)
+                    poolListInfo.setsPerPool = g_descriptorSettings.initialSetsPerPool;
+
+                m_descriptorPoolClassInfos[poolClassId] = info;
+            }
+
+            /* Allocate a set from the pool class, using the pools of the frame in flight if the pool class is per frame
+             * (the frame id is ignored otherwise). When the pool that is allocated from runs out, it is retired to the
+             * full pools and the allocation is retried once with a new pool
+            */
+            VkDescriptorSet allocateDescriptorSet (uint32_t deviceInfoId,
+                                                   uint32_t pipelineInfoId,
+                                                   uint32_t descriptorSetLayoutId,
+                                                   uint32_t poolClassId,
+                                                   uint32_t frameId) {
+
+                auto pipelineInfo  = getPipelineInfo            (pipelineInfoId);
+                auto poolClassInfo = getDescriptorPoolClassInfo (poolClassId);
+                frameId            = poolClassInfo->meta.perFrame ? frameId: 0;
+                auto poolListInfo  = getDescriptorPoolListInfo  (poolClassId, frameId);
+
+                if (descriptorSetLayoutId >= pipelineInfo->resource.descriptorSetLayouts.size()) {
+                    LOG_ERROR (m_VKDescriptorAllocatorLog) << "Invalid descriptor set layout id "
+                                                           << "[" << descriptorSetLayoutId << "]"
+                                                           << "->"
+                                                           << "[" << pipelineInfo->resource.descriptorSetLayouts.size()
+                                                           << "]"
+                                                           << std::endl;
+                    throw std::runtime_error ("Invalid descriptor set layout id");
+                }
+                auto descriptorSetLayout = pipelineInfo->resource.descriptorSetLayouts[descriptorSetLayoutId];
+
+                VkDescriptorSet descriptorSet;
+                VkDescriptorPool descriptorPool = getReadyDescriptorPool (deviceInfoId, poolClassId, frameId);
+                VkResult result = allocateFromDescriptorPool (deviceInfoId,
+                                                              descriptorPool,
+                                                              descriptorSetLayout,
+                                                              &descriptorSet);
+                /* Inadequate descriptor pools are a good example of a problem that the validation layers will not catch.
+                 * As of Vulkan 1.1 (or with VK_KHR_maintenance1), vkAllocateDescriptorSets may fail with the error code
+                 * VK_ERROR_OUT_OF_POOL_MEMORY if the pool is not sufficiently large, but the driver may also try to solve
+                 * the problem internally. This means that sometimes (depending on hardware, pool size and allocation
+                 * size) the driver will let us get away with an allocation that exceeds the limits of our descriptor pool
+                 *
+                 * Since the instance targets Vulkan 1.0, a pool that has run out may instead report the error code
+                 * VK_ERROR_FRAGMENTED_POOL (room in total but not in one piece) or one of the out of memory errors. So,
+                 * any failure is treated as the pool being exhausted, and the pool is of no use to us until it is reset.
+                 * If the allocation from a new pool fails as well, then the failure is not down to the pool
+                */
+                if (result != VK_SUCCESS) {
+                    LOG_INFO (m_VKDescriptorAllocatorLog) << "Descriptor pool exhausted "
+                                                          << "[" << poolClassId << "]"
+                                                          << " "
+                                                          << "[" << frameId << "]"
+                                                          << " "
+                                                          << "[" << string_VkResult (result) << "]"
+                                                          << std::endl;
+                    poolListInfo->readyPools.pop_back();
+                    poolListInfo->fullPools.push_back (descriptorPool);
+                    poolClassInfo->stats.growsCount++;
+
+                    descriptorPool = getReadyDescriptorPool (deviceInfoId, poolClassId, frameId);
+                    result         = allocateFromDescriptorPool (deviceInfoId,
+                                                                 descriptorPool,
+                                                                 descriptorSetLayout,
+                                                                 &descriptorSet);
+                }
+                if (result != VK_SUCCESS) {
+                    LOG_ERROR (m_VKDescriptorAllocatorLog) << "Failed to allocate descriptor set "
+                                                           << "[" << poolClassId << "]"
+                                                           << " "
+                                                           << "[" << pipelineInfoId << "]"
+                                                           << " "
+                                                           << "[" << descriptorSetLayoutId << "]"
+                                                           << " "
+                                                           << "[" << string_VkResult (result) << "]"
+                                                           << std::endl;
+                    throw std::runtime_error ("Failed to allocate descriptor set");
+                }
+                poolClassInfo->stats.allocationsCount++;
+                return descriptorSet;
+            }
+
+            /* Return the set that has the same layout and binding contents as the writes, if one was allocated from the
+             * pool class (and has not been reset since). Otherwise, a new set is allocated and the writes are applied
+             * to it. Sets are looked up by the hash of their key, and the keys are compared on a hit, so that a hash
+             * collision never hands out a set with different contents. Note that, the destination set of the writes is
+             * filled in here
+            */
+            VkDescriptorSet getCachedDescriptorSet (uint32_t deviceInfoId,
+                                                    uint32_t pipelineInfoId,
+                                                    uint32_t descriptorSetLayoutId,
+                                                    uint32_t poolClassId,
+                                                    uint32_t frameId,
+                                                    std::vector <VkWriteDescriptorSet>& writeDescriptorSets) {
+
+                auto pipelineInfo  = getPipelineInfo            (pipelineInfoId);
+                auto poolClassInfo = getDescriptorPoolClassInfo (poolClassId);
+                frameId            = poolClassInfo->meta.perFrame ? frameId: 0;
+                auto poolListInfo  = getDescriptorPoolListInfo  (poolClassId, frameId);
+
+                VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+                if (descriptorSetLayoutId < pipelineInfo->resource.descriptorSetLayouts.size())
+                    descriptorSetLayout = pipelineInfo->resource.descriptorSetLayouts[descriptorSetLayoutId];
+
+                auto setKey   = getDescriptorSetKey (descriptorSetLayout, writeDescriptorSets);
+                uint64_t hash = getHash (setKey.data(), setKey.size());
+                auto it       = poolListInfo->cachedSets.find (hash);
+                if (it != poolListInfo->cachedSets.end()) {
+                    if (it->second.setKey == setKey) {
+                        poolClassInfo->stats.cacheHitsCount++;
+                        return it->second.descriptorSet;
+                    }
+                    /* A set with different contents but the same hash is allocated anew, and the cache keeps pointing
+                     * to the set that was cached first
+                    */
+                    poolClassInfo->stats.cacheCollisionsCount++;
+                    LOG_INFO (m_VKDescriptorAllocatorLog) << "Descriptor set hash collision "
+                                                          << "[" << poolClassId << "]"
+                                                          << " "
+                                                          << "[" << std::hex << hash << std::dec << "]"
+                                                          << std::endl;
+                }
+
+                VkDescriptorSet descriptorSet = allocateDescriptorSet (deviceInfoId,
+                                                                       pipelineInfoId,
+                                                                       descriptorSetLayoutId,
+                                                                       poolClassId,
+                                                                       frameId);
+                for (auto& writeDescriptorSet: writeDescriptorSets)
+                    writeDescriptorSet.dstSet = descriptorSet;
+                updateDescriptorSets (deviceInfoId, writeDescriptorSets);
+
+                if (it == poolListInfo->cachedSets.end())
+                    poolListInfo->cachedSets.insert ({hash, {std::move (setKey), descriptorSet}});
+                return descriptorSet;
+            }
+
+            /* Release every set allocated from the pools of the frame in flight (or from all the pools, if the pool class
+             * is not per frame) at once. Note that, the pools that were never allocated from are left alone
+            */
+            void resetDescriptorPoolClass (uint32_t deviceInfoId, uint32_t poolClassId, uint32_t frameId) {
+                auto deviceInfo    = getDeviceInfo              (deviceInfoId);
+                auto poolClassInfo = getDescriptorPoolClassInfo (poolClassId);
+                frameId            = poolClassInfo->meta.perFrame ? frameId: 0;
+                auto poolListInfo  = getDescriptorPoolListInfo  (poolClassId, frameId);
+
+                if (poolListInfo->readyPools.empty() && poolListInfo->fullPools.empty())
+                    return;
+
+                for (auto const& descriptorPool: poolListInfo->readyPools)
+                    vkResetDescriptorPool (deviceInfo->resource.logDevice, descriptorPool, 0);
+                for (auto const& descriptorPool: poolListInfo->fullPools) {
+                    vkResetDescriptorPool (deviceInfo->resource.logDevice, descriptorPool, 0);
+                    poolListInfo->readyPools.push_back (descriptorPool);
+                }
+                poolListInfo->fullPools.clear();
+                poolListInfo->cachedSets.clear();
+                poolClassInfo->stats.resetsCount++;
+            }
+
+            void dumpDescriptorAllocatorStats (void) {
+                LOG_INFO (m_VKDescriptorAllocatorLog) << "Dumping descriptor allocator stats"
+                                                      << std::endl;
+
+                for (auto const& [poolClassId, info]: m_descriptorPoolClassInfos) {
+                    LOG_INFO (m_VKDescriptorAllocatorLog) << "Pool class id "
+                                                          << "[" << poolClassId << "]"
+                                                          << " "
+                                                          << "[" << (info.meta.perFrame ? "PER FRAME": "SCENE") << "]"
+                                                          << std::endl;
+
+                    for (auto const& [descriptorType, ratio]: info.meta.poolSizeRatios) {
+                        LOG_INFO (m_VKDescriptorAllocatorLog) << "Pool size ratio "
+                                                              << "[" << string_VkDescriptorType (descriptorType) << "]"
+                                                              << " "
+                                                              << "[" << ratio << "]"
+                                                              << std::endl;
+                    }
+
+                    LOG_INFO (m_VKDescriptorAllocatorLog) << "Pools count "
+                                                          << "[" << info.stats.poolsCount << "]"
+                                                          << std::endl;
+
+                    LOG_INFO (m_VKDescriptorAllocatorLog) << "Grows count "
+                                                          << "[" << info.stats.growsCount << "]"
+                                                          << std::endl;
+
+                    LOG_INFO (m_VKDescriptorAllocatorLog) << "Allocations count "
+                                                          << "[" << info.stats.allocationsCount << "]"
+                                                          << std::endl;
+
+                    LOG_INFO (m_VKDescriptorAllocatorLog) << "Cache hits count "
+                                                          << "[" << info.stats.cacheHitsCount << "]"
+                                                          << std::endl;
+
+                    LOG_INFO (m_VKDescriptorAllocatorLog) << "Cache collisions count "
+                                                          << "[" << info.stats.cacheCollisionsCount << "]"
+                                                          << std::endl;
+
+                    LOG_INFO (m_VKDescriptorAllocatorLog) << "Resets count "
+                                                          << "[" << info.stats.resetsCount << "]"
+                                                          << std::endl;
+                }
+            }
+
+            void cleanUpDescriptorAllocator (uint32_t deviceInfoId) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                /* You don't need to explicitly clean up descriptor sets, because they will be automatically freed when
+                 * the descriptor pool is destroyed
+                */
+                for (auto const& [poolClassId, info]: m_descriptorPoolClassInfos) {
+                    for (auto const& poolListInfo: info.resource.poolLists) {
+                        for (auto const& descriptorPool: poolListInfo.readyPools)
+                            vkDestroyDescriptorPool (deviceInfo->resource.logDevice, descriptorPool, VK_NULL_HANDLE);
+                        for (auto const& descriptorPool: poolListInfo.fullPools)
+                            vkDestroyDescriptorPool (deviceInfo->resource.logDevice, descriptorPool, VK_NULL_HANDLE);
+                    }
+                }
+                m_descriptorPoolClassInfos.clear();
+            }
+    };
+}   // namespace Core
+#endif  // VK_DESCRIPTOR_ALLOCATOR_H
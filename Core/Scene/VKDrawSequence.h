@@ -4,9 +4,16 @@
 #include "../Device/VKWindow.h"
 #include "../Model/VKModelMgr.h"
 #include "../Buffer/VKStorageBuffer.h"
+#include "../Buffer/VKReadBackBuffer.h"
 #include "../Cmd/VKCmdBuffer.h"
 #include "../Cmd/VKCmd.h"
+#include "../Cmd/VKQueryPool.h"
+#include "../Image/VKTextureImage.h"
+#include "../Image/VKTextureStream.h"
+#include "../Pipeline/VKPipelineRegistry.h"
 #include "VKCameraMgr.h"
+#include "VKTextureTable.h"
+#include "VKFrameAllocator.h"
 #include "VKSyncObject.h"
 #include "VKResizing.h"
 
@@ -14,20 +21,87 @@ namespace Core {
     class VKDrawSequence: protected virtual VKWindow,
                           protected virtual VKModelMgr,
                           protected virtual VKStorageBuffer,
+                          protected virtual VKReadBackBuffer,
                           protected virtual VKCmdBuffer,
                           protected virtual VKCmd,
+                          protected virtual VKQueryPool,
+                          protected virtual VKTextureImage,
+                          protected virtual VKTextureStream,
+                          protected virtual VKPipelineRegistry,
                           protected virtual VKCameraMgr,
+                          protected virtual VKTextureTable,
+                          protected virtual VKFrameAllocator,
                           protected virtual VKSyncObject,
                           protected VKResizing {
         private:
             Log::Record* m_VKDrawSequenceLog;
             const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
+#if ENABLE_HEADLESS_MODE
+            /* In headless mode, there is no swap chain to tell us which image to render to next. Instead, we keep count
+             * of the frames submitted so far and cycle through the offscreen images. We also keep track of which frame
+             * was copied to each frame in flight's read back buffer (if any), so that it can be saved once the frame's
+             * fence has been signaled
+            */
+            uint32_t m_offScreenFrameId;
+            std::vector <uint32_t> m_readBackFrameIds;
+
+            void saveReadBackFrame (uint32_t deviceInfoId, 
+                                    uint32_t sceneInfoId, 
+                                    uint32_t frameInFlight) {
+
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto sceneInfo  = getSceneInfo  (sceneInfoId);
+                if (m_readBackFrameIds[frameInFlight] == UINT32_MAX)
+                    return;
+
+                std::stringstream filePath;
+                filePath << g_headlessSettings.readBackSaveDirPath 
+                         << "frame_" 
+                         << std::setw (6) << std::setfill ('0') << m_readBackFrameIds[frameInFlight]
+                         << ".ppm";
+
+                saveReadBackBuffer (sceneInfo->id.readBackBufferInfoBase + frameInFlight,
+                                    deviceInfo->params.swapChainExtent.width,
+                                    deviceInfo->params.swapChainExtent.height,
+                                    filePath.str());
+                m_readBackFrameIds[frameInFlight] = UINT32_MAX;
+            }
+#endif  // ENABLE_HEADLESS_MODE
+#if ENABLE_BENCHMARK_MODE
+            /* Timings of the most recent call to run sequence. Note that, the device time is that of the last frame that
+             * was submitted using the same frame in flight (it is only safe to read once its fence has been signaled), 
+             * and is negative if not available
+            */
+            struct FrameTimingInfo {
+                float fenceWaitTimeMs;
+                float gpuTimeMs;
+            } m_frameTimingInfo;
+            std::vector <bool> m_timestampsWritten;
+#endif  // ENABLE_BENCHMARK_MODE
+#if ENABLE_FRAME_ALLOCATION_CHECK
+            /* Number of calls to run sequence so far, the first few frames are allowed to allocate while the pools they 
+             * look up settle
+            */
+            uint32_t m_framesCount;
+#endif  // ENABLE_FRAME_ALLOCATION_CHECK
 
         public:
             VKDrawSequence (void) {
                 m_VKDrawSequenceLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+#if ENABLE_HEADLESS_MODE
+                m_offScreenFrameId = 0;
+                m_readBackFrameIds.assign (g_coreSettings.maxFramesInFlight, UINT32_MAX);
+#endif  // ENABLE_HEADLESS_MODE
+#if ENABLE_BENCHMARK_MODE
+                m_frameTimingInfo.fenceWaitTimeMs = 0.0f;
+                m_frameTimingInfo.gpuTimeMs       = -1.0f;
+                m_timestampsWritten.assign (g_coreSettings.maxFramesInFlight, false);
+#endif  // ENABLE_BENCHMARK_MODE
+#if ENABLE_FRAME_ALLOCATION_CHECK
+                m_framesCount = 0;
+#endif  // ENABLE_FRAME_ALLOCATION_CHECK
             }
 
             ~VKDrawSequence (void) {
@@ -42,7 +116,7 @@ namespace Core {
                               uint32_t pipelineInfoId,
                               uint32_t cameraInfoId,
                               uint32_t sceneInfoId, 
-                              uint32_t currentFrameInFlight,
+                              uint32_t& currentFrameInFlight,
                               T lambda) {
 
                 auto deviceInfo    = getDeviceInfo (deviceInfoId);
@@ -66,11 +140,96 @@ namespace Core {
                  * overwrite the current contents of the command buffer while the GPU is using it
                 */
                 uint32_t inFlightFenceInfoId = sceneInfo->id.inFlightFenceInfoBase + currentFrameInFlight;
+#if ENABLE_BENCHMARK_MODE
+                auto fenceWaitStartTime = std::chrono::high_resolution_clock::now();
+#endif  // ENABLE_BENCHMARK_MODE
                 vkWaitForFences (deviceInfo->resource.logDevice, 
                                  1, 
                                  &getFenceInfo (inFlightFenceInfoId, FEN_IN_FLIGHT)->resource.fence, 
                                  VK_TRUE, 
                                  UINT64_MAX);
+#if ENABLE_BENCHMARK_MODE
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG DRAW OPS - FRAME TIMING                                                                 |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                auto fenceWaitEndTime = std::chrono::high_resolution_clock::now();
+                m_frameTimingInfo.fenceWaitTimeMs = std::chrono::duration <float, std::chrono::milliseconds::period> 
+                                                    (fenceWaitEndTime - fenceWaitStartTime).count();
+                m_frameTimingInfo.gpuTimeMs       = -1.0f;
+                if (m_timestampsWritten[currentFrameInFlight])
+                    m_frameTimingInfo.gpuTimeMs   = getTimestampDiffMs (deviceInfoId, 
+                                                                        sceneInfo->resource.queryPool, 
+                                                                        currentFrameInFlight * 2);
+#endif  // ENABLE_BENCHMARK_MODE
+#if ENABLE_HEADLESS_MODE
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG DRAW OPS - READ BACK                                                                    |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* The fence guarantees that the copy recorded the last time this frame in flight was used is complete, 
+                 * so the read back buffer can be saved without stalling on the frame that is currently being rendered
+                */
+                saveReadBackFrame (deviceInfoId, sceneInfoId, currentFrameInFlight);
+#endif  // ENABLE_HEADLESS_MODE
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG DRAW OPS - RESET FRAME ARENA                                                            |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* The fence guarantees that nothing from the previous use of this frame in flight is still referring to
+                 * its arena. Note that, the allocation check starts after the read back (if any) since saving to disk 
+                 * is allowed to allocate
+                */
+                resetFrameArena (currentFrameInFlight);
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG DRAW OPS - TEXTURE TABLE                                                                |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* The fence also guarantees that this frame in flight is no longer reading from the texture table, so 
+                 * the slots that were retired while it was pending can be handed out again
+                */
+                updateTextureTable (currentFrameInFlight);
+#if ENABLE_PROGRESSIVE_STARTUP
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG DRAW OPS - TEXTURE LOADS                                                                |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* Add the textures that have landed since the last frame to the texture table, and move the next batch 
+                 * along. This may allocate, hence it is done before the allocation check starts
+                */
+                updateTextureLoads (deviceInfoId);
+#endif  // ENABLE_PROGRESSIVE_STARTUP
+#if ENABLE_TEXTURE_STREAMING
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG DRAW OPS - TEXTURE STREAM                                                               |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* Swap in the textures that have finished streaming, and schedule the next batch based on where the 
+                 * camera is. This may allocate, hence it is done before the allocation check starts
+                */
+                updateTextureStream (deviceInfoId, modelInfoIds, cameraInfoId);
+#endif  // ENABLE_TEXTURE_STREAMING
+#if ENABLE_ASYNC_PIPELINE_COMPILATION
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG DRAW OPS - PIPELINE REQUESTS                                                            |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* Pick up the pipelines that have finished compiling, and move the next batch along. This may allocate,
+                 * hence it is done before the allocation check starts
+                */
+                updatePipelineRequests (deviceInfoId);
+#endif  // ENABLE_ASYNC_PIPELINE_COMPILATION
+#if ENABLE_FRAME_ALLOCATION_CHECK
+                size_t heapAllocationsCount = g_heapAllocationsCount;
+#endif  // ENABLE_FRAME_ALLOCATION_CHECK
+#if ENABLE_HEADLESS_MODE
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG DRAW OPS - PICK OFF SCREEN IMAGE                                                        |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                uint32_t swapChainImageId = m_offScreenFrameId % deviceInfo->meta.swapChainSize;
+                VkResult result;
+#else
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG DRAW OPS - ACQUIRE SWAP CHAIN IMAGE                                                     |
                  * |------------------------------------------------------------------------------------------------|
@@ -126,6 +285,7 @@ namespace Core {
                                                     << std::endl; 
                     throw std::runtime_error ("Failed to acquire swap chain image");
                 }
+#endif  // ENABLE_HEADLESS_MODE
                 /* After waiting for fence, we need to manually reset the fence to the unsignaled state immediately after.
                  * But we delay it to upto this point to avoid deadlock on the in flight fence
                  *
@@ -155,16 +315,27 @@ namespace Core {
                  * | CONFIG DRAW OPS - UPDATE UNIFORMS                                                              |
                  * |------------------------------------------------------------------------------------------------|
                 */
-                std::vector <InstanceDataSSBO> combinedInstances;
+                auto combinedInstances = allocateFromFrameArena <InstanceDataSSBO> (sceneInfo->meta.totalInstancesCount);
                 size_t combinedInstancesCount = 0;
 
                 for (auto const& infoId: modelInfoIds) {
-                    auto modelInfo          = getModelInfo (infoId);
+                    auto modelInfo = getModelInfo (infoId);
+                    std::copy (modelInfo->meta.instances.begin(), 
+                               modelInfo->meta.instances.end(),
+                               combinedInstances.begin() + combinedInstancesCount);
                     combinedInstancesCount += modelInfo->meta.instancesCount;
-
-                    combinedInstances.reserve (combinedInstancesCount);
-                    combinedInstances.insert  (combinedInstances.end(), modelInfo->meta.instances.begin(),
-                                                                        modelInfo->meta.instances.end());
+                }
+                /* The instances refer to textures by their ids, which are translated to the texture table slots here 
+                 * since a texture may move to a different slot when it is swapped out
+                */
+                for (size_t i = 0; i < combinedInstancesCount; i++) {
+                    auto& texIdLUT = combinedInstances[i].texIdLUT;
+                    for (int rowIdx = 0; rowIdx < 4; rowIdx++) {
+                        for (int colIdx = 0; colIdx < 4; colIdx++)
+                            texIdLUT[rowIdx][colIdx] = static_cast <float> 
+                                                       (getTextureTableSlot (static_cast <uint32_t> 
+                                                       (texIdLUT[rowIdx][colIdx])));
+                    }
                 }
                 updateStorageBuffer (sceneInfo->id.storageBufferInfoBase + currentFrameInFlight,
                                      sceneInfo->meta.totalInstancesCount * sizeof (InstanceDataSSBO),
@@ -181,6 +352,21 @@ namespace Core {
                 */
                 vkResetCommandBuffer (sceneInfo->resource.commandBuffers[currentFrameInFlight], 0);
                 beginRecording       (sceneInfo->resource.commandBuffers[currentFrameInFlight], 0, VK_NULL_HANDLE);
+#if ENABLE_BENCHMARK_MODE
+                resetQueryPool       (sceneInfo->resource.queryPool, 
+                                      currentFrameInFlight * 2, 2,
+                                      sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+                writeTimestamp       (sceneInfo->resource.queryPool, 
+                                      currentFrameInFlight * 2,
+                                      VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                      sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+#endif  // ENABLE_BENCHMARK_MODE
+#if ENABLE_PROGRESSIVE_STARTUP
+                recordTextureLoadTransitions   (sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+#endif  // ENABLE_PROGRESSIVE_STARTUP
+#if ENABLE_TEXTURE_STREAMING
+                recordTextureStreamTransitions (sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+#endif  // ENABLE_TEXTURE_STREAMING
                 /* Define the clear values to use for VK_ATTACHMENT_LOAD_OP_CLEAR. Note that, the order of clear values 
                  * should be identical to the order of your attachments
                  * 
@@ -188,7 +374,7 @@ namespace Core {
                  * and 0.0 at the near view plane. The initial value at each point in the depth buffer should be the 
                  * furthest possible depth, which is 1.0
                 */
-                auto clearValues = std::vector {
+                auto clearValues = std::array {
                     /* Attachment 0
                     */
                     VkClearValue {
@@ -210,7 +396,12 @@ namespace Core {
                                       clearValues,
                                       sceneInfo->resource.commandBuffers[currentFrameInFlight]);
 
-                bindPipeline         (pipelineInfoId,
+                /* If the pipeline is still being compiled (and there is no fallback for it), the models are not drawn
+                 * this frame
+                */
+                uint32_t bindPipelineInfoId = getBindablePipelineInfoId (pipelineInfoId);
+                if (bindPipelineInfoId != UINT32_MAX)
+                    bindPipeline     (bindPipelineInfoId,
                                       VK_PIPELINE_BIND_POINT_GRAPHICS,
                                       sceneInfo->resource.commandBuffers[currentFrameInFlight]);
 
@@ -219,20 +410,20 @@ namespace Core {
                                       0, sizeof (SceneDataVertPC), &sceneDataVert,
                                       sceneInfo->resource.commandBuffers[currentFrameInFlight]);
 
-                auto secondaryViewPorts = std::vector <VkViewport> {};
+                auto secondaryViewPorts = std::array <VkViewport, 0> {};
                 setViewPorts         (deviceInfoId,
                                       0,
                                       secondaryViewPorts,
                                       sceneInfo->resource.commandBuffers[currentFrameInFlight]);
 
-                auto secondaryScissors = std::vector <VkRect2D> {};
+                auto secondaryScissors = std::array <VkRect2D, 0> {};
                 setScissors          (deviceInfoId,
                                       0,
                                       secondaryScissors,
                                       sceneInfo->resource.commandBuffers[currentFrameInFlight]);
 
-                auto vertexBufferInfoIdsToBind = modelInfoBase->id.vertexBufferInfos;
-                auto vertexBufferOffsets       = std::vector <VkDeviceSize> {
+                auto& vertexBufferInfoIdsToBind = modelInfoBase->id.vertexBufferInfos;
+                auto vertexBufferOffsets        = std::array <VkDeviceSize, 1> {
                     0
                 };
                 bindVertexBuffers    (vertexBufferInfoIdsToBind,
@@ -245,10 +436,11 @@ namespace Core {
                                       VK_INDEX_TYPE_UINT32,
                                       sceneInfo->resource.commandBuffers[currentFrameInFlight]);
 
-                auto descriptorSetsToBind = std::vector {
-                    sceneInfo->resource.descriptorSets[currentFrameInFlight]
+                auto descriptorSetsToBind = std::array {
+                    sceneInfo->resource.descriptorSets[currentFrameInFlight],
+                    getTextureTableDescriptorSet()
                 };
-                auto dynamicOffsets       = std::vector <uint32_t> {
+                auto dynamicOffsets       = std::array <uint32_t, 0> {
                 };     
                 bindDescriptorSets   (pipelineInfoId,
                                       VK_PIPELINE_BIND_POINT_GRAPHICS,
@@ -274,22 +466,44 @@ namespace Core {
                 int32_t  vertexOffset  = 0;
                 uint32_t firstInstance = 0;
 
-                for (auto const& infoId: modelInfoIds) {
-                    auto modelInfo = getModelInfo (infoId);
+                if (bindPipelineInfoId != UINT32_MAX) {
+                    for (auto const& infoId: modelInfoIds) {
+                        auto modelInfo = getModelInfo (infoId);
  
-                    drawIndexed (modelInfo->meta.indicesCount,
-                                 modelInfo->meta.instancesCount, 
-                                 firstIndex, vertexOffset, firstInstance,
-                                 sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+                        drawIndexed (modelInfo->meta.indicesCount,
+                                     modelInfo->meta.instancesCount, 
+                                     firstIndex, vertexOffset, firstInstance,
+                                     sceneInfo->resource.commandBuffers[currentFrameInFlight]);
 
-                    firstIndex    += modelInfo->meta.indicesCount;
-                    vertexOffset  += modelInfo->meta.verticesCount;
-                    firstInstance += modelInfo->meta.instancesCount;
+                        firstIndex    += modelInfo->meta.indicesCount;
+                        vertexOffset  += modelInfo->meta.verticesCount;
+                        firstInstance += modelInfo->meta.instancesCount;
+                    }
                 }
 
                 lambda();
 
                 endRenderPass (sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+#if ENABLE_HEADLESS_MODE
+                if (g_headlessSettings.enableReadBack && 
+                    m_offScreenFrameId % g_headlessSettings.readBackInterval == 0) {
+
+                    copyImageToBuffer (sceneInfo->id.swapChainImageInfoBase + swapChainImageId,
+                                       sceneInfo->id.readBackBufferInfoBase + currentFrameInFlight,
+                                       OFFSCREEN_IMAGE,
+                                       READBACK_BUFFER,
+                                       VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                       sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+                    m_readBackFrameIds[currentFrameInFlight] = m_offScreenFrameId;
+                }
+#endif  // ENABLE_HEADLESS_MODE
+#if ENABLE_BENCHMARK_MODE
+                writeTimestamp (sceneInfo->resource.queryPool, 
+                                currentFrameInFlight * 2 + 1,
+                                VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+                m_timestampsWritten[currentFrameInFlight] = true;
+#endif  // ENABLE_BENCHMARK_MODE
                 endRecording  (sceneInfo->resource.commandBuffers[currentFrameInFlight]);  
 
                 VkSubmitInfo drawOpsSubmitInfo;
@@ -304,10 +518,18 @@ namespace Core {
                  * Each entry in the wait stages array corresponds to the semaphore with the same index in the wait
                  * semaphores array
                 */
-                auto waitSemaphores = std::vector {
+#if ENABLE_HEADLESS_MODE
+                /* There is no image to wait on to become available, or presentation to signal, in headless mode. The 
+                 * in flight fence alone is enough to pace the frames
+                */
+                auto waitSemaphores = std::array <VkSemaphore, 0> {
+                };
+#else
+                auto waitSemaphores = std::array {
                     getSemaphoreInfo (imageAvailableSemaphoreInfoId, SEM_IMAGE_AVAILABLE)->resource.semaphore 
                 };
-                auto waitStages     = std::vector <VkPipelineStageFlags> {
+#endif  // ENABLE_HEADLESS_MODE
+                auto waitStages     = std::array <VkPipelineStageFlags, 1> {
                     VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
                 };
                 drawOpsSubmitInfo.waitSemaphoreCount = static_cast <uint32_t> (waitSemaphores.size());
@@ -319,9 +541,15 @@ namespace Core {
                  * command buffer(s) have finished execution
                 */
                 uint32_t renderDoneSemaphoreInfoId = sceneInfo->id.renderDoneSemaphoreInfoBase + currentFrameInFlight;
-                auto signalSemaphores = std::vector {
+#if ENABLE_HEADLESS_MODE
+                static_cast <void> (renderDoneSemaphoreInfoId);
+                auto signalSemaphores = std::array <VkSemaphore, 0> {
+                };
+#else
+                auto signalSemaphores = std::array {
                     getSemaphoreInfo (renderDoneSemaphoreInfoId, SEM_RENDER_DONE)->resource.semaphore 
                 };
+#endif  // ENABLE_HEADLESS_MODE
                 drawOpsSubmitInfo.signalSemaphoreCount = static_cast <uint32_t> (signalSemaphores.size());
                 drawOpsSubmitInfo.pSignalSemaphores    = signalSemaphores.data();
                 /* The last parameter references an optional fence that will be signaled when the command buffers finish 
@@ -341,6 +569,9 @@ namespace Core {
                                                     << std::endl; 
                     throw std::runtime_error ("Failed to submit draw ops command buffer");                    
                 } 
+#if ENABLE_HEADLESS_MODE
+                m_offScreenFrameId++;
+#else
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG DRAW OPS - PRESENT                                                                      |
                  * |------------------------------------------------------------------------------------------------|
@@ -360,7 +591,7 @@ namespace Core {
                 /* The next two parameters specify the swap chains to present images to and the index of the image for 
                  * each swap chain
                 */
-                auto swapChains = std::vector {
+                auto swapChains = std::array {
                     deviceInfo->resource.swapChain
                 };
                 presentInfo.swapchainCount = static_cast <uint32_t> (swapChains.size());
@@ -408,6 +639,11 @@ namespace Core {
                                            sceneInfoId);
                     
                     cameraInfo->meta.updateProjectionMatrix = true;
+#if ENABLE_FRAME_ALLOCATION_CHECK
+                    /* Recreating the swap chain and its dependents is not part of the steady state frame loop
+                    */
+                    heapAllocationsCount = g_heapAllocationsCount;
+#endif  // ENABLE_FRAME_ALLOCATION_CHECK
                 }
                 else if (result != VK_SUCCESS) {
                     LOG_ERROR (m_VKDrawSequenceLog) << "Failed to present swap chain image "
@@ -417,12 +653,42 @@ namespace Core {
                                                     << std::endl;
                     throw std::runtime_error ("Failed to present swap chain image");
                 } 
+#endif  // ENABLE_HEADLESS_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG DRAW OPS - UPDATE CURRENT FRAME IN FLIGHT COUNT                                         |
                  * |------------------------------------------------------------------------------------------------|
                 */
                 currentFrameInFlight = (currentFrameInFlight + 1) % g_coreSettings.maxFramesInFlight;
+#if ENABLE_FRAME_ALLOCATION_CHECK
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG DRAW OPS - ALLOCATION CHECK                                                             |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                size_t frameHeapAllocationsCount = g_heapAllocationsCount - heapAllocationsCount;
+                if (m_framesCount++ >= g_coreSettings.maxFramesInFlight && frameHeapAllocationsCount != 0) {
+                    LOG_ERROR (m_VKDrawSequenceLog) << "Heap allocations in frame loop "
+                                                    << "[" << m_framesCount << "]"
+                                                    << " "
+                                                    << "[" << frameHeapAllocationsCount << "]"
+                                                    << std::endl;
+                    throw std::runtime_error ("Heap allocations in frame loop");
+                }
+#endif  // ENABLE_FRAME_ALLOCATION_CHECK
+            }
+#if ENABLE_BENCHMARK_MODE
+            FrameTimingInfo* getFrameTimingInfo (void) {
+                return &m_frameTimingInfo;
+            }
+#endif  // ENABLE_BENCHMARK_MODE
+#if ENABLE_HEADLESS_MODE
+            /* Save the frames that are still pending in the read back buffers, note that this is expected to be called
+             * only after the device is idle (after exiting the event loop)
+            */
+            void flushReadBackFrames (uint32_t deviceInfoId, uint32_t sceneInfoId) {
+                for (uint32_t i = 0; i < g_coreSettings.maxFramesInFlight; i++)
+                    saveReadBackFrame (deviceInfoId, sceneInfoId, i);
             }
+#endif  // ENABLE_HEADLESS_MODE
     };
 }   // namespace Core
 #endif  // VK_DRAW_SEQUENCE_H
\ No newline at end of file
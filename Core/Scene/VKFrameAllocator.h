@@ -0,0 +1,138 @@
+#ifndef VK_FRAME_ALLOCATOR_H
+#define VK_FRAME_ALLOCATOR_H
+
+#include <span>
+#include <memory>
+#include <cstdlib>
+#include <new>
+#include "../VKConfig.h"
+#include "../../Collections/Log/Log.h"
+
+using namespace Collections;
+
+#if ENABLE_FRAME_ALLOCATION_CHECK
+namespace Core {
+    /* Running count of heap allocations made through the global operator new by the calling thread, used to verify
+     * that the steady state frame loop does not touch the heap. The count is kept per thread so that the allocations
+     * made by the worker threads (texture loads, pipeline compiles, log writes etc.) during a frame are not blamed on
+     * the render thread
+    */
+    thread_local size_t g_heapAllocationsCount = 0;
+}   // namespace Core
+
+/* Note that, the replacement allocation functions are defined here (instead of in a translation unit) since the
+ * application is built from a single translation unit. The array and nothrow forms call these by default
+*/
+void* operator new (size_t size) {
+    Core::g_heapAllocationsCount++;
+    if (void* ptr = std::malloc (size == 0 ? 1: size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete (void* ptr) noexcept {
+    std::free (ptr);
+}
+
+void operator delete (void* ptr, size_t size) noexcept {
+    static_cast <void> (size);
+    std::free (ptr);
+}
+#endif  // ENABLE_FRAME_ALLOCATION_CHECK
+
+namespace Core {
+    /* A bump (linear) allocator with one arena per frame in flight. Allocations are made by simply moving an offset
+     * forward, and all allocations of a frame are released at once by resetting the offset when the frame in flight is
+     * reused (i.e. after its fence has been signaled). This lets the draw loop build its short lived arrays without
+     * any heap traffic. Note that, destructors are never run on memory handed out by the arena, so only trivially
+     * destructible types are allowed
+    */
+    class VKFrameAllocator {
+        private:
+            struct FrameArenaInfo {
+                std::vector <uint8_t> memory;
+                size_t offset;
+                size_t peakOffset;
+            };
+            std::vector <FrameArenaInfo> m_frameArenaInfos;
+            uint32_t m_activeFrameArenaId;
+
+            Log::Record* m_VKFrameAllocatorLog;
+            const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
+
+        public:
+            VKFrameAllocator (void) {
+                m_VKFrameAllocatorLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+
+                m_frameArenaInfos.resize (g_coreSettings.maxFramesInFlight);
+                for (auto& info: m_frameArenaInfos) {
+                    info.memory.resize (g_coreSettings.frameArenaSize);
+                    info.offset     = 0;
+                    info.peakOffset = 0;
+                }
+                m_activeFrameArenaId = 0;
+            }
+
+            ~VKFrameAllocator (void) {
+                LOG_CLOSE (m_instanceId);
+            }
+
+        protected:
+            /* Make the arena belonging to the frame in flight active and release all of its previous allocations
+            */
+            void resetFrameArena (uint32_t frameInFlight) {
+                m_activeFrameArenaId                           = frameInFlight;
+                m_frameArenaInfos[m_activeFrameArenaId].offset = 0;
+            }
+
+            template <typename T>
+            std::span <T> allocateFromFrameArena (size_t count) {
+                static_assert (std::is_trivially_destructible_v <T>, "Frame arena types must be trivially destructible");
+
+                auto& info           = m_frameArenaInfos[m_activeFrameArenaId];
+                uintptr_t base       = reinterpret_cast <uintptr_t> (info.memory.data());
+                uintptr_t address    = (base + info.offset + alignof (T) - 1) & ~(alignof (T) - 1);
+                size_t alignedOffset = static_cast <size_t> (address - base);
+                size_t size          = count * sizeof (T);
+
+                if (alignedOffset + size > info.memory.size()) {
+                    LOG_ERROR (m_VKFrameAllocatorLog) << "Failed to allocate from frame arena "
+                                                      << "[" << m_activeFrameArenaId << "]"
+                                                      << " "
+                                                      << "[" << size << "]"
+                                                      << "->"
+                                                      << "[" << info.memory.size() - info.offset << "]"
+                                                      << std::endl;
+                    throw std::runtime_error ("Failed to allocate from frame arena");
+                }
+                info.offset     = alignedOffset + size;
+                info.peakOffset = std::max (info.peakOffset, info.offset);
+
+                T* data = reinterpret_cast <T*> (address);
+                std::uninitialized_value_construct_n (data, count);
+                return std::span <T> (data, count);
+            }
+
+            void dumpFrameArenas (void) {
+                LOG_INFO (m_VKFrameAllocatorLog) << "Dumping frame arenas"
+                                                 << std::endl;
+
+                for (uint32_t i = 0; i < m_frameArenaInfos.size(); i++) {
+                    LOG_INFO (m_VKFrameAllocatorLog) << "Frame arena id "
+                                                     << "[" << i << "]"
+                                                     << std::endl;
+
+                    LOG_INFO (m_VKFrameAllocatorLog) << "Capacity "
+                                                     << "[" << m_frameArenaInfos[i].memory.size() << "]"
+                                                     << std::endl;
+
+                    LOG_INFO (m_VKFrameAllocatorLog) << "Peak usage "
+                                                     << "[" << m_frameArenaInfos[i].peakOffset << "]"
+                                                     << std::endl;
+                }
+            }
+    };
+}   // namespace Core
+#endif  // VK_FRAME_ALLOCATOR_H
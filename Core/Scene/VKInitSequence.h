@@ -7,12 +7,16 @@
 #include "../Device/VKLogDevice.h"
 #include "../Model/VKInstanceData.h"
 #include "../Image/VKSwapChainImage.h"
+#include "../Image/VKOffScreenImage.h"
 #include "../Image/VKTextureImage.h"
+#include "../Image/VKTextureStream.h"
 #include "../Image/VKDepthImage.h"
 #include "../Image/VKMultiSampleImage.h"
 #include "../Buffer/VKVertexBuffer.h"
 #include "../Buffer/VKIndexBuffer.h"
 #include "../Buffer/VKStorageBuffer.h"
+#include "../Buffer/VKReadBackBuffer.h"
+#include "../Buffer/VKStagingBuffer.h"
 #include "../RenderPass/VKAttachment.h"
 #include "../RenderPass/VKSubPass.h"
 #include "../RenderPass/VKFrameBuffer.h"
@@ -28,11 +32,15 @@
 #include "../Pipeline/VKDescriptorSetLayout.h"
 #include "../Pipeline/VKPushConstantRange.h"
 #include "../Pipeline/VKPipelineLayout.h"
+#include "../Pipeline/VKPipelineRegistry.h"
 #include "../Cmd/VKCmdBuffer.h"
 #include "../Cmd/VKCmd.h"
+#include "../Cmd/VKQueryPool.h"
 #include "VKCameraMgr.h"
 #include "VKTextureSampler.h"
 #include "VKDescriptor.h"
+#include "VKDescriptorAllocator.h"
+#include "VKTextureTable.h"
 #include "VKSyncObject.h"
 
 namespace Core {
@@ -42,12 +50,16 @@ namespace Core {
                           protected virtual VKLogDevice,
                           protected VKInstanceData,
                           protected virtual VKSwapChainImage,
-                          protected VKTextureImage,
+                          protected virtual VKOffScreenImage,
+                          protected virtual VKTextureImage,
+                          protected virtual VKTextureStream,
                           protected virtual VKDepthImage,
                           protected virtual VKMultiSampleImage,
                           protected VKVertexBuffer,
                           protected VKIndexBuffer,
                           protected virtual VKStorageBuffer,
+                          protected virtual VKReadBackBuffer,
+                          protected virtual VKStagingBuffer,
                           protected VKAttachment,
                           protected VKSubPass,
                           protected virtual VKFrameBuffer,
@@ -63,11 +75,15 @@ namespace Core {
                           protected VKDescriptorSetLayout,
                           protected VKPushConstantRange,
                           protected VKPipelineLayout,
+                          protected virtual VKPipelineRegistry,
                           protected virtual VKCmdBuffer,
                           protected virtual VKCmd,
+                          protected virtual VKQueryPool,
                           protected virtual VKCameraMgr,
                           protected virtual VKTextureSampler,
                           protected virtual VKDescriptor,
+                          protected virtual VKDescriptorAllocator,
+                          protected virtual VKTextureTable,
                           protected virtual VKSyncObject {
         private:
             Log::Record* m_VKInitSequenceLog;
@@ -76,8 +92,8 @@ namespace Core {
         public:
             VKInitSequence (void) {
                 m_VKInitSequenceLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_IMMEDIATE);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE); 
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE); 
             }
 
             ~VKInitSequence (void) {
@@ -105,6 +121,7 @@ namespace Core {
                 disableValidationLayers();
                 LOG_CLEAR_ALL_CONFIGS;
 #endif  // ENABLE_LOGGING
+#if !ENABLE_HEADLESS_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG WINDOW                                                                                  |
                  * |------------------------------------------------------------------------------------------------|
@@ -113,6 +130,7 @@ namespace Core {
                 LOG_INFO (m_VKInitSequenceLog) << "[OK] Window " 
                                                << "[" << deviceInfoId << "]"
                                                << std::endl;
+#endif  // ENABLE_HEADLESS_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG INSTANCE                                                                                |
                  * |------------------------------------------------------------------------------------------------|
@@ -129,6 +147,7 @@ namespace Core {
                 LOG_INFO (m_VKInitSequenceLog) << "[OK] Debug messenger "
                                                << "[" << deviceInfoId << "]" 
                                                << std::endl; 
+#if !ENABLE_HEADLESS_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG SURFACE                                                                                 |
                  * |------------------------------------------------------------------------------------------------|
@@ -137,6 +156,7 @@ namespace Core {
                 LOG_INFO (m_VKInitSequenceLog) << "[OK] Surface " 
                                                << "[" << deviceInfoId << "]"
                                                << std::endl;
+#endif  // ENABLE_HEADLESS_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG PHY DEVICE                                                                              |
                  * |------------------------------------------------------------------------------------------------|
@@ -170,6 +190,21 @@ namespace Core {
                                                    << "[" << infoId << "]"
                                                    << std::endl;
                 }
+#if ENABLE_HEADLESS_MODE
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG OFF SCREEN RESOURCES                                                                    |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* Note that, the offscreen images take the place of the swap chain images and hence share the same base
+                 * info id
+                */
+                createOffScreenResources (deviceInfoId, sceneInfo->id.swapChainImageInfoBase);
+                LOG_INFO (m_VKInitSequenceLog) << "[OK] Off screen resources " 
+                                               << "[" << sceneInfo->id.swapChainImageInfoBase << "]"
+                                               << " "
+                                               << "[" << deviceInfoId << "]"
+                                               << std::endl;
+#else
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG SWAP CHAIN RESOURCES                                                                    |
                  * |------------------------------------------------------------------------------------------------|
@@ -180,19 +215,53 @@ namespace Core {
                                                << " "
                                                << "[" << deviceInfoId << "]"
                                                << std::endl;   
+#endif  // ENABLE_HEADLESS_MODE
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG STAGING BUFFER                                                                          |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* All uploads made below are packed in to a single staging buffer, and their copy commands are recorded
+                 * in to a single command buffer that is submitted to the transfer queue once all uploads are staged
+                */
+                uint32_t stagingBufferInfoId    = getNextInfoIdFromBufferType (STAGING_BUFFER);
+                uint32_t transferOpsFenceInfoId = 0;
+                readyStagingBuffer (deviceInfoId, stagingBufferInfoId, transferOpsFenceInfoId);
+                LOG_INFO (m_VKInitSequenceLog) << "[OK] Staging buffer "
+                                               << "[" << stagingBufferInfoId << "]"
+                                               << " "
+                                               << "[" << transferOpsFenceInfoId << "]"
+                                               << std::endl;
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG TEXTURE RESOURCES - DIFFUSE TEXTURE                                                     |
                  * |------------------------------------------------------------------------------------------------|
                 */
                 /* Create texture resources from the texture image pool, this is to ensure that duplicate texture images 
-                 * across models are not loaded again
+                 * across models are not loaded again. The texture images are decoded in parallel on worker threads
                 */
+                createTextureResources (deviceInfoId, getTextureImagePool());
+                dumpTextureImageStats();
                 for (auto const& [path, infoId]: getTextureImagePool()) {
-                    createTextureResources (deviceInfoId, infoId, path.c_str());
                     LOG_INFO (m_VKInitSequenceLog) << "[OK] Texture resources " 
                                                    << "[" << infoId << "]"
                                                    << std::endl; 
                 }
+#if ENABLE_TEXTURE_STREAMING
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG TEXTURE STREAM                                                                          |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* The larger mip levels of the textures loaded from containers are streamed in later, through a staging
+                 * buffer and transfer fence of their own
+                */
+                uint32_t textureStreamBufferInfoId = getNextInfoIdFromBufferType (STAGING_BUFFER);
+                uint32_t textureStreamFenceInfoId  = transferOpsFenceInfoId + 1;
+                readyTextureStream (deviceInfoId, modelInfoIds, textureStreamBufferInfoId, textureStreamFenceInfoId);
+                LOG_INFO (m_VKInitSequenceLog) << "[OK] Texture stream "
+                                               << "[" << textureStreamBufferInfoId << "]"
+                                               << " "
+                                               << "[" << textureStreamFenceInfoId << "]"
+                                               << std::endl;
+#endif  // ENABLE_TEXTURE_STREAMING
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG DEPTH RESOURCES                                                                         |
                  * |------------------------------------------------------------------------------------------------|
@@ -213,29 +282,37 @@ namespace Core {
                  * | CONFIG VERTEX BUFFERS                                                                          |
                  * |------------------------------------------------------------------------------------------------|
                 */
-                std::vector <Vertex> combinedVertices;
-                size_t combinedVerticesCount = 0;
-                uint32_t vertexBufferInfoId  = getNextInfoIdFromBufferType (STAGING_BUFFER);
+                VkDeviceSize combinedVerticesSize = 0;
+                uint32_t vertexBufferInfoId       = getNextInfoIdFromBufferType (VERTEX_BUFFER);
                 /* Combine all vertex buffers to a single buffer. Note that, only the first model will have access to 
                  * the vertex buffer info id, and the remaining models will have it set to UINT32_MAX to indicate that 
                  * their vertex buffers are owned by another model
                 */
                 for (auto const& infoId: modelInfoIds) {
-                    auto modelInfo         = getModelInfo (infoId);
-                    combinedVerticesCount += modelInfo->meta.verticesCount;
-
-                    combinedVertices.reserve (combinedVerticesCount);
-                    combinedVertices.insert  (combinedVertices.end(), modelInfo->meta.vertices.begin(),
-                                                                      modelInfo->meta.vertices.end());
+                    auto modelInfo        = getModelInfo (infoId);
+                    combinedVerticesSize += modelInfo->meta.verticesCount * sizeof (Vertex);
    
                     infoId == *modelInfoIds.begin() ? modelInfo->id.vertexBufferInfos.push_back (vertexBufferInfoId):
                                                       modelInfo->id.vertexBufferInfos.push_back (UINT32_MAX);
                 }
                 
-                createVertexBuffer (deviceInfoId, 
-                                    vertexBufferInfoId,
-                                    combinedVerticesCount * sizeof (Vertex),
-                                    combinedVertices.data());
+                createVertexBuffer (deviceInfoId, vertexBufferInfoId, combinedVerticesSize);
+                /* Instead of combining the vertices of all models in to an intermediate array first, the vertices of each
+                 * model are staged directly at their offset in the combined vertex buffer
+                */
+                VkDeviceSize verticesOffset = 0;
+                for (auto const& infoId: modelInfoIds) {
+                    auto modelInfo    = getModelInfo (infoId);
+                    VkDeviceSize size = modelInfo->meta.verticesCount * sizeof (Vertex);
+
+                    stageBufferUpload (deviceInfoId,
+                                       vertexBufferInfoId,
+                                       VERTEX_BUFFER,
+                                       verticesOffset,
+                                       modelInfo->meta.vertices.data(),
+                                       size);
+                    verticesOffset += size;
+                }
 
                 LOG_INFO (m_VKInitSequenceLog) << "[OK] Vertex buffer " 
                                                << "[" << vertexBufferInfoId << "]"
@@ -244,26 +321,32 @@ namespace Core {
                  * | CONFIG INDEX BUFFER                                                                            |
                  * |------------------------------------------------------------------------------------------------|
                 */
-                std::vector <uint32_t> combinedIndices;
-                size_t combinedIndicesCount = 0;
-                uint32_t indexBufferInfoId  = getNextInfoIdFromBufferType (STAGING_BUFFER);
+                VkDeviceSize combinedIndicesSize = 0;
+                uint32_t indexBufferInfoId       = getNextInfoIdFromBufferType (INDEX_BUFFER);
 
                 for (auto const& infoId: modelInfoIds) {
-                    auto modelInfo        = getModelInfo (infoId);
-                    combinedIndicesCount += modelInfo->meta.indicesCount;
-
-                    combinedIndices.reserve (combinedIndicesCount);
-                    combinedIndices.insert  (combinedIndices.end(), modelInfo->meta.indices.begin(),
-                                                                    modelInfo->meta.indices.end());
+                    auto modelInfo       = getModelInfo (infoId);
+                    combinedIndicesSize += modelInfo->meta.indicesCount * sizeof (uint32_t);
                     
                     infoId == *modelInfoIds.begin() ? modelInfo->id.indexBufferInfo = indexBufferInfoId:
                                                       modelInfo->id.indexBufferInfo = UINT32_MAX;
                 }
 
-                createIndexBuffer (deviceInfoId, 
-                                   indexBufferInfoId,
-                                   combinedIndicesCount * sizeof (uint32_t),
-                                   combinedIndices.data());
+                createIndexBuffer (deviceInfoId, indexBufferInfoId, combinedIndicesSize);
+
+                VkDeviceSize indicesOffset = 0;
+                for (auto const& infoId: modelInfoIds) {
+                    auto modelInfo    = getModelInfo (infoId);
+                    VkDeviceSize size = modelInfo->meta.indicesCount * sizeof (uint32_t);
+
+                    stageBufferUpload (deviceInfoId,
+                                       indexBufferInfoId,
+                                       INDEX_BUFFER,
+                                       indicesOffset,
+                                       modelInfo->meta.indices.data(),
+                                       size);
+                    indicesOffset += size;
+                }
                 
                 LOG_INFO (m_VKInitSequenceLog) << "[OK] Index buffer " 
                                                << "[" << indexBufferInfoId << "]"
@@ -296,6 +379,28 @@ namespace Core {
                                                    << "[" << storageBufferInfoId << "]"
                                                    << std::endl; 
                 }
+#if ENABLE_HEADLESS_MODE
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG READ BACK BUFFERS                                                                       |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* Every frame in flight gets its own read back buffer, so that the host can read the previous frame's 
+                 * contents from one buffer while the device is copying the current frame to another
+                */
+                if (g_headlessSettings.enableReadBack) {
+                    for (uint32_t i = 0; i < g_coreSettings.maxFramesInFlight; i++) {
+                        uint32_t readBackBufferInfoId = sceneInfo->id.readBackBufferInfoBase + i;
+                        createReadBackBuffer (deviceInfoId,
+                                              readBackBufferInfoId,
+                                              deviceInfo->params.swapChainExtent.width  *
+                                              deviceInfo->params.swapChainExtent.height * 4);
+
+                        LOG_INFO (m_VKInitSequenceLog) << "[OK] Read back buffer " 
+                                                       << "[" << readBackBufferInfoId << "]"
+                                                       << std::endl; 
+                    }
+                }
+#endif  // ENABLE_HEADLESS_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG RENDER PASS ATTACHMENTS                                                                 |
                  * |------------------------------------------------------------------------------------------------|
@@ -327,6 +432,9 @@ namespace Core {
                 */                
                 createDepthStencilDependency (renderPassInfoId, VK_SUBPASS_EXTERNAL, 0);
                 createColorWriteDependency   (renderPassInfoId, VK_SUBPASS_EXTERNAL, 0);
+#if ENABLE_HEADLESS_MODE
+                createReadBackDependency     (renderPassInfoId, 0, VK_SUBPASS_EXTERNAL);
+#endif  // ENABLE_HEADLESS_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG RENDER PASS                                                                             |
                  * |------------------------------------------------------------------------------------------------|
@@ -358,7 +466,11 @@ namespace Core {
                 */
                 for (uint32_t i = 0; i < deviceInfo->meta.swapChainSize; i++) {
                     uint32_t swapChainImageInfoId = sceneInfo->id.swapChainImageInfoBase + i;
+#if ENABLE_HEADLESS_MODE
+                    auto swapChainImageInfo       = getImageInfo (swapChainImageInfoId, OFFSCREEN_IMAGE);
+#else
                     auto swapChainImageInfo       = getImageInfo (swapChainImageInfoId, SWAPCHAIN_IMAGE);
+#endif  // ENABLE_HEADLESS_MODE
 
                     auto attachments = std::vector {
                         multiSampleImageInfo->resource.imageView,
@@ -411,17 +523,46 @@ namespace Core {
                  * | CONFIG PIPELINE STATE - SHADERS                                                                |
                  * |------------------------------------------------------------------------------------------------|
                 */
-                auto vertexShaderModule   = createShaderStage (deviceInfoId, 
-                                                               pipelineInfoId,
-                                                               VK_SHADER_STAGE_VERTEX_BIT, 
-                                                               g_pipelineSettings.shaderStage.vertexShaderBinaryPath, 
-                                                               "main");
+                createShaderStage (deviceInfoId, 
+                                   pipelineInfoId,
+                                   VK_SHADER_STAGE_VERTEX_BIT, 
+                                   g_pipelineSettings.shaderStage.vertexShaderBinaryPath, 
+                                   "main",
+                                   VK_NULL_HANDLE);
+                /* The specialization info needs to be valid until the pipeline is requested
+                */
+                DefaultShaderFragSC fragSpecializationData{};
+                fragSpecializationData.enableTextureSampling = g_pipelineSettings.shaderStage.enableTextureSampling;
+                fragSpecializationData.defaultColor          = getDefaultTextureColor();
+                auto fragMapEntries = std::vector <VkSpecializationMapEntry> {
+                    getSpecializationMapEntry (0, 
+                                               offsetof (DefaultShaderFragSC, enableTextureSampling), 
+                                               sizeof (uint32_t)),
+                    getSpecializationMapEntry (1, 
+                                               offsetof (DefaultShaderFragSC, defaultColor) + 0 * sizeof (float), 
+                                               sizeof (float)),
+                    getSpecializationMapEntry (2, 
+                                               offsetof (DefaultShaderFragSC, defaultColor) + 1 * sizeof (float), 
+                                               sizeof (float)),
+                    getSpecializationMapEntry (3, 
+                                               offsetof (DefaultShaderFragSC, defaultColor) + 2 * sizeof (float), 
+                                               sizeof (float)),
+                    getSpecializationMapEntry (4, 
+                                               offsetof (DefaultShaderFragSC, defaultColor) + 3 * sizeof (float), 
+                                               sizeof (float))
+                };
+                VkSpecializationInfo fragSpecializationInfo;
+                fragSpecializationInfo.mapEntryCount = static_cast <uint32_t> (fragMapEntries.size());
+                fragSpecializationInfo.pMapEntries   = fragMapEntries.data();
+                fragSpecializationInfo.dataSize      = sizeof (DefaultShaderFragSC);
+                fragSpecializationInfo.pData         = &fragSpecializationData;
 
-                auto fragmentShaderModule = createShaderStage (deviceInfoId, 
-                                                               pipelineInfoId,
-                                                               VK_SHADER_STAGE_FRAGMENT_BIT, 
-                                                               g_pipelineSettings.shaderStage.fragmentShaderBinaryPath,
-                                                               "main");
+                createShaderStage (deviceInfoId, 
+                                   pipelineInfoId,
+                                   VK_SHADER_STAGE_FRAGMENT_BIT, 
+                                   g_pipelineSettings.shaderStage.fragmentShaderBinaryPath,
+                                   "main",
+                                   &fragSpecializationInfo);
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG PIPELINE STATE - VIEW PORT                                                              |
                  * |------------------------------------------------------------------------------------------------|
@@ -492,16 +633,33 @@ namespace Core {
                                       1,
                                       VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
                                       VK_SHADER_STAGE_VERTEX_BIT,
-                                      VK_NULL_HANDLE),
-
-                    /* Another commonly used type of descriptor is the combined image sampler, which is a single 
-                     * descriptor type associated with both a sampler and an image resource, combining both a sampler 
-                     * and sampled image descriptor into a single descriptor. Note that, it is possible to use texture 
-                     * sampling in the vertex shader, for example to dynamically deform a grid of vertices by a 
-                     * heightmap
-                    */
-                    getLayoutBinding (1,
-                                      static_cast <uint32_t> (getTextureImagePool().size()),
+                                      VK_NULL_HANDLE)
+                };
+                auto bindingFlags = std::vector <VkDescriptorBindingFlags> {
+                    g_pipelineSettings.descriptorSetLayout.bindingFlagsSSBO
+                };
+                createDescriptorSetLayout (deviceInfoId, 
+                                           pipelineInfoId, 
+                                           layoutBindings, 
+                                           bindingFlags, 
+                                           g_pipelineSettings.descriptorSetLayout.layoutCreateFlags);
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG DESCRIPTOR SET LAYOUT - TEXTURE TABLE                                                   |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* Another commonly used type of descriptor is the combined image sampler, which is a single descriptor 
+                 * type associated with both a sampler and an image resource, combining both a sampler and sampled image 
+                 * descriptor into a single descriptor. Note that, it is possible to use texture sampling in the vertex 
+                 * shader, for example to dynamically deform a grid of vertices by a heightmap
+                 *
+                 * The texture table (see VKTextureTable) is in a set of its own, since it is shared by all frames in
+                 * flight. Its binding is sized to the capacity of the table rather than the number of textures, so 
+                 * that textures can be added later on without rebuilding the layout
+                */
+                uint32_t textureTableCapacity = getTextureTableCapacity (deviceInfoId);
+                auto textureTableLayoutBindings = std::vector {
+                    getLayoutBinding (0,
+                                      textureTableCapacity,
                                       VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
                                       VK_SHADER_STAGE_FRAGMENT_BIT,
                                       VK_NULL_HANDLE)
@@ -535,15 +693,14 @@ namespace Core {
                  * but only binds the first 32 slots in the array. This also relies on the the application knowing that 
                  * it will not index into the unbound slots in the array
                 */
-                auto bindingFlags = std::vector <VkDescriptorBindingFlags> {
-                    g_pipelineSettings.descriptorSetLayout.bindingFlagsSSBO,
-                    g_pipelineSettings.descriptorSetLayout.bindingFlagsCIS
+                auto textureTableBindingFlags = std::vector <VkDescriptorBindingFlags> {
+                    g_textureTableSettings.bindingFlags
                 };
                 createDescriptorSetLayout (deviceInfoId, 
                                            pipelineInfoId, 
-                                           layoutBindings, 
-                                           bindingFlags, 
-                                           g_pipelineSettings.descriptorSetLayout.layoutCreateFlags);
+                                           textureTableLayoutBindings, 
+                                           textureTableBindingFlags, 
+                                           g_textureTableSettings.layoutCreateFlags);
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG PUSH CONSTANT RANGES                                                                    |
                  * |------------------------------------------------------------------------------------------------|
@@ -557,34 +714,36 @@ namespace Core {
                  * |------------------------------------------------------------------------------------------------|
                 */
                 createPipelineLayout (deviceInfoId, pipelineInfoId);
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG PIPELINE CACHE                                                                          |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* The pipeline cache is shared by all pipelines created from here on, including the ones created in the
+                 * edit configs section below
+                */
+                createPipelineCache (deviceInfoId);
+                LOG_INFO (m_VKInitSequenceLog) << "[OK] Pipeline cache "
+                                               << "[" << deviceInfoId << "]"
+                                               << std::endl;
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG PIPELINE                                                                                |
                  * |------------------------------------------------------------------------------------------------|
                 */
-                createGraphicsPipeline (deviceInfoId,
-                                        renderPassInfoId,
-                                        pipelineInfoId, 
-                                        0, -1, 
-                                        VK_NULL_HANDLE, 
-                                        g_pipelineSettings.pipelineCreateFlags);
+                /* The pipeline is compiled along with the pipelines requested in the edit configs section below, see
+                 * the pipeline requests section
+                */
+                requestGraphicsPipeline (renderPassInfoId,
+                                         pipelineInfoId, 
+                                         0, 
+                                         UINT32_MAX,
+                                         UINT32_MAX,
+                                         g_pipelineSettings.pipelineCreateFlags);
 
-                LOG_INFO (m_VKInitSequenceLog) << "[OK] Pipeline " 
+                LOG_INFO (m_VKInitSequenceLog) << "[OK] Pipeline request " 
                                                << "[" << pipelineInfoId << "]"
                                                << " "
                                                << "[" << renderPassInfoId << "]"
                                                << std::endl;  
-                /* |------------------------------------------------------------------------------------------------|
-                 * | DESTROY SHADER MODULES                                                                         |
-                 * |------------------------------------------------------------------------------------------------|
-                */
-                /* The compilation and linking of the SPIR-V bytecode to machine code for execution by the GPU doesn't 
-                 * happen until the graphics pipeline is created. That means that we're allowed to destroy the shader 
-                 * modules as soon as pipeline creation is finished
-                */
-                vkDestroyShaderModule (deviceInfo->resource.logDevice, vertexShaderModule,   VK_NULL_HANDLE);
-                vkDestroyShaderModule (deviceInfo->resource.logDevice, fragmentShaderModule, VK_NULL_HANDLE);
-                LOG_INFO (m_VKInitSequenceLog) << "[DELETE] Shader modules" 
-                                               << std::endl;  
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG CAMERA MATRIX                                                                           |
                  * |------------------------------------------------------------------------------------------------|
@@ -610,37 +769,26 @@ namespace Core {
                                                << "[" << sceneInfoId << "]"
                                                << std::endl;  
                 /* |------------------------------------------------------------------------------------------------|
-                 * | CONFIG DESCRIPTOR POOL                                                                         |
+                 * | CONFIG DESCRIPTOR POOL CLASSES                                                                 |
                  * |------------------------------------------------------------------------------------------------|
                 */
-                auto poolSizes = std::vector {
-                    getPoolSize (VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, g_coreSettings.maxFramesInFlight),
-
-                    getPoolSize (VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, static_cast <uint32_t> 
-                                (getTextureImagePool().size()) * g_coreSettings.maxFramesInFlight)
-                };
-                createDescriptorPool (deviceInfoId,
-                                      sceneInfoId, 
-                                      poolSizes, 
-                                      g_coreSettings.maxFramesInFlight, 
-                                      g_descriptorSettings.poolCreateFlags);
-                LOG_INFO (m_VKInitSequenceLog) << "[OK] Descriptor pool " 
-                                               << "[" << sceneInfoId << "]"
+                /* The scene pool class holds the sets that live as long as the scene (one storage buffer per set). 
+                 * Note that, no per frame pool class is created, since nothing allocates sets while recording a frame
+                */
+                uint32_t scenePoolClassId = g_descriptorSettings.scenePoolClassId;
+                createDescriptorPoolClass (scenePoolClassId,
+                                           {{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1.0f}},
+                                           g_descriptorSettings.poolCreateFlags,
+                                           false);
+                LOG_INFO (m_VKInitSequenceLog) << "[OK] Descriptor pool classes " 
+                                               << "[" << scenePoolClassId << "]"
                                                << std::endl;  
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG DESCRIPTOR SETS                                                                         |
                  * |------------------------------------------------------------------------------------------------|
                 */
                 uint32_t descriptorSetLayoutId = 0;
-                createDescriptorSets (deviceInfoId, 
-                                      pipelineInfoId, 
-                                      sceneInfoId,
-                                      descriptorSetLayoutId, 
-                                      g_coreSettings.maxFramesInFlight);
-                /* |------------------------------------------------------------------------------------------------|
-                 * | CONFIG DESCRIPTOR SETS UPDATE                                                                  |
-                 * |------------------------------------------------------------------------------------------------|
-                */
+                sceneInfo->resource.descriptorSets.resize (g_coreSettings.maxFramesInFlight);
                 for (uint32_t i = 0; i < g_coreSettings.maxFramesInFlight; i++) {
                     uint32_t storageBufferInfoId = sceneInfo->id.storageBufferInfoBase + i; 
                     auto bufferInfo              = getBufferInfo (storageBufferInfoId, STORAGE_BUFFER);
@@ -650,31 +798,23 @@ namespace Core {
                                                  sceneInfo->meta.totalInstancesCount * sizeof (InstanceDataSSBO))
                     };
 
-                    uint32_t textureCount = static_cast <uint32_t> (getTextureImagePool().size());
-                    std::vector <VkDescriptorImageInfo> descriptorImageInfos (textureCount);
-                    for (auto const& [path, infoId]: getTextureImagePool()) {
-                        auto imageInfo               = getImageInfo (infoId, TEXTURE_IMAGE);
-                        descriptorImageInfos[infoId] = getDescriptorImageInfo (sceneInfo->resource.textureSampler,
-                                                                               imageInfo->resource.imageView,
-                                                                               VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-                    }
-
                     /* The configuration of descriptors is updated using the vkUpdateDescriptorSets function, which takes 
-                     * an array of VkWriteDescriptorSet structs as parameter
+                     * an array of VkWriteDescriptorSet structs as parameter. The destination set is filled in by the 
+                     * allocator, which allocates and writes to a new set only if no identical set exists. Note that, 
+                     * each frame in flight points to its own storage buffer, so these sets never hit in the cache
                     */                    
                     auto writeDescriptorSets = std::vector {
                         getWriteBufferDescriptorSetInfo (VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                                         sceneInfo->resource.descriptorSets[i],
+                                                         VK_NULL_HANDLE,
                                                          descriptorBufferInfos,
-                                                         0, 0, 1),
-
-                        getWriteImageDescriptorSetInfo  (VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                                                         sceneInfo->resource.descriptorSets[i],
-                                                         descriptorImageInfos,
-                                                         1, 0, textureCount)
+                                                         0, 0, 1)
                     };
-
-                    updateDescriptorSets (deviceInfoId, writeDescriptorSets);
+                    sceneInfo->resource.descriptorSets[i] = getCachedDescriptorSet (deviceInfoId,
+                                                                                    pipelineInfoId,
+                                                                                    descriptorSetLayoutId,
+                                                                                    scenePoolClassId,
+                                                                                    i,
+                                                                                    writeDescriptorSets);
                 }
                 LOG_INFO (m_VKInitSequenceLog) << "[OK] Descriptor sets " 
                                                << "[" << sceneInfoId << "]"
@@ -684,153 +824,80 @@ namespace Core {
                                                << "[" << descriptorSetLayoutId << "]"
                                                << std::endl;
                 /* |------------------------------------------------------------------------------------------------|
-                 * | CONFIG TRANSFER OPS - COMMAND POOL AND BUFFER                                                  |
-                 * |------------------------------------------------------------------------------------------------|
-                */
-                /* Note that the command buffers that we will be submitting to the transfer queue will be short lived, so 
-                 * we will choose the VK_COMMAND_POOL_CREATE_TRANSIENT_BIT flag. And, this buffer copy command requires a 
-                 * queue family that supports transfer operations, which is indicated using VK_QUEUE_TRANSFER_BIT
-                */
-                auto transferOpsCommandPool = getCommandPool (deviceInfoId, 
-                                                              VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
-                                                              deviceInfo->meta.transferFamilyIndex.value());
-                LOG_INFO (m_VKInitSequenceLog) << "[OK] Transfer ops command pool "
-                                               << "[" << deviceInfoId << "]"
-                                               << std::endl;
-                /* Note that we are only requesting one command buffer from the pool, since it is recommended to combine 
-                 * all the transfer operations in a single command buffer and execute them asynchronously for higher 
-                 * throughput
-                */                                            
-                auto transferOpsCommandBuffers = std::vector {
-                    getCommandBuffers (deviceInfoId, transferOpsCommandPool, 1, VK_COMMAND_BUFFER_LEVEL_PRIMARY)
-                };
-                /* |------------------------------------------------------------------------------------------------|
-                 * | CONFIG TRANSFER OPS - FENCE                                                                    |
-                 * |------------------------------------------------------------------------------------------------|
-                */
-                uint32_t transferOpsFenceInfoId = 0;
-                createFence (deviceInfoId, transferOpsFenceInfoId, FEN_TRANSFER_DONE, 0);
-                LOG_INFO (m_VKInitSequenceLog) << "[OK] Transfer ops fence " 
-                                               << "[" << transferOpsFenceInfoId << "]"
-                                               << std::endl;
-                /* |------------------------------------------------------------------------------------------------|
-                 * | CONFIG TRANSFER OPS - RECORD AND SUBMIT                                                        |
+                 * | CONFIG TEXTURE TABLE                                                                           |
                  * |------------------------------------------------------------------------------------------------|
                 */
-                /* We're only going to use the command buffer once and wait (vkQueueWaitIdle/vkWaitForFences) until the
-                 * copy operation has finished executing. It's good practice to tell the driver about our intent using 
-                 * VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
-                */ 
-                beginRecording (transferOpsCommandBuffers[0],
-                                VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
-                                VK_NULL_HANDLE);
+                uint32_t textureTableLayoutId = 1;
+                createTextureTable (deviceInfoId, 
+                                    pipelineInfoId, 
+                                    sceneInfoId, 
+                                    textureTableLayoutId, 
+                                    textureTableCapacity,
+                                    getDefaultTextureImageInfoId());
+                /* The default diffuse texture is written to its reserved slot, and the rest of the textures to the slots 
+                 * after it. The textures that are yet to be loaded (see ENABLE_PROGRESSIVE_STARTUP) share the placeholder 
+                 * texture's slot for now
+                */
+                auto textureIds = std::vector <uint32_t> {};
+                for (auto const& [path, infoId]: getTextureImagePool())
+                    textureIds.push_back (infoId);
+                std::sort (textureIds.begin(), textureIds.end());
 
-                for (auto const& [path, infoId]: getTextureImagePool()) {
-                    copyBufferToImage (infoId, infoId, 
-                                       STAGING_BUFFER_TEX, TEXTURE_IMAGE,
-                                       0, 
-                                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                       transferOpsCommandBuffers[0]);
+                for (auto const& infoId: textureIds) {
+                    if (getSampledTextureImageInfoId (infoId) == infoId)
+                        writeTextureTableEntry (deviceInfoId, infoId, infoId);
                 }
-
-                for (auto const& infoId: modelInfoBase->id.vertexBufferInfos) {
-                    copyBufferToBuffer (infoId, infoId,
-                                        STAGING_BUFFER, VERTEX_BUFFER,
-                                        0, 0,
-                                        transferOpsCommandBuffers[0]);
+                for (auto const& infoId: textureIds) {
+                    uint32_t sampledInfoId = getSampledTextureImageInfoId (infoId);
+                    if (sampledInfoId != infoId)
+                        aliasTextureTableEntry (infoId, sampledInfoId);
                 }
-
-                copyBufferToBuffer (modelInfoBase->id.indexBufferInfo, 
-                                    modelInfoBase->id.indexBufferInfo,
-                                    STAGING_BUFFER, INDEX_BUFFER,
-                                    0, 0,
-                                    transferOpsCommandBuffers[0]);
-
-                endRecording (transferOpsCommandBuffers[0]);
-
-                VkSubmitInfo transferOpsSubmitInfo{};
-                transferOpsSubmitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-                transferOpsSubmitInfo.commandBufferCount = static_cast <uint32_t> (transferOpsCommandBuffers.size());
-                transferOpsSubmitInfo.pCommandBuffers    = transferOpsCommandBuffers.data();
-                VkResult result = vkQueueSubmit (deviceInfo->resource.transferQueue, 
-                                                 1, 
-                                                 &transferOpsSubmitInfo, 
-                                                 getFenceInfo (transferOpsFenceInfoId, FEN_TRANSFER_DONE)->resource.fence);
-
-                if (result != VK_SUCCESS) {
-                    LOG_ERROR (m_VKInitSequenceLog) << "Failed to submit transfer ops command buffer "
-                                                    << "[" << deviceInfoId << "]"
-                                                    << " " 
-                                                    << "[" << string_VkResult (result) << "]"
-                                                    << std::endl; 
-                    throw std::runtime_error ("Failed to submit transfer ops command buffer");                    
-                } 
+                LOG_INFO (m_VKInitSequenceLog) << "[OK] Texture table " 
+                                               << "[" << textureTableLayoutId << "]"
+                                               << " "
+                                               << "[" << textureIds.size() << "]"
+                                               << "->"
+                                               << "[" << textureTableCapacity << "]"
+                                               << std::endl;
                 /* |------------------------------------------------------------------------------------------------|
-                 * | CONFIG TRANSFER OPS - WAIT                                                                     |
+                 * | CONFIG TRANSFER OPS - SEMAPHORE                                                                |
                  * |------------------------------------------------------------------------------------------------|
                 */
-                /* Wait for fence 
-                 * Unlike the draw commands, there are no events we need to wait on. We just want to execute the transfer
-                 * on the buffers immediately. There are again two possible ways to wait on this transfer to complete
-                 * 
-                 * (1) We could use a fence and wait with vkWaitForFences, or 
-                 * (2) Simply wait for the transfer queue to become idle via vkQueueWaitIdle (getTransferQueue());
-                 * 
-                 * A fence would allow you to schedule multiple transfers simultaneously and wait for all of them 
-                 * complete, instead of executing one at a time. That may give the driver more opportunities to optimize
-                */ 
-                LOG_INFO (m_VKInitSequenceLog) << "[WAITING] Transfer ops fence " 
-                                               << "[" << transferOpsFenceInfoId << "]"
+                uint32_t transferOpsSemaphoreInfoId = 0;
+                createSemaphore (deviceInfoId, transferOpsSemaphoreInfoId, SEM_TRANSFER_DONE);
+                LOG_INFO (m_VKInitSequenceLog) << "[OK] Transfer ops semaphore " 
+                                               << "[" << transferOpsSemaphoreInfoId << "]"
                                                << std::endl;
-                vkWaitForFences (deviceInfo->resource.logDevice, 
-                                 1, 
-                                 &getFenceInfo (transferOpsFenceInfoId, FEN_TRANSFER_DONE)->resource.fence, 
-                                 VK_TRUE, 
-                                 UINT64_MAX);
-
-                vkResetFences   (deviceInfo->resource.logDevice, 
-                                 1, 
-                                 &getFenceInfo (transferOpsFenceInfoId, FEN_TRANSFER_DONE)->resource.fence);
-                LOG_INFO (m_VKInitSequenceLog) << "[OK] Transfer ops fence reset "
-                                               << "[" << transferOpsFenceInfoId << "]"
-                                               << std::endl;    
                 /* |------------------------------------------------------------------------------------------------|
-                 * | DESTROY STAGING BUFFERS                                                                        |
+                 * | CONFIG TRANSFER OPS - SUBMIT                                                                   |
                  * |------------------------------------------------------------------------------------------------|
                 */
-                VKBufferMgr::cleanUp (deviceInfoId, modelInfoBase->id.indexBufferInfo, STAGING_BUFFER);
-                LOG_INFO (m_VKInitSequenceLog) << "[DELETE] Staging buffer " 
-                                               << "[" << modelInfoBase->id.indexBufferInfo << "]"
-                                               << std::endl;  
-
-                for (auto const& infoId: modelInfoBase->id.vertexBufferInfos) {
-                    VKBufferMgr::cleanUp (deviceInfoId, infoId, STAGING_BUFFER);
-                    LOG_INFO (m_VKInitSequenceLog) << "[DELETE] Staging buffer "
-                                                   << "[" << infoId << "]"
-                                                   << std::endl;
-                }
-
-                for (auto const& [path, infoId]: getTextureImagePool()) {
-                    VKBufferMgr::cleanUp (deviceInfoId, infoId, STAGING_BUFFER_TEX);
-                    LOG_INFO (m_VKInitSequenceLog) << "[DELETE] Staging buffer (Tex) " 
-                                                   << "[" << infoId << "]"
-                                                   << std::endl;
-                }              
-                /* |------------------------------------------------------------------------------------------------|
-                 * | DESTROY TRANSFER OPS - FENCE                                                                   |
-                 * |------------------------------------------------------------------------------------------------|
+                /* Submit the copies that are yet to be submitted, note that, some of them may have been submitted already
+                 * if the staging buffer had run out of space. Instead of waiting on the copies here, the blit ops 
+                 * submission waits on the semaphore signaled by them, so the host doesn't stall between the two
                 */
-                cleanUpFence (deviceInfoId, transferOpsFenceInfoId, FEN_TRANSFER_DONE);
-                LOG_INFO (m_VKInitSequenceLog) << "[DELETE] Transfer ops fence " 
+                bool transferOpsPending = flushStagingBuffer (deviceInfoId, 
+                                                              getSemaphoreInfo (transferOpsSemaphoreInfoId, 
+                                                                                SEM_TRANSFER_DONE)->resource.semaphore);
+                LOG_INFO (m_VKInitSequenceLog) << "[OK] Transfer ops submitted "
                                                << "[" << transferOpsFenceInfoId << "]"
-                                               << std::endl;
+                                               << " "
+                                               << "[" << transferOpsPending << "]"
+                                               << std::endl;    
+#if ENABLE_GEOMETRY_RELEASE_AFTER_UPLOAD
                 /* |------------------------------------------------------------------------------------------------|
-                 * | DESTROY TRANSFER OPS - COMMAND POOL                                                            |
+                 * | RELEASE GEOMETRY                                                                               |
                  * |------------------------------------------------------------------------------------------------|
                 */
-                VKCmdBuffer::cleanUp (deviceInfoId, transferOpsCommandPool);
-                LOG_INFO (m_VKInitSequenceLog) << "[DELETE] Transfer ops command pool"
+                /* The vertex and index data now lives in the device local buffers, so the host side copy held by each
+                 * model info can be released
+                */
+                for (auto const& infoId: modelInfoIds)
+                    releaseGeometry (infoId);
+                LOG_INFO (m_VKInitSequenceLog) << "[DELETE] Geometry "
+                                               << "[" << modelInfoIds.size() << "]"
                                                << std::endl;
+#endif  // ENABLE_GEOMETRY_RELEASE_AFTER_UPLOAD
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG BLIT OPS - COMMAND POOL AND BUFFER                                                      |
                  * |------------------------------------------------------------------------------------------------|
@@ -862,20 +929,39 @@ namespace Core {
                                 VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
                                 VK_NULL_HANDLE);
 
-                for (auto const& [path, infoId]: getTextureImagePool()) {
-                    blitImageToMipMaps (infoId, TEXTURE_IMAGE, blitOpsCommandBuffers[0]);
-                }
+                /* If the resources that were uploaded are owned exclusively by the graphics queue family, they are taken 
+                 * over from the transfer queue family first
+                */
+                recordOwnershipAcquires (blitOpsCommandBuffers[0]);
+                /* If the mip levels were generated on the host (or loaded from a container), they have already been 
+                 * copied along with the base level and all that is left is to prepare them for shader access
+                */
+                recordTextureMipMaps    (blitOpsCommandBuffers[0]);
 
                 endRecording (blitOpsCommandBuffers[0]);
 
+                /* The blits (and ownership acquires) wait on the copies at the transfer and vertex input stages, which
+                 * are the earliest stages that the uploaded resources are used in
+                */
+                auto blitOpsWaitSemaphores = std::array {
+                    getSemaphoreInfo (transferOpsSemaphoreInfoId, SEM_TRANSFER_DONE)->resource.semaphore
+                };
+                auto blitOpsWaitStages     = std::array <VkPipelineStageFlags, 1> {
+                    VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT
+                };
+
                 VkSubmitInfo blitOpsSubmitInfo{};
                 blitOpsSubmitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                blitOpsSubmitInfo.waitSemaphoreCount = transferOpsPending ? 
+                                                       static_cast <uint32_t> (blitOpsWaitSemaphores.size()): 0;
+                blitOpsSubmitInfo.pWaitSemaphores    = blitOpsWaitSemaphores.data();
+                blitOpsSubmitInfo.pWaitDstStageMask  = blitOpsWaitStages.data();
                 blitOpsSubmitInfo.commandBufferCount = static_cast <uint32_t> (blitOpsCommandBuffers.size());
                 blitOpsSubmitInfo.pCommandBuffers    = blitOpsCommandBuffers.data();
-                result = vkQueueSubmit (deviceInfo->resource.graphicsQueue, 
-                                        1, 
-                                        &blitOpsSubmitInfo, 
-                                        getFenceInfo (blitOpsFenceInfoId, FEN_BLIT_DONE)->resource.fence);
+                VkResult result = vkQueueSubmit (deviceInfo->resource.graphicsQueue, 
+                                                 1, 
+                                                 &blitOpsSubmitInfo, 
+                                                 getFenceInfo (blitOpsFenceInfoId, FEN_BLIT_DONE)->resource.fence);
 
                 if (result != VK_SUCCESS) {
                     LOG_ERROR (m_VKInitSequenceLog) << "Failed to submit blit ops command buffer "
@@ -919,6 +1005,40 @@ namespace Core {
                 VKCmdBuffer::cleanUp (deviceInfoId, blitOpsCommandPool);
                 LOG_INFO (m_VKInitSequenceLog) << "[DELETE] Blit ops command pool"
                                                << std::endl;           
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG TRANSFER OPS - WAIT                                                                     |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* The copies were complete by the time the blit ops were, so this only resets the transfer fence
+                */
+                submitStagingBuffer (deviceInfoId);
+                LOG_INFO (m_VKInitSequenceLog) << "[OK] Transfer ops fence reset "
+                                               << "[" << transferOpsFenceInfoId << "]"
+                                               << std::endl;
+                /* |------------------------------------------------------------------------------------------------|
+                 * | DESTROY TRANSFER OPS - SEMAPHORE                                                               |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                cleanUpSemaphore (deviceInfoId, transferOpsSemaphoreInfoId, SEM_TRANSFER_DONE);
+                LOG_INFO (m_VKInitSequenceLog) << "[DELETE] Transfer ops semaphore " 
+                                               << "[" << transferOpsSemaphoreInfoId << "]"
+                                               << std::endl;
+                /* |------------------------------------------------------------------------------------------------|
+                 * | DESTROY STAGING BUFFER                                                                         |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* If there are textures left to be loaded after the first frame, the staging buffer is kept around for
+                 * them and destroyed once they have been loaded
+                */
+                if (areTextureImagesLoaded()) {
+                    dumpStagingBufferStats();
+                    cleanUpStagingBuffer (deviceInfoId);
+                    LOG_INFO (m_VKInitSequenceLog) << "[DELETE] Staging buffer " 
+                                                   << "[" << stagingBufferInfoId << "]"
+                                                   << " "
+                                                   << "[" << transferOpsFenceInfoId << "]"
+                                                   << std::endl;  
+                }
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG DRAW OPS - COMMAND POOL AND BUFFERS                                                     |
                  * |------------------------------------------------------------------------------------------------|
@@ -944,6 +1064,21 @@ namespace Core {
 
                 sceneInfo->resource.commandPool    = drawOpsCommandPool;
                 sceneInfo->resource.commandBuffers = drawOpsCommandBuffers;
+#if ENABLE_BENCHMARK_MODE
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG DRAW OPS - TIMESTAMP QUERY POOL                                                         |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* Each frame in flight writes a timestamp at the start and end of its command buffer, so that the time 
+                 * spent by the device on the frame can be read back once its fence has been signaled
+                */
+                sceneInfo->resource.queryPool = getQueryPool (deviceInfoId,
+                                                              VK_QUERY_TYPE_TIMESTAMP,
+                                                              g_coreSettings.maxFramesInFlight * 2);
+                LOG_INFO (m_VKInitSequenceLog) << "[OK] Draw ops query pool " 
+                                               << "[" << deviceInfoId << "]"
+                                               << std::endl;
+#endif  // ENABLE_BENCHMARK_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG DRAW OPS - FENCE AND SEMAPHORES                                                         |
                  * |------------------------------------------------------------------------------------------------|
@@ -983,6 +1118,20 @@ namespace Core {
                  * |------------------------------------------------------------------------------------------------|
                 */
                 lambda();
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG PIPELINE REQUESTS                                                                       |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* All the pipelines requested so far are compiled in a single batch. If compilation is asynchronous,
+                 * the draw sequence picks up the pipelines once they are ready, otherwise we wait for them here
+                */
+                flushPipelineRequests (deviceInfoId);
+#if !ENABLE_ASYNC_PIPELINE_COMPILATION
+                waitPipelineRequests  (deviceInfoId);
+#endif  // ENABLE_ASYNC_PIPELINE_COMPILATION
+                LOG_INFO (m_VKInitSequenceLog) << "[OK] Pipeline requests "
+                                               << "[" << deviceInfoId << "]"
+                                               << std::endl;
                 /* |------------------------------------------------------------------------------------------------|
                  * | DUMP METHODS                                                                                   |
                  * |------------------------------------------------------------------------------------------------|
@@ -991,6 +1140,7 @@ namespace Core {
                 dumpModelInfoPool();
                 dumpImageInfoPool();
                 dumpBufferInfoPool();
+                dumpMemoryAllocatorStats();
                 dumpRenderPassInfoPool();
                 dumpPipelineInfoPool();
                 dumpCameraInfoPool();
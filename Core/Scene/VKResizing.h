@@ -20,7 +20,7 @@ namespace Core {
         public:
             VKResizing (void) {
                 m_VKResizingLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO, Log::TO_FILE_IMMEDIATE);                
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO, Log::TO_FILE_SHARED);                
             }
 
             ~VKResizing (void) {
@@ -76,6 +76,10 @@ namespace Core {
                                            << " "
                                            << "[" << deviceInfoId << "]"
                                            << std::endl; 
+                /* Report the bytes saved by the transient attachments before they are destroyed, in case of resizing
+                 * these are the stats for the previous resolution
+                */
+                dumpTransientImageStats (deviceInfoId);
                 /* |------------------------------------------------------------------------------------------------|
                  * | DESTROY MULTI SAMPLE RESOURCES                                                                 |
                  * |------------------------------------------------------------------------------------------------|
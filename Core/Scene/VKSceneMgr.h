@@ -3,6 +3,7 @@
 
 #include "../VKConfig.h"
 #include "../../Collections/Log/Log.h"
+#include "../../Collections/SlotMap/SlotMap.h"
 
 using namespace Collections;
 
@@ -19,6 +20,7 @@ namespace Core {
                     uint32_t depthImageInfo;
                     uint32_t multiSampleImageInfo;
                     uint32_t storageBufferInfoBase;
+                    uint32_t readBackBufferInfoBase;
                     uint32_t inFlightFenceInfoBase;
                     uint32_t imageAvailableSemaphoreInfoBase;
                     uint32_t renderDoneSemaphoreInfoBase;
@@ -26,21 +28,22 @@ namespace Core {
 
                 struct Resource {
                     VkSampler textureSampler;
-                    VkDescriptorPool descriptorPool;
                     std::vector <VkDescriptorSet> descriptorSets;
 
                     VkCommandPool commandPool;
                     std::vector <VkCommandBuffer> commandBuffers;
+                    /* Timestamp query pool holding a pair of (begin, end) queries per frame in flight
+                    */
+                    VkQueryPool queryPool;
                 } resource;
             };
-            std::unordered_map <uint32_t, SceneInfo> m_sceneInfoPool;
+            SlotMap <SceneInfo> m_sceneInfoPool;
 
             Log::Record* m_VKSceneMgrLog;
             const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
 
             void deleteSceneInfo (uint32_t sceneInfoId) {
-                if (m_sceneInfoPool.find (sceneInfoId) != m_sceneInfoPool.end()) {
-                    m_sceneInfoPool.erase (sceneInfoId);
+                if (m_sceneInfoPool.erase (sceneInfoId)) {
                     return;
                 }
 
@@ -53,8 +56,8 @@ namespace Core {
         public:
             VKSceneMgr (void) {
                 m_VKSceneMgrLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_IMMEDIATE);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
             }
 
             ~VKSceneMgr (void) { 
@@ -66,7 +69,7 @@ namespace Core {
                                  uint32_t totatInstancesCount,
                                  const std::vector <uint32_t>& infoIds) {
 
-                if (m_sceneInfoPool.find (sceneInfoId) != m_sceneInfoPool.end()) {
+                if (m_sceneInfoPool.contains (sceneInfoId)) {
                     LOG_ERROR (m_VKSceneMgrLog) << "Scene info id already exists "
                                                 << "[" << sceneInfoId << "]"
                                                 << std::endl;
@@ -79,12 +82,13 @@ namespace Core {
                 info.id.imageAvailableSemaphoreInfoBase = infoIds[1];
                 info.id.renderDoneSemaphoreInfoBase     = infoIds[2];
 
-                m_sceneInfoPool[sceneInfoId] = info;
+                m_sceneInfoPool.insert (sceneInfoId, info);
             }
 
             SceneInfo* getSceneInfo (uint32_t sceneInfoId) {
-                if (m_sceneInfoPool.find (sceneInfoId) != m_sceneInfoPool.end())
-                    return &m_sceneInfoPool[sceneInfoId];
+                auto info = m_sceneInfoPool.find (sceneInfoId);
+                if (info != nullptr)
+                    return info;
                 
                 LOG_ERROR (m_VKSceneMgrLog) << "Failed to find scene info "
                                             << "[" << sceneInfoId << "]"
@@ -121,6 +125,10 @@ namespace Core {
                                                << "[" << val.id.storageBufferInfoBase << "]"
                                                << std::endl;
 
+                    LOG_INFO (m_VKSceneMgrLog) << "Read back buffer info id base "
+                                               << "[" << val.id.readBackBufferInfoBase << "]"
+                                               << std::endl;
+
                     LOG_INFO (m_VKSceneMgrLog) << "In flight fence info id base "
                                                << "[" << val.id.inFlightFenceInfoBase << "]" 
                                                << std::endl;
@@ -21,12 +21,8 @@ namespace Core {
                 struct Resource {
                     VkFence fence;
                 } resource;
-
-                bool operator == (const FenceInfo& other) const {
-                    return meta.id == other.meta.id;
-                }
             };
-            std::unordered_map <e_syncType, std::vector <FenceInfo>> m_fenceInfoPool;
+            std::unordered_map <e_syncType, SlotMap <FenceInfo>> m_fenceInfoPool;
 
             struct SemaphoreInfo {
                 struct Meta {
@@ -36,24 +32,16 @@ namespace Core {
                 struct Resource {
                     VkSemaphore semaphore;
                 } resource;
-
-                bool operator == (const SemaphoreInfo& other) const {
-                    return meta.id == other.meta.id;
-                }
             };
-            std::unordered_map <e_syncType, std::vector <SemaphoreInfo>> m_semaphoreInfoPool;
+            std::unordered_map <e_syncType, SlotMap <SemaphoreInfo>> m_semaphoreInfoPool;
 
             Log::Record* m_VKSyncObjectLog;
             const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
 
             void deleteFenceInfo (FenceInfo* fenceInfo, e_syncType type) {
-                if (m_fenceInfoPool.find (type) != m_fenceInfoPool.end()) {
-                    auto& infos = m_fenceInfoPool[type];
-
-                    infos.erase (std::remove (infos.begin(), infos.end(), *fenceInfo), infos.end());
-                    m_fenceInfoPool[type] = infos;
+                auto pool = m_fenceInfoPool.find (type);
+                if (pool != m_fenceInfoPool.end() && pool->second.erase (fenceInfo->meta.id))
                     return;
-                }
 
                 LOG_ERROR (m_VKSyncObjectLog) << "Failed to delete fence info "
                                               << "[" << fenceInfo->meta.id << "]"
@@ -64,13 +52,9 @@ namespace Core {
             }
 
             void deleteSemaphoreInfo (SemaphoreInfo* semaphoreInfo, e_syncType type) {
-                if (m_semaphoreInfoPool.find (type) != m_semaphoreInfoPool.end()) {
-                    auto& infos = m_semaphoreInfoPool[type];
-
-                    infos.erase (std::remove (infos.begin(), infos.end(), *semaphoreInfo), infos.end());
-                    m_semaphoreInfoPool[type] = infos;
+                auto pool = m_semaphoreInfoPool.find (type);
+                if (pool != m_semaphoreInfoPool.end() && pool->second.erase (semaphoreInfo->meta.id))
                     return;
-                }
 
                 LOG_ERROR (m_VKSyncObjectLog) << "Failed to delete semaphore info "
                                               << "[" << semaphoreInfo->meta.id << "]"
@@ -83,8 +67,8 @@ namespace Core {
         public:
             VKSyncObject (void) {
                 m_VKSyncObjectLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_IMMEDIATE);
-                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE); 
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE); 
             }
 
             ~VKSyncObject (void) {
@@ -98,15 +82,13 @@ namespace Core {
                               VkFenceCreateFlags fenceCreateFlags) {
 
                 auto deviceInfo = getDeviceInfo (deviceInfoId);
-                for (auto const& info: m_fenceInfoPool[type]) {
-                    if (info.meta.id == fenceInfoId) {
-                        LOG_ERROR (m_VKSyncObjectLog) << "Fence info id already exists " 
-                                                      << "[" << fenceInfoId << "]"
-                                                      << " "
-                                                      << "[" << Utils::getSyncTypeString (type) << "]"
-                                                      << std::endl;
-                        throw std::runtime_error ("Fence info id already exists");
-                    }
+                if (m_fenceInfoPool[type].contains (fenceInfoId)) {
+                    LOG_ERROR (m_VKSyncObjectLog) << "Fence info id already exists " 
+                                                  << "[" << fenceInfoId << "]"
+                                                  << " "
+                                                  << "[" << Utils::getSyncTypeString (type) << "]"
+                                                  << std::endl;
+                    throw std::runtime_error ("Fence info id already exists");
                 }
                 /* A fence has a similar purpose, in that it is used to synchronize execution, but it is for ordering the 
                  * execution on the CPU, otherwise known as the host. Simply put, if the host needs to know when the GPU 
@@ -144,20 +126,18 @@ namespace Core {
                 FenceInfo info;
                 info.meta.id        = fenceInfoId;
                 info.resource.fence = fence;
-                m_fenceInfoPool[type].push_back (info);
+                m_fenceInfoPool[type].insert (info.meta.id, info);
             }
 
             void createSemaphore (uint32_t deviceInfoId, uint32_t semaphoreInfoId, e_syncType type) {
                 auto deviceInfo = getDeviceInfo (deviceInfoId);
-                for (auto const& info: m_semaphoreInfoPool[type]) {
-                    if (info.meta.id == semaphoreInfoId) {
-                        LOG_ERROR (m_VKSyncObjectLog) << "Semaphore info id already exists " 
-                                                      << "[" << semaphoreInfoId << "]"
-                                                      << " "
-                                                      << "[" << Utils::getSyncTypeString (type) << "]"
-                                                      << std::endl;
-                        throw std::runtime_error ("Semaphore info id already exists");
-                    }
+                if (m_semaphoreInfoPool[type].contains (semaphoreInfoId)) {
+                    LOG_ERROR (m_VKSyncObjectLog) << "Semaphore info id already exists " 
+                                                  << "[" << semaphoreInfoId << "]"
+                                                  << " "
+                                                  << "[" << Utils::getSyncTypeString (type) << "]"
+                                                  << std::endl;
+                    throw std::runtime_error ("Semaphore info id already exists");
                 }
                 /* A semaphore is used to add order between queue operations. Queue operations refer to the work we 
                  * submit to a queue, either in a command buffer or from within a function. Semaphores are used both to 
@@ -197,15 +177,15 @@ namespace Core {
                 SemaphoreInfo info;
                 info.meta.id            = semaphoreInfoId;
                 info.resource.semaphore = semaphore;
-                m_semaphoreInfoPool[type].push_back (info);
+                m_semaphoreInfoPool[type].insert (info.meta.id, info);
             }
 
             FenceInfo* getFenceInfo (uint32_t fenceInfoId, e_syncType type) {
-                if (m_fenceInfoPool.find (type) != m_fenceInfoPool.end()) {
-                    auto& infos = m_fenceInfoPool[type];
-                    for (auto& info: infos) {
-                        if (info.meta.id == fenceInfoId) return &info;
-                    }
+                auto pool = m_fenceInfoPool.find (type);
+                if (pool != m_fenceInfoPool.end()) {
+                    auto info = pool->second.find (fenceInfoId);
+                    if (info != nullptr)
+                        return info;
                 }
 
                 LOG_ERROR (m_VKSyncObjectLog) << "Failed to find fence info "
@@ -217,11 +197,11 @@ namespace Core {
             }
 
             SemaphoreInfo* getSemaphoreInfo (uint32_t semaphoreInfoId, e_syncType type) {
-                if (m_semaphoreInfoPool.find (type) != m_semaphoreInfoPool.end()) {
-                    auto& infos = m_semaphoreInfoPool[type];
-                    for (auto& info: infos) {
-                        if (info.meta.id == semaphoreInfoId) return &info;
-                    }
+                auto pool = m_semaphoreInfoPool.find (type);
+                if (pool != m_semaphoreInfoPool.end()) {
+                    auto info = pool->second.find (semaphoreInfoId);
+                    if (info != nullptr)
+                        return info;
                 }
 
                 LOG_ERROR (m_VKSyncObjectLog) << "Failed to find semaphore info "
@@ -241,7 +221,7 @@ namespace Core {
                                                  << "[" << Utils::getSyncTypeString (key) << "]"
                                                  << std::endl;
                     
-                    for (auto const& info: val) {
+                    for (auto const& [infoId, info]: val) {
                         LOG_INFO (m_VKSyncObjectLog) << "Id "
                                                      << "[" << info.meta.id << "]"
                                                      << std::endl; 
@@ -258,7 +238,7 @@ namespace Core {
                                                  << "[" << Utils::getSyncTypeString (key) << "]"
                                                  << std::endl;
                     
-                    for (auto const& info: val) {
+                    for (auto const& [infoId, info]: val) {
                         LOG_INFO (m_VKSyncObjectLog) << "Id "
                                                      << "[" << info.meta.id << "]"
                                                      << std::endl; 
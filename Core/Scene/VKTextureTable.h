@@ -0,0 +1,335 @@
+#ifndef VK_TEXTURE_TABLE_H
+#define VK_TEXTURE_TABLE_H
+
+#include <algorithm>
+#include "../Image/VKImageMgr.h"
+#include "VKDescriptor.h"
+
+namespace Core {
+    /* The texture table is a single descriptor set that holds a combined image sampler descriptor for every texture in
+     * the scene, and is shared by all frames in flight (as opposed to the per frame descriptor sets which hold the
+     * instance data). Shaders index in to the table using the slot that a texture id is mapped to, which is handed to
+     * them through the texture id look up table in the instance data
+     *
+     * The table is sized to an upper limit up front, and is created with the descriptor indexing flags below, so that
+     * textures can be added to it or retired from it at run time by writing a single descriptor, without having to
+     * rebuild the descriptor set layout or the pipelines that use it
+     * (1) Update after bind, the descriptors can be written while the table is bound in a command buffer
+     * (2) Update unused while pending, the descriptors that are not used by the command buffers that are pending
+     * execution can be written
+     * (3) Partially bound, the slots that are not written to are never accessed, so they need not be valid
+     * (4) Variable descriptor count, the size of the run time array in the shader is set when the set is allocated
+     *
+     * Note that, a slot that may be in use by a frame in flight is never written to. A texture whose image is replaced
+     * is written to a new slot instead, and its old slot is retired until every frame in flight has been waited on
+     *
+     * Slot 0 is reserved for the default diffuse texture, the shaders shade faces that sample from it with its color
+     * instead of sampling it (see defaultShader.frag). It is written once, and is never retired or handed out to another
+     * texture
+    */
+    class VKTextureTable: protected virtual VKImageMgr,
+                          protected virtual VKDescriptor {
+        private:
+            struct RetiredSlotInfo {
+                uint32_t slot;
+                /* Frames in flight that may still be using the slot
+                */
+                std::vector <bool> framesPending;
+            };
+
+            const static uint32_t m_defaultTextureSlot = 0;
+
+            struct TextureTableInfo {
+                struct Meta {
+                    uint32_t sceneInfoId;
+                    uint32_t capacity;
+                    uint32_t defaultTextureId;
+                    /* Slots below this have been handed out at least once
+                    */
+                    uint32_t nextSlot;
+                } meta;
+
+                struct Resource {
+                    VkDescriptorPool descriptorPool;
+                    VkDescriptorSet descriptorSet;
+                } resource;
+
+                struct Stats {
+                    uint32_t writesCount;
+                    uint32_t retiredCount;
+                } stats;
+                /* Slot that each texture id is mapped to (UINT32_MAX if none), and whether the slot is owned by the
+                 * texture id or is shared with the texture that it is aliased to
+                */
+                std::vector <uint32_t> textureSlots;
+                std::vector <bool> ownedSlots;
+                std::vector <uint32_t> freeSlots;
+                std::vector <RetiredSlotInfo> retiredSlots;
+            } m_textureTableInfo;
+
+            Log::Record* m_VKTextureTableLog;
+            const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
+
+            void readyTextureSlot (uint32_t textureId) {
+                auto& info = m_textureTableInfo;
+                if (textureId >= info.textureSlots.size()) {
+                    info.textureSlots.resize (textureId + 1, UINT32_MAX);
+                    info.ownedSlots.resize   (textureId + 1, false);
+                }
+            }
+
+            /* The slot is returned to the free slots once no frame in flight can be using it anymore
+            */
+            void retireTextureSlot (uint32_t textureId) {
+                auto& info = m_textureTableInfo;
+                if (info.textureSlots[textureId] == UINT32_MAX || !info.ownedSlots[textureId] ||
+                    info.textureSlots[textureId] == m_defaultTextureSlot)
+                    return;
+
+                RetiredSlotInfo retiredSlot;
+                retiredSlot.slot = info.textureSlots[textureId];
+                retiredSlot.framesPending.assign (g_coreSettings.maxFramesInFlight, true);
+                info.retiredSlots.push_back (retiredSlot);
+                info.stats.retiredCount++;
+            }
+
+        public:
+            VKTextureTable (void) {
+                m_VKTextureTableLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+            }
+
+            ~VKTextureTable (void) {
+                LOG_CLOSE (m_instanceId);
+            }
+
+        protected:
+            /* The number of slots in the table, which is also the descriptor count of its binding in the descriptor set
+             * layout. This is clamped to the device's limits on update after bind sampled images
+            */
+            uint32_t getTextureTableCapacity (uint32_t deviceInfoId) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                return std::min (g_textureTableSettings.maxTexturesCount,
+                                 deviceInfo->params.maxUpdateAfterBindSampledImages);
+            }
+
+            void createTextureTable (uint32_t deviceInfoId,
+                                     uint32_t pipelineInfoId,
+                                     uint32_t sceneInfoId,
+                                     uint32_t descriptorSetLayoutId,
+                                     uint32_t capacity,
+                                     uint32_t defaultTextureId) {
+
+                auto deviceInfo   = getDeviceInfo   (deviceInfoId);
+                auto pipelineInfo = getPipelineInfo (pipelineInfoId);
+                auto& info        = m_textureTableInfo;
+                /* The descriptor pool that the table is allocated from needs to have the update after bind flag set
+                */
+                auto poolSizes = std::vector {
+                    getPoolSize (VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, capacity)
+                };
+                VkDescriptorPoolCreateInfo poolCreateInfo;
+                poolCreateInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+                poolCreateInfo.pNext         = VK_NULL_HANDLE;
+                poolCreateInfo.flags         = g_textureTableSettings.poolCreateFlags;
+                poolCreateInfo.poolSizeCount = static_cast <uint32_t> (poolSizes.size());
+                poolCreateInfo.pPoolSizes    = poolSizes.data();
+                poolCreateInfo.maxSets       = 1;
+
+                VkDescriptorPool descriptorPool;
+                VkResult result = vkCreateDescriptorPool (deviceInfo->resource.logDevice,
+                                                          &poolCreateInfo,
+                                                          VK_NULL_HANDLE,
+                                                          &descriptorPool);
+                if (result != VK_SUCCESS) {
+                    LOG_ERROR (m_VKTextureTableLog) << "Failed to create texture table descriptor pool "
+                                                    << "[" << sceneInfoId << "]"
+                                                    << " "
+                                                    << "[" << string_VkResult (result) << "]"
+                                                    << std::endl;
+                    throw std::runtime_error ("Failed to create texture table descriptor pool");
+                }
+                /* The actual size of the run time array is given at allocation, for the binding that has the variable
+                 * descriptor count flag set (which must be the last binding in the layout)
+                */
+                VkDescriptorSetVariableDescriptorCountAllocateInfo variableCountInfo;
+                variableCountInfo.sType              =
+                                        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO;
+                variableCountInfo.pNext              = VK_NULL_HANDLE;
+                variableCountInfo.descriptorSetCount = 1;
+                variableCountInfo.pDescriptorCounts  = &capacity;
+
+                VkDescriptorSetAllocateInfo allocInfo;
+                allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+                allocInfo.pNext              = &variableCountInfo;
+                allocInfo.descriptorPool     = descriptorPool;
+                allocInfo.descriptorSetCount = 1;
+                allocInfo.pSetLayouts        = &pipelineInfo->resource.descriptorSetLayouts[descriptorSetLayoutId];
+
+                VkDescriptorSet descriptorSet;
+                result = vkAllocateDescriptorSets (deviceInfo->resource.logDevice, &allocInfo, &descriptorSet);
+                if (result != VK_SUCCESS) {
+                    LOG_ERROR (m_VKTextureTableLog) << "Failed to allocate texture table descriptor set "
+                                                    << "[" << sceneInfoId << "]"
+                                                    << " "
+                                                    << "[" << capacity << "]"
+                                                    << " "
+                                                    << "[" << string_VkResult (result) << "]"
+                                                    << std::endl;
+                    throw std::runtime_error ("Failed to allocate texture table descriptor set");
+                }
+
+                info                         = {};
+                info.meta.sceneInfoId        = sceneInfoId;
+                info.meta.capacity           = capacity;
+                info.meta.defaultTextureId   = defaultTextureId;
+                info.meta.nextSlot           = m_defaultTextureSlot + 1;
+                info.resource.descriptorPool = descriptorPool;
+                info.resource.descriptorSet  = descriptorSet;
+            }
+
+            VkDescriptorSet getTextureTableDescriptorSet (void) {
+                return m_textureTableInfo.resource.descriptorSet;
+            }
+
+            /* Write the image held by the image info id to a free slot, and map the texture id to it. The slot that the
+             * texture id was mapped to before (if it owned one) is retired. The default diffuse texture is always written
+             * to the reserved slot
+            */
+            void writeTextureTableEntry (uint32_t deviceInfoId, uint32_t textureId, uint32_t imageInfoId) {
+                auto sceneInfo = getSceneInfo (m_textureTableInfo.meta.sceneInfoId);
+                auto imageInfo = getImageInfo (imageInfoId, TEXTURE_IMAGE);
+                auto& info     = m_textureTableInfo;
+
+                uint32_t slot;
+                if (textureId == info.meta.defaultTextureId) {
+                    /* The reserved slot may be in use by a frame in flight once it has been written
+                    */
+                    if (textureId < info.textureSlots.size() && info.textureSlots[textureId] != UINT32_MAX) {
+                        LOG_ERROR (m_VKTextureTableLog) << "Default texture slot already written "
+                                                        << "[" << textureId << "]"
+                                                        << " "
+                                                        << "[" << m_defaultTextureSlot << "]"
+                                                        << std::endl;
+                        throw std::runtime_error ("Default texture slot already written");
+                    }
+                    slot = m_defaultTextureSlot;
+                }
+                else if (!info.freeSlots.empty()) {
+                    slot = info.freeSlots.back();
+                    info.freeSlots.pop_back();
+                }
+                else if (info.meta.nextSlot < info.meta.capacity)
+                    slot = info.meta.nextSlot++;
+                else {
+                    LOG_ERROR (m_VKTextureTableLog) << "Texture table is full "
+                                                    << "[" << textureId << "]"
+                                                    << " "
+                                                    << "[" << info.meta.capacity << "]"
+                                                    << std::endl;
+                    throw std::runtime_error ("Texture table is full");
+                }
+
+                auto descriptorImageInfos = std::vector {
+                    getDescriptorImageInfo (sceneInfo->resource.textureSampler,
+                                            imageInfo->resource.imageView,
+                                            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+                };
+                auto writeDescriptorSets  = std::vector {
+                    getWriteImageDescriptorSetInfo (VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                                    info.resource.descriptorSet,
+                                                    descriptorImageInfos,
+                                                    0, slot, 1)
+                };
+                updateDescriptorSets (deviceInfoId, writeDescriptorSets);
+
+                readyTextureSlot  (textureId);
+                retireTextureSlot (textureId);
+                info.textureSlots[textureId] = slot;
+                info.ownedSlots[textureId]   = true;
+                info.stats.writesCount++;
+            }
+
+            /* Map the texture id to the slot of another texture id, without writing a descriptor. For example, to have
+             * a texture that is yet to be loaded sample the placeholder texture in its place
+            */
+            void aliasTextureTableEntry (uint32_t textureId, uint32_t aliasTextureId) {
+                auto& info = m_textureTableInfo;
+                readyTextureSlot  (textureId);
+                readyTextureSlot  (aliasTextureId);
+                retireTextureSlot (textureId);
+                info.textureSlots[textureId] = info.textureSlots[aliasTextureId];
+                info.ownedSlots[textureId]   = false;
+            }
+
+            void removeTextureTableEntry (uint32_t textureId) {
+                auto& info = m_textureTableInfo;
+                readyTextureSlot  (textureId);
+                retireTextureSlot (textureId);
+                info.textureSlots[textureId] = UINT32_MAX;
+                info.ownedSlots[textureId]   = false;
+            }
+
+            /* Texture ids that are not mapped to a slot fall back to the reserved slot of the default diffuse texture
+            */
+            uint32_t getTextureTableSlot (uint32_t textureId) {
+                auto& info = m_textureTableInfo;
+                if (textureId >= info.textureSlots.size() || info.textureSlots[textureId] == UINT32_MAX)
+                    return m_defaultTextureSlot;
+                return info.textureSlots[textureId];
+            }
+
+            /* Called once every frame, after the frame's fence has been waited on. The slots that are not pending on
+             * any frame in flight anymore are free to be written to again
+            */
+            void updateTextureTable (uint32_t currentFrameInFlight) {
+                auto& info = m_textureTableInfo;
+                std::erase_if (info.retiredSlots, [&] (RetiredSlotInfo& retiredSlot) {
+                    retiredSlot.framesPending[currentFrameInFlight] = false;
+                    if (std::find (retiredSlot.framesPending.begin(),
+                                   retiredSlot.framesPending.end(), true) != retiredSlot.framesPending.end())
+                        return false;
+
+                    info.freeSlots.push_back (retiredSlot.slot);
+                    return true;
+                });
+            }
+
+            void dumpTextureTableStats (void) {
+                auto& info = m_textureTableInfo;
+                LOG_INFO (m_VKTextureTableLog) << "Dumping texture table stats"
+                                               << std::endl;
+
+                LOG_INFO (m_VKTextureTableLog) << "Capacity "
+                                               << "[" << info.meta.capacity << "]"
+                                               << std::endl;
+
+                LOG_INFO (m_VKTextureTableLog) << "Slots used "
+                                               << "[" << info.meta.nextSlot - info.freeSlots.size() << "]"
+                                               << "->"
+                                               << "[" << info.meta.nextSlot << "]"
+                                               << std::endl;
+
+                LOG_INFO (m_VKTextureTableLog) << "Writes count "
+                                               << "[" << info.stats.writesCount << "]"
+                                               << std::endl;
+
+                LOG_INFO (m_VKTextureTableLog) << "Retired count "
+                                               << "[" << info.stats.retiredCount << "]"
+                                               << std::endl;
+            }
+
+            void cleanUpTextureTable (uint32_t deviceInfoId) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                /* The descriptor set is freed along with the pool
+                */
+                vkDestroyDescriptorPool (deviceInfo->resource.logDevice,
+                                         m_textureTableInfo.resource.descriptorPool,
+                                         VK_NULL_HANDLE);
+                m_textureTableInfo.resource.descriptorPool = VK_NULL_HANDLE;
+                m_textureTableInfo.resource.descriptorSet  = VK_NULL_HANDLE;
+            }
+    };
+}   // namespace Core
+#endif  // VK_TEXTURE_TABLE_H
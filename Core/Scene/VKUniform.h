@@ -108,5 +108,12 @@ namespace Core {
         glm::mat4 viewMatrix;
         alignas (16) glm::mat4 projectionMatrix;  
     };
+    /* Specialization constants are not subject to the above layout rules, each constant is read from the offset given 
+     * in its map entry. Note that, a bool constant is read as a 32 bit value
+    */
+    struct DefaultShaderFragSC {
+        uint32_t enableTextureSampling;
+        glm::vec4 defaultColor;
+    };
 }   // namespace Core
 #endif  // VK_UNIFORM_H
\ No newline at end of file
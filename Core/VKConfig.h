@@ -9,6 +9,27 @@ namespace Core {
     #define ENABLE_LOGGING                                           (true)
     #define ENABLE_AUTO_PICK_QUEUE_FAMILY_INDICES                    (true)
     #define ENABLE_PARSED_INSTANCE_DATA_DUMP                         (true)
+    #define ENABLE_HEADLESS_MODE                                     (false)
+    #define ENABLE_BENCHMARK_MODE                                    (false)
+    #define ENABLE_FRAME_ALLOCATION_CHECK                            (false)
+    #define ENABLE_GEOMETRY_RELEASE_AFTER_UPLOAD                     (false)
+    #define ENABLE_HOST_MIP_GENERATION                               (false)
+    #define ENABLE_TEXTURE_STREAMING                                 (false)
+    #define ENABLE_PROGRESSIVE_STARTUP                               (false)
+    #define ENABLE_QUEUE_FAMILY_OWNERSHIP_TRANSFER                   (false)
+    #define ENABLE_ASYNC_PIPELINE_COMPILATION                        (false)
+    /* Log levels that are compiled in, and the per module level masks (see Collections/Log/Log.h). The log statements
+     * of the other levels compile to nothing, for example, use (Log::ERROR) for production builds. Note that, these
+     * need to be defined before the log header is first included
+    */
+    #define LOG_COMPILED_LEVELS                                      (Log::INFO | Log::WARNING | Log::ERROR)
+    #define LOG_MODULE_LEVELS
+    /* Write a shared log file per logging thread, instead of one per log save dir (see Collections/Log/SharedSink.h)
+    */
+    #define LOG_SHARED_FILE_PER_THREAD                               (false)
+    /* Size (in bytes) of the ring in each flight recorder file (see Collections/Log/FlightRecorder.h)
+    */
+    #define LOG_FLIGHT_RECORDER_SIZE                                 (64 * 1024)
 
     struct CollectionsSettings {
         /* Collections instance id range assignments
@@ -25,6 +46,37 @@ namespace Core {
         const char* title                                            = "WINDOW_";
     } g_windowSettings;
 
+    struct HeadlessSettings {
+        /* Note that, the below settings are used only if the macro that enables headless mode is enabled. In headless 
+         * mode, there is no window or surface to present to, instead we render into a set of offscreen images that are 
+         * sized using the window settings
+        */
+        const uint32_t offScreenImageCount                           = 3;
+        const VkFormat offScreenImageFormat                          = VK_FORMAT_R8G8B8A8_SRGB;
+        /* Number of frames to render before exiting the event loop, frames are submitted back to back without any 
+         * pacing
+        */
+        const uint32_t framesCount                                   = 1000;
+        /* Frames are copied to host visible buffers and saved to disk as a PPM sequence once the frame in flight 
+         * fence has been signaled, so that the read back never stalls the frame being recorded. Save every n-th frame
+         * by setting the interval
+        */
+        const bool enableReadBack                                    = false;
+        const uint32_t readBackInterval                              = 1;
+        const char* readBackSaveDirPath                              = "Build/Frame/";
+    } g_headlessSettings;
+
+    struct MemoryAllocatorSettings {
+        /* Device memory is allocated in blocks of the below size per memory type, and resources are sub allocated from
+         * them. Note that, the block size and the min allocation size are required to be powers of two
+        */
+        const VkDeviceSize blockSize                                 = 64 * 1024 * 1024;
+        const VkDeviceSize minAllocationSize                         = 256;
+        /* Resources at least this large are given a dedicated allocation instead of being sub allocated
+        */
+        const VkDeviceSize dedicatedAllocationSize                   = 16 * 1024 * 1024;
+    } g_memoryAllocatorSettings;
+
     struct QueueSettings {
         /* Note that, the below indices are used only if the macro that allows manual picking of queue indices is enabled
         */
@@ -42,6 +94,11 @@ namespace Core {
         struct ShaderStage {
             const char* vertexShaderBinaryPath                       = "Build/Bin/defaultShaderVert.spv";
             const char* fragmentShaderBinaryPath                     = "Build/Bin/defaultShaderFrag.spv";
+            /* Specialization constant of the default fragment shader. Faces that map to the default diffuse texture are
+             * shaded with its linear color (worked out from the texture at init) without sampling it. Disable texture
+             * sampling to build a variant of the pipeline that shades all faces with that color
+            */
+            const bool enableTextureSampling                         = true;
         } shaderStage;
         
         struct Rasterization {
@@ -77,10 +134,17 @@ namespace Core {
 
         struct DescriptorSetLayout {
             const VkDescriptorBindingFlags bindingFlagsSSBO          = 0;
-            const VkDescriptorBindingFlags bindingFlagsCIS           = 0;
             const VkDescriptorSetLayoutCreateFlags layoutCreateFlags = 0;
         } descriptorSetLayout;
 
+        struct PipelineCache {
+            /* The pipeline cache is written to the below file on shut down and is used to preinitialize the pipeline
+             * cache on the next run. Disable loading from file to measure pipeline create times with a cold cache
+            */
+            const bool loadFromFile                                  = true;
+            const char* cacheFilePath                                = "Build/Bin/pipeline.cache";
+        } pipelineCache;
+
         /* The allow derivative flag specifies that the pipeline to be created is allowed to be the parent of a pipeline
          * that will be created in a subsequent pipeline creation call. Pipeline derivatives can be used for pipelines 
          * that share most of their state, depending on the implementation this may result in better performance for 
@@ -104,8 +168,54 @@ namespace Core {
         const float maxLod                                           = 13.0f;
     } g_textureSamplerSettings;
 
+    struct TextureStreamSettings {
+        /* Note that, the below settings are used only if the macro that enables texture streaming is enabled. Only the
+         * textures loaded from block compressed containers are streamed, since their mip levels can be read from disk
+         * one at a time. At init, such textures are created with only the mip levels that are at most the below size
+         * on either side, the larger levels are streamed in once the textures are seen up close
+        */
+        const uint32_t initialResidentDimension                      = 128;
+        /* Upper limit on the device memory taken up by the streamed textures, when a texture that needs more detail 
+         * does not fit, the least recently used textures that hold more detail than they need are evicted first
+        */
+        const VkDeviceSize memoryBudget                              = 128 * 1024 * 1024;
+        /* Size in bytes of the host visible staging buffer that streamed mip levels are read in to, a batch of 
+         * streamed textures has to fit in it as a whole
+        */
+        const VkDeviceSize stagingBufferSize                         = 32 * 1024 * 1024;
+        const uint32_t maxTexturesPerBatch                           = 4;
+        /* Bias added to the mip level that a texture is required at, a positive bias trades detail for memory
+        */
+        const float mipLevelBias                                     = 0.0f;
+    } g_textureStreamSettings;
+
+    struct TextureTableSettings {
+        /* Upper limit on the number of textures that can be in the texture table at once, this is clamped to the 
+         * device's limits. Note that, a texture whose image is replaced holds on to two slots until its old slot is
+         * retired
+        */
+        const uint32_t maxTexturesCount                              = 4096;
+        const VkDescriptorBindingFlags bindingFlags                  = 
+                                                          VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT           |
+                                                          VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
+                                                          VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT             |
+                                                          VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT;
+        const VkDescriptorSetLayoutCreateFlags layoutCreateFlags     = 
+                                                          VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+        const VkDescriptorPoolCreateFlags poolCreateFlags            = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    } g_textureTableSettings;
+
     struct DescriptorSettings {
         const VkDescriptorPoolCreateFlags poolCreateFlags            = 0;
+        /* Id of the descriptor pool class that holds the sets that live as long as the scene
+        */
+        const uint32_t scenePoolClassId                              = 0;
+        /* Number of descriptor sets that the first pool of a descriptor pool class is sized for. Each pool that the 
+         * class grows by afterwards is larger by the growth factor, up to the upper limit below
+        */
+        const uint32_t initialSetsPerPool                            = 8;
+        const uint32_t maxSetsPerPool                                = 4096;
+        const float poolGrowthFactor                                 = 2.0f;
     } g_descriptorSettings;
 
     struct CoreSettings {
@@ -128,6 +238,23 @@ namespace Core {
          * the swap chain yet 
         */
         const uint32_t maxFramesInFlight                             = 2;
+        /* Size in bytes of the bump allocator arena that each frame in flight uses for its short lived arrays, this 
+         * needs to hold at least the combined instance data of the scene
+        */
+        const size_t frameArenaSize                                  = 4 * 1024 * 1024;
+        /* Size in bytes of the host visible staging buffer that all uploads made during initialization are packed in
+         * to. Note that, every texture image has to fit in the staging buffer on its own, larger buffer uploads are
+         * split up
+        */
+        const VkDeviceSize stagingBufferSize                         = 64 * 1024 * 1024;
+        /* Number of worker threads that texture images are decoded (and their mip chains generated, if enabled) on
+         * during initialization, or after the first frame if progressive startup is enabled
+        */
+        const uint32_t textureDecodeWorkersCount                     = 4;
+        /* Max number of texture images that are decoded and uploaded together after the first frame, if progressive 
+         * startup is enabled. Until a texture image has been loaded, the default diffuse texture is sampled in its place
+        */
+        const uint32_t textureLoadBatchSize                          = 8;
         const char* defaultDiffuseTexturePath                        = "Assets/Texture/tex_16x16_empty.png";
     } g_coreSettings;
 }   // namespace Core
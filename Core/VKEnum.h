@@ -7,17 +7,18 @@ namespace Core {
         SWAPCHAIN_IMAGE     = 1,
         TEXTURE_IMAGE       = 2,
         DEPTH_IMAGE         = 3,
-        MULTISAMPLE_IMAGE   = 4
+        MULTISAMPLE_IMAGE   = 4,
+        OFFSCREEN_IMAGE     = 5
     } e_imageType;
 
     typedef enum {
         VOID_BUFFER         = 0,
         STAGING_BUFFER      = 1,
-        STAGING_BUFFER_TEX  = 2,
-        VERTEX_BUFFER       = 3,
-        INDEX_BUFFER        = 4,
-        UNIFORM_BUFFER      = 5,
-        STORAGE_BUFFER      = 6
+        VERTEX_BUFFER       = 2,
+        INDEX_BUFFER        = 3,
+        UNIFORM_BUFFER      = 4,
+        STORAGE_BUFFER      = 5,
+        READBACK_BUFFER     = 6
     } e_bufferType;
 
     typedef enum {
@@ -25,7 +26,8 @@ namespace Core {
         FEN_BLIT_DONE       = 1,
         FEN_IN_FLIGHT       = 2,
         SEM_IMAGE_AVAILABLE = 3,
-        SEM_RENDER_DONE     = 4
+        SEM_RENDER_DONE     = 4,
+        SEM_TRANSFER_DONE   = 5
     } e_syncType;
 }   // namespace Core
 #endif  // VK_ENUM_H
\ No newline at end of file
@@ -19,6 +19,9 @@ namespace SandBox {
     struct GridSettings {
         const char* vertexShaderBinaryPath   = "Build/Bin/gridShaderVert.spv";
         const char* fragmentShaderBinaryPath = "Build/Bin/gridShaderFrag.spv";
+        /* Distance between the grid lines is 1/scale
+        */
+        const float scale                    = 1.0f;
     } g_gridSettings;
 
     struct CameraSettings {
@@ -82,6 +85,40 @@ namespace SandBox {
         {LEFT_PROFILE,  {{-2.0f,  0.0f,   0.0f},    {0.0f,  0.0f,  0.0f},       80.0f}}
     };
 
+    struct BenchmarkSettings {
+        /* Note that, the below settings are used only if the macro that enables benchmark mode is enabled. Frames are
+         * rendered using a fixed time step (instead of wall clock time) and the camera follows a scripted path, so that
+         * every run renders the exact same sequence of frames. Samples from the warm up frames are discarded
+        */
+        const uint32_t warmUpFramesCount     = 120;
+        const uint32_t framesCount           = 3000;
+        const float fixedTimeStep            = 1.0f/60.0f;
+        const char* reportSaveFilePath       = "Build/Report/benchmark.json";
+    } g_benchmarkSettings;
+
+    struct BenchmarkKeyFrameInfo {
+        e_cameraType type;
+        /* Time in seconds the camera spends on this key frame before moving on to the next one. The path loops back to
+         * the first key frame once the last key frame has elapsed
+        */
+        float duration;
+        /* Camera state is used only for free roam key frames, the camera moves linearly towards the state of the next
+         * key frame if it is also a free roam key frame. Key frames of all other types use the camera state info pool
+        */
+        CameraStateInfo state;
+    };
+
+    std::vector <BenchmarkKeyFrameInfo> g_benchmarkCameraPath = {
+        {SPOILER,       5.0f, {{ 0.0f,  0.0f,   0.0f},  {0.0f,  0.0f,  0.0f},   0.0f}},
+        {FPV,           5.0f, {{ 0.0f,  0.0f,   0.0f},  {0.0f,  0.0f,  0.0f},   0.0f}},
+        {TOP_DOWN,      5.0f, {{ 0.0f,  0.0f,   0.0f},  {0.0f,  0.0f,  0.0f},   0.0f}},
+        {RIGHT_PROFILE, 5.0f, {{ 0.0f,  0.0f,   0.0f},  {0.0f,  0.0f,  0.0f},   0.0f}},
+        {LEFT_PROFILE,  5.0f, {{ 0.0f,  0.0f,   0.0f},  {0.0f,  0.0f,  0.0f},   0.0f}},
+        {FREE_ROAM,     5.0f, {{ 0.0f, -4.0f, -10.0f},  {0.0f,  0.3f,  1.0f},  60.0f}},
+        {FREE_ROAM,     5.0f, {{10.0f, -4.0f,   0.0f},  {-1.0f, 0.3f,  0.0f},  60.0f}},
+        {FREE_ROAM,     5.0f, {{ 0.0f, -4.0f,  10.0f},  {0.0f,  0.3f, -1.0f},  80.0f}}
+    };
+
     struct CoreSettings {
         struct KeyMap {
             const int exitWindow             = 256; /* ESC key */
@@ -0,0 +1,180 @@
+#ifndef EN_BENCHMARK_CONTROL_H
+#define EN_BENCHMARK_CONTROL_H
+
+#include <nlohmann/json.hpp>
+#include "../../Core/Model/VKModelMgr.h"
+#include "../../Core/Scene/VKCameraMgr.h"
+#include "../Config/ENEnvConfig.h"
+
+namespace SandBox {
+    class ENBenchmarkControl: protected virtual Core::VKModelMgr,
+                              protected virtual Core::VKCameraMgr {
+        private:
+            uint32_t m_cameraInfoId;
+
+            struct FrameSampleInfo {
+                std::vector <float> cpuFrameTimesMs;
+                std::vector <float> fenceWaitTimesMs;
+                std::vector <float> gpuTimesMs;
+            } m_frameSampleInfo;
+
+            Log::Record* m_ENBenchmarkControlLog;
+            const uint32_t m_instanceId = g_collectionsSettings.instanceId++;
+
+            /* Returns the key frame id that is active at the specified time along the camera path, and the time that
+             * has elapsed since the start of that key frame
+            */
+            uint32_t getKeyFrameId (float elapsedTime, float& keyFrameElapsedTime) {
+                float pathDuration = 0.0f;
+                for (auto const& keyFrame: g_benchmarkCameraPath)
+                    pathDuration += keyFrame.duration;
+
+                keyFrameElapsedTime = fmod (elapsedTime, pathDuration);
+                for (uint32_t i = 0; i < g_benchmarkCameraPath.size(); i++) {
+                    if (keyFrameElapsedTime < g_benchmarkCameraPath[i].duration)
+                        return i;
+                    keyFrameElapsedTime -= g_benchmarkCameraPath[i].duration;
+                }
+                /* Floating point error may push us past the last key frame, in which case we stay on it
+                */
+                keyFrameElapsedTime = g_benchmarkCameraPath.back().duration;
+                return static_cast <uint32_t> (g_benchmarkCameraPath.size() - 1);
+            }
+
+            /* Statistics are computed over a sorted copy of the samples, percentiles use the nearest rank method
+            */
+            nlohmann::ordered_json getSampleStats (std::vector <float> samples) {
+                nlohmann::ordered_json stats;
+                stats["count"] = samples.size();
+                if (samples.empty())
+                    return stats;
+
+                std::sort (samples.begin(), samples.end());
+                auto getPercentile = [&](float percentile) {
+                    size_t rank = static_cast <size_t> (ceil (percentile / 100.0f * samples.size()));
+                    return samples[rank == 0 ? 0: rank - 1];
+                };
+
+                float sum = 0.0f;
+                for (auto const& sample: samples)
+                    sum += sample;
+
+                stats["mean"] = sum / samples.size();
+                stats["p50"]  = getPercentile (50.0f);
+                stats["p95"]  = getPercentile (95.0f);
+                stats["p99"]  = getPercentile (99.0f);
+                stats["max"]  = samples.back();
+                return stats;
+            }
+
+        public:
+            ENBenchmarkControl (void) {
+                m_ENBenchmarkControlLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,  Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
+            }
+
+            ~ENBenchmarkControl (void) {
+                LOG_CLOSE (m_instanceId);
+            }
+
+        protected:
+            void readyBenchmarkControl (uint32_t cameraInfoId) {
+                m_cameraInfoId = cameraInfoId;
+
+                if (g_benchmarkCameraPath.empty()) {
+                    LOG_ERROR (m_ENBenchmarkControlLog) << "Benchmark camera path is empty"
+                                                        << std::endl;
+                    throw std::runtime_error ("Benchmark camera path is empty");
+                }
+
+                m_frameSampleInfo.cpuFrameTimesMs.reserve  (g_benchmarkSettings.framesCount);
+                m_frameSampleInfo.fenceWaitTimesMs.reserve (g_benchmarkSettings.framesCount);
+                m_frameSampleInfo.gpuTimesMs.reserve       (g_benchmarkSettings.framesCount);
+            }
+
+            /* Replaces user input driven camera control in benchmark mode, the camera state is a function of only the
+             * elapsed (simulated) time along the camera path
+            */
+            void updateBenchmarkCameraState (uint32_t modelInfoId, uint32_t modelInstanceId, float elapsedTime) {
+                auto modelInfo  = getModelInfo  (modelInfoId);
+                auto cameraInfo = getCameraInfo (m_cameraInfoId);
+
+                if (modelInstanceId >= modelInfo->meta.instancesCount) {
+                    LOG_ERROR (m_ENBenchmarkControlLog) << "Invalid model instance id "
+                                                        << "[" << modelInstanceId << "]"
+                                                        << "->"
+                                                        << "[" << modelInfo->meta.instancesCount << "]"
+                                                        << std::endl;
+                    throw std::runtime_error ("Invalid model instance id");
+                }
+
+                float keyFrameElapsedTime;
+                uint32_t keyFrameId = getKeyFrameId (elapsedTime, keyFrameElapsedTime);
+                auto& keyFrame      = g_benchmarkCameraPath[keyFrameId];
+
+                if (keyFrame.type == FREE_ROAM) {
+                    auto& nextKeyFrame = g_benchmarkCameraPath[(keyFrameId + 1) % g_benchmarkCameraPath.size()];
+                    float t            = 0.0f;
+                    if (nextKeyFrame.type == FREE_ROAM && keyFrame.duration > 0.0f)
+                        t = keyFrameElapsedTime / keyFrame.duration;
+
+                    cameraInfo->meta.position  = glm::mix (keyFrame.state.position,  nextKeyFrame.state.position,  t);
+                    cameraInfo->meta.direction = glm::mix (keyFrame.state.direction, nextKeyFrame.state.direction, t);
+                    cameraInfo->meta.fovDeg    = glm::mix (keyFrame.state.fovDeg,    nextKeyFrame.state.fovDeg,    t);
+                }
+                else {
+                    glm::mat4 modelMatrix      = modelInfo->meta.instances[modelInstanceId].modelMatrix;
+                    cameraInfo->meta.position  = glm::vec3 (modelMatrix *
+                                                 glm::vec4 (g_cameraStateInfoPool[keyFrame.type].position,  1.0f));
+
+                    cameraInfo->meta.direction = glm::vec3 (modelMatrix *
+                                                 glm::vec4 (g_cameraStateInfoPool[keyFrame.type].direction, 1.0f)) -
+                                                 cameraInfo->meta.position;
+
+                    cameraInfo->meta.fovDeg    = g_cameraStateInfoPool[keyFrame.type].fovDeg;
+                }
+
+                cameraInfo->meta.updateViewMatrix       = true;
+                cameraInfo->meta.updateProjectionMatrix = true;
+            }
+
+            /* Note that, a negative gpu time indicates that the timestamp queries were not available for the frame, in
+             * which case only the host side timings are recorded
+            */
+            void addFrameSample (float cpuFrameTimeMs, float fenceWaitTimeMs, float gpuTimeMs) {
+                m_frameSampleInfo.cpuFrameTimesMs.push_back      (cpuFrameTimeMs);
+                m_frameSampleInfo.fenceWaitTimesMs.push_back     (fenceWaitTimeMs);
+                if (gpuTimeMs >= 0.0f)
+                    m_frameSampleInfo.gpuTimesMs.push_back       (gpuTimeMs);
+            }
+
+            void saveBenchmarkReport (const char* reportSaveFilePath) {
+                nlohmann::ordered_json report;
+                report["warmUpFramesCount"] = g_benchmarkSettings.warmUpFramesCount;
+                report["framesCount"]       = g_benchmarkSettings.framesCount;
+                report["fixedTimeStep"]     = g_benchmarkSettings.fixedTimeStep;
+                report["width"]             = Core::g_windowSettings.width;
+                report["height"]            = Core::g_windowSettings.height;
+                report["maxFramesInFlight"] = Core::g_coreSettings.maxFramesInFlight;
+                report["cpuFrameTimeMs"]    = getSampleStats (m_frameSampleInfo.cpuFrameTimesMs);
+                report["fenceWaitTimeMs"]   = getSampleStats (m_frameSampleInfo.fenceWaitTimesMs);
+                report["gpuTimeMs"]         = getSampleStats (m_frameSampleInfo.gpuTimesMs);
+
+                std::ofstream file (reportSaveFilePath);
+                if (!file.is_open()) {
+                    LOG_ERROR (m_ENBenchmarkControlLog) << "Failed to open file "
+                                                        << "[" << reportSaveFilePath << "]"
+                                                        << std::endl;
+                    throw std::runtime_error ("Failed to open file");
+                }
+                file << report.dump (4) << std::endl;
+                file.close();
+
+                LOG_INFO (m_ENBenchmarkControlLog) << "Saved benchmark report "
+                                                   << "[" << reportSaveFilePath << "]"
+                                                   << std::endl;
+            }
+    };
+}   // namespace SandBox
+#endif  // EN_BENCHMARK_CONTROL_H
@@ -29,7 +29,7 @@ namespace SandBox {
         public:
             ENGenericControl (void) {
                 m_ENGenericControlLog = LOG_INIT (m_instanceId, g_collectionsSettings.logSaveDirPath);
-                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_SHARED | Log::TO_CONSOLE);
             }
 
             ~ENGenericControl (void) {
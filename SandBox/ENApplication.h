@@ -6,6 +6,7 @@
 #include "../Core/Scene/VKDeleteSequence.h"
 #include "Control/ENGenericControl.h"
 #include "Control/ENCameraControl.h"
+#include "Control/ENBenchmarkControl.h"
 #include "Config/ENModelConfig.h"
 
 namespace SandBox {
@@ -13,7 +14,8 @@ namespace SandBox {
                          protected Core::VKDrawSequence,
                          protected Core::VKDeleteSequence,
                          protected ENGenericControl,
-                         protected ENCameraControl {
+                         protected ENCameraControl,
+                         protected ENBenchmarkControl {
         private:
             uint32_t m_deviceInfoId;
             std::vector <uint32_t> m_modelInfoIds;
@@ -100,6 +102,9 @@ namespace SandBox {
                 cameraInfo->meta.upVector  = g_cameraSettings.upVector;
                 cameraInfo->meta.nearPlane = g_cameraSettings.nearPlane;
                 cameraInfo->meta.farPlane  = g_cameraSettings.farPlane;
+#if ENABLE_BENCHMARK_MODE
+                readyBenchmarkControl (m_cameraInfoId);
+#endif  // ENABLE_BENCHMARK_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | READY SCENE INFO                                                                               |
                  * |------------------------------------------------------------------------------------------------|
@@ -138,16 +143,15 @@ namespace SandBox {
                 }
                 {
                     /* Add a pipeline derivative. Note that, we are only allowed to either use a handle or index of the 
-                     * base pipeline, as we are using the handle, we must set the index to -1. The create derivative bit
-                     * specifies that the pipeline to be created will be a child of a previously created parent pipeline
+                     * base pipeline, the pipeline registry picks one depending on whether the base pipeline is created
+                     * in the same batch. The create derivative bit specifies that the pipeline to be created will be a 
+                     * child of a previously created parent pipeline
                     */
                     uint32_t gridPipelineInfoId = m_pipelineInfoId + 1;
                     readyPipelineInfo  (gridPipelineInfoId);
                     derivePipelineInfo (gridPipelineInfoId, m_pipelineInfoId);
 
-                    auto deviceInfo       = getDeviceInfo   (m_deviceInfoId);
                     auto gridPipelineInfo = getPipelineInfo (gridPipelineInfoId);
-                    auto basePipelineInfo = getPipelineInfo (m_pipelineInfoId);
 
                     /* Add/edit configs that are missing/different from base pipeline
                     */
@@ -158,17 +162,41 @@ namespace SandBox {
                                                attributeDescriptions);
 
                     gridPipelineInfo->state.stages.clear();
-                    auto vertexShaderModule   = createShaderStage (m_deviceInfoId, 
-                                                                   gridPipelineInfoId,
-                                                                   VK_SHADER_STAGE_VERTEX_BIT, 
-                                                                   g_gridSettings.vertexShaderBinaryPath, 
-                                                                   "main");
+                    createShaderStage         (m_deviceInfoId, 
+                                               gridPipelineInfoId,
+                                               VK_SHADER_STAGE_VERTEX_BIT, 
+                                               g_gridSettings.vertexShaderBinaryPath, 
+                                               "main",
+                                               VK_NULL_HANDLE);
+                    /* The grid scale and the near and far plane values are specialized from the settings, so that the
+                     * grid fades out in line with the camera's projection
+                    */
+                    struct GridShaderFragSC {
+                        float scale;
+                        float nearPlane;
+                        float farPlane;
+                    } fragSpecializationData;
+                    fragSpecializationData.scale     = g_gridSettings.scale;
+                    fragSpecializationData.nearPlane = g_cameraSettings.nearPlane;
+                    fragSpecializationData.farPlane  = g_cameraSettings.farPlane;
+
+                    auto fragMapEntries = std::vector <VkSpecializationMapEntry> {
+                        getSpecializationMapEntry (0, offsetof (GridShaderFragSC, scale),     sizeof (float)),
+                        getSpecializationMapEntry (1, offsetof (GridShaderFragSC, nearPlane), sizeof (float)),
+                        getSpecializationMapEntry (2, offsetof (GridShaderFragSC, farPlane),  sizeof (float))
+                    };
+                    VkSpecializationInfo fragSpecializationInfo;
+                    fragSpecializationInfo.mapEntryCount = static_cast <uint32_t> (fragMapEntries.size());
+                    fragSpecializationInfo.pMapEntries   = fragMapEntries.data();
+                    fragSpecializationInfo.dataSize      = sizeof (GridShaderFragSC);
+                    fragSpecializationInfo.pData         = &fragSpecializationData;
 
-                    auto fragmentShaderModule = createShaderStage (m_deviceInfoId, 
-                                                                   gridPipelineInfoId,
-                                                                   VK_SHADER_STAGE_FRAGMENT_BIT, 
-                                                                   g_gridSettings.fragmentShaderBinaryPath,
-                                                                   "main");
+                    createShaderStage         (m_deviceInfoId, 
+                                               gridPipelineInfoId,
+                                               VK_SHADER_STAGE_FRAGMENT_BIT, 
+                                               g_gridSettings.fragmentShaderBinaryPath,
+                                               "main",
+                                               &fragSpecializationInfo);
 
                     auto layoutBindings = std::vector <VkDescriptorSetLayoutBinding> {};
                     auto bindingFlags   = std::vector <VkDescriptorBindingFlags>     {};
@@ -185,24 +213,26 @@ namespace SandBox {
 
                     createPipelineLayout      (m_deviceInfoId, gridPipelineInfoId);
 
-                    createGraphicsPipeline    (m_deviceInfoId,
-                                               m_renderPassInfoId,
+                    /* The grid pipeline is compiled in the same batch as the base pipeline, and there is no fallback
+                     * for it, so the grid is not drawn until it is ready
+                    */
+                    requestGraphicsPipeline   (m_renderPassInfoId,
                                                gridPipelineInfoId,
-                                               0, -1,
-                                               basePipelineInfo->resource.pipeline, 
+                                               0,
+                                               m_pipelineInfoId,
+                                               UINT32_MAX,
                                                VK_PIPELINE_CREATE_DERIVATIVE_BIT);
-
-                    vkDestroyShaderModule (deviceInfo->resource.logDevice, vertexShaderModule,   VK_NULL_HANDLE);
-                    vkDestroyShaderModule (deviceInfo->resource.logDevice, fragmentShaderModule, VK_NULL_HANDLE);
                 }
                 });
                 /* |------------------------------------------------------------------------------------------------|
                  * | READY CONTROL                                                                                  |
                  * |------------------------------------------------------------------------------------------------|
                 */
+#if !ENABLE_HEADLESS_MODE && !ENABLE_BENCHMARK_MODE
                 auto deviceInfo = getDeviceInfo (m_deviceInfoId);
                 readyGenericControl             (m_deviceInfoId);
                 readyKeyCallBack                (deviceInfo->resource.window);
+#endif  // ENABLE_HEADLESS_MODE && ENABLE_BENCHMARK_MODE
             }
 
             void runScene (void) {
@@ -211,6 +241,24 @@ namespace SandBox {
                  * | EVENT LOOP                                                                                     |
                  * |------------------------------------------------------------------------------------------------|
                 */
+#if ENABLE_BENCHMARK_MODE
+                /* In benchmark mode, user input is ignored and a fixed number of frames are rendered. Note that, if a
+                 * window exists we still need to poll for events to keep it responsive
+                */
+                uint32_t framesCount = g_benchmarkSettings.warmUpFramesCount + g_benchmarkSettings.framesCount;
+                for (uint32_t i = 0; i < framesCount; i++) {
+                    auto frameStartTime = std::chrono::high_resolution_clock::now();
+#if !ENABLE_HEADLESS_MODE
+                    glfwPollEvents();
+                    if (glfwWindowShouldClose (deviceInfo->resource.window))
+                        break;
+#endif  // ENABLE_HEADLESS_MODE
+#elif ENABLE_HEADLESS_MODE
+                /* In headless mode, there is no window to close or input to poll. Instead, we render a fixed number of 
+                 * frames as fast as the device allows and then exit the loop
+                */
+                for (uint32_t i = 0; i < Core::g_headlessSettings.framesCount; i++) {
+#else
                 while (!glfwWindowShouldClose (deviceInfo->resource.window)) {
                     /* GLFW needs to poll the window system for events both to provide input to the application and to 
                      * prove to the window system that the application hasn't locked up. Event processing is normally 
@@ -223,6 +271,7 @@ namespace SandBox {
                      * glfwWaitEvents() is a better choice
                     */
                     glfwPollEvents();
+#endif  // ENABLE_BENCHMARK_MODE
                 /* |------------------------------------------------------------------------------------------------|
                  * | MOTION UPDATE                                                                                  |
                  * |------------------------------------------------------------------------------------------------|
@@ -234,12 +283,23 @@ namespace SandBox {
                     float deltaTime       = std::chrono::duration <float, std::chrono::seconds::period> 
                                             (currentTime - startTime).count();  
 
+#if ENABLE_BENCHMARK_MODE
+                    /* Replace wall clock time with a fixed time step, so that the same frame id always renders the same
+                     * scene state
+                    */
+                    deltaTime = i * g_benchmarkSettings.fixedTimeStep;
+#elif !ENABLE_HEADLESS_MODE
                     handleKeyEvents    (currentTime);
+#endif  // ENABLE_BENCHMARK_MODE
                     /* [ X ] update vehicle state here before camera state so that the model matrix is ready to be
                      * used by camera vectors in the same frame
                     */
                     static_cast <void> (deltaTime);
-#if ENABLE_SAMPLE_MODELS_IMPORT
+#if ENABLE_SAMPLE_MODELS_IMPORT && ENABLE_BENCHMARK_MODE
+                    updateBenchmarkCameraState (SAMPLE_1, 0, deltaTime);
+#elif ENABLE_BENCHMARK_MODE
+                    updateBenchmarkCameraState (VEHICLE_BASE, 0, deltaTime);
+#elif ENABLE_SAMPLE_MODELS_IMPORT
                     updateCameraState  (SAMPLE_1, 0);
 #else
                     updateCameraState  (VEHICLE_BASE, 0);
@@ -260,11 +320,11 @@ namespace SandBox {
                  * | EDIT CONFIGS                                                                                   |
                  * |------------------------------------------------------------------------------------------------|
                 */
-                    {
+                    uint32_t gridPipelineInfoId = getBindablePipelineInfoId (m_pipelineInfoId + 1);
+                    if (gridPipelineInfoId != UINT32_MAX) {
                         auto cameraInfo = getCameraInfo (m_cameraInfoId);
                         auto sceneInfo  = getSceneInfo  (m_sceneInfoId);
                         
-                        uint32_t gridPipelineInfoId = m_pipelineInfoId + 1;
                         bindPipeline        (gridPipelineInfoId,
                                              VK_PIPELINE_BIND_POINT_GRAPHICS,
                                              sceneInfo->resource.commandBuffers[m_currentFrameInFlight]);
@@ -280,6 +340,19 @@ namespace SandBox {
 
                         draw (6, 1, 0, 0, sceneInfo->resource.commandBuffers[m_currentFrameInFlight]);
                     }});
+#if ENABLE_BENCHMARK_MODE
+                /* |------------------------------------------------------------------------------------------------|
+                 * | FRAME SAMPLE                                                                                   |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                    auto frameEndTime    = std::chrono::high_resolution_clock::now();
+                    auto frameTimingInfo = getFrameTimingInfo();
+                    if (i >= g_benchmarkSettings.warmUpFramesCount)
+                        addFrameSample (std::chrono::duration <float, std::chrono::milliseconds::period> 
+                                        (frameEndTime - frameStartTime).count(),
+                                        frameTimingInfo->fenceWaitTimeMs,
+                                        frameTimingInfo->gpuTimeMs);
+#endif  // ENABLE_BENCHMARK_MODE
                 }
                 /* Remember that all of the operations in the above render method are asynchronous. That means that when
                  * we exit the render loop, drawing and presentation operations may still be going on. Cleaning up
@@ -287,11 +360,26 @@ namespace SandBox {
                  * device to finish operations before exiting mainLoop and destroying the window
                 */
                 vkDeviceWaitIdle (deviceInfo->resource.logDevice);
+#if ENABLE_BENCHMARK_MODE
+                /* |------------------------------------------------------------------------------------------------|
+                 * | SAVE BENCHMARK REPORT                                                                          |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                saveBenchmarkReport (g_benchmarkSettings.reportSaveFilePath);
+#endif  // ENABLE_BENCHMARK_MODE
+#if ENABLE_HEADLESS_MODE
+                /* |------------------------------------------------------------------------------------------------|
+                 * | FLUSH READ BACK FRAMES                                                                         |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                flushReadBackFrames (m_deviceInfoId, m_sceneInfoId);
+#else
                 /* |------------------------------------------------------------------------------------------------|
                  * | DESTROY CONTROL                                                                                |
                  * |------------------------------------------------------------------------------------------------|
                 */
                 UserInput::cleanUp (deviceInfo->resource.window);
+#endif  // ENABLE_HEADLESS_MODE
             }
 
             void deleteScene (void) {
@@ -32,8 +32,26 @@ layout (location = 0) out vec4 outColor;
  * run-time sized. A 'run-time sized' array has its size determined by a buffer or descriptor set bound via the API
  *
  * Note that, only the final binding in a descriptor set can have a variable size
+ * 
+ * The texture table is a separate descriptor set from the per frame set that holds the instance data, it is shared by 
+ * all frames in flight and the texture id here is the slot of the texture in the table
+*/
+layout (set = 1, binding = 0) uniform sampler2D texSampler[];
+/* Specialization constants are constants whose values are set when the pipeline is created, the values given here are 
+ * the defaults that are used if they are not specialized. Since the values are known when the pipeline is compiled, the 
+ * branches that depend on them are eliminated
+ *
+ * Faces with no texture map to the default diffuse texture (slot 0 in the texture table, which is reserved for it), 
+ * which has a single color. Such faces are shaded with the default color instead of sampling the texture. If texture 
+ * sampling is disabled, all faces are shaded with the default color. The default color is always specialized with the 
+ * linear color of the default diffuse texture, the value here is only a neutral fallback
 */
-layout (binding = 1) uniform sampler2D texSampler[];
+layout (constant_id = 0) const bool  enableTextureSampling = true;
+layout (constant_id = 1) const float defaultColorR         = 1.0;
+layout (constant_id = 2) const float defaultColorG         = 1.0;
+layout (constant_id = 3) const float defaultColorB         = 1.0;
+layout (constant_id = 4) const float defaultColorA         = 1.0;
+const uint defaultTexSlot                                  = 0;
 
 /* The main function is called for every fragment just like the vertex shader main function is called for every vertex
 */
@@ -50,6 +68,12 @@ void main (void) {
     */
     /* Textures are sampled using the built-in texture function. It takes a sampler and coordinate as arguments. The 
      * sampler automatically takes care of the filtering and transformations in the background
+     *
+     * Note that, the texture id is the same for all fragments of a primitive, so the branch is taken uniformly within
+     * the fragments that are used to compute the derivatives for sampling
     */
-    outColor = texture (texSampler[fragTexId], fragTexCoord);
+    if (!enableTextureSampling || fragTexId == defaultTexSlot)
+        outColor = vec4 (defaultColorR, defaultColorG, defaultColorB, defaultColorA);
+    else
+        outColor = texture (texSampler[nonuniformEXT (fragTexId)], fragTexCoord);
 }
\ No newline at end of file
@@ -14,12 +14,13 @@ layout (push_constant) uniform SceneDataVertPC {
     mat4 projectionMatrix;
 } sceneData;
 
-/* Use the scale variable to set the distance between the grid lines
+/* Use the scale variable to set the distance between the grid lines. The scale and the near and far plane values are
+ * specialization constants, so that they follow the camera settings without having to recompile the shader
 */
-const float scale           = 1.0;
-const float highlightMargin = 1.0;
-const float nearPlane       = 0.01;
-const float farPlane        = 100.0;
+layout (constant_id = 0) const float scale     = 1.0;
+layout (constant_id = 1) const float nearPlane = 0.01;
+layout (constant_id = 2) const float farPlane  = 100.0;
+const float highlightMargin                    = 1.0;
 
 /* To draw lines instead of just a uniform color, compute the 3D position on the actual xz plane using the near point and 
  * far point calculated earlier and use that position to determine if the point is actually on a line or on the void of 
@@ -97,7 +98,8 @@ void main (void) {
     float linearDepth = computeLinearDepth (fragPosition);
     float fading      = max (0, (0.5 - linearDepth));
 
-    outColor          = (grid (fragPosition, scale, true)  +
-                         grid (fragPosition, scale, true)) * float (t > 0);
+    /* The grid is evaluated once and doubled, which is the same as adding up two evaluations with identical arguments
+    */
+    outColor          = 2.0 * grid (fragPosition, scale, true) * float (t > 0);
     outColor.a       *= fading; 
 }
\ No newline at end of file
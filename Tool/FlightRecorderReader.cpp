@@ -0,0 +1,122 @@
+/* Recovers the lines held in a flight recorder (.ring) file written by the TO_FILE_FLIGHT_RECORDER sink, including the
+ * file of a process that was killed or crashed. The lines are written out oldest first, one per line
+ *
+ * Usage
+ * FlightRecorderReader_exe <input .ring> [output .txt]
+ *
+ * The output is written next to the input (same file name, .txt extension) if an output path is not given
+*/
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <cstddef>
+#include <unordered_map>
+#include "../Collections/Log/FlightRecorder.h"
+
+using namespace Collections;
+
+namespace Tool {
+    /* Reads from the ring at the given (unwrapped) offset, splitting the read if it runs past the end
+    */
+    void copyFromRing (const std::string& ring, uint64_t offset, void* data, size_t size) {
+        size_t start     = static_cast <size_t> (offset % ring.size());
+        size_t firstSize = std::min (size, ring.size() - start);
+        std::memcpy (data, ring.data() + start, firstSize);
+        if (firstSize < size)
+            std::memcpy (static_cast <uint8_t*> (data) + firstSize, ring.data(), size - firstSize);
+    }
+
+    /* Walks the ring backwards from the head using the trailing lengths, and stops at the first entry that has been
+     * (partly) overwritten or whose lengths do not agree. Returns the lines oldest first
+    */
+    std::vector <std::string> recoverLines (const std::string& ring, uint64_t head) {
+        std::vector <std::string> lines;
+        uint64_t capacity = ring.size();
+        uint64_t tail     = head > capacity ? head - capacity: 0;
+        uint64_t offset   = head;
+
+        while (offset - tail >= 2 * sizeof (uint32_t)) {
+            uint32_t trailingLength;
+            copyFromRing (ring, offset - sizeof (uint32_t), &trailingLength, sizeof (trailingLength));
+
+            uint64_t entrySize = 2 * sizeof (uint32_t) + static_cast <uint64_t> (trailingLength);
+            if (entrySize > offset - tail)
+                break;
+
+            uint64_t entryStart = offset - entrySize;
+            uint32_t leadingLength;
+            copyFromRing (ring, entryStart, &leadingLength, sizeof (leadingLength));
+            if (leadingLength != trailingLength)
+                break;
+
+            std::string line (trailingLength, '\0');
+            copyFromRing (ring, entryStart + sizeof (uint32_t), line.data(), trailingLength);
+            lines.push_back (std::move (line));
+            offset = entryStart;
+        }
+        return std::vector <std::string> (lines.rbegin(), lines.rend());
+    }
+}   // namespace Tool
+
+int main (int argc, char* argv[]) {
+    using namespace Tool;
+    if (argc < 2) {
+        std::cerr << "Usage: FlightRecorderReader_exe <input .ring> [output .txt]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string inputPath  = argv[1];
+    std::string outputPath = argc > 2 ? argv[2]: inputPath.substr (0, inputPath.find_last_of ('.')) + ".txt";
+
+    std::ifstream inputFile (inputPath, std::ios_base::in | std::ios_base::binary);
+    if (!inputFile.is_open()) {
+        std::cerr << "Failed to open input file " << "[" << inputPath << "]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::stringstream contents;
+    contents << inputFile.rdbuf();
+    std::string bytes = contents.str();
+    /* The header is read field by field, since it holds atomics in the writer
+    */
+    char magic[4];
+    uint32_t version;
+    uint64_t capacity, head, entriesCount;
+    if (bytes.size() < Log::g_flightRecorderDataOffset) {
+        std::cerr << "Truncated flight recorder " << "[" << inputPath << "]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::memcpy (magic,         bytes.data() + offsetof (Log::FlightRecorderHeader, magic),        sizeof (magic));
+    std::memcpy (&version,      bytes.data() + offsetof (Log::FlightRecorderHeader, version),      sizeof (version));
+    std::memcpy (&capacity,     bytes.data() + offsetof (Log::FlightRecorderHeader, capacity),     sizeof (capacity));
+    std::memcpy (&head,         bytes.data() + offsetof (Log::FlightRecorderHeader, head),         sizeof (head));
+    std::memcpy (&entriesCount, bytes.data() + offsetof (Log::FlightRecorderHeader, entriesCount), sizeof (entriesCount));
+
+    if (std::memcmp (magic, Log::g_flightRecorderMagic, sizeof (magic)) != 0 ||
+        version != Log::g_flightRecorderVersion                              ||
+        bytes.size() < Log::g_flightRecorderDataOffset + capacity            ||
+        capacity == 0) {
+        std::cerr << "Invalid flight recorder " << "[" << inputPath << "]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string ring = bytes.substr (Log::g_flightRecorderDataOffset, capacity);
+    auto lines       = recoverLines (ring, head);
+
+    std::ofstream outputFile (outputPath, std::ios_base::out);
+    if (!outputFile.is_open()) {
+        std::cerr << "Failed to open output file " << "[" << outputPath << "]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    for (auto const& line: lines)
+        outputFile << line << "\n";
+
+    std::cout << "[" << inputPath << "]"
+              << " -> "
+              << "[" << outputPath << "]"
+              << " "
+              << "[" << lines.size() << "/" << entriesCount << " entries recovered]"
+              << std::endl;
+    return EXIT_SUCCESS;
+}
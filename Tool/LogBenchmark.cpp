@@ -0,0 +1,142 @@
+/* Measures the logging throughput (in lines per second) of the file sinks, by logging the same lines through each sink
+ * from a single thread. Lines resemble the ones logged by the Core classes at init, i.e. a header followed by a few
+ * bracketed values. Note that, the async sink is timed until the last line has been written out to disk, not just
+ * until it has been queued. The binary sink is fed the same values through a binary log statement, and the size of
+ * each file is reported along with the time. Finally, the cost of building a header is measured on its own, for each
+ * timestamp mode
+ *
+ * Usage
+ * LogBenchmark_exe [save dir] [lines count]
+*/
+#include <chrono>
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <filesystem>
+#include <unordered_map>
+#include "../Collections/Log/Log.h"
+
+using namespace Collections;
+
+namespace Tool {
+    struct SinkInfo {
+        const char* name;
+        Log::e_sink sink;
+    };
+
+    /* Files of an instance are named <sink prefix>_<instance id>_<calling file>, so they can be found without knowing the
+     * sink that wrote them
+    */
+    uintmax_t getFilesSize (const std::string& saveDir, uint32_t instanceId, bool removeFiles) {
+        std::string fragment = "_" + std::to_string (instanceId) + "_LogBenchmark";
+        uintmax_t filesSize  = 0;
+        for (auto const& entry: std::filesystem::directory_iterator (saveDir)) {
+            if (entry.path().filename().string().find (fragment) != 1)
+                continue;
+
+            filesSize += entry.file_size();
+            if (removeFiles)
+                std::filesystem::remove (entry.path());
+        }
+        return filesSize;
+    }
+
+    double runBenchmark (uint32_t instanceId, const std::string& saveDir, Log::e_sink sink, uint32_t linesCount) {
+        auto benchmarkLog = LOG_INIT (instanceId, saveDir);
+        LOG_ADD_CONFIG (instanceId, Log::INFO, sink);
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < linesCount; i++) {
+            if (sink & Log::TO_FILE_BINARY) {
+                LOG_BINARY (benchmarkLog, Log::INFO, "Buffer info id [{}] [{}]->[{}]", i, i * 64, 0.5f * i);
+                continue;
+            }
+            LOG_INFO (benchmarkLog) << "Buffer info id "
+                                    << "[" << i << "]"
+                                    << " "
+                                    << "[" << i * 64 << "]"
+                                    << "->"
+                                    << "[" << 0.5f * i << "]"
+                                    << std::endl;
+        }
+        /* Closing the record waits on nothing for the async sink, so the writer is shut down to make sure every line
+         * has reached the file
+        */
+        LOG_CLOSE (instanceId);
+        if (sink & Log::TO_FILE_ASYNC)
+            Log::g_asyncSink.shutdown();
+
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration <double> (stop - start).count();
+    }
+
+    /* Returns the average time (in nanoseconds) taken to build a header, the header sizes are summed up so that the
+     * calls are not optimized away
+    */
+    double runHeaderBenchmark (uint32_t instanceId, Log::e_timestampMode mode, uint32_t headersCount) {
+        auto benchmarkLog = LOG_INIT (instanceId, "");
+        LOG_SET_TIMESTAMP_MODE (instanceId, mode);
+
+        size_t headersSize = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < headersCount; i++)
+            headersSize += benchmarkLog->getHeader (Log::INFO, "runHeaderBenchmark", i, true).size();
+        auto stop  = std::chrono::steady_clock::now();
+
+        LOG_CLOSE (instanceId);
+        if (headersSize == 0)
+            return 0.0;
+        return std::chrono::duration <double, std::nano> (stop - start).count() / headersCount;
+    }
+}   // namespace Tool
+
+int main (int argc, char* argv[]) {
+    using namespace Tool;
+    std::string saveDir = argc > 1 ? argv[1]: "Build/Log/";
+    uint32_t linesCount = argc > 2 ? static_cast <uint32_t> (std::stoul (argv[2])): 1000000;
+    std::filesystem::create_directories (saveDir);
+
+    /* The async sink is run last, since its writer thread can not be restarted once shut down
+    */
+    const SinkInfo sinkInfos[] = {
+        {"TO_FILE_IMMEDIATE", Log::TO_FILE_IMMEDIATE},
+        {"TO_FILE_BINARY",    Log::TO_FILE_BINARY},
+        {"TO_FILE_ASYNC",     Log::TO_FILE_ASYNC}
+    };
+
+    uint32_t instanceId = 0;
+    for (auto const& info: sinkInfos) {
+        /* Files are opened in append mode, so any file left behind by an earlier run is removed first
+        */
+        getFilesSize (saveDir, instanceId, true);
+        double seconds   = runBenchmark (instanceId, saveDir, info.sink, linesCount);
+        uintmax_t bytes  = getFilesSize (saveDir, instanceId, false);
+        instanceId++;
+
+        std::cout << "[" << info.name << "]"
+                  << " "
+                  << "[" << linesCount << " lines]"
+                  << " "
+                  << "[" << seconds * 1000.0 << " ms]"
+                  << " "
+                  << "[" << static_cast <uint64_t> (linesCount / seconds) << " lines/s]"
+                  << " "
+                  << "[" << bytes / 1024 << " KB]"
+                  << std::endl;
+    }
+
+    const std::pair <const char*, Log::e_timestampMode> timestampModes[] = {
+        {"WALL_CLOCK", Log::WALL_CLOCK},
+        {"MONOTONIC",  Log::MONOTONIC}
+    };
+    for (auto const& [name, mode]: timestampModes) {
+        double nanoseconds = runHeaderBenchmark (instanceId++, mode, linesCount);
+        std::cout << "[" << name << "]"
+                  << " "
+                  << "[" << linesCount << " headers]"
+                  << " "
+                  << "[" << nanoseconds << " ns/header]"
+                  << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
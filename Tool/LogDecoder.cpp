@@ -0,0 +1,254 @@
+/* Offline decoder that turns a binary log (.blog) file written by the TO_FILE_BINARY sink back in to text. Each record
+ * is written out as a line with the same header as the text sinks, followed by its format string with every {} replaced
+ * by the next argument
+ *
+ * Usage
+ * LogDecoder_exe <input .blog> [output .txt]
+ *
+ * The output is written next to the input (same file name, .txt extension) if an output path is not given
+*/
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <unordered_map>
+#include "../Collections/Log/BinaryFormat.h"
+#include "../Collections/Log/Timestamp.h"
+
+using namespace Collections;
+
+namespace Tool {
+    struct FormatInfo {
+        uint8_t level;
+        uint32_t line;
+        std::string function;
+        std::string format;
+        std::string argTypes;
+    };
+
+    /* Reads values from the file contents, in the same byte order that they were written in
+    */
+    class BinaryReader {
+        private:
+            const std::string& m_bytes;
+            size_t m_offset;
+
+            void require (size_t size) {
+                if (m_offset + size > m_bytes.size())
+                    throw std::runtime_error ("Truncated entry in binary log");
+            }
+
+        public:
+            BinaryReader (const std::string& bytes): m_bytes (bytes) {
+                m_offset = 0;
+            }
+
+            bool isEnd (void) {
+                return m_offset >= m_bytes.size();
+            }
+
+            template <typename T>
+            T readValue (void) {
+                require (sizeof (T));
+                T value;
+                std::memcpy (&value, m_bytes.data() + m_offset, sizeof (T));
+                m_offset += sizeof (T);
+                return value;
+            }
+
+            std::string readString (void) {
+                uint32_t size = readValue <uint32_t>();
+                require (size);
+                std::string value = m_bytes.substr (m_offset, size);
+                m_offset += size;
+                return value;
+            }
+
+            void readMagic (void) {
+                require (sizeof (Log::g_binaryMagic));
+                if (m_bytes.compare (m_offset, sizeof (Log::g_binaryMagic),
+                                     Log::g_binaryMagic, sizeof (Log::g_binaryMagic)) != 0)
+                    throw std::runtime_error ("Invalid binary log magic");
+                m_offset += sizeof (Log::g_binaryMagic);
+            }
+    };
+
+    const char* getLevelString (uint8_t level) {
+        switch (level) {
+            case 1:
+                return "INFO";
+            case 2:
+                return "WARN";
+            case 4:
+                return "ERRO";
+            default:
+                return "UNDF";
+        }
+    }
+
+    void decodeArg (BinaryReader& reader, char argType, std::ostream& ost) {
+        switch (argType) {
+            case Log::ARG_BOOL:
+                ost << static_cast <bool>     (reader.readValue <uint8_t>());
+                break;
+            case Log::ARG_CHAR:
+                ost << static_cast <char>     (reader.readValue <uint8_t>());
+                break;
+            case Log::ARG_INT32:
+                ost << reader.readValue <int32_t>();
+                break;
+            case Log::ARG_UINT32:
+                ost << reader.readValue <uint32_t>();
+                break;
+            case Log::ARG_INT64:
+                ost << reader.readValue <int64_t>();
+                break;
+            case Log::ARG_UINT64:
+                ost << reader.readValue <uint64_t>();
+                break;
+            case Log::ARG_FLOAT:
+                ost << reader.readValue <float>();
+                break;
+            case Log::ARG_DOUBLE:
+                ost << reader.readValue <double>();
+                break;
+            case Log::ARG_STRING:
+                ost << reader.readString();
+                break;
+            default:
+                throw std::runtime_error ("Unknown argument type in binary log");
+        }
+    }
+
+    void decodeRecord (BinaryReader& reader,
+                       uint32_t instanceId,
+                       const FormatInfo& info,
+                       std::ostream& ost) {
+
+        std::string timestamp;
+        Log::TimestampService::appendWallClock (timestamp, static_cast <int64_t> (reader.readValue <uint64_t>()));
+
+        ost << "[" << std::setw (2) << std::setfill ('0') << instanceId << "]"
+            << " "
+            << timestamp
+            << " "
+            << "[" << getLevelString (info.level) << "]"
+            << " "
+            << info.function
+            << " "
+            << info.line
+            << " ";
+        /* Arguments are read in order, so every argument is read even if the format string has fewer placeholders
+        */
+        size_t argIdx = 0;
+        size_t pos    = 0;
+        while (pos < info.format.size()) {
+            if (info.format.compare (pos, 2, "{}") == 0 && argIdx < info.argTypes.size()) {
+                decodeArg (reader, info.argTypes[argIdx++], ost);
+                pos += 2;
+            }
+            else
+                ost << info.format[pos++];
+        }
+        while (argIdx < info.argTypes.size()) {
+            ost << " ";
+            decodeArg (reader, info.argTypes[argIdx++], ost);
+        }
+        ost << "\n";
+    }
+
+    uint32_t decodeFile (const std::string& bytes, std::ostream& ost) {
+        BinaryReader reader (bytes);
+        std::unordered_map <uint32_t, FormatInfo> formatInfos;
+        uint32_t instanceId   = 0;
+        uint32_t recordsCount = 0;
+        bool headerFound      = false;
+
+        while (!reader.isEnd()) {
+            uint8_t tag = reader.readValue <uint8_t>();
+            switch (tag) {
+                /* A new session, format ids from the previous session are no longer valid
+                */
+                case Log::HEADER: {
+                    reader.readMagic();
+                    uint16_t version = reader.readValue <uint16_t>();
+                    if (version != Log::g_binaryVersion)
+                        throw std::runtime_error ("Unsupported binary log version");
+
+                    instanceId  = reader.readValue <uint32_t>();
+                    headerFound = true;
+                    formatInfos.clear();
+                    break;
+                }
+
+                case Log::FORMAT: {
+                    uint32_t formatId = reader.readValue <uint32_t>();
+                    FormatInfo info;
+                    info.level    = reader.readValue <uint8_t>();
+                    info.line     = reader.readValue <uint32_t>();
+                    info.function = reader.readString();
+                    info.format   = reader.readString();
+                    info.argTypes = reader.readString();
+                    formatInfos[formatId] = info;
+                    break;
+                }
+
+                case Log::RECORD: {
+                    uint32_t formatId = reader.readValue <uint32_t>();
+                    if (!headerFound || formatInfos.find (formatId) == formatInfos.end())
+                        throw std::runtime_error ("Record with unknown format id in binary log");
+
+                    decodeRecord (reader, instanceId, formatInfos[formatId], ost);
+                    recordsCount++;
+                    break;
+                }
+
+                default:
+                    throw std::runtime_error ("Unknown entry tag in binary log");
+            }
+        }
+        return recordsCount;
+    }
+}   // namespace Tool
+
+int main (int argc, char* argv[]) {
+    using namespace Tool;
+    if (argc < 2) {
+        std::cerr << "Usage: LogDecoder_exe <input .blog> [output .txt]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string inputPath  = argv[1];
+    std::string outputPath = argc > 2 ? argv[2]: inputPath.substr (0, inputPath.find_last_of ('.')) + ".txt";
+
+    std::ifstream inputFile (inputPath, std::ios_base::in | std::ios_base::binary);
+    if (!inputFile.is_open()) {
+        std::cerr << "Failed to open input file " << "[" << inputPath << "]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::stringstream contents;
+    contents << inputFile.rdbuf();
+
+    std::ofstream outputFile (outputPath, std::ios_base::out);
+    if (!outputFile.is_open()) {
+        std::cerr << "Failed to open output file " << "[" << outputPath << "]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        uint32_t recordsCount = decodeFile (contents.str(), outputFile);
+        std::cout << "[" << inputPath << "]"
+                  << " -> "
+                  << "[" << outputPath << "]"
+                  << " "
+                  << "[" << recordsCount << " records]"
+                  << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Failed to decode " << "[" << inputPath << "]" << " " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+/* Splits the shared log files written by the TO_FILE_SHARED sink back in to one file per record. Every line in a shared
+ * file starts with the tag of its record, {<instance id> <calling file>}, the tag is stripped and the rest of the line
+ * is written to v_<instance id>_<calling file>.txt. A line that does not start with a tag is the continuation of a
+ * message that spans more than one line (a validation message for example), so it is written to the view of the last
+ * tag seen in the same shared log
+ *
+ * Usage
+ * LogSplitter_exe <shared log> [shared log ...]
+ *
+ * The views are written next to the first shared log. When more than one shared log is given (one per thread), the
+ * lines of each record are written out one shared log after the other
+*/
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+#include <unordered_map>
+#include <memory>
+
+namespace Tool {
+    struct ViewInfo {
+        std::unique_ptr <std::ofstream> file;
+        uint32_t linesCount;
+    };
+
+    /* Returns false if the line does not start with a tag, the tag contents are returned without the braces
+    */
+    bool splitTag (const std::string& line, std::string& tag, std::string& rest) {
+        if (line.empty() || line[0] != '{')
+            return false;
+
+        size_t tagEnd = line.find ("} ");
+        if (tagEnd == std::string::npos)
+            return false;
+
+        tag  = line.substr (1, tagEnd - 1);
+        rest = line.substr (tagEnd + 2);
+        return true;
+    }
+
+    std::string getViewPath (const std::string& saveDir, const std::string& tag) {
+        std::string fileName = tag;
+        size_t spaceIdx      = fileName.find (' ');
+        if (spaceIdx != std::string::npos)
+            fileName[spaceIdx] = '_';
+        return saveDir + "v_" + fileName + ".txt";
+    }
+}   // namespace Tool
+
+int main (int argc, char* argv[]) {
+    using namespace Tool;
+    if (argc < 2) {
+        std::cerr << "Usage: LogSplitter_exe <shared log> [shared log ...]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string saveDir = std::filesystem::path (argv[1]).parent_path().string();
+    if (!saveDir.empty())
+        saveDir += "/";
+
+    std::unordered_map <std::string, ViewInfo> viewInfos;
+    uint32_t orphanedCount = 0;
+    for (int i = 1; i < argc; i++) {
+        std::ifstream sharedFile (argv[i], std::ios_base::in);
+        if (!sharedFile.is_open()) {
+            std::cerr << "Failed to open shared log " << "[" << argv[i] << "]" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        /* The last tag is not carried over from one shared log to the next, since each shared log is written by a
+         * different thread
+        */
+        std::string line, tag, rest, lastTag;
+        while (std::getline (sharedFile, line)) {
+            if (splitTag (line, tag, rest))
+                lastTag = tag;
+            else if (!lastTag.empty()) {
+                tag  = lastTag;
+                rest = line;
+            }
+            else {
+                orphanedCount++;
+                continue;
+            }
+
+            auto& info = viewInfos[tag];
+            if (info.file == nullptr) {
+                std::string viewPath = getViewPath (saveDir, tag);
+                info.file            = std::make_unique <std::ofstream> (viewPath, std::ios_base::out);
+                info.linesCount      = 0;
+                if (!info.file->is_open()) {
+                    std::cerr << "Failed to open view " << "[" << viewPath << "]" << std::endl;
+                    return EXIT_FAILURE;
+                }
+            }
+            *info.file << rest << "\n";
+            info.linesCount++;
+        }
+    }
+
+    for (auto const& [tag, info]: viewInfos)
+        std::cout << "[" << getViewPath (saveDir, tag) << "]"
+                  << " "
+                  << "[" << info.linesCount << " lines]"
+                  << std::endl;
+    /* Untagged lines at the start of a shared log have no record to go to, this only happens if the shared log was
+     * truncated from the front
+    */
+    if (orphanedCount != 0)
+        std::cout << "[" << orphanedCount << " untagged lines before the first tag skipped]" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,529 @@
+/* Offline encoder that converts a texture image in to a block compressed KTX2 container, with all of its mip levels
+ * generated up front. The texture loader picks up the container in place of the source image if it is found next to
+ * it (same file name, .ktx2 extension)
+ *
+ * Usage
+ * TextureEncoder_exe <input image> <output .ktx2> [BC7 | BC1 | BC4 | BC5]
+ *
+ * BC7 (8 bits per texel) is used by default for color textures. BC1 (4 bits per texel) can be used for opaque color
+ * textures that can live with lower quality, while BC4 (single channel) and BC5 (two channel) are meant for linear
+ * data like masks and normal maps. Note that, only the color formats are sampled as sRGB
+*/
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <array>
+#include <string>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include "../Utils/KTXContainer.h"
+
+namespace Tool {
+    typedef enum {
+        BC7 = 0,
+        BC1 = 1,
+        BC4 = 2,
+        BC5 = 3
+    } e_blockFormat;
+
+    struct BlockFormatInfo {
+        const char* name;
+        VkFormat format;
+        uint32_t blockSize;
+        bool isSRGB;
+        /* Data format descriptor color model and channel ids of its samples, the samples split the block evenly
+        */
+        uint32_t colorModel;
+        std::vector <uint32_t> channelIds;
+    };
+
+    const std::array <BlockFormatInfo, 4> g_blockFormatInfos = {{
+        {"BC7", VK_FORMAT_BC7_SRGB_BLOCK,     16, true,  134, {0}},
+        {"BC1", VK_FORMAT_BC1_RGB_SRGB_BLOCK,  8, true,  128, {0}},
+        {"BC4", VK_FORMAT_BC4_UNORM_BLOCK,     8, false, 131, {0}},
+        {"BC5", VK_FORMAT_BC5_UNORM_BLOCK,    16, false, 132, {0, 1}}
+    }};
+
+    struct MipLevel {
+        uint32_t width;
+        uint32_t height;
+        std::vector <uint8_t> pixels;
+        std::vector <uint8_t> blocks;
+    };
+
+    /* Writes bits to a block starting from the least significant bit of the first byte
+    */
+    class BitWriter {
+        private:
+            uint8_t* m_data;
+            uint32_t m_bitOffset;
+
+        public:
+            BitWriter (uint8_t* data) {
+                m_data      = data;
+                m_bitOffset = 0;
+            }
+
+            void write (uint32_t value, uint32_t bitsCount) {
+                for (uint32_t i = 0; i < bitsCount; i++, m_bitOffset++) {
+                    if ((value >> i) & 1)
+                        m_data[m_bitOffset / 8] |= static_cast <uint8_t> (1 << (m_bitOffset % 8));
+                }
+            }
+    };
+
+    float srgbToLinear (uint8_t value) {
+        float normalized = value / 255.0f;
+        return normalized <= 0.04045f ? normalized / 12.92f: std::pow ((normalized + 0.055f) / 1.055f, 2.4f);
+    }
+
+    uint8_t linearToSrgb (float value) {
+        float normalized = value <= 0.0031308f ? value * 12.92f: 1.055f * std::pow (value, 1.0f / 2.4f) - 0.055f;
+        return static_cast <uint8_t> (std::clamp (normalized * 255.0f + 0.5f, 0.0f, 255.0f));
+    }
+
+    /* Build the next mip level using a 2x2 box filter, color channels of sRGB textures are averaged in linear space
+    */
+    MipLevel getNextMipLevel (const MipLevel& srcLevel, bool isSRGB) {
+        MipLevel dstLevel;
+        dstLevel.width  = srcLevel.width  > 1 ? srcLevel.width  / 2: 1;
+        dstLevel.height = srcLevel.height > 1 ? srcLevel.height / 2: 1;
+        dstLevel.pixels.resize (static_cast <size_t> (dstLevel.width) * dstLevel.height * 4);
+
+        for (uint32_t y = 0; y < dstLevel.height; y++) {
+            for (uint32_t x = 0; x < dstLevel.width; x++) {
+                const uint8_t* srcTexels[4];
+                for (uint32_t i = 0; i < 4; i++) {
+                    uint32_t srcX = std::min (2 * x + (i % 2), srcLevel.width  - 1);
+                    uint32_t srcY = std::min (2 * y + (i / 2), srcLevel.height - 1);
+                    srcTexels[i]  = &srcLevel.pixels[(static_cast <size_t> (srcY) * srcLevel.width + srcX) * 4];
+                }
+                uint8_t* dstTexel = &dstLevel.pixels[(static_cast <size_t> (y) * dstLevel.width + x) * 4];
+
+                for (uint32_t c = 0; c < 4; c++) {
+                    if (isSRGB && c < 3) {
+                        float sum = 0.0f;
+                        for (auto const& texel: srcTexels)
+                            sum += srgbToLinear (texel[c]);
+                        dstTexel[c] = linearToSrgb (sum * 0.25f);
+                    }
+                    else {
+                        uint32_t sum = 2;
+                        for (auto const& texel: srcTexels)
+                            sum += texel[c];
+                        dstTexel[c] = static_cast <uint8_t> (sum / 4);
+                    }
+                }
+            }
+        }
+        return dstLevel;
+    }
+
+    /* Find the line through the texels (in the first channelsCount channels) that best fits them, using the mean and
+     * the principal axis of the covariance matrix (power iteration). The end points are where the texels projected on
+     * to the line start and end
+    */
+    void getEndPoints (const uint8_t texels[16][4], uint32_t channelsCount, float endPoints[2][4]) {
+        float mean[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (uint32_t i = 0; i < 16; i++)
+            for (uint32_t c = 0; c < channelsCount; c++)
+                mean[c] += texels[i][c] / 16.0f;
+
+        float covariance[4][4] = {};
+        for (uint32_t i = 0; i < 16; i++)
+            for (uint32_t a = 0; a < channelsCount; a++)
+                for (uint32_t b = 0; b < channelsCount; b++)
+                    covariance[a][b] += (texels[i][a] - mean[a]) * (texels[i][b] - mean[b]);
+
+        /* Start from the covariance column of the channel with the largest variance, a fixed starting axis could be
+         * orthogonal to the principal axis (for example, two colors that differ only in green and blue)
+        */
+        uint32_t maxVarianceChannel = 0;
+        for (uint32_t c = 1; c < channelsCount; c++)
+            if (covariance[c][c] > covariance[maxVarianceChannel][maxVarianceChannel])
+                maxVarianceChannel = c;
+
+        float axis[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (uint32_t c = 0; c < channelsCount; c++)
+            axis[c] = covariance[c][maxVarianceChannel];
+
+        for (uint32_t iteration = 0; iteration < 8; iteration++) {
+            float nextAxis[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            float length      = 0.0f;
+            for (uint32_t a = 0; a < channelsCount; a++) {
+                for (uint32_t b = 0; b < channelsCount; b++)
+                    nextAxis[a] += covariance[a][b] * axis[b];
+                length += nextAxis[a] * nextAxis[a];
+            }
+            /* All texels are the same, any axis will do
+            */
+            if (length < 1e-6f)
+                break;
+            for (uint32_t c = 0; c < channelsCount; c++)
+                axis[c] = nextAxis[c] / std::sqrt (length);
+        }
+
+        float minProjection = 0.0f, maxProjection = 0.0f;
+        for (uint32_t i = 0; i < 16; i++) {
+            float projection = 0.0f;
+            for (uint32_t c = 0; c < channelsCount; c++)
+                projection += (texels[i][c] - mean[c]) * axis[c];
+            minProjection = std::min (minProjection, projection);
+            maxProjection = std::max (maxProjection, projection);
+        }
+
+        for (uint32_t c = 0; c < channelsCount; c++) {
+            endPoints[0][c] = std::clamp (mean[c] + axis[c] * minProjection, 0.0f, 255.0f);
+            endPoints[1][c] = std::clamp (mean[c] + axis[c] * maxProjection, 0.0f, 255.0f);
+        }
+    }
+
+    /* BC7 mode 6, a single subset with 7 bit RGBA end points (plus a shared low bit per end point) and 4 bit indices.
+     * All four combinations of the low bits are tried and the one with the least error is kept
+    */
+    void encodeBC7Block (const uint8_t texels[16][4], uint8_t* block) {
+        const uint32_t weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+        float endPoints[2][4];
+        getEndPoints (texels, 4, endPoints);
+
+        uint32_t bestError = UINT32_MAX;
+        uint32_t bestEndPoints[2][4], bestPBits[2], bestIndices[16];
+
+        for (uint32_t pBits = 0; pBits < 4; pBits++) {
+            uint32_t pBit[2] = {pBits & 1, pBits >> 1};
+            uint32_t quantized[2][4];
+            uint32_t palette[16][4];
+
+            for (uint32_t e = 0; e < 2; e++)
+                for (uint32_t c = 0; c < 4; c++)
+                    quantized[e][c] = static_cast <uint32_t> (std::clamp (
+                                      std::round ((endPoints[e][c] - pBit[e]) / 2.0f), 0.0f, 127.0f));
+
+            for (uint32_t i = 0; i < 16; i++)
+                for (uint32_t c = 0; c < 4; c++) {
+                    uint32_t e0    = (quantized[0][c] << 1) | pBit[0];
+                    uint32_t e1    = (quantized[1][c] << 1) | pBit[1];
+                    palette[i][c]  = ((64 - weights[i]) * e0 + weights[i] * e1 + 32) >> 6;
+                }
+
+            uint32_t error = 0;
+            uint32_t indices[16];
+            for (uint32_t t = 0; t < 16; t++) {
+                uint32_t bestTexelError = UINT32_MAX;
+                for (uint32_t i = 0; i < 16; i++) {
+                    uint32_t texelError = 0;
+                    for (uint32_t c = 0; c < 4; c++) {
+                        int32_t delta = static_cast <int32_t> (palette[i][c]) - texels[t][c];
+                        texelError   += static_cast <uint32_t> (delta * delta);
+                    }
+                    if (texelError < bestTexelError) {
+                        bestTexelError = texelError;
+                        indices[t]     = i;
+                    }
+                }
+                error += bestTexelError;
+            }
+
+            if (error < bestError) {
+                bestError = error;
+                memcpy (bestEndPoints, quantized, sizeof (quantized));
+                memcpy (bestPBits,     pBit,      sizeof (pBit));
+                memcpy (bestIndices,   indices,   sizeof (indices));
+            }
+        }
+        /* The most significant bit of the first index is implied to be 0 (anchor index), if it isn't, the end points
+         * are swapped and the indices inverted
+        */
+        if (bestIndices[0] & 0x8) {
+            for (uint32_t c = 0; c < 4; c++)
+                std::swap (bestEndPoints[0][c], bestEndPoints[1][c]);
+            std::swap (bestPBits[0], bestPBits[1]);
+            for (auto& index: bestIndices)
+                index = 15 - index;
+        }
+
+        memset (block, 0, 16);
+        BitWriter writer (block);
+        writer.write (1 << 6, 7);
+        for (uint32_t c = 0; c < 4; c++) {
+            writer.write (bestEndPoints[0][c], 7);
+            writer.write (bestEndPoints[1][c], 7);
+        }
+        writer.write (bestPBits[0], 1);
+        writer.write (bestPBits[1], 1);
+        for (uint32_t t = 0; t < 16; t++)
+            writer.write (bestIndices[t], t == 0 ? 3: 4);
+    }
+
+    /* BC1 in 4 color (opaque) mode, 565 end points with 2 bit indices. The 4 color mode is selected by storing the
+     * larger end point first
+    */
+    void encodeBC1Block (const uint8_t texels[16][4], uint8_t* block) {
+        float endPoints[2][4];
+        getEndPoints (texels, 3, endPoints);
+
+        uint16_t colors[2];
+        uint32_t palette[4][3];
+        for (uint32_t e = 0; e < 2; e++) {
+            uint32_t r = static_cast <uint32_t> (std::round (endPoints[e][0] * 31.0f / 255.0f));
+            uint32_t g = static_cast <uint32_t> (std::round (endPoints[e][1] * 63.0f / 255.0f));
+            uint32_t b = static_cast <uint32_t> (std::round (endPoints[e][2] * 31.0f / 255.0f));
+            colors[e]  = static_cast <uint16_t> ((r << 11) | (g << 5) | b);
+        }
+        if (colors[0] < colors[1])
+            std::swap (colors[0], colors[1]);
+
+        for (uint32_t e = 0; e < 2; e++) {
+            uint32_t r     = (colors[e] >> 11) & 0x1F;
+            uint32_t g     = (colors[e] >> 5)  & 0x3F;
+            uint32_t b     =  colors[e]        & 0x1F;
+            palette[e][0]  = (r << 3) | (r >> 2);
+            palette[e][1]  = (g << 2) | (g >> 4);
+            palette[e][2]  = (b << 3) | (b >> 2);
+        }
+        for (uint32_t c = 0; c < 3; c++) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        uint32_t indices = 0;
+        /* If both end points are the same, the block is in 3 color mode and only index 0 is safe to use
+        */
+        if (colors[0] != colors[1]) {
+            for (uint32_t t = 0; t < 16; t++) {
+                uint32_t bestTexelError = UINT32_MAX, bestIndex = 0;
+                for (uint32_t i = 0; i < 4; i++) {
+                    uint32_t texelError = 0;
+                    for (uint32_t c = 0; c < 3; c++) {
+                        int32_t delta = static_cast <int32_t> (palette[i][c]) - texels[t][c];
+                        texelError   += static_cast <uint32_t> (delta * delta);
+                    }
+                    if (texelError < bestTexelError) {
+                        bestTexelError = texelError;
+                        bestIndex      = i;
+                    }
+                }
+                indices |= bestIndex << (2 * t);
+            }
+        }
+
+        memcpy (block,     &colors[0], 2);
+        memcpy (block + 2, &colors[1], 2);
+        memcpy (block + 4, &indices,   4);
+    }
+
+    /* BC4 in 8 value mode (first end point larger), 8 bit end points with 3 bit indices
+    */
+    void encodeBC4Block (const uint8_t texels[16][4], uint32_t channel, uint8_t* block) {
+        uint8_t maxValue = 0, minValue = 255;
+        for (uint32_t t = 0; t < 16; t++) {
+            maxValue = std::max (maxValue, texels[t][channel]);
+            minValue = std::min (minValue, texels[t][channel]);
+        }
+
+        uint32_t palette[8];
+        palette[0] = maxValue;
+        palette[1] = minValue;
+        for (uint32_t i = 2; i < 8; i++)
+            palette[i] = ((8 - i) * maxValue + (i - 1) * minValue + 3) / 7;
+
+        memset (block, 0, 8);
+        block[0] = maxValue;
+        block[1] = minValue;
+        /* If both end points are the same, index 0 is used for all texels
+        */
+        if (maxValue == minValue)
+            return;
+
+        BitWriter writer (block + 2);
+        for (uint32_t t = 0; t < 16; t++) {
+            uint32_t bestTexelError = UINT32_MAX, bestIndex = 0;
+            for (uint32_t i = 0; i < 8; i++) {
+                uint32_t texelError = static_cast <uint32_t> (std::abs (static_cast <int32_t> (palette[i]) -
+                                                                        texels[t][channel]));
+                if (texelError < bestTexelError) {
+                    bestTexelError = texelError;
+                    bestIndex      = i;
+                }
+            }
+            writer.write (bestIndex, 3);
+        }
+    }
+
+    void encodeMipLevel (MipLevel& level, e_blockFormat blockFormat) {
+        uint32_t blocksX   = (level.width  + 3) / 4;
+        uint32_t blocksY   = (level.height + 3) / 4;
+        uint32_t blockSize = g_blockFormatInfos[blockFormat].blockSize;
+        level.blocks.resize (static_cast <size_t> (blocksX) * blocksY * blockSize);
+
+        for (uint32_t by = 0; by < blocksY; by++) {
+            for (uint32_t bx = 0; bx < blocksX; bx++) {
+                /* Blocks that hang over the edge of the level repeat the last row/column
+                */
+                uint8_t texels[16][4];
+                for (uint32_t t = 0; t < 16; t++) {
+                    uint32_t x = std::min (bx * 4 + t % 4, level.width  - 1);
+                    uint32_t y = std::min (by * 4 + t / 4, level.height - 1);
+                    memcpy (texels[t], &level.pixels[(static_cast <size_t> (y) * level.width + x) * 4], 4);
+                }
+
+                uint8_t* block = &level.blocks[(static_cast <size_t> (by) * blocksX + bx) * blockSize];
+                switch (blockFormat) {
+                    case BC7:   encodeBC7Block (texels, block);            break;
+                    case BC1:   encodeBC1Block (texels, block);            break;
+                    case BC4:   encodeBC4Block (texels, 0, block);         break;
+                    case BC5:   encodeBC4Block (texels, 0, block);
+                                encodeBC4Block (texels, 1, block + 8);     break;
+                }
+            }
+        }
+    }
+
+    /* Basic data format descriptor block, which describes the texel block dimensions and the samples (channels) in it
+    */
+    std::vector <uint32_t> getDataFormatDescriptor (e_blockFormat blockFormat) {
+        auto& info             = g_blockFormatInfos[blockFormat];
+        uint32_t samplesCount  = static_cast <uint32_t> (info.channelIds.size());
+        uint32_t blockByteSize = 24 + 16 * samplesCount;
+
+        std::vector <uint32_t> words;
+        words.push_back (4 + blockByteSize);
+        /* Vendor id and descriptor type (both 0 for Khronos basic), version number and block size
+        */
+        words.push_back (0);
+        words.push_back (2 | (blockByteSize << 16));
+        /* Color model, color primaries (BT709), transfer function (linear or sRGB) and flags (straight alpha)
+        */
+        words.push_back (info.colorModel | (1 << 8) | ((info.isSRGB ? 2: 1) << 16));
+        /* Texel block dimensions (minus 1) and bytes per plane
+        */
+        words.push_back (3 | (3 << 8));
+        words.push_back (info.blockSize);
+        words.push_back (0);
+
+        /* Each sample's bit offset and bit length (minus 1), a BC7 block is a single 128 bit sample while a BC5 block is
+         * two 64 bit samples
+        */
+        uint32_t sampleBits = info.blockSize * 8 / samplesCount;
+        for (uint32_t i = 0; i < samplesCount; i++) {
+            words.push_back ((i * sampleBits) | ((sampleBits - 1) << 16) | (info.channelIds[i] << 24));
+            words.push_back (0);
+            words.push_back (0);
+            words.push_back (UINT32_MAX);
+        }
+        return words;
+    }
+
+    void writeContainer (const char* outputFilePath,
+                         const std::vector <MipLevel>& levels,
+                         e_blockFormat blockFormat) {
+
+        auto& info      = g_blockFormatInfos[blockFormat];
+        auto dfdWords   = getDataFormatDescriptor (blockFormat);
+        uint32_t levelCount = static_cast <uint32_t> (levels.size());
+
+        Utils::KTXHeader header{};
+        memcpy (header.identifier, Utils::g_KTXIdentifier, sizeof (Utils::g_KTXIdentifier));
+        header.vkFormat               = static_cast <uint32_t> (info.format);
+        header.typeSize               = 1;
+        header.pixelWidth             = levels[0].width;
+        header.pixelHeight            = levels[0].height;
+        header.pixelDepth             = 0;
+        header.layerCount             = 0;
+        header.faceCount              = 1;
+        header.levelCount             = levelCount;
+        header.supercompressionScheme = 0;
+        header.dfdByteOffset          = static_cast <uint32_t> (sizeof (Utils::KTXHeader) +
+                                                                levelCount * sizeof (Utils::KTXLevelIndex));
+        header.dfdByteLength          = static_cast <uint32_t> (dfdWords.size() * sizeof (uint32_t));
+        /* Mip level data is stored from the smallest level to level 0, with each level aligned to the block size
+        */
+        std::vector <Utils::KTXLevelIndex> levelIndices (levelCount);
+        uint64_t offset = header.dfdByteOffset + header.dfdByteLength;
+        for (uint32_t i = levelCount; i > 0; i--) {
+            offset = (offset + info.blockSize - 1) / info.blockSize * info.blockSize;
+            levelIndices[i - 1].byteOffset             = offset;
+            levelIndices[i - 1].byteLength             = levels[i - 1].blocks.size();
+            levelIndices[i - 1].uncompressedByteLength = levels[i - 1].blocks.size();
+            offset += levels[i - 1].blocks.size();
+        }
+
+        std::ofstream file (outputFilePath, std::ios::binary);
+        if (!file.is_open())
+            throw std::runtime_error ("Failed to open output file");
+
+        file.write (reinterpret_cast <const char*> (&header), sizeof (header));
+        file.write (reinterpret_cast <const char*> (levelIndices.data()),
+                    levelIndices.size() * sizeof (Utils::KTXLevelIndex));
+        file.write (reinterpret_cast <const char*> (dfdWords.data()), header.dfdByteLength);
+
+        for (uint32_t i = levelCount; i > 0; i--) {
+            uint64_t padding = levelIndices[i - 1].byteOffset - static_cast <uint64_t> (file.tellp());
+            for (uint64_t p = 0; p < padding; p++)
+                file.put (0);
+            file.write (reinterpret_cast <const char*> (levels[i - 1].blocks.data()),
+                        static_cast <std::streamsize> (levels[i - 1].blocks.size()));
+        }
+    }
+}   // namespace Tool
+
+int main (int argc, char* argv[]) {
+    using namespace Tool;
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <input image> <output .ktx2> [BC7 | BC1 | BC4 | BC5]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    e_blockFormat blockFormat = BC7;
+    if (argc > 3) {
+        auto match = std::find_if (g_blockFormatInfos.begin(), g_blockFormatInfos.end(),
+                                   [&] (const BlockFormatInfo& info) { return info.name == std::string (argv[3]); });
+        if (match == g_blockFormatInfos.end()) {
+            std::cerr << "Unknown block format " << "[" << argv[3] << "]" << std::endl;
+            return EXIT_FAILURE;
+        }
+        blockFormat = static_cast <e_blockFormat> (match - g_blockFormatInfos.begin());
+    }
+
+    int width, height, channels;
+    stbi_uc* pixels = stbi_load (argv[1], &width, &height, &channels, STBI_rgb_alpha);
+    if (!pixels) {
+        std::cerr << "Failed to load image " << "[" << argv[1] << "]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector <MipLevel> levels (1);
+    levels[0].width  = static_cast <uint32_t> (width);
+    levels[0].height = static_cast <uint32_t> (height);
+    levels[0].pixels.assign (pixels, pixels + static_cast <size_t> (width) * height * 4);
+    stbi_image_free (pixels);
+
+    while (levels.back().width > 1 || levels.back().height > 1)
+        levels.push_back (getNextMipLevel (levels.back(), g_blockFormatInfos[blockFormat].isSRGB));
+
+    size_t inputSize = 0, outputSize = 0;
+    for (auto& level: levels) {
+        encodeMipLevel (level, blockFormat);
+        inputSize  += level.pixels.size();
+        outputSize += level.blocks.size();
+    }
+
+    try {
+        writeContainer (argv[2], levels, blockFormat);
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << " " << "[" << argv[2] << "]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "[OK] " << argv[1] << " -> " << argv[2]
+              << " " << "[" << g_blockFormatInfos[blockFormat].name << "]"
+              << " " << "[" << levels.size() << " levels" << "]"
+              << " " << "[" << inputSize << "->" << outputSize << "]"
+              << std::endl;
+    return EXIT_SUCCESS;
+}
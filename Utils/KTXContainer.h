@@ -0,0 +1,58 @@
+#ifndef KTX_CONTAINER_H
+#define KTX_CONTAINER_H
+
+#include <cstdint>
+
+namespace Utils {
+    /* KTX2 is a container format for GPU textures, it stores the image data in the exact layout it is uploaded in (for
+     * example, block compressed), along with its mip levels. A KTX2 file is laid out as follows
+     *
+     * Header
+     * Level index                  One entry per mip level, starting from level 0 (largest)
+     * Data format descriptor       Describes the texel layout, the Vulkan format in the header is enough for us
+     * Key/value data               Optional
+     * Mip level data               Ordered from the smallest level to level 0, each level is aligned to the texel block
+     *                              size
+     *
+     * Note that, all fields are little endian and naturally aligned, so the structs below match the file layout
+    */
+    const uint8_t g_KTXIdentifier[12] = {
+        0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+    };
+
+    struct KTXHeader {
+        uint8_t identifier[12];
+        uint32_t vkFormat;
+        /* Size of the data type in bytes, this is 1 for block compressed formats
+        */
+        uint32_t typeSize;
+        uint32_t pixelWidth;
+        uint32_t pixelHeight;
+        /* Depth and layer count are 0 for 2D images that are not arrays
+        */
+        uint32_t pixelDepth;
+        uint32_t layerCount;
+        uint32_t faceCount;
+        /* A level count of 0 indicates that the mip levels are expected to be generated at load time
+        */
+        uint32_t levelCount;
+        uint32_t supercompressionScheme;
+
+        uint32_t dfdByteOffset;
+        uint32_t dfdByteLength;
+        uint32_t kvdByteOffset;
+        uint32_t kvdByteLength;
+        uint64_t sgdByteOffset;
+        uint64_t sgdByteLength;
+    };
+
+    struct KTXLevelIndex {
+        uint64_t byteOffset;
+        uint64_t byteLength;
+        uint64_t uncompressedByteLength;
+    };
+
+    static_assert (sizeof (KTXHeader)     == 80, "KTX header does not match file layout");
+    static_assert (sizeof (KTXLevelIndex) == 24, "KTX level index does not match file layout");
+}   // namespace Utils
+#endif  // KTX_CONTAINER_H
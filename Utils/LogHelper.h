@@ -35,6 +35,7 @@ namespace Utils {
             case Core::TEXTURE_IMAGE:       return "TEXTURE_IMAGE";
             case Core::DEPTH_IMAGE:         return "DEPTH_IMAGE";
             case Core::MULTISAMPLE_IMAGE:   return "MULTISAMPLE_IMAGE";
+            case Core::OFFSCREEN_IMAGE:     return "OFFSCREEN_IMAGE";
             default:                        return "Unhandled e_imageType";
         }
     }
@@ -44,11 +45,11 @@ namespace Utils {
         {
             case Core::VOID_BUFFER:         return "VOID_BUFFER";
             case Core::STAGING_BUFFER:      return "STAGING_BUFFER";
-            case Core::STAGING_BUFFER_TEX:  return "STAGING_BUFFER_TEX";
             case Core::VERTEX_BUFFER:       return "VERTEX_BUFFER";
             case Core::INDEX_BUFFER:        return "INDEX_BUFFER";
             case Core::UNIFORM_BUFFER:      return "UNIFORM_BUFFER";
             case Core::STORAGE_BUFFER:      return "STORAGE_BUFFER";
+            case Core::READBACK_BUFFER:     return "READBACK_BUFFER";
             default:                        return "Unhandled e_bufferType";
         }
     }
@@ -61,6 +62,7 @@ namespace Utils {
             case Core::FEN_IN_FLIGHT:       return "FEN_IN_FLIGHT";
             case Core::SEM_IMAGE_AVAILABLE: return "SEM_IMAGE_AVAILABLE";
             case Core::SEM_RENDER_DONE:     return "SEM_RENDER_DONE";
+            case Core::SEM_TRANSFER_DONE:   return "SEM_TRANSFER_DONE";
             default:                        return "Unhandled e_syncType";
         }
     }